@@ -3,6 +3,9 @@ SET_LOOP_TASK_STACK_SIZE(4 * 1024);
 #include "globals.h"
 #include "src/params/params.h"
 #include "src/sd_card.h"
+#include "src/storage_service.h"
+#include "src/storage_index.h"
+#include "src/tile_download_task.h"
 #include "src/sensors_i2c_task.h"
 #include "src/lvgl_port/lvgl_port.h"
 #include "src/rgb_lcd_port/rgb_lcd_port.h"
@@ -15,6 +18,7 @@ SET_LOOP_TASK_STACK_SIZE(4 * 1024);
 #include "src/ui/ui_settings_vario.h"
 #include "src/ui/ui_settings_map.h"
 #include "src/ui/ui_settings_system.h"
+#include "src/ui/ui_settings_diag.h"
 #include "src/ui/ui_settings.h"
 #include "src/ui/ui_file_transfer.h"
 #include "src/ui/ui_main_screens.h"
@@ -24,10 +28,63 @@ SET_LOOP_TASK_STACK_SIZE(4 * 1024);
 #include "src/test_logger_task.h"
 #include "src/kalman_task.h"
 #include "src/flight_data.h"
+#include "src/task_profiler.h"
+#include "src/boot_sequence.h"
+#include "src/audio_vario_task.h"
 
 bool mainscreen_active = false;
 SemaphoreHandle_t sd_mutex = NULL;
 
+// Etape stockage: SD puis cache terrain (tache de demarrage, coeur 0)
+static void boot_storage_task(void *pvParameters) {
+  boot_stage_begin(BOOT_STAGE_SD);
+  bool ok = sd_init();
+#ifdef DEBUG_MODE
+  if (!ok) Serial.println("SD Failed");
+#endif
+  // Toutes les taches passent ensuite par le service pour acceder a la carte
+  if (!storage_service_start()) {
+#ifdef DEBUG_MODE
+    Serial.println("[STORAGE] Start failed");
+#endif
+  }
+  // Statistiques carte construites en arriere-plan pour l'UI
+  storage_index_init();
+  tile_coverage_init();
+  storage_index_rescan();
+  boot_stage_end(BOOT_STAGE_SD, ok);
+
+  boot_stage_begin(BOOT_STAGE_TERRAIN);
+  ok = terrain.begin();
+#ifdef DEBUG_MODE
+  if (!ok) Serial.println("[TERRAIN] Init failed - no memory");
+#endif
+  boot_stage_end(BOOT_STAGE_TERRAIN, ok);
+
+  // Telechargement de tuiles interrompu: reprise des que le WiFi est connecte
+  tile_download_resume();
+
+  vTaskDelete(NULL);
+}
+
+// Etape capteurs puis Kalman (tache de demarrage, coeur 0)
+static void boot_sensors_task(void *pvParameters) {
+  boot_stage_begin(BOOT_STAGE_SENSORS);
+  boot_stage_end(BOOT_STAGE_SENSORS, sensors_i2c_start());
+
+  boot_stage_begin(BOOT_STAGE_KALMAN);
+  boot_stage_end(BOOT_STAGE_KALMAN, kalman_start());
+
+  // Audio vario (silencieux tant que Kalman non valide)
+  if (!audio_vario_start()) {
+#ifdef DEBUG_MODE
+    Serial.println("[AUDIO] Start failed");
+#endif
+  }
+
+  vTaskDelete(NULL);
+}
+
 void setup() {
   sd_mutex = xSemaphoreCreateMutex();
   Serial.begin(115200);
@@ -35,30 +92,20 @@ void setup() {
   Serial.setDebugOutput(true);
 #endif
 
-  // Delai initial stabilisation
-  delay(100);
+  boot_begin();
 
-  // 1. Bus I2C + IO Extender
+  // 1. Bus I2C + IO Extender (dependance de toutes les autres etapes)
+  boot_stage_begin(BOOT_STAGE_IO);
   DEV_I2C_Init();
-  delay(50);
-
+  bool io_ok = boot_wait_i2c_device(IO_EXTENSION_ADDR, BOOT_IO_READY_TIMEOUT_MS);
   IO_EXTENSION_Init();
-  delay(100);  // Augmente de 10->100ms
-
   IO_EXTENSION_Output(IO_EXTENSION_IO_4, 1);
-  delay(50);
+  boot_stage_end(BOOT_STAGE_IO, io_ok);
 
-  // 2. Params + SD Card
+  // 2. Params (luminosite necessaire a l'ecran)
+  boot_stage_begin(BOOT_STAGE_PARAMS);
   params_init();
-
-#ifdef DEBUG_MODE
-  Serial.println("Initialisation SD...");
-#endif
-  if (!sd_init()) {
-#ifdef DEBUG_MODE
-    Serial.println("SD Failed");
-#endif
-  }
+  boot_stage_end(BOOT_STAGE_PARAMS, true);
 
 #ifdef DEBUG_MODE
   Serial.println("Starting Vario...");
@@ -66,39 +113,38 @@ void setup() {
   Serial.printf("Version: %s\n", VARIO_VERSION);
 #endif
 
-  // Delai avant capteurs I2C
-  delay(100);
-
-  // 3. Capteurs I2C (BMP390, BNO080, GPS)
-  sensors_i2c_start();
-
-  if (!terrain.begin()) {
-#ifdef DEBUG_MODE
-    Serial.println("[TERRAIN] Init failed - no memory");
-#endif
-  }
+  // 3. SD et capteurs en parallele sur le coeur 0 pendant l'init ecran
+  xTaskCreatePinnedToCore(boot_storage_task, "boot_sd", BOOT_TASK_STACK_SIZE, NULL, BOOT_TASK_PRIORITY, NULL, 0);
+  xTaskCreatePinnedToCore(boot_sensors_task, "boot_sensors", BOOT_TASK_STACK_SIZE, NULL, BOOT_TASK_PRIORITY, NULL, 0);
 
-  // 4. Kalman
-  kalman_start();
+  // Taches evenementielles sans dependance materielle
   metar_start();
+  wifi_task_start();
 
-  // Delai avant ecran
-  delay(100);
-
-  // 5. Ecran + Touch
+  // 4. Ecran + Touch + LVGL -> splash au plus tot
+  boot_stage_begin(BOOT_STAGE_DISPLAY);
   esp_lcd_touch_handle_t tp_handle = touch_gt911_init();
   esp_lcd_panel_handle_t panel_handle = waveshare_esp32_s3_rgb_lcd_init();
   wavesahre_rgb_lcd_set_brightness(params.system_brightness);
 
-  // 6. Init LVGL
   esp_err_t ret = lvgl_port_init(panel_handle, tp_handle);
   if (ret != ESP_OK) {
 #ifdef DEBUG_MODE
     Serial.println("LVGL init failed!");
 #endif
+    boot_stage_end(BOOT_STAGE_DISPLAY, false);
     while (1) vTaskDelay(pdMS_TO_TICKS(1000));
   }
 
+  // Calibration tactile appliquee par le port (lecture GT911)
+  lvgl_port_touch_calib_t touch_calib = { params.touch_offset_x, params.touch_offset_y,
+                                          params.touch_scale_x, params.touch_scale_y };
+  lvgl_port_set_touch_calibration(&touch_calib);
+
+  // Splash affiche jusqu'a ce que les etapes vol soient pretes -> puis ui_prestart_show()
+  ui_splash_show();
+  boot_stage_end(BOOT_STAGE_DISPLAY, true);
+
 #ifdef TEST_MODE
   test_logger_start();
 #ifdef DEBUG_MODE
@@ -107,9 +153,7 @@ void setup() {
 #endif
 
   flight_data_task_start();
-
-  // 7. Afficher splash (3s) -> puis ui_prestart_show()
-  ui_splash_show();
+  task_profiler_start();
 
 #ifdef DEBUG_MODE
   Serial.println("Setup complete");
@@ -117,6 +161,22 @@ void setup() {
 }
 
 void loop() {
+  // Console: seuls les caracteres de commande connus sont consommes,
+  // le reste de l'entree serie reste disponible pour les autres lecteurs
+  while (Serial.available()) {
+    int c = Serial.peek();
+    if (c == METRICS_DUMP_SERIAL_CMD) {
+      Serial.read();
+      sensor_metrics_dump_serial();
+    } else if (c == LVGL_MEM_TRACE_SERIAL_CMD) {
+      Serial.read();
+      lvgl_mem_set_trace(!lvgl_mem_get_trace());
+      Serial.printf("LVMEM trace %s\n", lvgl_mem_get_trace() ? "on" : "off");
+    } else {
+      break;
+    }
+  }
+
 #ifdef DEBUG_MODE_ALL
   static unsigned long last_print = 0;
 
@@ -36,6 +36,7 @@ I2C GPIO AND CONSTANTS
 #define GPS_I2C_ADDR (0x10)
 #define ESP_LCD_TOUCH_IO_I2C_GT911_ADDRESS (0x5D)
 #define ESP_LCD_TOUCH_IO_I2C_GT911_ADDRESS_BACKUP (0x14)
+#define TOUCH_IRQ_WATCHDOG_MS (50)  // Doigt pose sans front INT: relecture de securite
 #define IO_EXTENSION_ADDR 0x24
 
 //I2C Constants
@@ -61,6 +62,18 @@ I2C PERIPHERALS CONSTANTS
 #define GPS_SAMPLE_RATE_HZ (2)
 #define PMTK_SET_NMEA_UPDATE_2HZ "$PMTK220,500*2B"
 #define PMTK_API_SET_FIX_CTL_2HZ "$PMTK300,500,0,0,0,0*28"
+#define GPS_READY_TIMEOUT_MS (1000)     // Attente premiere trame NMEA
+#define GPS_ACK_TIMEOUT_MS (300)        // Attente acquittement PMTK
+#define GPS_ACK_MAX_SENTENCES (10)
+
+//Metriques capteurs
+#define METRICS_MAGIC (0x54454D53)    // "SMET" little-endian
+#define METRICS_VERSION (2)           // 2: compteur read_empty
+#define METRICS_HIST_BUCKETS (16)     // Buckets log2 (us pour lecture, ms pour age)
+#define METRICS_STALE_BMP390_MS (100)
+#define METRICS_STALE_BNO080_MS (50)
+#define METRICS_STALE_GPS_MS (1500)
+#define METRICS_DUMP_SERIAL_CMD 'm'   // Caractere declenchant le dump serie (console de loop())
 
 //IO EXTANDER CONSTANTS
 #define IO_EXTENSION_Mode 0x02
@@ -99,6 +112,22 @@ SDMMC GPIO AND CONSTANTS
 // Option de formatage automatique (mettre true pour forcer FAT32 si echec)
 #define SD_FORMAT_IF_MOUNT_FAILED false
 
+// Service de stockage (tache unique proprietaire de la carte)
+#define STORAGE_TASK_STACK_SIZE (8192)     // Lectures terrain (700 o sur la pile) + demandes imbriquees
+#define STORAGE_TASK_PRIORITY (3)
+#define STORAGE_QUEUE_DEPTH (8)            // Demandes en attente par niveau de priorite
+#define STORAGE_SUBMIT_TIMEOUT_MS (20)     // Attente max si la file est pleine
+#define STORAGE_IO_BUF_SIZE (16 * 1024)    // Tampon SRAM DMA, taille d'un bloc de transfert
+#define STORAGE_BUF_ALIGN (64)
+#define STORAGE_PATH_MAX (96)
+#define TEST_LOG_BLOCK_SIZE (4096)         // Bloc d'ecriture du journal test
+#define FILE_SERVER_CHUNK_SIZE (16 * 1024) // Bloc de telechargement web
+
+// Index du stockage (statistiques en cache pour l'UI)
+#define STORAGE_INDEX_SLICE_ENTRIES (64)            // Entrees lues par tranche de parcours
+#define STORAGE_INDEX_CAPACITY_MAX_AGE_MS (60000)   // Relecture de l'espace libre
+#define TILE_COVERAGE_MAX_TILES (256 * 1024)        // Liste de construction max (8 o/tuile, PSRAM)
+
 
 /*=========================================================================
 LCD GPIO AND CONSTANTS
@@ -133,6 +162,14 @@ LCD GPIO AND CONSTANTS
 #define LCD_H_RES (1024)
 #define LCD_V_RES (600)
 #define LCD_PIXEL_CLOCK_HZ (16 * 1000 * 1000)
+#define LCD_HSYNC_PULSE_WIDTH (162)
+#define LCD_HSYNC_BACK_PORCH (152)
+#define LCD_HSYNC_FRONT_PORCH (48)
+#define LCD_VSYNC_PULSE_WIDTH (45)
+#define LCD_VSYNC_BACK_PORCH (13)
+#define LCD_VSYNC_FRONT_PORCH (3)
+#define LCD_FRAME_CLOCKS ((LCD_H_RES + LCD_HSYNC_PULSE_WIDTH + LCD_HSYNC_BACK_PORCH + LCD_HSYNC_FRONT_PORCH) * (LCD_V_RES + LCD_VSYNC_PULSE_WIDTH + LCD_VSYNC_BACK_PORCH + LCD_VSYNC_FRONT_PORCH))
+#define LCD_REFRESH_HZ (LCD_PIXEL_CLOCK_HZ / LCD_FRAME_CLOCKS)  // ~17 Hz
 
 #define LCD_BIT_PER_PIXEL (16)
 #define RGB_BIT_PER_PIXEL (16)
@@ -159,10 +196,12 @@ LVGL AND GRAPHICS CONSTANTS
 #define LVGL_PORT_V_RES (LCD_V_RES)
 #define LVGL_PORT_TICK_PERIOD_MS (2)
 #define LVGL_PORT_TASK_MAX_DELAY_MS (500)
-#define LVGL_PORT_TASK_MIN_DELAY_MS (10)
 #define LVGL_PORT_TASK_STACK_SIZE (16 * 1024)
 #define LVGL_PORT_TASK_PRIORITY (2)
 #define LVGL_PORT_TASK_CORE (1)
+#define LVGL_PORT_VSYNC_TIMEOUT_MS (100)  // Au-dela: trame rendue sans VSYNC
+#define LVGL_PORT_FPS_FLIGHT (LCD_REFRESH_HZ)  // Ecrans de vol: chaque VSYNC
+#define LVGL_PORT_FPS_SETTINGS (8)              // Menus: une VSYNC sur deux
 #define CONFIG_LVGL_PORT_BUF_PSRAM 1
 #define CONFIG_LVGL_PORT_BUF_INTERNAL 0
 #define LVGL_PORT_BUFFER_MALLOC_CAPS (MALLOC_CAP_SPIRAM)
@@ -173,7 +212,22 @@ LVGL AND GRAPHICS CONSTANTS
 #define LVGL_PORT_LCD_RGB_BUFFER_NUMS (2)
 #define LVGL_PORT_DIRECT_MODE (1)
 
+// Allocateur LVGL: pools SRAM interne par classe de taille (~64 Ko), au-dela PSRAM
+#define LVGL_MEM_POOL_16_COUNT (512)
+#define LVGL_MEM_POOL_32_COUNT (640)
+#define LVGL_MEM_POOL_64_COUNT (256)
+#define LVGL_MEM_POOL_128_COUNT (96)
+#define LVGL_MEM_POOL_256_COUNT (32)
+#define LVGL_MEM_TRACE_SERIAL_CMD 't'  // Bascule la trace LVMEM (console de loop(), rejeu: tools/lvgl_mem_replay.cpp)
+
 #define UI_TASK_PRIORITY 2
+#define UI_FLIGHT_UPDATE_PERIOD_MS (100)  // Zones altitude/vario (10 Hz, labels reecrits sur changement)
+#define UI_MAP_RETRY_MS (2000)             // Nouvel essai de creation de la carte apres un echec
+#define UI_GAUGE_VARIO_RANGE (10.0f)       // Pleine echelle barre / aiguille (+-m/s)
+#define UI_GAUGE_NEEDLE_SIZE (320)
+#define UI_GAUGE_TAPE_W (120)
+#define UI_GAUGE_TAPE_H (500)
+#define UI_GAUGE_TAPE_PX_PER_M (2.0f)      // 500 px = 250 m visibles
 
 
 /*=========================================================================
@@ -183,6 +237,10 @@ WIFI CONSTANTS
 #define WIFI_DISCONNECTED_BIT BIT1
 #define WIFI_START_BIT BIT2
 #define WIFI_STOP_BIT BIT3
+#define WIFI_POLL_MS (20)               // Cadence de la machine a etats de connexion
+#define WIFI_SCAN_MS_PER_CHANNEL (100)  // Scan actif: ~1.3 s pour 13 canaux
+#define WIFI_NVS_NAMESPACE "wifi"        // Point d'acces memorise et refus (wifi_mgr_saved_t)
+#define WIFI_NVS_SAVED_KEY "saved"
 
 /*=========================================================================
 TILES CONSTANTS
@@ -214,6 +272,8 @@ TILES CONSTANTS
 
 // Nom du serveur de cartes (peut être paramétrable plus tard)
 #define OSM_SERVER_NAME "osm"
+// Source des tuiles de OSM_SERVER_NAME: seul serveur telechargeable, la carte ne lit que ce repertoire
+#define OSM_SERVER_URL "http://{a-c}.tile.openstreetmap.fr/osmfr/{z}/{x}/{y}.png"
 
 #define MAP_ZOOM_MIN  8
 #define MAP_ZOOM_MAX 15
@@ -229,6 +289,23 @@ TILES CONSTANTS
 #define CACHE_REFRESH_RATIO 0.5f  // Recharge à 50% du rayon
 #define CACHE_MAX_SIZE 350 
 
+// Telechargement de tuiles (PNG -> RGB565 sur la carte SD)
+#define TILE_DL_WORKERS (1)                  // Une seule connexion (regles d'usage des serveurs OSM)
+#define TILE_DL_TASK_STACK_SIZE (8192)       // HTTPS
+#define TILE_DL_TASK_PRIORITY (1)            // Sous toutes les taches de vol
+#define TILE_DL_TASK_CORE (0)
+#define TILE_DL_DITHER (true)                // Tramage ordonne a la conversion RGB565
+#define TILE_DL_HTTP_TIMEOUT_MS (10000)
+#define TILE_DL_RETRIES (2)
+#define TILE_DL_RETRY_DELAY_MS (2000)
+#define TILE_DL_YIELD_MS (20)                // Pause entre deux tuiles
+#define TILE_DL_MIN_INTERVAL_MS (500)        // Au plus 2 requetes/s par connexion (tuiles sautees non comptees)
+#define TILE_DL_MAX_TILES (2000)             // Refus des zones plus grandes (pas de telechargement de masse)
+#define TILE_DL_USER_AGENT "Vario_LVGL tile downloader (https://github.com/moreauftheobald/Vario_LVGL)"
+#define TILE_DL_CHECKPOINT_TILES (16)        // Sauvegarde de la reprise
+#define TILE_DL_AREA_KM (10.0f)              // Demi-cote de la zone depuis l'ecran carte
+#define TILE_DL_JOB_PATH OSM_TILES_DIR "/download.job"
+
 /*=========================================================================
 METAR CONSTANTS
 /*=========================================================================*/
@@ -239,9 +316,37 @@ METAR CONSTANTS
 // Configuration
 #define QNH_UPDATE_INTERVAL_MS (10 * 60 * 1000)  // 1 heure par défaut
 #define QNH_UPDATE_DISTANCE_KM (30)  
+#define QNH_METAR_HOST "aviationweather.gov"   // METAR des stations proches (prioritaire)
+#define QNH_METAR_SEARCH_KM (60.0f)             // Demi-cote de la zone de recherche
+#define QNH_OPENMETEO_HOST "api.open-meteo.com"  // Repli: modele a la position
+#define QNH_HTTPS_PORT (443)
+#define QNH_HTTP_TIMEOUT_MS (8000)      // Connexion et silence max pendant la reponse
+#define QNH_HTTP_POLL_MS (20)           // Attente entre deux lectures (STOP pris en compte)
+#define QNH_CACHE_MAX_AGE_MS QNH_UPDATE_INTERVAL_MS  // QNH d'une maille reutilise sans requete; la mise a jour periodique interroge toujours le reseau
 
-//Methode Update QNH
-#define QNH_ADJUST_METHOD 3
+#define QNH_BLEND_TIME_S (10.0f)        // Constante de temps de l'affichage apres un changement de QNH (0: saut)
+
+/*=========================================================================
+BOOT CONSTANTS
+/*=========================================================================*/
+#define BOOT_TASK_STACK_SIZE (4096)
+#define BOOT_TASK_PRIORITY (3)
+#define BOOT_I2C_PROBE_TIMEOUT_MS (5)
+#define BOOT_IO_READY_TIMEOUT_MS (200)   // Attente reponse IO extender
+#define BOOT_SPLASH_MIN_MS (1000)        // Duree minimale splash
+#define BOOT_SPLASH_MAX_MS (6000)        // Sortie splash meme si etapes non terminees
+#define BOOT_SPLASH_POLL_MS (100)
+
+/*=========================================================================
+PROFILER CONSTANTS
+/*=========================================================================*/
+#define PROFILER_TASK_COUNT (9)
+#define PROFILER_MAX_TASKS (32)          // Taille tableau uxTaskGetSystemState
+#define PROFILER_HISTORY_SIZE (60)       // Echantillons conserves
+#define PROFILER_SAMPLE_PERIOD_MS (1000)
+#define PROFILER_NOT_RUNNING (0xFFFF)
+#define PROFILER_TASK_STACK_SIZE (3072)
+#define PROFILER_TASK_PRIORITY (1)
 
 /*=========================================================================
 OTHER CONSTANTS
@@ -257,4 +362,37 @@ OTHER CONSTANTS
 #define MIN_FREQ   600
 #define MAX_FREQ  1400
 
+/*=========================================================================
+AUDIO CONSTANTS
+/*=========================================================================*/
+// Ampli I2S externe (type MAX98357A)
+#define AUDIO_I2S_BCLK GPIO_NUM_15
+#define AUDIO_I2S_WS GPIO_NUM_16
+#define AUDIO_I2S_DOUT GPIO_NUM_6
+
+//Task
+#define AUDIO_TASK_STACK_SIZE (3072)
+#define AUDIO_TASK_PRIORITY (6)          // Au-dessus des capteurs
+#define AUDIO_TASK_CORE (1)
+
+// Synthese: latence bloc + DMA = 4 + 16 ms
+#define AUDIO_SAMPLE_RATE (16000)
+#define AUDIO_BLOCK_SAMPLES (64)
+#define AUDIO_DMA_DESC_NUM (4)
+#define AUDIO_VOLUME_MAX (12000)         // Volume Q15 (= amplitude crete PCM)
+#define AUDIO_GLIDE_MS (10.0f)           // Constante de temps glissement frequence
+#define AUDIO_RAMP_MS (3.0f)             // Rampe anti-clic
+
+// Profil vario -> frequence (params.vario_audio_frequencies)
+#define AUDIO_PROFILE_POINTS (16)
+#define AUDIO_PROFILE_VARIO_MIN (-5.0f)
+#define AUDIO_PROFILE_VARIO_MAX (10.0f)
+
+// Cadence et seuils
+#define AUDIO_CLIMB_THRESHOLD (0.2f)     // m/s, bips au-dessus
+#define AUDIO_SINK_THRESHOLD (-2.0f)     // m/s, son continu en dessous
+#define AUDIO_BEEP_PERIOD_MAX_MS (600)   // Au seuil de montee
+#define AUDIO_BEEP_PERIOD_MIN_MS (150)   // A +10 m/s
+#define AUDIO_BEEP_DUTY_PERCENT (50)
+
 #endif
\ No newline at end of file
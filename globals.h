@@ -60,12 +60,11 @@ typedef struct {
   bno080_data_t bno080;
   gps_data_t gps;
   float qnh_metar;          // QNH du METAR en hPa (default: 1013.25)
-  bool qnh_transition;      // Flag: true pendant transition QNH (method 2)
 } sensor_raw_data_t;  
 
 // Structure donnees METAR
 typedef struct {
-  char station[5];      // Code ICAO
+  char station[12];     // Code ICAO ou source
   float qnh;            // hPa
   float temperature;    // Celsius
   float dewpoint;       // Celsius
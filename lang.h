@@ -54,6 +54,27 @@ struct TextStrings {
   const char* ice_firstname;
   const char* ice_phone;
   const char* ice_contact;
+  const char* diagnostics;
+  const char* diag_tasks;
+  const char* diag_memory;
+  const char* diag_fragmentation;
+  const char* diag_fmt_stack;
+  const char* diag_cpu_unavailable;
+  const char* diag_fmt_heap;
+  const char* diag_fmt_lcd;
+  const char* diag_fmt_frames;
+  const char* diag_fmt_lvgl;
+  const char* diag_fmt_touch;
+  const char* diag_touch_polling;
+  const char* diag_fmt_storage;
+  const char* diag_tiles_none;
+  const char* diag_fmt_tiles;
+  const char* map_download;
+  const char* map_download_stop;
+  const char* map_download_refused;
+  const char* diag_waiting_wifi;
+  const char* diag_running;
+  const char* diag_done;
 };
 
 // Strings FR en PROGMEM
@@ -100,6 +121,27 @@ static const char str_fr_ice_name[] PROGMEM = "Nom";
 static const char str_fr_ice_firstname[] PROGMEM = "Prenom";
 static const char str_fr_ice_phone[] PROGMEM = "Telephone";
 static const char str_fr_ice_contact[] PROGMEM = "Contact urgence";
+static const char str_fr_diagnostics[] PROGMEM = "Diagnostic";
+static const char str_fr_diag_tasks[] PROGMEM = "Taches (CPU / pile libre)";
+static const char str_fr_diag_memory[] PROGMEM = "Memoire";
+static const char str_fr_diag_fragmentation[] PROGMEM = "Fragmentation (%)";
+static const char str_fr_diag_fmt_stack[] PROGMEM = "%lu o";
+static const char str_fr_diag_cpu_unavailable[] PROGMEM = "n/d";
+static const char str_fr_diag_fmt_heap[] PROGMEM = "%s: %lu Ko libre, frag %d%%";
+static const char str_fr_diag_fmt_lcd[] PROGMEM = "LCD: %lu px/frame (%u zones), %lu px recopies, %lu plein ecran";
+static const char str_fr_diag_fmt_frames[] PROGMEM = "Frames: %d fps cible, rendu %lu/%lu us, attente %lu us, VSYNC perdues %lu";
+static const char str_fr_diag_fmt_lvgl[] PROGMEM = "LVGL: %s| PSRAM %lu Ko, debord. %lu, fuites %lu";
+static const char str_fr_diag_fmt_touch[] PROGMEM = "Tactile: %s, %lu INT, %lu lectures (%lu secours), %lu scrutations sans I2C, %lu gestes";
+static const char str_fr_diag_touch_polling[] PROGMEM = "scrutation";
+static const char str_fr_diag_fmt_storage[] PROGMEM = "SD: %lu Ko/s, file %lu, attente max ms log/ter/vis/pre/web %lu/%lu/%lu/%lu/%lu, preempt. %lu, tuiles absentes evitees %lu";
+static const char str_fr_diag_tiles_none[] PROGMEM = "Tuiles: aucun telechargement";
+static const char str_fr_diag_fmt_tiles[] PROGMEM = "Tuiles: %s %lu/%lu, %lu telechargees, %lu presentes, %lu echecs, %lu Ko, %lu ms/tuile";
+static const char str_fr_map_download[] PROGMEM = "Telecharger";
+static const char str_fr_map_download_stop[] PROGMEM = "Arreter";
+static const char str_fr_map_download_refused[] PROGMEM = "Refuse";
+static const char str_fr_diag_waiting_wifi[] PROGMEM = "attente WiFi";
+static const char str_fr_diag_running[] PROGMEM = "en cours";
+static const char str_fr_diag_done[] PROGMEM = "termine";
 
 // Strings EN en PROGMEM
 static const char str_en_file_transfer[] PROGMEM = "File Transfer";
@@ -145,6 +187,27 @@ static const char str_en_ice_name[] PROGMEM = "Name";
 static const char str_en_ice_firstname[] PROGMEM = "First Name";
 static const char str_en_ice_phone[] PROGMEM = "Phone";
 static const char str_en_ice_contact[] PROGMEM = "Emergency contact";
+static const char str_en_diagnostics[] PROGMEM = "Diagnostics";
+static const char str_en_diag_tasks[] PROGMEM = "Tasks (CPU / free stack)";
+static const char str_en_diag_memory[] PROGMEM = "Memory";
+static const char str_en_diag_fragmentation[] PROGMEM = "Fragmentation (%)";
+static const char str_en_diag_fmt_stack[] PROGMEM = "%lu B";
+static const char str_en_diag_cpu_unavailable[] PROGMEM = "n/a";
+static const char str_en_diag_fmt_heap[] PROGMEM = "%s: %lu KB free, frag %d%%";
+static const char str_en_diag_fmt_lcd[] PROGMEM = "LCD: %lu px/frame (%u areas), %lu px copied, %lu full screen";
+static const char str_en_diag_fmt_frames[] PROGMEM = "Frames: %d fps target, render %lu/%lu us, wait %lu us, missed VSYNC %lu";
+static const char str_en_diag_fmt_lvgl[] PROGMEM = "LVGL: %s| PSRAM %lu KB, overflow %lu, leaks %lu";
+static const char str_en_diag_fmt_touch[] PROGMEM = "Touch: %s, %lu INT, %lu reads (%lu fallback), %lu polls without I2C, %lu gestures";
+static const char str_en_diag_touch_polling[] PROGMEM = "polling";
+static const char str_en_diag_fmt_storage[] PROGMEM = "SD: %lu KB/s, queue %lu, max wait ms log/ter/vis/pre/web %lu/%lu/%lu/%lu/%lu, preempt. %lu, absent tiles skipped %lu";
+static const char str_en_diag_tiles_none[] PROGMEM = "Tiles: no download";
+static const char str_en_diag_fmt_tiles[] PROGMEM = "Tiles: %s %lu/%lu, %lu downloaded, %lu present, %lu failed, %lu KB, %lu ms/tile";
+static const char str_en_map_download[] PROGMEM = "Download";
+static const char str_en_map_download_stop[] PROGMEM = "Stop";
+static const char str_en_map_download_refused[] PROGMEM = "Refused";
+static const char str_en_diag_waiting_wifi[] PROGMEM = "waiting for WiFi";
+static const char str_en_diag_running[] PROGMEM = "running";
+static const char str_en_diag_done[] PROGMEM = "done";
 
 // Tables de pointeurs en PROGMEM
 static const TextStrings text_fr PROGMEM = {
@@ -190,7 +253,28 @@ static const TextStrings text_fr PROGMEM = {
   str_fr_ice_name,
   str_fr_ice_firstname,
   str_fr_ice_phone,
-  str_fr_ice_contact
+  str_fr_ice_contact,
+  str_fr_diagnostics,
+  str_fr_diag_tasks,
+  str_fr_diag_memory,
+  str_fr_diag_fragmentation,
+  str_fr_diag_fmt_stack,
+  str_fr_diag_cpu_unavailable,
+  str_fr_diag_fmt_heap,
+  str_fr_diag_fmt_lcd,
+  str_fr_diag_fmt_frames,
+  str_fr_diag_fmt_lvgl,
+  str_fr_diag_fmt_touch,
+  str_fr_diag_touch_polling,
+  str_fr_diag_fmt_storage,
+  str_fr_diag_tiles_none,
+  str_fr_diag_fmt_tiles,
+  str_fr_map_download,
+  str_fr_map_download_stop,
+  str_fr_map_download_refused,
+  str_fr_diag_waiting_wifi,
+  str_fr_diag_running,
+  str_fr_diag_done
 };
 
 static const TextStrings text_en PROGMEM = {
@@ -236,7 +320,28 @@ static const TextStrings text_en PROGMEM = {
   str_en_ice_name,
   str_en_ice_firstname,
   str_en_ice_phone,
-  str_en_ice_contact
+  str_en_ice_contact,
+  str_en_diagnostics,
+  str_en_diag_tasks,
+  str_en_diag_memory,
+  str_en_diag_fragmentation,
+  str_en_diag_fmt_stack,
+  str_en_diag_cpu_unavailable,
+  str_en_diag_fmt_heap,
+  str_en_diag_fmt_lcd,
+  str_en_diag_fmt_frames,
+  str_en_diag_fmt_lvgl,
+  str_en_diag_fmt_touch,
+  str_en_diag_touch_polling,
+  str_en_diag_fmt_storage,
+  str_en_diag_tiles_none,
+  str_en_diag_fmt_tiles,
+  str_en_map_download,
+  str_en_map_download_stop,
+  str_en_map_download_refused,
+  str_en_diag_waiting_wifi,
+  str_en_diag_running,
+  str_en_diag_done
 };
 
 // Fonction helper pour copier depuis PROGMEM vers SRAM
@@ -49,6 +49,10 @@
     #define LV_MEM_CUSTOM_REALLOC(ptr, size) heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM)
 #endif     /*LV_MEM_CUSTOM*/
 
+/*LVGL 9: allocateur a niveaux, petits blocs en pools SRAM interne, gros blocs en PSRAM
+ *(lv_malloc_core & co dans src/lvgl_port/lvgl_mem.cpp)*/
+#define LV_USE_STDLIB_MALLOC LV_STDLIB_CUSTOM
+
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
  *You will see an error log message if there wasn't enough buffers. */
 #define LV_MEM_BUF_MAX_NUM 16
@@ -343,13 +347,20 @@
  *   FONT USAGE
  *===================*/
 
+/*Seules les tailles referencees par graphical.h (UI_FONT_*) sont compilees.
+ *VARIO_FONTS_MINIMAL (defaut) retire aussi 12 et 16: UI_FONT_TINY / UI_FONT_CAPTION
+ *retombent sur 14 et 18. Mesure: tools/font_budget.py*/
+#ifndef VARIO_FONTS_MINIMAL
+#define VARIO_FONTS_MINIMAL 1
+#endif
+
 /*Montserrat fonts with ASCII range and some symbols using bpp = 4
  *https://fonts.google.com/specimen/Montserrat*/
 #define LV_FONT_MONTSERRAT_8  0
 #define LV_FONT_MONTSERRAT_10 0
-#define LV_FONT_MONTSERRAT_12 1
+#define LV_FONT_MONTSERRAT_12 (!VARIO_FONTS_MINIMAL)
 #define LV_FONT_MONTSERRAT_14 1
-#define LV_FONT_MONTSERRAT_16 1
+#define LV_FONT_MONTSERRAT_16 (!VARIO_FONTS_MINIMAL)
 #define LV_FONT_MONTSERRAT_18 1
 #define LV_FONT_MONTSERRAT_20 1
 #define LV_FONT_MONTSERRAT_22 0
@@ -279,7 +279,11 @@ bool GPS_I2C_ESP32_wait_for_sentence(gps_i2c_esp32_t *gps, const char *wait4me,
             return false;
         }
 
-        GPS_I2C_ESP32_read(gps);
+        // Vider le tampon I2C d'un coup, n'attendre que si rien n'est arrive
+        if (GPS_I2C_ESP32_read(gps) == 0) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
 
         if (GPS_I2C_ESP32_new_nmea_received(gps)) {
             char *nmea = GPS_I2C_ESP32_last_nmea(gps);
@@ -289,8 +293,6 @@ bool GPS_I2C_ESP32_wait_for_sentence(gps_i2c_esp32_t *gps, const char *wait4me,
                 return true;
             }
         }
-
-        vTaskDelay(pdMS_TO_TICKS(10));
     }
 
     return false;
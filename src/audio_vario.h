@@ -0,0 +1,121 @@
+#ifndef AUDIO_VARIO_H
+#define AUDIO_VARIO_H
+
+#include <stdint.h>
+#include <string.h>
+#include "constants.h"
+#include "dds_synth.h"
+
+// =============================================================================
+// Coeur audio vario: vario -> frequence (profil 16 points -5..+10 m/s),
+// cadence des bips, synthese DDS a phase continue. Aucune dependance materielle:
+// se compile sur PC pour generer un fichier WAV.
+// =============================================================================
+
+typedef struct {
+  uint32_t sample_rate;
+  dds_t dds;              // Oscillateur (glissement + enveloppe anti-clic)
+  uint32_t beep_pos;      // Position dans le cycle bip (echantillons)
+  uint32_t beep_period;   // Periode bip (echantillons)
+  uint32_t beep_on;       // Duree son dans la periode (echantillons)
+  bool continuous;        // Son continu (descente)
+  bool silent;            // Zone morte
+} audio_vario_state_t;
+
+// Frequence interpolee dans le profil (index 0 = -5 m/s, 15 = +10 m/s)
+static inline float audio_vario_profile_freq(float vario, const uint16_t *profile) {
+  float pos = vario - AUDIO_PROFILE_VARIO_MIN;
+  if (pos <= 0.0f) return profile[0];
+  if (pos >= AUDIO_PROFILE_POINTS - 1) return profile[AUDIO_PROFILE_POINTS - 1];
+
+  int i = (int)pos;
+  float frac = pos - i;
+  return profile[i] + (profile[i + 1] - profile[i]) * frac;
+}
+
+// Periode bip (ms) en montee: AUDIO_BEEP_PERIOD_MAX_MS au seuil -> MIN_MS a +10 m/s
+static inline uint32_t audio_vario_beep_period_ms(float vario) {
+  float span = AUDIO_PROFILE_VARIO_MAX - AUDIO_CLIMB_THRESHOLD;
+  float t = (vario - AUDIO_CLIMB_THRESHOLD) / span;
+  if (t < 0.0f) t = 0.0f;
+  if (t > 1.0f) t = 1.0f;
+  return (uint32_t)(AUDIO_BEEP_PERIOD_MAX_MS - t * (AUDIO_BEEP_PERIOD_MAX_MS - AUDIO_BEEP_PERIOD_MIN_MS));
+}
+
+static inline void audio_vario_init(audio_vario_state_t *s, uint32_t sample_rate) {
+  memset(s, 0, sizeof(audio_vario_state_t));
+  s->sample_rate = sample_rate;
+  dds_init(&s->dds, sample_rate, AUDIO_RAMP_MS, AUDIO_GLIDE_MS, AUDIO_VOLUME_MAX);
+  s->silent = true;
+}
+
+// Nouvelle valeur de vario: cible frequence + cadence (le cycle bip en cours continue)
+static inline void audio_vario_set_vario(audio_vario_state_t *s, float vario, const uint16_t *profile) {
+  dds_set_freq(&s->dds, audio_vario_profile_freq(vario, profile));
+
+  if (vario >= AUDIO_CLIMB_THRESHOLD) {
+    uint32_t period = audio_vario_beep_period_ms(vario) * s->sample_rate / 1000;
+    if (period == 0) period = 1;
+    s->beep_period = period;
+    s->beep_on = period * AUDIO_BEEP_DUTY_PERCENT / 100;
+    if (s->beep_pos >= period) s->beep_pos %= period;
+    s->continuous = false;
+    s->silent = false;
+  } else if (vario <= AUDIO_SINK_THRESHOLD) {
+    s->continuous = true;
+    s->silent = false;
+  } else {
+    s->continuous = false;
+    s->silent = true;
+  }
+}
+
+// Generation d'un bloc PCM 16 bits mono, decoupe aux fronts de bip
+static inline void audio_vario_render(audio_vario_state_t *s, int16_t *out, uint32_t n) {
+  uint32_t done = 0;
+
+  while (done < n) {
+    uint32_t chunk = n - done;
+    bool gate;
+
+    if (s->silent) {
+      gate = false;
+    } else if (s->continuous) {
+      gate = true;
+    } else {
+      gate = s->beep_pos < s->beep_on;
+      uint32_t to_edge = gate ? (s->beep_on - s->beep_pos) : (s->beep_period - s->beep_pos);
+      if (chunk > to_edge) chunk = to_edge;
+      s->beep_pos += chunk;
+      if (s->beep_pos >= s->beep_period) s->beep_pos = 0;
+    }
+
+    dds_gate(&s->dds, gate);
+    dds_render_block(&s->dds, out + done, chunk);
+    done += chunk;
+  }
+}
+
+// En-tete WAV PCM 16 bits mono (44 octets) pour rendu sur PC
+static inline void audio_wav_header(uint8_t *hdr, uint32_t sample_rate, uint32_t num_samples) {
+  uint32_t data_size = num_samples * 2;
+  uint32_t riff_size = 36 + data_size;
+  uint32_t byte_rate = sample_rate * 2;
+  uint32_t fmt_size = 16;
+  uint16_t format = 1, channels = 1, block_align = 2, bits = 16;
+
+  memcpy(hdr, "RIFF", 4);
+  memcpy(hdr + 4, &riff_size, 4);
+  memcpy(hdr + 8, "WAVEfmt ", 8);
+  memcpy(hdr + 16, &fmt_size, 4);
+  memcpy(hdr + 20, &format, 2);
+  memcpy(hdr + 22, &channels, 2);
+  memcpy(hdr + 24, &sample_rate, 4);
+  memcpy(hdr + 28, &byte_rate, 4);
+  memcpy(hdr + 32, &block_align, 2);
+  memcpy(hdr + 34, &bits, 2);
+  memcpy(hdr + 36, "data", 4);
+  memcpy(hdr + 40, &data_size, 4);
+}
+
+#endif
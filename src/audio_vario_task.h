@@ -0,0 +1,116 @@
+#ifndef AUDIO_VARIO_TASK_H
+#define AUDIO_VARIO_TASK_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/i2s_std.h"
+#include "constants.h"
+#include "audio_vario.h"
+#include "kalman_task.h"
+#include "params/params.h"
+
+// =============================================================================
+// Tache audio: lit le vario Kalman a chaque bloc et alimente l'ampli I2S.
+// Latence = periode Kalman (20 ms) + bloc + tampons DMA (< 50 ms).
+// =============================================================================
+
+static TaskHandle_t audio_task_handle = NULL;
+static i2s_chan_handle_t audio_tx_chan = NULL;
+static audio_vario_state_t audio_state;
+static int16_t audio_block[AUDIO_BLOCK_SAMPLES] __attribute__((aligned(4)));
+
+static bool audio_i2s_init() {
+  i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_NUM_0, I2S_ROLE_MASTER);
+  chan_cfg.dma_desc_num = AUDIO_DMA_DESC_NUM;
+  chan_cfg.dma_frame_num = AUDIO_BLOCK_SAMPLES;
+  chan_cfg.auto_clear = true;  // Silence si la tache prend du retard
+
+  if (i2s_new_channel(&chan_cfg, &audio_tx_chan, NULL) != ESP_OK) {
+#ifdef DEBUG_MODE
+    Serial.println("[AUDIO] I2S channel creation failed");
+#endif
+    return false;
+  }
+
+  i2s_std_config_t std_cfg = {
+    .clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(AUDIO_SAMPLE_RATE),
+    .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_16BIT, I2S_SLOT_MODE_MONO),
+    .gpio_cfg = {
+      .mclk = I2S_GPIO_UNUSED,
+      .bclk = AUDIO_I2S_BCLK,
+      .ws = AUDIO_I2S_WS,
+      .dout = AUDIO_I2S_DOUT,
+      .din = I2S_GPIO_UNUSED,
+      .invert_flags = {
+        .mclk_inv = false,
+        .bclk_inv = false,
+        .ws_inv = false,
+      },
+    },
+  };
+
+  if (i2s_channel_init_std_mode(audio_tx_chan, &std_cfg) != ESP_OK || i2s_channel_enable(audio_tx_chan) != ESP_OK) {
+#ifdef DEBUG_MODE
+    Serial.println("[AUDIO] I2S init failed");
+#endif
+    i2s_del_channel(audio_tx_chan);
+    audio_tx_chan = NULL;
+    return false;
+  }
+
+  return true;
+}
+
+static void audio_vario_task(void *pvParameters) {
+  kalman_data_t data;
+  size_t written;
+
+#ifdef DEBUG_MODE
+  Serial.println("[AUDIO] Task started");
+#endif
+
+  while (1) {
+    // Mise a jour cible a chaque bloc (silence tant que Kalman non valide)
+    if (kalman_get_data(&data)) {
+      audio_vario_set_vario(&audio_state, data.vario, params.vario_audio_frequencies);
+    } else {
+      audio_state.silent = true;
+    }
+
+    audio_vario_render(&audio_state, audio_block, AUDIO_BLOCK_SAMPLES);
+
+    // Bloquant tant que le DMA n'a pas de place: cadence la tache
+    i2s_channel_write(audio_tx_chan, audio_block, sizeof(audio_block), &written, portMAX_DELAY);
+  }
+}
+
+bool audio_vario_start(void) {
+  if (audio_task_handle != NULL) return true;
+
+  audio_vario_init(&audio_state, AUDIO_SAMPLE_RATE);
+
+  if (!audio_tx_chan && !audio_i2s_init()) {
+    return false;
+  }
+
+  BaseType_t ret = xTaskCreatePinnedToCore(
+    audio_vario_task,
+    "audio_vario",
+    AUDIO_TASK_STACK_SIZE,
+    NULL,
+    AUDIO_TASK_PRIORITY,
+    &audio_task_handle,
+    AUDIO_TASK_CORE);
+
+  if (ret != pdPASS) {
+#ifdef DEBUG_MODE
+    Serial.println("[AUDIO] Task creation failed");
+#endif
+    return false;
+  }
+
+  return true;
+}
+
+#endif
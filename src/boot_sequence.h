@@ -0,0 +1,108 @@
+#ifndef BOOT_SEQUENCE_H
+#define BOOT_SEQUENCE_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "esp_timer.h"
+#include "constants.h"
+#include "src/i2c/i2c.h"
+
+// =============================================================================
+// Sequence de demarrage: etapes avec dependances, signalees par event group
+// au lieu de delais fixes. Chaque etape est chronometree (us depuis boot).
+// =============================================================================
+
+// Etapes (l'index sert aussi de bit dans l'event group)
+enum {
+  BOOT_STAGE_IO = 0,   // Bus I2C + IO extender
+  BOOT_STAGE_PARAMS,   // NVS
+  BOOT_STAGE_DISPLAY,  // Touch + LCD + LVGL + splash
+  BOOT_STAGE_SD,       // Montage SD
+  BOOT_STAGE_TERRAIN,  // Cache HGT
+  BOOT_STAGE_SENSORS,  // BMP390 + BNO080 + GPS
+  BOOT_STAGE_KALMAN,   // Tache Kalman
+  BOOT_STAGE_UI,       // Ecran prestart affiche
+  BOOT_STAGE_COUNT
+};
+
+#define BOOT_BIT(stage) (1 << (stage))
+#define BOOT_FLIGHT_READY_BITS (BOOT_BIT(BOOT_STAGE_SD) | BOOT_BIT(BOOT_STAGE_TERRAIN) | BOOT_BIT(BOOT_STAGE_SENSORS) | BOOT_BIT(BOOT_STAGE_KALMAN))
+
+static const char *const boot_stage_names[BOOT_STAGE_COUNT] = {
+  "io", "params", "display", "sd", "terrain", "sensors", "kalman", "ui"
+};
+
+typedef struct {
+  uint32_t start_us;
+  uint32_t end_us;
+  bool ok;
+} boot_stage_t;
+
+static boot_stage_t boot_stages[BOOT_STAGE_COUNT] = { 0 };
+static EventGroupHandle_t boot_event_group = NULL;
+
+static inline void boot_begin(void) {
+  if (!boot_event_group) boot_event_group = xEventGroupCreate();
+}
+
+static inline void boot_stage_begin(int stage) {
+  boot_stages[stage].start_us = (uint32_t)esp_timer_get_time();
+}
+
+// Fin d'etape: le bit est positionne meme en cas d'echec pour debloquer les dependants
+static inline void boot_stage_end(int stage, bool ok) {
+  boot_stages[stage].end_us = (uint32_t)esp_timer_get_time();
+  boot_stages[stage].ok = ok;
+  if (boot_event_group) xEventGroupSetBits(boot_event_group, BOOT_BIT(stage));
+
+#ifdef DEBUG_MODE
+  Serial.printf("[BOOT] %s %s in %lu ms\n", boot_stage_names[stage], ok ? "OK" : "FAILED",
+                (unsigned long)((boot_stages[stage].end_us - boot_stages[stage].start_us) / 1000));
+#endif
+}
+
+static inline bool boot_stage_ok(int stage) {
+  return boot_stages[stage].ok;
+}
+
+// Attente de plusieurs etapes (toutes), false si timeout
+static inline bool boot_wait(EventBits_t bits, uint32_t timeout_ms) {
+  if (!boot_event_group) return false;
+  EventBits_t got = xEventGroupWaitBits(boot_event_group, bits, pdFALSE, pdTRUE, pdMS_TO_TICKS(timeout_ms));
+  return (got & bits) == bits;
+}
+
+static inline bool boot_is_flight_ready(void) {
+  if (!boot_event_group) return false;
+  return (xEventGroupGetBits(boot_event_group) & BOOT_FLIGHT_READY_BITS) == BOOT_FLIGHT_READY_BITS;
+}
+
+// Attente qu'un peripherique I2C reponde (remplace les delais de stabilisation)
+static inline bool boot_wait_i2c_device(uint8_t addr, uint32_t timeout_ms) {
+  DEV_I2C_Port port = DEV_I2C_Get_Handle();
+  uint32_t start = millis();
+  while (millis() - start < timeout_ms) {
+    if (i2c_master_probe(port.bus, addr, BOOT_I2C_PROBE_TIMEOUT_MS) == ESP_OK) return true;
+    vTaskDelay(pdMS_TO_TICKS(2));
+  }
+  return false;
+}
+
+// Emission des temps de demarrage sur une ligne (suivi des regressions)
+// Format: BOOT <etape>=<debut ms>+<duree ms>[!] ... ("!" = echec)
+static inline void boot_print_timings(void) {
+  Serial.print("BOOT");
+  for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+    const boot_stage_t *s = &boot_stages[i];
+    if (s->end_us == 0) continue;
+    Serial.printf(" %s=%lu+%lu%s", boot_stage_names[i],
+                  (unsigned long)(s->start_us / 1000),
+                  (unsigned long)((s->end_us - s->start_us) / 1000),
+                  s->ok ? "" : "!");
+  }
+  Serial.println();
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef DDS_SYNTH_H
+#define DDS_SYNTH_H
+
+#include <stdint.h>
+#include <string.h>
+#include "constants.h"
+
+// =============================================================================
+// Synthese DDS: accumulateur de phase 32 bits, table sinus 256 points avec
+// interpolation lineaire, enveloppes attaque/relache en table (cosinus sureleve).
+// Aucun appel a sin() a l'execution, uniquement entiers dans la boucle echantillon.
+// =============================================================================
+
+#define DDS_SINE_BITS 8
+#define DDS_SINE_SIZE (1 << DDS_SINE_BITS)
+#define DDS_ENV_SIZE 64
+
+// Sinus pleine echelle, DDS_SINE_SIZE + 1 points (garde pour l'interpolation)
+static const int16_t dds_sine_table[DDS_SINE_SIZE + 1] = {
+  0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739,
+  9512, 10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+  18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170, 23731, 24279, 24811,
+  25329, 25832, 26319, 26790, 27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+  30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971, 32137, 32285, 32412, 32521,
+  32609, 32678, 32728, 32757, 32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285,
+  32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571, 30273, 29956, 29621, 29268,
+  28898, 28510, 28105, 27683, 27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+  23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868, 18204, 17530, 16846, 16151,
+  15446, 14732, 14010, 13279, 12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179,
+  6393, 5602, 4808, 4011, 3212, 2410, 1608, 804, 0, -804, -1608, -2410,
+  -3212, -4011, -4808, -5602, -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+  -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530, -18204, -18868, -19519, -20159,
+  -20787, -21403, -22005, -22594, -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+  -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956, -30273, -30571, -30852, -31113,
+  -31356, -31580, -31785, -31971, -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+  -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285, -32137, -31971, -31785, -31580,
+  -31356, -31113, -30852, -30571, -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+  -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731, -23170, -22594, -22005, -21403,
+  -20787, -20159, -19519, -18868, -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+  -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179, -6393, -5602, -4808, -4011,
+  -3212, -2410, -1608, -804, 0
+};
+
+// Enveloppe 0 -> 32767 en cosinus sureleve, lue a l'endroit (attaque) ou a l'envers (relache)
+static const int16_t dds_env_table[DDS_ENV_SIZE + 1] = {
+  0, 20, 79, 177, 315, 491, 705, 958, 1247, 1573, 1935, 2331,
+  2761, 3224, 3719, 4244, 4799, 5381, 5990, 6624, 7281, 7961, 8660, 9379,
+  10114, 10864, 11628, 12403, 13187, 13980, 14778, 15580, 16383, 17187, 17989, 18787,
+  19580, 20364, 21139, 21903, 22653, 23388, 24107, 24806, 25486, 26143, 26777, 27386,
+  27968, 28523, 29048, 29543, 30006, 30436, 30832, 31194, 31520, 31809, 32062, 32276,
+  32452, 32590, 32688, 32747, 32767
+};
+
+typedef enum {
+  DDS_ENV_IDLE = 0,
+  DDS_ENV_ATTACK,
+  DDS_ENV_SUSTAIN,
+  DDS_ENV_RELEASE
+} dds_env_state_t;
+
+typedef struct {
+  uint32_t phase;         // Accumulateur de phase
+  uint32_t inc;           // Increment courant
+  uint32_t target_inc;    // Increment cible (glissement)
+  float inc_per_hz;       // 2^32 / frequence echantillonnage
+  uint8_t glide_shift;    // Lissage increment: constante de temps 2^shift echantillons
+  uint32_t env_pos;       // Position enveloppe (Q16, en points de table)
+  uint32_t env_step;      // Avance enveloppe par echantillon (Q16)
+  dds_env_state_t env_state;
+  int16_t volume;         // Q15
+} dds_t;
+
+// ramp_ms: duree attaque/relache, glide_ms: constante de temps du glissement
+static inline void dds_init(dds_t *d, uint32_t sample_rate, float ramp_ms, float glide_ms, int16_t volume) {
+  memset(d, 0, sizeof(dds_t));
+  d->inc_per_hz = 4294967296.0f / (float)sample_rate;
+
+  uint32_t ramp_samples = (uint32_t)(ramp_ms * sample_rate / 1000.0f);
+  if (ramp_samples == 0) ramp_samples = 1;
+  d->env_step = ((uint32_t)DDS_ENV_SIZE << 16) / ramp_samples;
+
+  uint32_t glide_samples = (uint32_t)(glide_ms * sample_rate / 1000.0f);
+  while (d->glide_shift < 15 && (2u << d->glide_shift) <= glide_samples) d->glide_shift++;
+
+  d->volume = volume;
+  d->inc = d->target_inc = (uint32_t)(MIN_FREQ * d->inc_per_hz);
+}
+
+// Frequence cible, bornee a [MIN_FREQ, MAX_FREQ]
+static inline void dds_set_freq(dds_t *d, float freq_hz) {
+  if (freq_hz < MIN_FREQ) freq_hz = MIN_FREQ;
+  if (freq_hz > MAX_FREQ) freq_hz = MAX_FREQ;
+  d->target_inc = (uint32_t)(freq_hz * d->inc_per_hz);
+}
+
+// Ouverture/fermeture de la porte: repart du niveau courant (pas de saut)
+static inline void dds_gate(dds_t *d, bool on) {
+  const uint32_t env_end = (uint32_t)DDS_ENV_SIZE << 16;
+  if (on) {
+    if (d->env_state == DDS_ENV_RELEASE) {
+      d->env_pos = env_end - d->env_pos;
+      d->env_state = DDS_ENV_ATTACK;
+    } else if (d->env_state == DDS_ENV_IDLE) {
+      d->env_pos = 0;
+      d->env_state = DDS_ENV_ATTACK;
+    }
+  } else {
+    if (d->env_state == DDS_ENV_ATTACK) {
+      d->env_pos = env_end - d->env_pos;
+      d->env_state = DDS_ENV_RELEASE;
+    } else if (d->env_state == DDS_ENV_SUSTAIN) {
+      d->env_pos = 0;
+      d->env_state = DDS_ENV_RELEASE;
+    }
+  }
+}
+
+static inline bool dds_is_idle(const dds_t *d) {
+  return d->env_state == DDS_ENV_IDLE;
+}
+
+// Niveau d'enveloppe (Q15) et avance d'un echantillon
+static inline int32_t dds_env_next(dds_t *d) {
+  const uint32_t env_end = (uint32_t)DDS_ENV_SIZE << 16;
+  int32_t e;
+
+  switch (d->env_state) {
+    case DDS_ENV_ATTACK:
+      e = dds_env_table[d->env_pos >> 16];
+      d->env_pos += d->env_step;
+      if (d->env_pos >= env_end) d->env_state = DDS_ENV_SUSTAIN;
+      return e;
+    case DDS_ENV_SUSTAIN:
+      return 32767;
+    case DDS_ENV_RELEASE:
+      e = dds_env_table[DDS_ENV_SIZE - (d->env_pos >> 16)];
+      d->env_pos += d->env_step;
+      if (d->env_pos >= env_end) d->env_state = DDS_ENV_IDLE;
+      return e;
+    default:
+      return 0;
+  }
+}
+
+// Bloc PCM 16 bits mono. Le tampon de sortie peut etre un buffer DMA
+// (aligne sur 4 octets, n pair); la phase avance meme en silence.
+static inline void dds_render_block(dds_t *d, int16_t *out, uint32_t n) {
+  for (uint32_t i = 0; i < n; i++) {
+    // Glissement de l'increment (entier signe)
+    int32_t diff = (int32_t)(d->target_inc - d->inc);
+    if (diff > -(1 << d->glide_shift) && diff < (1 << d->glide_shift)) d->inc = d->target_inc;
+    else d->inc += diff >> d->glide_shift;
+
+    // Interpolation lineaire entre deux points de table
+    uint32_t idx = d->phase >> (32 - DDS_SINE_BITS);
+    int32_t frac = (d->phase >> (32 - DDS_SINE_BITS - 16)) & 0xFFFF;
+    int32_t a = dds_sine_table[idx];
+    int32_t b = dds_sine_table[idx + 1];
+    int32_t s = a + (((b - a) * frac) >> 16);
+    d->phase += d->inc;
+
+    int32_t e = dds_env_next(d);
+    out[i] = (int16_t)((((s * e) >> 15) * d->volume) >> 15);
+  }
+}
+
+#endif
@@ -7,11 +7,37 @@
 #include <FS.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "sensor_metrics.h"
+#include "src/storage_service.h"
 
 static TaskHandle_t file_server_task_handle = NULL;
 static WebServer *web_server = NULL;
 static bool server_is_running = false;
 
+// Liste des vols construite par la tache stockage
+static bool file_server_list_flights(void *user) {
+  String *html = (String *)user;
+  File root = SD_MMC.open(FLIGHTS_DIR);
+  if (!root) return false;
+
+  File file = root.openNextFile();
+  while (file) {
+    if (!file.isDirectory()) {
+      *html += "<div class='file'><a href='/download?file=";
+      *html += file.name();
+      *html += "'>";
+      *html += file.name();
+      *html += "</a><span class='size'>";
+      *html += String(file.size() / 1024);
+      *html += " KB</span></div>";
+    }
+    file.close();
+    file = root.openNextFile();
+  }
+  root.close();
+  return true;
+}
+
 // Handler pour la page d'accueil
 static void handle_root() {
   static const char PAGE_HEADER[] PROGMEM = R"rawliteral(
@@ -43,48 +69,24 @@ a:hover{background:#3a3a6e}
   web_server->send(200, "text/html", "");
   web_server->sendContent_P(PAGE_HEADER);
 
-  // Attendre un peu que SD soit dispo
-  vTaskDelay(pdMS_TO_TICKS(100));
-
-  File root = SD_MMC.open(FLIGHTS_DIR);
-  if (!root) {
+  // Parcours du repertoire en priorite basse: le vol en cours passe avant
+  String html;
+  if (!storage_call(file_server_list_flights, &html, STORAGE_PRIO_WEB)) {
     web_server->sendContent("<p>No flights directory found</p>");
     #ifdef DEBUG_MODE
     Serial.println("[FILE_SERVER] Cannot open /flights");
     #endif
+  } else if (html.length() == 0) {
+    web_server->sendContent("<p>No flight files available</p>");
   } else {
-    File file = root.openNextFile();
-    bool has_files = false;
-
-    while (file) {
-      if (!file.isDirectory()) {
-        has_files = true;
-        web_server->sendContent("<div class='file'>");
-        web_server->sendContent("<a href='/download?file=");
-        web_server->sendContent(String(file.name()));
-        web_server->sendContent("'>");
-        web_server->sendContent(String(file.name()));
-        web_server->sendContent("</a>");
-        web_server->sendContent("<span class='size'>");
-        web_server->sendContent(String(file.size() / 1024));
-        web_server->sendContent(" KB");
-        web_server->sendContent("</span>");
-        web_server->sendContent("</div>");
-      }
-      file.close();
-      file = root.openNextFile();
-    }
-
-    if (!has_files) {
-      web_server->sendContent("<p>No flight files available</p>");
-    }
-
-    root.close();
+    web_server->sendContent(html);
   }
   web_server->sendContent_P(PAGE_FOOTER);
 }
 
-// Handler pour le telechargement de fichiers
+// Handler pour le telechargement de fichiers: lecture bloc par bloc via le
+// service de stockage, envoi depuis cette tache. Un client lent ne bloque que
+// le serveur web, la carte est rendue entre deux blocs (journal, tuiles).
 static void handle_download() {
   if (!web_server->hasArg("file")) {
     web_server->send(400, "text/plain", "Missing file parameter");
@@ -97,23 +99,42 @@ static void handle_download() {
   char filepath[96];
   snprintf(filepath, sizeof(filepath), "%s/%s", FLIGHTS_DIR, filename.c_str());
 
-  if (!SD_MMC.exists(filepath)) {
+  size_t size = 0;
+  if (!storage_file_size(filepath, &size, STORAGE_PRIO_WEB)) {
     web_server->send(404, "text/plain", "File not found");
     return;
   }
 
-  File file = SD_MMC.open(filepath, FILE_READ);
-  if (!file) {
+  uint8_t *chunk = (uint8_t *)storage_buf_alloc(FILE_SERVER_CHUNK_SIZE);
+  if (!chunk) {
     web_server->send(500, "text/plain", "Failed to open file");
     return;
   }
 
+  web_server->setContentLength(size);
+  web_server->send(200, "application/octet-stream", "");
+  size_t sent = 0;
+  while (sent < size && web_server->client().connected()) {
+    size_t n = min((size_t)FILE_SERVER_CHUNK_SIZE, size - sent);
+    size_t got = 0;
+    storage_read(filepath, sent, chunk, n, STORAGE_PRIO_WEB, &got);
+    if (got == 0) break;
+    web_server->sendContent((const char *)chunk, got);
+    sent += got;
+  }
+  storage_buf_free(chunk);
+
 #ifdef DEBUG_MODE
-  Serial.printf("Sending file: %s (%d bytes)\n", filename.c_str(), file.size());
+  Serial.printf("Sent file: %s (%u/%u bytes%s)\n", filename.c_str(), (unsigned)sent, (unsigned)size,
+                sent == size ? "" : ", interrompu");
 #endif
+}
 
-  web_server->streamFile(file, "application/octet-stream");
-  file.close();
+// Handler metriques capteurs (dump binaire, meme format que le port serie)
+static void handle_metrics() {
+  static uint8_t buf[sizeof(sensor_metrics_t)];
+  size_t n = sensor_metrics_serialize(&g_sensor_metrics, millis(), buf, sizeof(buf));
+  web_server->send_P(200, "application/octet-stream", (const char *)buf, n);
 }
 
 // Handler 404
@@ -128,6 +149,7 @@ static void file_server_task(void *pvParameters) {
 
   web_server->on("/", handle_root);
   web_server->on("/download", handle_download);
+  web_server->on("/metrics", handle_metrics);
   web_server->onNotFound(handle_not_found);
 
   web_server->begin();
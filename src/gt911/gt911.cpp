@@ -319,18 +319,28 @@ esp_lcd_touch_handle_t touch_gt911_init() {
   // Recuperer le bus I2C existant (deja initialise dans setup)
   DEV_I2C_Port port = DEV_I2C_Get_Handle();
   
-  delay(10);
-
+  // Sequence reset GT911 (datasheet: RST bas >100us, INT maintenu >5ms apres RST,
+  // puis I2C disponible apres ~50ms). INT bas -> adresse 0x5D.
   pinMode(PIN_NUM_TOUCH_INT, OUTPUT);
   IO_EXTENSION_Output(IO_EXTENSION_IO_1, 0);
-
-  delay(100);
   digitalWrite(PIN_NUM_TOUCH_INT, 0);
 
-  delay(100);
+  delay(10);
   IO_EXTENSION_Output(IO_EXTENSION_IO_1, 1);
 
-  delay(200);
+  delay(10);
+
+  // Attendre que le controleur reponde au lieu d'un delai fixe
+  uint32_t probe_start = millis();
+  while (i2c_master_probe(port.bus, ESP_LCD_TOUCH_IO_I2C_GT911_ADDRESS, 5) != ESP_OK) {
+    if (millis() - probe_start > 200) {
+#ifdef DEBUG_MODE
+      ESP_LOGW(TAG, "GT911 not answering after reset");
+#endif
+      break;
+    }
+    delay(5);
+  }
 
 #ifdef DEBUG_MODE
   ESP_LOGI(TAG, "Initialize I2C panel IO");
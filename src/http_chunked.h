@@ -0,0 +1,70 @@
+#ifndef HTTP_CHUNKED_H
+#define HTTP_CHUNKED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+// =============================================================================
+// Decodage du transfert HTTP "Transfer-Encoding: chunked" au fil de l'eau,
+// partage par le telechargeur de tuiles et la recuperation du QNH.
+// Calcul pur sans Arduino ni ESP-IDF: se compile sur PC.
+// =============================================================================
+
+typedef struct {
+  uint8_t state;      // 0: taille, 1: fin de ligne taille, 2: donnees, 3: CRLF apres donnees,
+                      // 4: fin, 5: en-tetes de fin (jusqu'a la ligne vide)
+  uint32_t left;      // Octets restants dans le bloc courant (5: longueur de la ligne)
+  bool error;
+} http_chunked_t;
+
+// Retire l'encodage en place; retourne le nombre d'octets utiles dans buf
+static size_t http_chunked_decode(http_chunked_t *d, uint8_t *buf, size_t len) {
+  size_t o = 0;
+  for (size_t i = 0; i < len && !d->error && d->state != 4; i++) {
+    uint8_t c = buf[i];
+    switch (d->state) {
+      case 0:
+        if (c >= '0' && c <= '9') d->left = d->left * 16 + (c - '0');
+        else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') d->left = d->left * 16 + ((c | 0x20) - 'a' + 10);
+        else if (c == ';' || c == '\r') d->state = 1;
+        else if (c == '\n') d->state = d->left ? 2 : 5;
+        else d->error = true;
+        if (d->left > 0x1000000) d->error = true;
+        break;
+      case 1:
+        if (c == '\n') d->state = d->left ? 2 : 5;
+        break;
+      case 2: {
+        size_t n = len - i < d->left ? len - i : d->left;
+        memmove(buf + o, buf + i, n);
+        o += n;
+        i += n - 1;
+        d->left -= n;
+        if (d->left == 0) d->state = 3;
+        break;
+      }
+      case 3:
+        if (c == '\n') d->state = 0;
+        else if (c != '\r') d->error = true;
+        break;
+      case 5:
+        // Consommee en entier pour laisser la connexion prete a la reponse suivante
+        if (c == '\n') {
+          if (d->left == 0) d->state = 4;
+          d->left = 0;
+        } else if (c != '\r') {
+          d->left++;
+        }
+        break;
+    }
+  }
+  return o;
+}
+
+static inline bool http_chunked_done(const http_chunked_t *d) {
+  return d->state == 4;
+}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+// =============================================================================
+// Lecture JSON au fil de l'eau sans document: chaque valeur simple (chaine,
+// nombre, true/false/null) et chaque fin d'objet est signalee au rappel avec
+// sa profondeur et la cle courante des premiers niveaux. Le texte entier
+// n'est jamais en memoire: seule la valeur en cours (tronquee au-dela de
+// JSON_STREAM_VALUE_MAX) est conservee.
+// Calcul pur sans Arduino ni ESP-IDF: se compile sur PC.
+// =============================================================================
+
+#define JSON_STREAM_KEY_MAX 24
+#define JSON_STREAM_VALUE_MAX 256
+#define JSON_STREAM_DEPTH_MAX 31
+#define JSON_STREAM_PATH 4          // Niveaux dont la cle est memorisee
+
+typedef enum {
+  JSON_STREAM_STRING = 0,
+  JSON_STREAM_NUMBER,
+  JSON_STREAM_LITERAL,            // true, false, null
+  JSON_STREAM_END_OBJECT          // value: "", depth: profondeur de l'objet ferme
+} json_stream_event_t;
+
+typedef struct json_stream_s json_stream_t;
+typedef void (*json_stream_cb_t)(json_stream_t *s, json_stream_event_t ev, const char *value);
+
+struct json_stream_s {
+  uint8_t depth;                  // 1: dans l'objet ou le tableau racine
+  uint32_t arrays;                // Bit d: le conteneur de profondeur d est un tableau
+  bool in_string;
+  bool escape;
+  bool is_key;
+  bool expect_key;
+  bool in_scalar;                 // Nombre ou litteral en cours
+  char keys[JSON_STREAM_PATH + 1][JSON_STREAM_KEY_MAX];  // keys[d]: cle courante au niveau d
+  char key[JSON_STREAM_KEY_MAX];  // Cle en cours de lecture
+  uint8_t key_len;
+  char value[JSON_STREAM_VALUE_MAX];
+  uint16_t value_len;
+  bool error;
+  json_stream_cb_t cb;
+  void *user;
+};
+
+static void json_stream_init(json_stream_t *s, json_stream_cb_t cb, void *user) {
+  memset(s, 0, sizeof(*s));
+  s->cb = cb;
+  s->user = user;
+}
+
+static inline bool json_stream_in_array(const json_stream_t *s) {
+  return (s->arrays >> s->depth) & 1;
+}
+
+// Cle courante du niveau d ("" dans un tableau ou au-dela de JSON_STREAM_PATH)
+static inline const char *json_stream_key(const json_stream_t *s, uint8_t d) {
+  if (d == 0 || d > JSON_STREAM_PATH || ((s->arrays >> d) & 1)) return "";
+  return s->keys[d];
+}
+
+static inline bool json_stream_at(const json_stream_t *s, uint8_t depth, const char *key) {
+  return s->depth == depth && strcmp(json_stream_key(s, depth), key) == 0;
+}
+
+static inline void json_stream_append(json_stream_t *s, char c) {
+  if (s->value_len < JSON_STREAM_VALUE_MAX - 1) s->value[s->value_len++] = c;
+}
+
+static void json_stream_emit(json_stream_t *s, json_stream_event_t ev) {
+  s->value[s->value_len] = '\0';
+  if (s->cb) s->cb(s, ev, s->value);
+  s->value_len = 0;
+}
+
+static inline bool json_stream_scalar_char(char c) {
+  return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E';
+}
+
+static void json_stream_feed(json_stream_t *s, const uint8_t *buf, size_t len) {
+  for (size_t i = 0; i < len && !s->error; i++) {
+    char c = (char)buf[i];
+    if (s->in_string) {
+      if (s->escape) {
+        s->escape = false;
+        if (c == 'n') c = '\n';
+        else if (c == 't') c = '\t';
+      } else if (c == '\\') {
+        s->escape = true;
+        continue;
+      } else if (c == '"') {
+        s->in_string = false;
+        if (s->is_key) {
+          s->key[s->key_len] = '\0';
+          if (s->depth <= JSON_STREAM_PATH) memcpy(s->keys[s->depth], s->key, s->key_len + 1);
+        } else {
+          json_stream_emit(s, JSON_STREAM_STRING);
+        }
+        continue;
+      }
+      if (!s->is_key) json_stream_append(s, c);
+      else if (s->key_len < JSON_STREAM_KEY_MAX - 1) s->key[s->key_len++] = c;
+      continue;
+    }
+    if (s->in_scalar) {
+      if (json_stream_scalar_char(c)) {
+        json_stream_append(s, c);
+        continue;
+      }
+      s->in_scalar = false;
+      bool literal = s->value[0] >= 'a' && s->value[0] <= 'z';
+      json_stream_emit(s, literal ? JSON_STREAM_LITERAL : JSON_STREAM_NUMBER);
+    }
+    switch (c) {
+      case '"':
+        s->in_string = true;
+        s->is_key = s->expect_key;
+        s->key_len = 0;
+        s->value_len = 0;
+        break;
+      case ':':
+        s->expect_key = false;
+        break;
+      case ',':
+        s->expect_key = !json_stream_in_array(s);
+        break;
+      case '{':
+      case '[':
+        if (s->depth >= JSON_STREAM_DEPTH_MAX) {
+          s->error = true;
+          break;
+        }
+        s->depth++;
+        if (c == '[') s->arrays |= 1u << s->depth;
+        else s->arrays &= ~(1u << s->depth);
+        if (s->depth <= JSON_STREAM_PATH) s->keys[s->depth][0] = '\0';
+        s->expect_key = c == '{';
+        break;
+      case '}':
+      case ']':
+        if (s->depth == 0 || json_stream_in_array(s) != (c == ']')) {
+          s->error = true;
+          break;
+        }
+        if (c == '}') json_stream_emit(s, JSON_STREAM_END_OBJECT);
+        s->depth--;
+        s->expect_key = false;
+        break;
+      case ' ':
+      case '\t':
+      case '\r':
+      case '\n':
+        break;
+      default:
+        if (!json_stream_scalar_char(c)) {
+          s->error = true;
+          break;
+        }
+        s->in_scalar = true;
+        s->value_len = 0;
+        json_stream_append(s, c);
+        break;
+    }
+  }
+}
+
+#endif
@@ -5,6 +5,7 @@
 #include "constants.h"
 #include "globals.h"
 #include "terrain_elevation.h" 
+#include "sensor_metrics.h"
 
 // Structure des donnees filtrees
 typedef struct {
@@ -41,40 +42,30 @@ static const uint32_t SENSOR_STABILIZATION_TIME = 3000;
 static float init_buffer[INIT_SAMPLES];
 static int init_count = 0;
 
-// Fonction pour appeler depuis metar_task quand QNH est recupere
+// QNH demande par metar_task, applique par la tache Kalman
+static portMUX_TYPE qnh_request_lock = portMUX_INITIALIZER_UNLOCKED;
+static float qnh_request = 1013.25f;
+static bool qnh_request_pending = false;
+static float qnh_display_offset = 0.0f;  // Ecart affiche restant apres un changement de QNH (m)
+
+// Fonction pour appeler depuis metar_task quand QNH est recupere (non bloquante)
 void kalman_set_qnh_ready(float qnh_hpa) {
-  qnh_setting = qnh_hpa;
-  qnh_ready = true;
-  last_qnh = qnh_hpa;
-  
+  portENTER_CRITICAL(&qnh_request_lock);
+  qnh_request = qnh_hpa;
+  qnh_request_pending = true;
+  portEXIT_CRITICAL(&qnh_request_lock);
+
 #ifdef DEBUG_MODE
-  Serial.printf("[KALMAN] QNH ready: %.2f hPa\n", qnh_hpa);
+  Serial.printf("[KALMAN] QNH requested: %.2f hPa\n", qnh_hpa);
 #endif
 }
 
 // Fonction pour forcer le demarrage avec QNH standard si timeout
 void kalman_force_start_standard_qnh() {
-  qnh_setting = 1013.25f;
-  qnh_ready = true;
-  last_qnh = 1013.25f;
-  
-#ifdef DEBUG_MODE
-  Serial.println("[KALMAN] Forced start with standard QNH (1013.25 hPa)");
-#endif
-}
+  kalman_set_qnh_ready(1013.25f);
 
-// METHOD 3: Appliquer un offset d'altitude direct
-void kalman_apply_altitude_offset(float offset_m) {
-#ifdef DEBUG_MODE
-  Serial.printf("[KALMAN] Applying altitude offset: %.1f m (before: %.1f m)\n", 
-                offset_m, kf.x[0]);
-#endif
-  
-  // Appliquer l'offset sur l'altitude uniquement
-  kf.x[0] += offset_m;
-  
 #ifdef DEBUG_MODE
-  Serial.printf("[KALMAN] Altitude after offset: %.1f m\n", kf.x[0]);
+  Serial.println("[KALMAN] Forced start with standard QNH (1013.25 hPa)");
 #endif
 }
 
@@ -84,21 +75,43 @@ static float pressure_to_altitude(float pressure_pa, float qnh_hpa) {
   return 44330.0f * (1.0f - pow(pressure_hpa / qnh_hpa, 0.1903f));
 }
 
-// Reinitialisation Kalman lors changement QNH (pas utilisee avec les nouvelles methodes)
-void kalman_reset_on_qnh_change(float new_altitude, float current_qnh) {
-    if (fabs(current_qnh - last_qnh) > 0.5) {
+// Conversion inverse altitude -> pression (Pa)
+static float altitude_to_pressure(float altitude_m, float qnh_hpa) {
+  return qnh_hpa * 100.0f * pow(1.0f - altitude_m / 44330.0f, 1.0f / 0.1903f);
+}
+
+// Changement de QNH: nouvelle reference d'altitude en un pas. L'ecart est
+// calcule a la pression courante avec la formule de la mesure baro, l'etat
+// est decale d'autant: l'innovation suivante reste nulle, le vario et la
+// covariance ne bougent pas. L'affichage rejoint la nouvelle altitude avec
+// la constante de temps QNH_BLEND_TIME_S.
+static void kalman_apply_qnh_request(void) {
+  if (!qnh_request_pending) return;
+  portENTER_CRITICAL(&qnh_request_lock);
+  float qnh = qnh_request;
+  qnh_request_pending = false;
+  portEXIT_CRITICAL(&qnh_request_lock);
+
+  if (kf.initialized && g_sensor_data.bmp390.valid) {
+    float p = g_sensor_data.bmp390.pressure;
+    float shift = pressure_to_altitude(p, qnh) - pressure_to_altitude(p, qnh_setting);
+    // Decollage: meme pression de reference, nouvelle altitude
+    float p_takeoff = altitude_to_pressure(qfe_offset, qnh_setting);
+    qfe_offset = pressure_to_altitude(p_takeoff, qnh);
+    kf.x[0] += shift;
+    if (QNH_BLEND_TIME_S > 0.0f) qnh_display_offset += shift;
+
 #ifdef DEBUG_MODE
-        Serial.printf("[KALMAN] QNH changed: %.2f -> %.2f hPa, reinitializing state\n", 
-                      last_qnh, current_qnh);
+    Serial.printf("[KALMAN] QNH %.2f -> %.2f hPa: altitude shift %.2f m at %.1f hPa\n", qnh_setting, qnh, shift,
+                  p / 100.0f);
 #endif
-        kf.x[0] = new_altitude;
-        kf.x[1] = 0.0;
-        
-        kf.P[0][0] = 100.0;
-        kf.P[1][1] = 10.0;
-        
-        last_qnh = current_qnh;
-    }
+  } else if (!kf.initialized) {
+    // Moyenne de demarrage avec l'ancien QNH: recommencer
+    init_count = 0;
+  }
+  qnh_setting = qnh;
+  last_qnh = qnh;
+  qnh_ready = true;
 }
 
 // Init filtre
@@ -270,7 +283,11 @@ static void kalman_task(void* parameter) {
   uint32_t last_baro_time = 0;
   uint32_t last_gps_time = 0;
 
+  const float blend_decay = QNH_BLEND_TIME_S > 0.0f ? expf(-0.02f / QNH_BLEND_TIME_S) : 0.0f;
+
   while (1) {
+    if (!kf.initialized) kalman_apply_qnh_request();
+
     if (!qnh_ready) {
       vTaskDelay(pdMS_TO_TICKS(100));
       continue;
@@ -307,6 +324,8 @@ static void kalman_task(void* parameter) {
     }
 
     uint32_t now = millis();
+    uint32_t loop_start_us = sensor_metrics_now_us();
+    kalman_apply_qnh_request();
     kalman_predict(0.02f);
 
     // Update Baro
@@ -314,6 +333,7 @@ static void kalman_task(void* parameter) {
       if (now - last_baro_time >= 200) {
         float alt_baro = pressure_to_altitude(g_sensor_data.bmp390.pressure, qnh_setting);
         kalman_update(alt_baro, 0.25f, 0);
+        sensor_metrics_record_age(&g_sensor_metrics, METRICS_SENSOR_BMP390, now - g_sensor_data.bmp390.timestamp);
         last_baro_time = now;
       }
     }
@@ -322,41 +342,30 @@ static void kalman_task(void* parameter) {
     if (g_sensor_data.gps.valid && g_sensor_data.gps.fix && g_sensor_data.gps.fixquality >= 1) {
       if (now - last_gps_time >= 500) {
         kalman_update(g_sensor_data.gps.altitude, 5.0f, 0);
+        sensor_metrics_record_age(&g_sensor_metrics, METRICS_SENSOR_GPS, now - g_sensor_data.gps.timestamp);
         last_gps_time = now;
       }
     }
 
-    // Update IMU avec ajustement confiance si METHOD 2
+    // Update IMU
     if (g_sensor_data.bno080.valid) {
       float az_world = get_accel_z_world(&g_sensor_data.bno080);
       if (fabs(az_world) < 0.05f) az_world = 0.0f;
-      
-      // METHOD 2: Si en transition QNH, augmenter la confiance IMU
-      float imu_variance = 1.0f;  // Variance par defaut
-      
-#if QNH_ADJUST_METHOD == 2
-      if (g_sensor_data.qnh_transition) {
-        imu_variance = 0.1f;  // 10x plus de confiance pendant transition
-#ifdef DEBUG_MODE
-        static uint32_t last_debug_transition = 0;
-        if (now - last_debug_transition >= 1000) {
-          Serial.println("[KALMAN] QNH transition: IMU confidence boosted");
-          last_debug_transition = now;
-        }
-#endif
-      }
-#endif
-      
-      kalman_update(az_world, imu_variance, 2);
+      kalman_update(az_world, 1.0f, 2);
+      sensor_metrics_record_age(&g_sensor_metrics, METRICS_SENSOR_BNO080, now - g_sensor_data.bno080.timestamp);
     }
 
+    // Ecart d'affichage apres changement de QNH
+    qnh_display_offset *= blend_decay;
+    if (fabsf(qnh_display_offset) < 0.01f) qnh_display_offset = 0.0f;
+
     // Maj donnees filtrees
     if (g_sensor_data.bmp390.valid) {
       if (xSemaphoreTake(kalman_mutex, pdMS_TO_TICKS(5))) {
         kalman_data.altitude = kf.x[0];
         kalman_data.vario = kf.x[1];
         kalman_data.altitude_qne = pressure_to_altitude(g_sensor_data.bmp390.pressure, 1013.25f);
-        kalman_data.altitude_qnh = kf.x[0];
+        kalman_data.altitude_qnh = kf.x[0] - qnh_display_offset;
         kalman_data.altitude_qfe = kf.x[0] - qfe_offset;
         kalman_data.timestamp = now;
         kalman_data.valid = true;
@@ -400,6 +409,8 @@ static void kalman_task(void* parameter) {
       last_debug = now;
     }
 #endif
+    sensor_metrics_record_loop(&g_sensor_metrics, METRICS_TASK_KALMAN,
+                               sensor_metrics_now_us() - loop_start_us, 20000);
     vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(20));
   }
 }
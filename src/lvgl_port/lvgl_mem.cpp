@@ -0,0 +1,305 @@
+#include "lvgl_mem.h"
+#include "lvgl_mem_pool.h"
+#include <stdio.h>
+#include <string.h>
+#include "lvgl.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "constants.h"
+
+static const char *TAG = "lvgl_mem";
+
+// Classes de taille croissantes: la premiere qui contient la demande la sert
+static const uint16_t pool_block_sizes[LVGL_MEM_POOL_CLASSES] = LVGL_MEM_POOL_SIZES;
+static const uint16_t pool_block_counts[LVGL_MEM_POOL_CLASSES] = {
+  LVGL_MEM_POOL_16_COUNT, LVGL_MEM_POOL_32_COUNT, LVGL_MEM_POOL_64_COUNT,
+  LVGL_MEM_POOL_128_COUNT, LVGL_MEM_POOL_256_COUNT
+};
+
+static lvgl_mem_pool_t pools[LVGL_MEM_POOL_CLASSES];
+static void *pool_area = NULL;
+// Protege les pools et tous les compteurs ci-dessous (pas d'appel heap_caps_* dedans)
+static portMUX_TYPE pool_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t psram_allocs = 0;
+static uint32_t psram_blocks = 0;
+static uint32_t psram_bytes = 0;
+static uint32_t psram_peak_bytes = 0;
+static uint32_t pool_bytes = 0;
+static uint32_t failures = 0;
+static bool trace_enabled = false;
+
+// Bilan par ecran
+static uint32_t screen_mark_blocks = 0, screen_mark_bytes = 0;
+static uint32_t screen_created_blocks = 0, screen_created_bytes = 0;
+static uint32_t screen_size_blocks = 0, screen_size_bytes = 0;  // Ecran actif, a sa creation
+static uint32_t pending_size_blocks = 0, pending_size_bytes = 0;
+static int32_t last_leak_blocks = 0, last_leak_bytes = 0;
+static uint32_t leak_reports = 0;
+
+// ============================================================================
+// Niveaux
+// ============================================================================
+
+static int pool_class_for(size_t size) {
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    if (size <= pools[i].block_size) return i;
+  }
+  return -1;
+}
+
+static int pool_owner(const void *ptr) {
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    if (lvgl_mem_pool_owns(&pools[i], ptr)) return i;
+  }
+  return -1;
+}
+
+static void *tier_alloc(size_t size) {
+  int cls = pool_class_for(size);
+  if (cls >= 0) {
+    portENTER_CRITICAL(&pool_mux);
+    void *p = lvgl_mem_pool_alloc(&pools[cls]);
+    if (p) pool_bytes += pools[cls].block_size;
+    portEXIT_CRITICAL(&pool_mux);
+    if (p) return p;
+  }
+
+  void *p = heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+  size_t got = p ? heap_caps_get_allocated_size(p) : 0;
+  portENTER_CRITICAL(&pool_mux);
+  if (p) {
+    psram_allocs++;
+    psram_blocks++;
+    psram_bytes += got;
+    if (psram_bytes > psram_peak_bytes) psram_peak_bytes = psram_bytes;
+  } else {
+    failures++;
+  }
+  portEXIT_CRITICAL(&pool_mux);
+  return p;
+}
+
+static void tier_free(void *p) {
+  int cls = pool_owner(p);
+  if (cls >= 0) {
+    portENTER_CRITICAL(&pool_mux);
+    lvgl_mem_pool_free(&pools[cls], p);
+    pool_bytes -= pools[cls].block_size;
+    portEXIT_CRITICAL(&pool_mux);
+    return;
+  }
+
+  size_t size = heap_caps_get_allocated_size(p);
+  portENTER_CRITICAL(&pool_mux);
+  psram_blocks--;
+  psram_bytes -= size;
+  portEXIT_CRITICAL(&pool_mux);
+  heap_caps_free(p);
+}
+
+// Appelant sous pool_mux
+static uint32_t live_blocks(void) {
+  uint32_t n = psram_blocks;
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) n += pools[i].used;
+  return n;
+}
+
+// ============================================================================
+// Interface LVGL (lv_mem.h, LV_STDLIB_CUSTOM)
+// ============================================================================
+
+void lv_mem_init(void) {
+  size_t total = 0;
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    total += (size_t)pool_block_sizes[i] * pool_block_counts[i];
+  }
+
+  pool_area = heap_caps_malloc(total, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+  if (!pool_area) {
+    ESP_LOGW(TAG, "Pools SRAM indisponibles (%u octets), tout en PSRAM", (unsigned)total);
+  }
+
+  uint8_t *base = (uint8_t *)pool_area;
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    lvgl_mem_pool_init(&pools[i], base, pool_block_sizes[i], pool_block_counts[i]);
+    if (base) base += (size_t)pool_block_sizes[i] * pool_block_counts[i];
+  }
+  ESP_LOGI(TAG, "Pools SRAM: %u octets, %d classes", pool_area ? (unsigned)total : 0, LVGL_MEM_POOL_CLASSES);
+}
+
+void lv_mem_deinit(void) {
+  // Les blocs vivants ne sont plus valides: on ne rend que la zone des pools
+  if (pool_area) heap_caps_free(pool_area);
+  pool_area = NULL;
+  memset(pools, 0, sizeof(pools));
+}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes) {
+  LV_UNUSED(mem);
+  LV_UNUSED(bytes);
+  return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+  LV_UNUSED(pool);
+}
+
+void *lv_malloc_core(size_t size) {
+  void *p = tier_alloc(size);
+  if (trace_enabled) printf("LVMEM a %u %p\n", (unsigned)size, p);
+  return p;
+}
+
+void *lv_realloc_core(void *p, size_t new_size) {
+  if (!p) return lv_malloc_core(new_size);
+
+  int cls = pool_owner(p);
+  size_t old_size = (cls >= 0) ? pools[cls].block_size : heap_caps_get_allocated_size(p);
+  void *np;
+
+  if (cls >= 0 && new_size <= old_size && (cls == 0 || new_size > pools[cls - 1].block_size)) {
+    np = p;  // Meme classe: rien a deplacer
+  } else if (cls < 0 && pool_class_for(new_size) < 0) {
+    // Gros bloc qui reste gros: realloc PSRAM en place si possible
+    np = heap_caps_realloc(p, new_size, MALLOC_CAP_SPIRAM);
+    size_t new_alloc = heap_caps_get_allocated_size(np ? np : p);
+    portENTER_CRITICAL(&pool_mux);
+    psram_bytes = psram_bytes - old_size + new_alloc;
+    if (!np) failures++;
+    if (psram_bytes > psram_peak_bytes) psram_peak_bytes = psram_bytes;
+    portEXIT_CRITICAL(&pool_mux);
+  } else {
+    // Changement de niveau ou de classe
+    np = tier_alloc(new_size);
+    if (np) {
+      memcpy(np, p, old_size < new_size ? old_size : new_size);
+      tier_free(p);
+    }
+  }
+
+  if (trace_enabled) printf("LVMEM r %p %u %p\n", p, (unsigned)new_size, np);
+  return np;
+}
+
+void lv_free_core(void *p) {
+  if (!p) return;
+  if (trace_enabled) printf("LVMEM f %p\n", p);
+  tier_free(p);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p) {
+  uint32_t pool_total = 0, pool_free_cnt = 0, biggest = 0, pool_peak = 0;
+  portENTER_CRITICAL(&pool_mux);
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    pool_total += (uint32_t)pools[i].block_size * pools[i].count;
+    pool_free_cnt += pools[i].count - pools[i].used;
+    pool_peak += (uint32_t)pools[i].block_size * pools[i].peak;
+    if (pools[i].used < pools[i].count) biggest = pools[i].block_size;
+  }
+  uint32_t psram_used = psram_bytes;
+  uint32_t used = pool_bytes + psram_bytes;
+  uint32_t used_cnt = live_blocks();
+  uint32_t peak = psram_peak_bytes + pool_peak;
+  portEXIT_CRITICAL(&pool_mux);
+
+  uint32_t psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+  mon_p->total_size = pool_total + psram_used + psram_free;
+  mon_p->free_size = mon_p->total_size - used;
+  mon_p->free_cnt = pool_free_cnt;
+  mon_p->free_biggest_size = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+  if (mon_p->free_biggest_size < biggest) mon_p->free_biggest_size = biggest;
+  mon_p->used_cnt = used_cnt;
+  mon_p->max_used = peak;
+  mon_p->used_pct = mon_p->total_size ? (uint8_t)(100ULL * used / mon_p->total_size) : 0;
+  mon_p->frag_pct = psram_free ? (uint8_t)(100 - 100ULL * heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM) / psram_free) : 0;
+}
+
+lv_result_t lv_mem_test_core(void) {
+  if (!heap_caps_check_integrity(MALLOC_CAP_SPIRAM, false)) return LV_RESULT_INVALID;
+
+  // Listes libres: chaque maillon doit rester dans son pool
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    uint32_t n = 0;
+    for (void **b = (void **)pools[i].free_list; b; b = (void **)*b) {
+      if (!lvgl_mem_pool_owns(&pools[i], b) || ++n > pools[i].count) return LV_RESULT_INVALID;
+    }
+    if (n != (uint32_t)(pools[i].count - pools[i].used)) return LV_RESULT_INVALID;
+  }
+  return LV_RESULT_OK;
+}
+
+// ============================================================================
+// Statistiques et bilan des ecrans
+// ============================================================================
+
+void lvgl_mem_get_stats(lvgl_mem_stats_t *out) {
+  memset(out, 0, sizeof(lvgl_mem_stats_t));
+  portENTER_CRITICAL(&pool_mux);
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    out->pool[i].block_size = pools[i].block_size;
+    out->pool[i].count = pools[i].count;
+    out->pool[i].used = pools[i].used;
+    out->pool[i].peak = pools[i].peak;
+    out->pool[i].allocs = pools[i].allocs;
+    out->pool[i].fallbacks = pools[i].fallbacks;
+  }
+  out->psram_allocs = psram_allocs;
+  out->psram_blocks = psram_blocks;
+  out->psram_bytes = psram_bytes;
+  out->psram_peak_bytes = psram_peak_bytes;
+  out->live_blocks = live_blocks();
+  out->live_bytes = pool_bytes + psram_bytes;
+  out->failures = failures;
+  portEXIT_CRITICAL(&pool_mux);
+  out->last_leak_blocks = last_leak_blocks;
+  out->last_leak_bytes = last_leak_bytes;
+  out->leak_reports = leak_reports;
+}
+
+static void live_snapshot(uint32_t *blocks, uint32_t *bytes) {
+  portENTER_CRITICAL(&pool_mux);
+  *blocks = live_blocks();
+  *bytes = pool_bytes + psram_bytes;
+  portEXIT_CRITICAL(&pool_mux);
+}
+
+void lvgl_mem_screen_begin(void) {
+  live_snapshot(&screen_mark_blocks, &screen_mark_bytes);
+}
+
+void lvgl_mem_screen_created(void) {
+  live_snapshot(&screen_created_blocks, &screen_created_bytes);
+  pending_size_blocks = screen_created_blocks - screen_mark_blocks;
+  pending_size_bytes = screen_created_bytes - screen_mark_bytes;
+}
+
+void lvgl_mem_screen_deleted(const char *tag) {
+  uint32_t blocks, bytes;
+  live_snapshot(&blocks, &bytes);
+
+  // Ce que l'ancien ecran a rendu vs ce qu'il avait pris a sa creation
+  // (le premier ecran n'a pas de taille connue: pas de bilan)
+  if (screen_size_blocks) {
+    last_leak_blocks = (int32_t)screen_size_blocks - (int32_t)(screen_created_blocks - blocks);
+    last_leak_bytes = (int32_t)screen_size_bytes - (int32_t)(screen_created_bytes - bytes);
+    if (last_leak_blocks > 0) {
+      leak_reports++;
+      ESP_LOGW(TAG, "Fuite suspectee (%s): %ld blocs, %ld octets non rendus", tag ? tag : "ecran",
+               (long)last_leak_blocks, (long)last_leak_bytes);
+    }
+  }
+
+  screen_size_blocks = pending_size_blocks;
+  screen_size_bytes = pending_size_bytes;
+}
+
+void lvgl_mem_set_trace(bool enable) {
+  trace_enabled = enable;
+}
+
+bool lvgl_mem_get_trace(void) {
+  return trace_enabled;
+}
@@ -0,0 +1,51 @@
+#ifndef LVGL_MEM_H
+#define LVGL_MEM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Allocateur LVGL a niveaux (LV_USE_STDLIB_MALLOC = LV_STDLIB_CUSTOM):
+// petits blocs dans des pools SRAM interne par classe de taille,
+// gros blocs et debordements en PSRAM.
+
+#define LVGL_MEM_POOL_CLASSES 5
+#define LVGL_MEM_POOL_SIZES { 16, 32, 64, 128, 256 }  // Classes croissantes (octets)
+
+typedef struct {
+  uint16_t block_size;
+  uint16_t count;
+  uint16_t used;
+  uint16_t peak;
+  uint32_t allocs;
+  uint32_t fallbacks;   // Pool plein, servi en PSRAM
+} lvgl_mem_pool_stats_t;
+
+typedef struct {
+  lvgl_mem_pool_stats_t pool[LVGL_MEM_POOL_CLASSES];
+  uint32_t psram_allocs;      // Allocations servies en PSRAM (gros blocs + debordements)
+  uint32_t psram_blocks;      // Blocs PSRAM vivants
+  uint32_t psram_bytes;
+  uint32_t psram_peak_bytes;
+  uint32_t live_blocks;       // Tous niveaux
+  uint32_t live_bytes;
+  uint32_t failures;          // Allocations impossibles
+  int32_t last_leak_blocks;   // Dernier ecran detruit: blocs non rendus
+  int32_t last_leak_bytes;
+  uint32_t leak_reports;      // Ecrans detruits avec fuite suspectee
+} lvgl_mem_stats_t;
+
+void lvgl_mem_get_stats(lvgl_mem_stats_t *out);
+
+// Bilan memoire des changements d'ecran (appels sous verrou LVGL):
+// avant creation du nouvel ecran, apres creation, apres destruction de l'ancien.
+// Une fuite est signalee si l'ancien ecran ne rend pas ce qu'il avait pris.
+void lvgl_mem_screen_begin(void);
+void lvgl_mem_screen_created(void);
+void lvgl_mem_screen_deleted(const char *tag);
+
+// Trace des allocations sur la console ("LVMEM a|f|r ...") pour rejeu sur PC
+// (tools/lvgl_mem_replay.cpp), basculee par LVGL_MEM_TRACE_SERIAL_CMD
+void lvgl_mem_set_trace(bool enable);
+bool lvgl_mem_get_trace(void);
+
+#endif
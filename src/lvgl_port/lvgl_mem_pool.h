@@ -0,0 +1,68 @@
+#ifndef LVGL_MEM_POOL_H
+#define LVGL_MEM_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// =============================================================================
+// Pool de blocs de taille fixe (liste libre chainee dans les blocs libres).
+// Sans dependance ESP-IDF: rejouable sur PC avec une trace d'allocations.
+// =============================================================================
+
+typedef struct {
+  uint8_t *base;         // Zone contigue de count * block_size octets
+  void *free_list;
+  uint16_t block_size;   // Multiple de 8 (alignement LVGL)
+  uint16_t count;
+  uint16_t used;
+  uint16_t peak;
+  uint32_t allocs;       // Allocations servies par ce pool
+  uint32_t fallbacks;    // Demandes de cette classe renvoyees en PSRAM (pool plein)
+} lvgl_mem_pool_t;
+
+static inline void lvgl_mem_pool_init(lvgl_mem_pool_t *p, void *base, uint16_t block_size, uint16_t count) {
+  p->base = (uint8_t *)base;
+  p->block_size = block_size;
+  p->count = base ? count : 0;
+  p->used = 0;
+  p->peak = 0;
+  p->allocs = 0;
+  p->fallbacks = 0;
+  p->free_list = NULL;
+
+  // Chainage du dernier au premier: les premiers blocs sortent en premier
+  for (int32_t i = (int32_t)p->count - 1; i >= 0; i--) {
+    void **block = (void **)(p->base + (size_t)i * block_size);
+    *block = p->free_list;
+    p->free_list = block;
+  }
+}
+
+static inline bool lvgl_mem_pool_owns(const lvgl_mem_pool_t *p, const void *ptr) {
+  const uint8_t *b = (const uint8_t *)ptr;
+  return p->count && b >= p->base && b < p->base + (size_t)p->count * p->block_size;
+}
+
+// NULL si le pool est plein (compte comme repli)
+static inline void *lvgl_mem_pool_alloc(lvgl_mem_pool_t *p) {
+  void **block = (void **)p->free_list;
+  if (!block) {
+    p->fallbacks++;
+    return NULL;
+  }
+  p->free_list = *block;
+  p->used++;
+  p->allocs++;
+  if (p->used > p->peak) p->peak = p->used;
+  return block;
+}
+
+static inline void lvgl_mem_pool_free(lvgl_mem_pool_t *p, void *ptr) {
+  void **block = (void **)ptr;
+  *block = p->free_list;
+  p->free_list = block;
+  p->used--;
+}
+
+#endif
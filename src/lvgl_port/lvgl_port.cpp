@@ -12,67 +12,252 @@ static esp_lcd_touch_handle_t touch_handle = NULL;
 static lv_display_t *lvgl_disp = NULL;
 static lv_indev_t *lvgl_touch_indev = NULL;
 
-// Callback LVGL flush avec synchronisation VSYNC
+// LVGL >= 9.1 recopie lui-meme les zones du frame precedent avant de rendre
+// dans l'autre framebuffer (mode direct double buffer): pas de double copie
+#if LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 1)
+#define LVGL_PORT_SYNC_IN_PORT 0
+#define lvgl_port_render() lv_display_refr_timer(NULL)
+#else
+#define LVGL_PORT_SYNC_IN_PORT 1
+#define lvgl_port_render() _lv_display_refr_timer(NULL)
+#endif
+
+// Zones invalidees du frame en cours (LVGL appelle flush une fois par zone,
+// au-dela de LV_INV_BUF_SIZE il invalide l'ecran entier)
+static lv_area_t dirty_areas[LV_INV_BUF_SIZE];
+static uint16_t dirty_count = 0;
+static uint32_t dirty_pixels = 0;
+static void *fb_1 = NULL;
+static void *fb_2 = NULL;
+static const uint8_t *sync_deferred_src = NULL;  // Recopie reportee (VSYNC expiree, back buffer peut-etre affiche)
+static lvgl_port_flush_stats_t flush_stats = { 0 };
+
+// Ordonnanceur de frames: lv_timer_handler cale sur la fin de trame LCD
+static TaskHandle_t lvgl_task_handle = NULL;
+static uint8_t vsync_divider = 1;   // Une execution toutes les N trames LCD
+static uint32_t flush_wait_us = 0;  // Attente VSYNC cumulee pendant le handler en cours
+static lvgl_port_frame_stats_t frame_stats = { 0 };
+
+// Tactile: etat du dernier rapport GT911 (coordonnees ecran)
+static volatile bool touch_irq_pending = false;
+static bool touch_irq_enabled = false;
+static uint32_t touch_last_read_ms = 0;
+static uint8_t touch_points = 0;
+static int16_t touch_x[2] = { 0 };
+static int16_t touch_y[2] = { 0 };
+static lvgl_port_touch_calib_t touch_calib = { 0.0f, 0.0f, 1.0f, 1.0f };
+static bool touch_calib_enabled = true;
+static touch_gesture_ctx_t touch_gesture = { 0 };
+static lvgl_port_gesture_cb_t gesture_cb = NULL;
+static lvgl_port_touch_stats_t touch_stats = { 0 };
+
+// Recopie des zones sales du framebuffer affiche vers l'autre (lignes contigues)
+static uint32_t copy_dirty_areas(uint16_t *dst, const uint16_t *src) {
+  uint32_t copied = 0;
+  for (uint16_t i = 0; i < dirty_count; i++) {
+    const lv_area_t *a = &dirty_areas[i];
+    int32_t w = lv_area_get_width(a);
+    size_t offset = (size_t)a->y1 * LVGL_PORT_H_RES + a->x1;
+
+    if (w == LVGL_PORT_H_RES) {
+      memcpy(dst + offset, src + offset, (size_t)w * lv_area_get_height(a) * sizeof(uint16_t));
+    } else {
+      for (int32_t y = a->y1; y <= a->y2; y++) {
+        memcpy(dst + offset, src + offset, w * sizeof(uint16_t));
+        offset += LVGL_PORT_H_RES;
+      }
+    }
+    copied += lv_area_get_size(a);
+  }
+  return copied;
+}
+
+// Callback LVGL flush: une seule bascule de framebuffer par frame, sur VSYNC
 static void flush_callback(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
   esp_lcd_panel_handle_t panel = (esp_lcd_panel_handle_t)lv_display_get_user_data(disp);
-  
-  // Synchronisation VSYNC
-  if (sem_gui_ready != NULL) {
+
+  if (dirty_count < LV_INV_BUF_SIZE) {
+    dirty_areas[dirty_count++] = *area;
+  }
+  dirty_pixels += lv_area_get_size(area);
+
+  // Zones intermediaires: rien a transferer, px_map est deja le framebuffer
+  if (!lv_display_flush_is_last(disp)) {
+    lv_display_flush_ready(disp);
+    return;
+  }
+
+  // Ecriture cache des zones rendues puis bascule sur ce framebuffer
+  // (px_map appartient au driver RGB: pas de copie, prise en compte a la trame suivante)
+  for (uint16_t i = 0; i < dirty_count; i++) {
+    const lv_area_t *a = &dirty_areas[i];
+    esp_lcd_panel_draw_bitmap(panel, a->x1, a->y1, a->x2 + 1, a->y2 + 1, px_map);
+  }
+
+  // Attente fin de trame: l'ancien framebuffer n'est plus lu par le LCD
+  bool vsync_ok = true;
+  if (sem_gui_ready != NULL && sem_vsync_end != NULL) {
+    int64_t wait_start = esp_timer_get_time();
+    xSemaphoreTake(sem_vsync_end, 0);
     xSemaphoreGive(sem_gui_ready);
-    xSemaphoreTake(sem_vsync_end, portMAX_DELAY);
+    if (xSemaphoreTake(sem_vsync_end, pdMS_TO_TICKS(LVGL_PORT_VSYNC_TIMEOUT_MS)) != pdTRUE) {
+      xSemaphoreTake(sem_gui_ready, 0);
+      flush_stats.vsync_timeouts++;
+      vsync_ok = false;
+    }
+    flush_wait_us += (uint32_t)(esp_timer_get_time() - wait_start);
   }
-  
-  // Swap framebuffer (safe pendant vertical blank)
-  int x1 = area->x1;
-  int y1 = area->y1;
-  int x2 = area->x2 + 1;
-  int y2 = area->y2 + 1;
-  
-  esp_lcd_panel_draw_bitmap(panel, x1, y1, x2, y2, px_map);
-  
+
+  uint32_t copied = 0;
+#if LVGL_PORT_SYNC_IN_PORT
+  // Le back buffer recoit les zones du frame affiche pour rester coherent.
+  // Sans VSYNC il peut encore etre balaye: recopie avant le prochain rendu
+  if (vsync_ok) {
+    void *back = (px_map == (uint8_t *)fb_1) ? fb_2 : fb_1;
+    copied = copy_dirty_areas((uint16_t *)back, (const uint16_t *)px_map);
+  } else {
+    sync_deferred_src = px_map;
+  }
+#endif
+
+  flush_stats.frames++;
+  flush_stats.last_areas = dirty_count;
+  flush_stats.last_flushed_px = dirty_pixels;
+  flush_stats.last_copied_px = copied;
+  flush_stats.total_flushed_px += dirty_pixels;
+  if (dirty_pixels >= (uint32_t)LVGL_PORT_H_RES * LVGL_PORT_V_RES) flush_stats.full_frames++;
+
+  if (!sync_deferred_src) dirty_count = 0;  // Zones gardees pour la recopie reportee
+  dirty_pixels = 0;
+
   lv_display_flush_ready(disp);
 }
 
+// Lecture tactile sur interruption: le GT911 pulse INT a chaque rapport (contact
+// en cours ou relache), le bus I2C n'est lu que sur signal. Tant qu'un doigt est
+// pose, une relecture de securite couvre un front manque.
+static void IRAM_ATTR touch_isr(esp_lcd_touch_handle_t tp) {
+  touch_irq_pending = true;
+  touch_stats.irqs++;
+}
+
+static inline int16_t touch_calibrate(uint16_t raw, float scale, float offset, int16_t max) {
+  int32_t v = (int32_t)lroundf(raw * scale + offset);
+  if (v < 0) v = 0;
+  if (v > max - 1) v = max - 1;
+  return (int16_t)v;
+}
+
 // Callback lecture tactile
 static void touchpad_read(lv_indev_t *indev, lv_indev_data_t *data) {
   esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)lv_indev_get_user_data(indev);
-  
-  uint16_t touch_x = 0;
-  uint16_t touch_y = 0;
-  uint8_t touch_cnt = 0;
-  
-  esp_lcd_touch_read_data(tp);
-  bool pressed = esp_lcd_touch_get_coordinates(tp, &touch_x, &touch_y, NULL, &touch_cnt, 1);
-  
-  if (pressed && touch_cnt > 0) {
-    data->point.x = touch_x;
-    data->point.y = touch_y;
+  uint32_t now = lv_tick_get();
+
+  bool watchdog = touch_points > 0 && lv_tick_diff(now, touch_last_read_ms) >= TOUCH_IRQ_WATCHDOG_MS;
+  if (!touch_irq_enabled || touch_irq_pending || watchdog) {
+    touch_irq_pending = false;
+    touch_last_read_ms = now;
+    touch_stats.reads++;
+    if (watchdog) touch_stats.watchdog_reads++;
+
+    uint16_t raw_x[2] = { 0 }, raw_y[2] = { 0 };
+    uint8_t cnt = 0;
+    esp_lcd_touch_read_data(tp);
+    if (!esp_lcd_touch_get_coordinates(tp, raw_x, raw_y, NULL, &cnt, 2)) cnt = 0;
+
+    touch_points = cnt;
+    for (uint8_t i = 0; i < cnt; i++) {
+      if (touch_calib_enabled) {
+        touch_x[i] = touch_calibrate(raw_x[i], touch_calib.scale_x, touch_calib.offset_x, LVGL_PORT_H_RES);
+        touch_y[i] = touch_calibrate(raw_y[i], touch_calib.scale_y, touch_calib.offset_y, LVGL_PORT_V_RES);
+      } else {
+        touch_x[i] = raw_x[i];
+        touch_y[i] = raw_y[i];
+      }
+    }
+  } else {
+    touch_stats.skipped_polls++;
+  }
+
+  // Gestes (appui long: aussi sans nouvelle lecture, le temps avance)
+  touch_gesture_t gesture;
+  if (touch_gesture_update(&touch_gesture, now, touch_points, touch_x, touch_y, &gesture)) {
+    touch_stats.gestures++;
+    if (gesture_cb) gesture_cb(&gesture);
+  }
+
+  if (touch_points > 0) {
+    data->point.x = touch_x[0];
+    data->point.y = touch_y[0];
     data->state = LV_INDEV_STATE_PRESSED;
   } else {
     data->state = LV_INDEV_STATE_RELEASED;
   }
 }
 
-// Tâche LVGL principale
+// Rendu des zones invalidees (verrou LVGL pris)
+static void render_frame(void) {
+#if LVGL_PORT_SYNC_IN_PORT
+  // Recopie reportee: une trame s'est ecoulee depuis la bascule (ou le panel est arrete)
+  if (sync_deferred_src) {
+    void *back = (sync_deferred_src == (uint8_t *)fb_1) ? fb_2 : fb_1;
+    copy_dirty_areas((uint16_t *)back, (const uint16_t *)sync_deferred_src);
+    sync_deferred_src = NULL;
+    dirty_count = 0;
+  }
+#endif
+  lvgl_port_render();
+}
+
+// Tâche LVGL principale: reveillee a chaque fin de trame. Timers LVGL et
+// tactile a chaque trame LCD, rendu seulement toutes les vsync_divider trames
+// (une trame rendue = bascule a la VSYNC suivante)
 static void lvgl_port_task(void *arg) {
 #ifdef DEBUG_MODE
   ESP_LOGI(TAG, "LVGL task started");
 #endif
-  
+
+  uint32_t pending = 0;
+
   while (1) {
+    uint32_t vsyncs = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LVGL_PORT_VSYNC_TIMEOUT_MS));
+    // Pas de VSYNC (panel arrete): on tourne quand meme au rythme du timeout
+    pending += (vsyncs > 0) ? vsyncs : vsync_divider;
+    bool render = pending >= vsync_divider;
+
+    // Trames LCD ecoulees au-dela de l'objectif depuis la derniere execution
+    uint32_t missed = render ? pending - vsync_divider : 0;
+    if (render) pending = 0;
+
     // Lock pour protéger LVGL
     if (lvgl_port_lock(LVGL_PORT_TASK_MAX_DELAY_MS)) {
-      uint32_t task_delay_ms = lv_timer_handler();
-      lvgl_port_unlock();
-      
-      // Délai adaptatif selon le temps de traitement LVGL
-      if (task_delay_ms > LVGL_PORT_TASK_MAX_DELAY_MS) {
-        task_delay_ms = LVGL_PORT_TASK_MAX_DELAY_MS;
-      } else if (task_delay_ms < LVGL_PORT_TASK_MIN_DELAY_MS) {
-        task_delay_ms = LVGL_PORT_TASK_MIN_DELAY_MS;
+      lv_timer_handler();
+      if (!render) {
+        lvgl_port_unlock();
+        continue;
       }
-      
-      vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+
+      uint32_t frames_before = flush_stats.frames;
+      flush_wait_us = 0;
+
+      int64_t start = esp_timer_get_time();
+      render_frame();
+      uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+
+      // Statistiques uniquement pour les executions qui ont produit un frame
+      if (flush_stats.frames != frames_before) {
+        uint32_t render_us = (elapsed > flush_wait_us) ? elapsed - flush_wait_us : 0;
+        frame_stats.frames++;
+        frame_stats.missed_vsyncs += missed;
+        frame_stats.last_render_us = render_us;
+        frame_stats.last_flush_wait_us = flush_wait_us;
+        if (render_us > frame_stats.max_render_us) frame_stats.max_render_us = render_us;
+        if (flush_wait_us > frame_stats.max_flush_wait_us) frame_stats.max_flush_wait_us = flush_wait_us;
+        frame_stats.sum_render_us += render_us;
+        frame_stats.sum_flush_wait_us += flush_wait_us;
+      }
+
+      lvgl_port_unlock();
     }
   }
 }
@@ -92,6 +277,8 @@ static lv_display_t *lvgl_port_display_init(esp_lcd_panel_handle_t panel) {
   void *buf1 = NULL;
   void *buf2 = NULL;
   ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel, 2, &buf1, &buf2));
+  fb_1 = buf1;
+  fb_2 = buf2;
   
 #ifdef DEBUG_MODE
   ESP_LOGI(TAG, "Framebuffer 1: %p", buf1);
@@ -109,6 +296,9 @@ static lv_display_t *lvgl_port_display_init(esp_lcd_panel_handle_t panel) {
   
   lv_display_set_flush_cb(disp, flush_callback);
   lv_display_set_user_data(disp, panel);
+
+  // Rendu declenche par lvgl_port_task a la frequence cible, pas par un timer
+  lv_display_delete_refr_timer(disp);
   
 #ifdef DEBUG_MODE
   ESP_LOGI(TAG, "LVGL display configured: %dx%d, Direct mode, 2 framebuffers",
@@ -128,6 +318,13 @@ static lv_indev_t *lvgl_port_indev_init(esp_lcd_touch_handle_t tp) {
   lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
   lv_indev_set_read_cb(indev, touchpad_read);
   lv_indev_set_user_data(indev, tp);
+
+  // Sans INT cable on retombe sur une lecture a chaque scrutation
+  touch_gesture_reset(&touch_gesture);
+  touch_irq_enabled = (esp_lcd_touch_register_interrupt_callback(tp, touch_isr) == ESP_OK);
+#ifdef DEBUG_MODE
+  ESP_LOGI(TAG, "Touch reads: %s", touch_irq_enabled ? "interrupt" : "polling");
+#endif
   
   return indev;
 }
@@ -151,6 +348,7 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
   
   // Initialiser LVGL
   lv_init();
+  lvgl_port_set_target_fps(LVGL_PORT_FPS_SETTINGS);
   
 #ifdef DEBUG_MODE
   ESP_LOGI(TAG, "LVGL initialized (version %d.%d.%d)",
@@ -193,7 +391,7 @@ esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle
     LVGL_PORT_TASK_STACK_SIZE,
     NULL,
     LVGL_PORT_TASK_PRIORITY,
-    NULL,
+    &lvgl_task_handle,
     LVGL_PORT_TASK_CORE
   );
   
@@ -222,7 +420,96 @@ void lvgl_port_unlock(void) {
   xSemaphoreGiveRecursive(lvgl_mux);
 }
 
-// Notification VSYNC (pas utilisé dans notre config mais gardé pour compatibilité)
-bool lvgl_port_notify_rgb_vsync(void) {
-  return false;
-}
\ No newline at end of file
+// Notification fin de trame (ISR): libere le flush si LVGL attend la bascule
+IRAM_ATTR bool lvgl_port_notify_rgb_vsync(void) {
+  BaseType_t high_task_awoken = pdFALSE;
+
+  if (sem_gui_ready != NULL && xSemaphoreTakeFromISR(sem_gui_ready, &high_task_awoken) == pdTRUE) {
+    xSemaphoreGiveFromISR(sem_vsync_end, &high_task_awoken);
+  }
+
+  // Cadencement de la tache LVGL (compte des trames)
+  if (lvgl_task_handle != NULL) {
+    vTaskNotifyGiveFromISR(lvgl_task_handle, &high_task_awoken);
+  }
+
+  return high_task_awoken == pdTRUE;
+}
+
+// API publique: statistiques de flush (copie coherente, appel depuis n'importe quelle tache)
+void lvgl_port_get_flush_stats(lvgl_port_flush_stats_t *out) {
+  if (lvgl_port_lock(-1)) {
+    *out = flush_stats;
+    lvgl_port_unlock();
+  }
+}
+
+// API publique: rendu immediat hors cadencement (verrou LVGL deja pris)
+void lvgl_port_refresh_now(void) {
+  render_frame();
+}
+
+// API publique: frequence cible (arrondie a un diviseur de la trame LCD)
+void lvgl_port_set_target_fps(uint8_t fps) {
+  if (fps == 0) fps = 1;
+  uint32_t divider = (LCD_REFRESH_HZ + fps / 2) / fps;
+  if (divider < 1) divider = 1;
+  if (divider > 255) divider = 255;
+
+  if (lvgl_port_lock(-1)) {
+    vsync_divider = (uint8_t)divider;
+    frame_stats.target_fps = fps;
+    lvgl_port_unlock();
+  }
+}
+
+// API publique: statistiques de cadencement
+void lvgl_port_get_frame_stats(lvgl_port_frame_stats_t *out) {
+  if (lvgl_port_lock(-1)) {
+    *out = frame_stats;
+    out->vsync_divider = vsync_divider;
+    lvgl_port_unlock();
+  }
+}
+
+// API publique: remise a zero des statistiques (debut de mesure)
+void lvgl_port_reset_frame_stats(void) {
+  if (lvgl_port_lock(-1)) {
+    uint8_t target = frame_stats.target_fps;
+    memset(&frame_stats, 0, sizeof(frame_stats));
+    frame_stats.target_fps = target;
+    lvgl_port_unlock();
+  }
+}
+
+// API publique: calibration tactile (ecran = brut * scale + offset)
+void lvgl_port_set_touch_calibration(const lvgl_port_touch_calib_t *calib) {
+  if (lvgl_port_lock(-1)) {
+    touch_calib = *calib;
+    lvgl_port_unlock();
+  }
+}
+
+// API publique: coordonnees brutes pendant l'ecran de calibration
+void lvgl_port_enable_touch_calibration(bool enable) {
+  if (lvgl_port_lock(-1)) {
+    touch_calib_enabled = enable;
+    lvgl_port_unlock();
+  }
+}
+
+// API publique: destinataire des gestes (appele sous verrou LVGL), NULL pour aucun
+void lvgl_port_set_gesture_cb(lvgl_port_gesture_cb_t cb) {
+  if (lvgl_port_lock(-1)) {
+    gesture_cb = cb;
+    lvgl_port_unlock();
+  }
+}
+
+void lvgl_port_get_touch_stats(lvgl_port_touch_stats_t *out) {
+  if (lvgl_port_lock(-1)) {
+    *out = touch_stats;
+    out->irq_driven = touch_irq_enabled;
+    lvgl_port_unlock();
+  }
+}
@@ -5,11 +5,57 @@
 #include "esp_err.h"
 #include "esp_lcd_types.h"
 #include "src/touch/touch.h"
+#include "src/touch/touch_gesture.h"
 #include "lvgl.h"
 #include "src/rgb_lcd_port/rgb_lcd_port.h"
 #include "src/gt911/gt911.h"
 #include "constants.h"
 
+// Statistiques du flush (pixels en PSRAM par frame)
+typedef struct {
+  uint32_t frames;            // Frames envoyes au LCD
+  uint32_t full_frames;       // Frames ayant rendu l'ecran entier
+  uint32_t vsync_timeouts;    // Attentes fin de trame expirees
+  uint16_t last_areas;        // Zones invalidees du dernier frame
+  uint32_t last_flushed_px;   // Pixels rendus au dernier frame
+  uint32_t last_copied_px;    // Pixels recopies vers le back buffer au dernier frame
+  uint64_t total_flushed_px;  // Cumul depuis le demarrage
+} lvgl_port_flush_stats_t;
+
+// Statistiques de cadencement (temps en us)
+typedef struct {
+  uint32_t frames;              // Frames produits
+  uint32_t missed_vsyncs;       // Trames LCD perdues au-dela de l'objectif
+  uint32_t last_render_us;      // Rendu LVGL (hors attente VSYNC)
+  uint32_t max_render_us;
+  uint32_t last_flush_wait_us;  // Attente de la bascule en fin de trame
+  uint32_t max_flush_wait_us;
+  uint64_t sum_render_us;       // Cumuls pour les moyennes
+  uint64_t sum_flush_wait_us;
+  uint8_t target_fps;
+  uint8_t vsync_divider;        // Une execution toutes les N trames LCD
+} lvgl_port_frame_stats_t;
+
+// Calibration lineaire du tactile (params.touch_*)
+typedef struct {
+  float offset_x;
+  float offset_y;
+  float scale_x;
+  float scale_y;
+} lvgl_port_touch_calib_t;
+
+// Statistiques tactile
+typedef struct {
+  uint32_t irqs;            // Fronts INT recus
+  uint32_t reads;           // Lectures I2C effectuees
+  uint32_t watchdog_reads;  // Dont relectures de securite (doigt pose sans INT)
+  uint32_t skipped_polls;   // Scrutations LVGL sans acces bus
+  uint32_t gestures;
+  bool irq_driven;
+} lvgl_port_touch_stats_t;
+
+typedef void (*lvgl_port_gesture_cb_t)(const touch_gesture_t *gesture);
+
 esp_err_t lvgl_port_init(esp_lcd_panel_handle_t lcd_handle, esp_lcd_touch_handle_t tp_handle);
 
 bool lvgl_port_lock(int timeout_ms);
@@ -18,4 +64,22 @@ void lvgl_port_unlock(void);
 
 bool lvgl_port_notify_rgb_vsync(void);
 
+void lvgl_port_get_flush_stats(lvgl_port_flush_stats_t *out);
+
+void lvgl_port_set_target_fps(uint8_t fps);
+
+void lvgl_port_refresh_now(void);
+
+void lvgl_port_get_frame_stats(lvgl_port_frame_stats_t *out);
+
+void lvgl_port_reset_frame_stats(void);
+
+void lvgl_port_set_touch_calibration(const lvgl_port_touch_calib_t *calib);
+
+void lvgl_port_enable_touch_calibration(bool enable);
+
+void lvgl_port_set_gesture_cb(lvgl_port_gesture_cb_t cb);
+
+void lvgl_port_get_touch_stats(lvgl_port_touch_stats_t *out);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#ifndef METAR_DECODE_H
+#define METAR_DECODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Decodage d'un message METAR brut (OACI et variantes US):
+//   [METAR|SPECI] LFLS 011230Z [AUTO] 24012G22KT 9999 -RA BKN030 18/12 Q1013 ...
+// Station, heure d'observation, vent, visibilite, temps present, premier
+// nuage, temperature/point de rosee et QNH (Qxxxx hPa ou Axxxx inHg).
+// Les groupes de tendance (NOSIG, BECMG, TEMPO) et les remarques (RMK) sont
+// ignores. Calcul pur sans Arduino ni ESP-IDF: se compile sur PC
+// (tools/metar_decode_check.cpp, corpus tools/metar_corpus.txt).
+// =============================================================================
+
+#define METAR_TOKEN_MAX 24
+#define METAR_CONDITIONS_MAX 32
+#define METAR_VIS_MAX 10000          // 9999, CAVOK, 10SM: 10 km et plus
+
+typedef struct {
+  char station[5];
+  uint8_t day, hour, minute;         // Heure d'observation UTC
+  int wind_dir;                      // Degres, -1: variable
+  float wind_speed;                  // m/s
+  float wind_gust;                   // m/s, 0: pas de rafales
+  int visibility;                    // metres, -1: absente
+  float temperature;                 // Celsius
+  float dewpoint;                    // Celsius
+  float qnh;                         // hPa
+  bool has_wind;
+  bool has_temp;
+  bool has_qnh;
+  char conditions[METAR_CONDITIONS_MAX];  // Temps present et premier nuage, "CAVOK"
+} metar_report_t;
+
+static inline bool metar_is_digits(const char *s, int n) {
+  for (int i = 0; i < n; i++) {
+    if (s[i] < '0' || s[i] > '9') return false;
+  }
+  return true;
+}
+
+static void metar_add_condition(metar_report_t *r, const char *text) {
+  size_t len = strlen(r->conditions);
+  size_t add = strlen(text);
+  if (len + (len ? 1 : 0) + add >= METAR_CONDITIONS_MAX) return;
+  if (len) r->conditions[len++] = ' ';
+  memcpy(r->conditions + len, text, add + 1);
+}
+
+// dddssKT, dddssGggKT, VRBssKT, unites KT / MPS / KMH
+static bool metar_parse_wind(metar_report_t *r, const char *t) {
+  size_t n = strlen(t);
+  float unit;
+  size_t u;
+  if (n > 2 && strcmp(t + n - 2, "KT") == 0) unit = 0.514444f, u = 2;
+  else if (n > 3 && strcmp(t + n - 3, "MPS") == 0) unit = 1.0f, u = 3;
+  else if (n > 3 && strcmp(t + n - 3, "KMH") == 0) unit = 1.0f / 3.6f, u = 3;
+  else return false;
+  if (n - u < 5) return false;
+  int dir;
+  if (strncmp(t, "VRB", 3) == 0) dir = -1;
+  else if (metar_is_digits(t, 3)) dir = (t[0] - '0') * 100 + (t[1] - '0') * 10 + (t[2] - '0');
+  else if (strncmp(t, "///", 3) == 0) return true;   // Capteur hors service
+  else return false;
+
+  const char *p = t + 3;
+  const char *end = t + n - u;
+  int len = 0;
+  while (p + len < end && p[len] >= '0' && p[len] <= '9') len++;
+  if (len < 2 || len > 3) return false;
+  float speed = atoi(p) * unit;
+  float gust = 0;
+  p += len;
+  if (p < end) {
+    if (*p != 'G' || !metar_is_digits(p + 1, (int)(end - p - 1)) || end - p - 1 < 2) return false;
+    gust = atoi(p + 1) * unit;
+  }
+  r->wind_dir = dir;
+  r->wind_speed = speed;
+  r->wind_gust = gust;
+  r->has_wind = true;
+  return true;
+}
+
+// 9999, 4000, 4000NE, 9999NDV, 10SM, 1/2SM, M1/4SM, "1 1/2SM" (whole: entier precedent)
+static bool metar_parse_visibility(metar_report_t *r, const char *t, int whole) {
+  static const char *const suffixes[] = { "", "N", "S", "E", "W", "NE", "NW", "SE", "SW", "NDV" };
+  size_t n = strlen(t);
+  if (n >= 4 && metar_is_digits(t, 4)) {
+    bool known = false;
+    for (size_t i = 0; i < sizeof(suffixes) / sizeof(suffixes[0]) && !known; i++) known = !strcmp(t + 4, suffixes[i]);
+    if (!known) return false;
+    int v = atoi(t);
+    r->visibility = v >= 9999 ? METAR_VIS_MAX : v;
+    return true;
+  }
+  if (n > 2 && strcmp(t + n - 2, "SM") == 0) {
+    const char *p = t[0] == 'M' || t[0] == 'P' ? t + 1 : t;
+    float miles;
+    unsigned a, b;
+    if (sscanf(p, "%u/%uSM", &a, &b) == 2 && b) miles = whole + (float)a / b;
+    else if (sscanf(p, "%uSM", &a) == 1) miles = a;
+    else return false;
+    int v = (int)(miles * 1609.34f + 0.5f);
+    r->visibility = v > METAR_VIS_MAX ? METAR_VIS_MAX : v;
+    return true;
+  }
+  return false;
+}
+
+// Temps present: [-+|VC][descripteur][phenomenes]
+static bool metar_parse_weather(const char *t) {
+  static const char *const codes[] = { "MI", "PR", "BC", "DR", "BL", "SH", "TS", "FZ", "DZ", "RA", "SN", "SG",
+                                       "IC", "PL", "GR", "GS", "UP", "BR", "FG", "FU", "VA", "DU", "SA", "HZ",
+                                       "PY", "PO", "SQ", "FC", "SS", "DS" };
+  const char *p = t;
+  if (*p == '-' || *p == '+') p++;
+  else if (strncmp(p, "VC", 2) == 0) p += 2;
+  if (!*p || strlen(p) % 2) return false;
+  for (; *p; p += 2) {
+    bool known = false;
+    for (size_t i = 0; i < sizeof(codes) / sizeof(codes[0]) && !known; i++) known = strncmp(p, codes[i], 2) == 0;
+    if (!known) return false;
+  }
+  return true;
+}
+
+static bool metar_parse_cloud(const char *t) {
+  static const char *const covers[] = { "FEW", "SCT", "BKN", "OVC" };
+  for (size_t i = 0; i < 4; i++) {
+    if (strncmp(t, covers[i], 3) == 0 && (metar_is_digits(t + 3, 3) || strncmp(t + 3, "///", 3) == 0)) return true;
+  }
+  return strncmp(t, "VV", 2) == 0 && strlen(t) == 5;
+}
+
+// Mdd -> -dd
+static bool metar_parse_temp_value(const char *s, size_t n, float *out) {
+  bool neg = n == 3 && s[0] == 'M';
+  if (neg) s++, n--;
+  if (n != 2 || !metar_is_digits(s, 2)) return false;
+  *out = (float)((s[0] - '0') * 10 + (s[1] - '0'));
+  if (neg) *out = -*out;
+  return true;
+}
+
+static bool metar_parse_temp(metar_report_t *r, const char *t) {
+  const char *slash = strchr(t, '/');
+  if (!slash || strchr(slash + 1, '/')) return false;
+  float temp, dew;
+  if (!metar_parse_temp_value(t, slash - t, &temp)) return false;
+  r->temperature = temp;
+  r->dewpoint = metar_parse_temp_value(slash + 1, strlen(slash + 1), &dew) ? dew : temp;
+  r->has_temp = true;
+  return true;
+}
+
+static bool metar_parse_pressure(metar_report_t *r, const char *t) {
+  if (strlen(t) != 5 || !metar_is_digits(t + 1, 4)) return false;
+  int v = atoi(t + 1);
+  if (t[0] == 'Q') r->qnh = (float)v;
+  else if (t[0] == 'A') r->qnh = v * 0.338639f;   // Centiemes de inHg
+  else return false;
+  r->has_qnh = r->qnh >= 850.0f && r->qnh <= 1100.0f;
+  return true;
+}
+
+// false si la station ou l'heure manquent
+static bool metar_decode(const char *text, metar_report_t *r) {
+  memset(r, 0, sizeof(*r));
+  r->visibility = -1;
+  int step = 0;     // 0: station, 1: heure, 2: corps
+  int whole = 0;    // Entier de visibilite US en attente ("1 1/2SM")
+  bool cloud_seen = false;
+  const char *p = text;
+
+  while (*p) {
+    while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t') p++;
+    size_t n = strcspn(p, " \n\r\t=");
+    if (n == 0) {
+      if (*p == '=') break;
+      continue;
+    }
+    char t[METAR_TOKEN_MAX];
+    if (n >= sizeof(t)) {
+      p += n;
+      continue;
+    }
+    memcpy(t, p, n);
+    t[n] = '\0';
+    p += n;
+
+    if (step == 0) {
+      if (!strcmp(t, "METAR") || !strcmp(t, "SPECI") || !strcmp(t, "COR")) continue;
+      if (n != 4 || t[0] < 'A' || t[0] > 'Z') return false;
+      memcpy(r->station, t, 5);
+      step = 1;
+      continue;
+    }
+    if (step == 1) {
+      if (n != 7 || t[6] != 'Z' || !metar_is_digits(t, 6)) return false;
+      r->day = (t[0] - '0') * 10 + (t[1] - '0');
+      r->hour = (t[2] - '0') * 10 + (t[3] - '0');
+      r->minute = (t[4] - '0') * 10 + (t[5] - '0');
+      if (r->day < 1 || r->day > 31 || r->hour > 23 || r->minute > 59) return false;
+      step = 2;
+      continue;
+    }
+
+    if (!strcmp(t, "RMK") || !strcmp(t, "NOSIG") || !strcmp(t, "BECMG") || !strcmp(t, "TEMPO")) break;
+    int pending = whole;
+    whole = 0;
+    if (!strcmp(t, "AUTO") || !strcmp(t, "COR") || !strcmp(t, "NIL")) continue;
+    if (!r->has_wind && metar_parse_wind(r, t)) continue;
+    if (!strcmp(t, "CAVOK")) {
+      r->visibility = METAR_VIS_MAX;
+      metar_add_condition(r, "CAVOK");
+      continue;
+    }
+    if (r->visibility < 0) {
+      if (n == 1 && t[0] >= '1' && t[0] <= '9') {
+        whole = t[0] - '0';
+        continue;
+      }
+      if (metar_parse_visibility(r, t, pending)) continue;
+    }
+    if (t[0] == 'R' && strchr(t, '/')) continue;    // Portee visuelle de piste
+    if (metar_parse_weather(t)) {
+      metar_add_condition(r, t);
+      continue;
+    }
+    if (metar_parse_cloud(t)) {
+      if (!cloud_seen) metar_add_condition(r, t);
+      cloud_seen = true;
+      continue;
+    }
+    if (!r->has_temp && metar_parse_temp(r, t)) continue;
+    if (!r->has_qnh) metar_parse_pressure(r, t);
+  }
+  return step == 2;
+}
+
+// Age en minutes d'une observation (jour/heure du METAR) a l'heure UTC
+// courante; -1 si l'observation n'est ni du jour ni de la veille
+static int metar_age_minutes(const metar_report_t *r, uint8_t now_day, uint8_t now_hour, uint8_t now_minute) {
+  int now = now_hour * 60 + now_minute;
+  int obs = r->hour * 60 + r->minute;
+  if (r->day == now_day) return now >= obs ? now - obs : -1;
+  bool yesterday = now_day == r->day + 1 || (now_day == 1 && r->day >= 28);
+  return yesterday ? now + 1440 - obs : -1;
+}
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef METAR_STATIONS_H
+#define METAR_STATIONS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "src/json_stream.h"
+#include "src/metar_decode.h"
+
+// =============================================================================
+// QNH des stations METAR proches: lecture au fil de l'eau de la reponse JSON
+// d'aviationweather.gov (tableau d'objets {"icaoId", "lat", "lon", "rawOb",
+// ...}), decodage de chaque METAR brut, conservation des plus proches, puis
+// QNH de la station la plus proche ou interpole (inverse du carre de la
+// distance) entre les stations voisines, avec l'age de l'observation.
+// Calcul pur sans Arduino ni ESP-IDF: se compile sur PC
+// (tools/metar_decode_check.cpp).
+// =============================================================================
+
+#define METAR_STATIONS_MAX 6          // Stations conservees (les plus proches)
+#define METAR_NEAR_KM 15.0f           // Station assez proche: QNH pris tel quel
+#define METAR_RADIUS_KM 80.0f         // Au-dela: station ignoree
+#define METAR_INTERP_MAX 3            // Stations combinees au plus
+#define METAR_MAX_AGE_MIN 90          // Observation plus ancienne ignoree
+
+typedef struct {
+  metar_report_t report;
+  float distance_km;
+  int age_min;                        // -1: inconnu
+} metar_station_t;
+
+typedef struct {
+  float lat, lon;                     // Position du vario
+  metar_station_t stations[METAR_STATIONS_MAX];  // Triees par distance
+  int count;
+  uint16_t records;                   // Objets lus dans la reponse
+  // Objet en cours de lecture
+  float rec_lat, rec_lon;
+  bool rec_has_lat, rec_has_lon;
+  metar_report_t rec_report;
+  bool rec_decoded;
+} metar_stations_t;
+
+typedef struct {
+  float qnh;
+  char station[12];                   // "LFLS" ou "LFLS+2" si interpole
+  float distance_km;                  // Station la plus proche
+  int age_min;                        // Observation la plus ancienne utilisee
+  uint8_t used;
+  const metar_report_t *nearest;
+} metar_qnh_t;
+
+static float metar_distance_km(float lat1, float lon1, float lat2, float lon2) {
+  const float R = 6371.0f;
+  float dlat = (lat2 - lat1) * (float)M_PI / 180.0f;
+  float dlon = (lon2 - lon1) * (float)M_PI / 180.0f;
+  float a = sinf(dlat / 2) * sinf(dlat / 2) +
+            cosf(lat1 * (float)M_PI / 180.0f) * cosf(lat2 * (float)M_PI / 180.0f) * sinf(dlon / 2) * sinf(dlon / 2);
+  return R * 2 * atan2f(sqrtf(a), sqrtf(1 - a));
+}
+
+static void metar_stations_init(metar_stations_t *st, float lat, float lon) {
+  memset(st, 0, sizeof(*st));
+  st->lat = lat;
+  st->lon = lon;
+}
+
+// Insertion triee par distance, les plus lointaines sortent de la liste
+static void metar_stations_add(metar_stations_t *st, const metar_report_t *r, float distance_km) {
+  for (int i = 0; i < st->count; i++) {
+    if (strcmp(st->stations[i].report.station, r->station) == 0) return;   // Doublon (SPECI)
+  }
+  int pos = st->count;
+  while (pos > 0 && st->stations[pos - 1].distance_km > distance_km) pos--;
+  if (pos >= METAR_STATIONS_MAX) return;
+  int last = st->count < METAR_STATIONS_MAX ? st->count : METAR_STATIONS_MAX - 1;
+  memmove(&st->stations[pos + 1], &st->stations[pos], (last - pos) * sizeof(metar_station_t));
+  st->stations[pos].report = *r;
+  st->stations[pos].distance_km = distance_km;
+  st->stations[pos].age_min = -1;
+  if (st->count < METAR_STATIONS_MAX) st->count++;
+}
+
+// Rappel JSON: [{"icaoId": "LFLS", "lat": 45.36, "lon": 5.33, "rawOb": "METAR LFLS ...", ...}, ...]
+static void metar_stations_cb(json_stream_t *s, json_stream_event_t ev, const char *value) {
+  metar_stations_t *st = (metar_stations_t *)s->user;
+  // Champs des objets du tableau racine uniquement
+  if (s->depth != 2 || !((s->arrays >> 1) & 1)) return;
+
+  if (ev == JSON_STREAM_END_OBJECT) {
+    st->records++;
+    if (st->rec_decoded && st->rec_has_lat && st->rec_has_lon && st->rec_report.has_qnh) {
+      float d = metar_distance_km(st->lat, st->lon, st->rec_lat, st->rec_lon);
+      if (d <= METAR_RADIUS_KM) metar_stations_add(st, &st->rec_report, d);
+    }
+    st->rec_has_lat = st->rec_has_lon = st->rec_decoded = false;
+    return;
+  }
+  const char *key = json_stream_key(s, 2);
+  if (ev == JSON_STREAM_NUMBER && strcmp(key, "lat") == 0) {
+    st->rec_lat = strtof(value, NULL);
+    st->rec_has_lat = true;
+  } else if (ev == JSON_STREAM_NUMBER && strcmp(key, "lon") == 0) {
+    st->rec_lon = strtof(value, NULL);
+    st->rec_has_lon = true;
+  } else if (ev == JSON_STREAM_STRING && strcmp(key, "rawOb") == 0) {
+    st->rec_decoded = metar_decode(value, &st->rec_report);
+  }
+}
+
+// QNH a l'heure UTC courante (has_now false: age non verifie)
+static bool metar_stations_qnh(metar_stations_t *st, bool has_now, uint8_t day, uint8_t hour, uint8_t minute,
+                               metar_qnh_t *out) {
+  memset(out, 0, sizeof(*out));
+  const metar_station_t *used[METAR_INTERP_MAX];
+  int n = 0;
+  for (int i = 0; i < st->count && n < METAR_INTERP_MAX; i++) {
+    metar_station_t *s = &st->stations[i];
+    s->age_min = has_now ? metar_age_minutes(&s->report, day, hour, minute) : -1;
+    if (has_now && (s->age_min < 0 || s->age_min > METAR_MAX_AGE_MIN)) continue;
+    used[n++] = s;
+    // Station assez proche: pas d'interpolation
+    if (n == 1 && s->distance_km <= METAR_NEAR_KM) break;
+  }
+  if (n == 0) return false;
+
+  float sum = 0, weight = 0;
+  int age = -1;
+  for (int i = 0; i < n; i++) {
+    float d = used[i]->distance_km < 1.0f ? 1.0f : used[i]->distance_km;
+    float w = 1.0f / (d * d);
+    sum += used[i]->report.qnh * w;
+    weight += w;
+    if (used[i]->age_min > age) age = used[i]->age_min;
+  }
+  out->qnh = sum / weight;
+  out->used = n;
+  out->age_min = age;
+  out->distance_km = used[0]->distance_km;
+  out->nearest = &used[0]->report;
+  if (n > 1) snprintf(out->station, sizeof(out->station), "%s+%d", used[0]->report.station, n - 1);
+  else snprintf(out->station, sizeof(out->station), "%s", used[0]->report.station);
+  return true;
+}
+
+#endif
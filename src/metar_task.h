@@ -3,12 +3,13 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <HTTPClient.h>
-#include <ArduinoJson.h>
+#include <WiFiClientSecure.h>
 #include "constants.h"
 #include "globals.h"
 #include "src/wifi_task.h"
 #include "src/kalman_task.h"
+#include "src/qnh_fetch.h"
+#include "src/metar_stations.h"
 
 // =============================
 // Données globales
@@ -18,258 +19,211 @@ static SemaphoreHandle_t metar_mutex = NULL;
 static TaskHandle_t metar_task_handle = NULL;
 static EventGroupHandle_t metar_event_group = NULL;
 static bool qnh_retrieved = false;
+static WiFiClientSecure qnh_client;   // Reutilisee tant que le serveur la garde ouverte
+static qnh_http_t qnh_http;
+static qnh_cache_t qnh_cache;
+
+// Fin d'une demande metar_fetch_async, appelee depuis metar_task
+typedef void (*qnh_done_cb_t)(bool ok, float qnh, void *user);
+static qnh_done_cb_t qnh_done_cb = NULL;
+static void *qnh_done_user = NULL;
 
 // =============================
-// METHOD 1: Progressive smooth transition
+// Requete HTTPS (connexion TLS conservee, reponse analysee au fil de l'eau)
 // =============================
-#if QNH_ADJUST_METHOD == 1
-static void updateQNH_method1(float newQNH) {
-  float startQNH = metar_data.qnh;
-
-  if (startQNH < 900.0f || startQNH > 1100.0f) {
-    startQNH = 1013.25f;
-  }
-
-  float deltaQNH = newQNH - startQNH;
+static char qnh_client_host[32] = "";
 
-  if (fabs(deltaQNH) < 0.1f) {
-    if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-      metar_data.qnh = newQNH;
-      g_sensor_data.qnh_metar = newQNH;
-      xSemaphoreGive(metar_mutex);
-    }
-    kalman_set_qnh_ready(newQNH);
-    return;
-  }
+static bool qnh_stop_requested(void) {
+  return xEventGroupGetBits(metar_event_group) & METAR_STOP_BIT;
+}
 
+// Corps JSON remis a cb; true si reponse 200 complete
+static bool qnh_http_request(const char *host, const char *path, json_stream_cb_t cb, void *user) {
+  // Autre serveur: la connexion conservee ne sert plus
+  if (strcmp(host, qnh_client_host) != 0) qnh_client.stop();
+  bool reused = qnh_client.connected();
+  for (int attempt = 0; attempt < 2; attempt++) {
+    if (!qnh_client.connected()) {
+      qnh_client.stop();
+      qnh_client.setInsecure();
+      uint32_t t0 = millis();
+      if (!qnh_client.connect(host, QNH_HTTPS_PORT, QNH_HTTP_TIMEOUT_MS)) {
 #ifdef DEBUG_MODE
-  Serial.printf("[QNH-M1] Smooth transition: %.1f -> %.1f hPa\n", startQNH, newQNH);
+        Serial.printf("[QNH] Connection to %s failed\n", host);
 #endif
-
-  const int STEPS = 50;
-  const int DELAY_MS = 100;
-
-  for (int i = 1; i <= STEPS; i++) {
-    float currentQNH = startQNH + (deltaQNH * i / STEPS);
-
-    if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-      metar_data.qnh = currentQNH;
-      g_sensor_data.qnh_metar = currentQNH;
-      xSemaphoreGive(metar_mutex);
-    }
-
-    kalman_set_qnh_ready(currentQNH);
-    vTaskDelay(pdMS_TO_TICKS(DELAY_MS));
-  }
-
-  if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-    metar_data.qnh = newQNH;
-    g_sensor_data.qnh_metar = newQNH;
-    xSemaphoreGive(metar_mutex);
-  }
-  kalman_set_qnh_ready(newQNH);
-
+        return false;
+      }
+      strlcpy(qnh_client_host, host, sizeof(qnh_client_host));
+      reused = false;
 #ifdef DEBUG_MODE
-  Serial.printf("[QNH-M1] Transition completed: %.1f hPa\n", newQNH);
-#endif
-}
+      Serial.printf("[QNH] Connected to %s in %lu ms\n", host, (unsigned long)(millis() - t0));
 #endif
-
-// =============================
-// METHOD 2: Smooth transition + IMU confidence boost
-// =============================
-#if QNH_ADJUST_METHOD == 2
-static void updateQNH_method2(float newQNH) {
-  float startQNH = metar_data.qnh;
-
-  if (startQNH < 900.0f || startQNH > 1100.0f) {
-    startQNH = 1013.25f;
-  }
-
-  float deltaQNH = newQNH - startQNH;
-
-  if (fabs(deltaQNH) < 0.1f) {
-    if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-      metar_data.qnh = newQNH;
-      g_sensor_data.qnh_metar = newQNH;
-      g_sensor_data.qnh_transition = false;
-      xSemaphoreGive(metar_mutex);
     }
-    kalman_set_qnh_ready(newQNH);
-    return;
-  }
-
-#ifdef DEBUG_MODE
-  Serial.printf("[QNH-M2] Smooth transition + IMU boost: %.1f -> %.1f hPa\n", startQNH, newQNH);
-#endif
-
-  // Activer le flag de transition (pour kalman_task)
-  if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-    g_sensor_data.qnh_transition = true;
-    xSemaphoreGive(metar_mutex);
-  }
-
-  const int STEPS = 50;
-  const int DELAY_MS = 100;
-
-  for (int i = 1; i <= STEPS; i++) {
-    float currentQNH = startQNH + (deltaQNH * i / STEPS);
 
-    if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-      metar_data.qnh = currentQNH;
-      g_sensor_data.qnh_metar = currentQNH;
-      xSemaphoreGive(metar_mutex);
+    char req[320];
+    int n = snprintf(req, sizeof(req),
+                     "GET %s HTTP/1.1\r\n"
+                     "Host: %s\r\n"
+                     "User-Agent: Vario_LVGL\r\n"
+                     "Connection: keep-alive\r\n\r\n",
+                     path, host);
+    qnh_http_init(&qnh_http, cb, user);
+    if (n < (int)sizeof(req) && qnh_client.write((const uint8_t *)req, n) == (size_t)n) {
+      uint8_t buf[256];
+      uint32_t last_rx = millis();
+      while (qnh_http.state != QNH_HTTP_DONE && qnh_http.state != QNH_HTTP_ERROR && !qnh_stop_requested()) {
+        int avail = qnh_client.available();
+        if (avail > 0) {
+          int r = qnh_client.read(buf, avail < (int)sizeof(buf) ? avail : sizeof(buf));
+          if (r > 0) {
+            qnh_http_feed(&qnh_http, buf, r);
+            last_rx = millis();
+          }
+          continue;
+        }
+        if (!qnh_client.connected()) {
+          qnh_http_eof(&qnh_http);
+          break;
+        }
+        if (millis() - last_rx > QNH_HTTP_TIMEOUT_MS) break;
+        vTaskDelay(pdMS_TO_TICKS(QNH_HTTP_POLL_MS));
+      }
     }
 
-    kalman_set_qnh_ready(currentQNH);
-    vTaskDelay(pdMS_TO_TICKS(DELAY_MS));
+    if (qnh_http.state != QNH_HTTP_DONE || qnh_http.close) qnh_client.stop();
+    if (qnh_http.state == QNH_HTTP_DONE) return qnh_http_ok(&qnh_http);
+    // Connexion conservee fermee par le serveur entre deux requetes: une seule reprise
+    if (!reused || qnh_http.status != 0 || qnh_stop_requested()) break;
   }
-
-  if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-    metar_data.qnh = newQNH;
-    g_sensor_data.qnh_metar = newQNH;
-    g_sensor_data.qnh_transition = false;
-    xSemaphoreGive(metar_mutex);
-  }
-  kalman_set_qnh_ready(newQNH);
-
 #ifdef DEBUG_MODE
-  Serial.printf("[QNH-M2] Transition completed: %.1f hPa\n", newQNH);
+  Serial.printf("[QNH] %s: HTTP failed (state %d, status %d)\n", host, qnh_http.state, qnh_http.status);
 #endif
+  return false;
 }
-#endif
 
 // =============================
-// METHOD 3: Direct altitude offset (instant)
+// Sources de QNH
 // =============================
-#if QNH_ADJUST_METHOD == 3
-static void updateQNH_method3(float newQNH) {
-  float startQNH = metar_data.qnh;
-
-  if (startQNH < 900.0f || startQNH > 1100.0f) {
-    startQNH = 1013.25f;
-  }
-
-  float deltaQNH = newQNH - startQNH;
-
-  if (fabs(deltaQNH) < 0.1f) {
-    if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-      metar_data.qnh = newQNH;
-      g_sensor_data.qnh_metar = newQNH;
-      xSemaphoreGive(metar_mutex);
-    }
-    kalman_set_qnh_ready(newQNH);
-    return;
+typedef struct {
+  float qnh;
+  char source[12];          // Station(s) METAR ou modele
+  int age_min;              // Age de l'observation, -1: inconnu
+  bool has_report;
+  metar_report_t report;    // Station METAR la plus proche
+} qnh_result_t;
+
+typedef struct {
+  const char *name;
+  bool (*fetch)(float lat, float lon, qnh_result_t *out);
+} qnh_provider_t;
+
+// METAR des aeroports dans un carre de 2 x QNH_METAR_SEARCH_KM
+static bool qnh_from_metar(float lat, float lon, qnh_result_t *out) {
+  static metar_stations_t stations;
+  float dlat = QNH_METAR_SEARCH_KM / 111.0f;
+  float dlon = dlat / cosf(lat * M_PI / 180.0f);
+  char path[128];
+  snprintf(path, sizeof(path), "/api/data/metar?bbox=%.3f,%.3f,%.3f,%.3f&format=json", lat - dlat, lon - dlon,
+           lat + dlat, lon + dlon);
+  metar_stations_init(&stations, lat, lon);
+  if (!qnh_http_request(QNH_METAR_HOST, path, metar_stations_cb, &stations)) return false;
+
+  // Heure UTC: en-tete Date du serveur, sinon GPS
+  bool has_now = qnh_http.has_date;
+  uint8_t day = qnh_http.date_day, hour = qnh_http.date_hour, minute = qnh_http.date_minute;
+  if (!has_now && g_sensor_data.gps.valid && g_sensor_data.gps.fix) {
+    has_now = true;
+    day = g_sensor_data.gps.day;
+    hour = g_sensor_data.gps.hour;
+    minute = g_sensor_data.gps.minute;
   }
 
+  metar_qnh_t q;
+  if (!metar_stations_qnh(&stations, has_now, day, hour, minute, &q)) {
 #ifdef DEBUG_MODE
-  Serial.printf("[QNH-M3] Direct offset: %.1f -> %.1f hPa (delta: %.1f hPa)\n",
-                startQNH, newQNH, deltaQNH);
-#endif
-
-  // Calculer offset d'altitude (approximation: ~8.3m par hPa à altitude moyenne)
-  float alt_offset = 8.3f * deltaQNH;
-
-#ifdef DEBUG_MODE
-  Serial.printf("[QNH-M3] Applying altitude offset: %.1f m\n", alt_offset);
+    Serial.printf("[QNH] No recent METAR (%u reports, %d with QNH in range)\n", stations.records, stations.count);
 #endif
-
-  // Appliquer l'offset directement au Kalman
-  kalman_apply_altitude_offset(alt_offset);
-
-  // Mettre à jour le QNH instantanément
-  if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-    metar_data.qnh = newQNH;
-    g_sensor_data.qnh_metar = newQNH;
-    xSemaphoreGive(metar_mutex);
+    return false;
   }
-  kalman_set_qnh_ready(newQNH);
-
+  out->qnh = q.qnh;
+  strlcpy(out->source, q.station, sizeof(out->source));
+  out->age_min = q.age_min;
+  out->has_report = true;
+  out->report = *q.nearest;
 #ifdef DEBUG_MODE
-  Serial.printf("[QNH-M3] QNH updated instantly to %.1f hPa\n", newQNH);
+  Serial.printf("[QNH] METAR %s: %.1f hPa, %.1f km, %d min old\n", q.station, q.qnh, q.distance_km, q.age_min);
 #endif
+  return true;
 }
-#endif
 
-// =============================
-// Fonction wrapper qui appelle la bonne méthode
-// =============================
-static void updateQNH_smooth(float newQNH) {
-#if QNH_ADJUST_METHOD == 1
-  updateQNH_method1(newQNH);
-#elif QNH_ADJUST_METHOD == 2
-  updateQNH_method2(newQNH);
-#elif QNH_ADJUST_METHOD == 3
-  updateQNH_method3(newQNH);
-#else
-#error "QNH_ADJUST_METHOD must be 1, 2, or 3"
-#endif
+// Modele Open-Meteo (pression reduite au niveau de la mer a la position)
+static bool qnh_from_openmeteo(float lat, float lon, qnh_result_t *out) {
+  qnh_openmeteo_t om = { 0, false };
+  char path[128];
+  snprintf(path, sizeof(path), "/v1/forecast?latitude=%.4f&longitude=%.4f&current=pressure_msl", lat, lon);
+  if (!qnh_http_request(QNH_OPENMETEO_HOST, path, qnh_openmeteo_cb, &om) || !om.found) return false;
+  out->qnh = om.qnh;
+  strlcpy(out->source, "OpenMeteo", sizeof(out->source));
+  out->age_min = -1;
+  out->has_report = false;
+  return true;
 }
 
-// =============================
-// Fonction utilitaire API Open-Meteo
-// =============================
-static bool fetch_qnh_openmeteo(float lat, float lon) {
-  if (!wifi_get_connected_status()) return false;
-
-  char url[256];
-  snprintf(url, sizeof(url),
-           "https://api.open-meteo.com/v1/forecast?latitude=%.6f&longitude=%.6f&current=pressure_msl",
-           lat, lon);
-
-#ifdef DEBUG_MODE
-  Serial.printf("[QNH] Fetching from Open-Meteo:\n%s\n", url);
-#endif
-
-  HTTPClient http;
-  http.begin(url);
-  http.setTimeout(10000);
-  int code = http.GET();
-
-  if (code != HTTP_CODE_OK) {
-#ifdef DEBUG_MODE
-    Serial.printf("[QNH] HTTP error: %d\n", code);
-#endif
-    http.end();
-    return false;
-  }
-
-  String payload = http.getString();
-  http.end();
-
-  DynamicJsonDocument doc(2048);
-  DeserializationError err = deserializeJson(doc, payload);
-
-  if (err) {
+// Par ordre de preference
+static const qnh_provider_t qnh_providers[] = {
+  { "METAR", qnh_from_metar },
+  { "OpenMeteo", qnh_from_openmeteo },
+};
+
+static bool fetch_qnh(float lat, float lon) {
+  qnh_result_t res;
+  memset(&res, 0, sizeof(res));
+  uint32_t age = 0;
+  bool cached = qnh_cache_get(&qnh_cache, lat, lon, millis(), QNH_CACHE_MAX_AGE_MS, &res.qnh, &age);
+
+  if (!cached) {
+    if (!wifi_get_connected_status()) return false;
+    bool ok = false;
+    for (size_t i = 0; i < sizeof(qnh_providers) / sizeof(qnh_providers[0]) && !ok && !qnh_stop_requested(); i++) {
+      uint32_t t0 = millis();
+      ok = qnh_providers[i].fetch(lat, lon, &res);
 #ifdef DEBUG_MODE
-    Serial.printf("[QNH] JSON error: %s\n", err.c_str());
+      Serial.printf("[QNH] %s %s in %lu ms\n", qnh_providers[i].name, ok ? "OK" : "failed",
+                    (unsigned long)(millis() - t0));
 #endif
-    return false;
-  }
-
-  if (!doc.containsKey("current") || !doc["current"].containsKey("pressure_msl")) {
+    }
+    if (!ok) return false;
+    qnh_cache_put(&qnh_cache, lat, lon, res.qnh, millis());
+  } else {
 #ifdef DEBUG_MODE
-    Serial.println("[QNH] Missing pressure_msl field");
+    Serial.printf("[QNH] Cached QNH = %.1f hPa (%lu s old)\n", res.qnh, (unsigned long)(age / 1000));
 #endif
-    return false;
   }
 
-  float qnh = doc["current"]["pressure_msl"];
-
-#ifdef DEBUG_MODE
-  Serial.printf("[QNH] Retrieved pressure_msl = %.1f hPa\n", qnh);
-#endif
-
-  // Sauvegarde du nom de station thread-safe
+  // Source et releve de la station thread-safe (cache: releve precedent conserve)
   if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
-    strcpy(metar_data.station, "OpenMeteo");
-    metar_data.timestamp = millis();
+    if (!cached) {
+      strlcpy(metar_data.station, res.source, sizeof(metar_data.station));
+      if (res.has_report) {
+        metar_data.temperature = res.report.temperature;
+        metar_data.dewpoint = res.report.dewpoint;
+        metar_data.wind_dir = res.report.wind_dir;
+        metar_data.wind_speed = res.report.wind_speed;
+        metar_data.visibility = res.report.visibility;
+        strlcpy(metar_data.conditions, res.report.conditions, sizeof(metar_data.conditions));
+      } else {
+        metar_data.conditions[0] = '\0';
+      }
+      metar_data.timestamp = millis() - (res.age_min > 0 ? res.age_min * 60000UL : 0);
+    }
+    metar_data.qnh = res.qnh;
+    g_sensor_data.qnh_metar = res.qnh;
     metar_data.valid = true;
     xSemaphoreGive(metar_mutex);
   }
 
-  // Appliquer la méthode d'ajustement sélectionnée
-  updateQNH_smooth(qnh);
+  // Nouvelle reference appliquee par la tache Kalman (sans attente)
+  kalman_set_qnh_ready(res.qnh);
 
   qnh_retrieved = true;
 
@@ -289,6 +243,22 @@ static float calculate_distance(float lat1, float lon1, float lat2, float lon2)
   return R * c;
 }
 
+// Resultat de la demande en cours remis a l'appelant (un seul appel par demande)
+static void qnh_notify(bool ok) {
+  qnh_done_cb_t cb = NULL;
+  void *user = NULL;
+  float qnh = 0.0f;
+  if (xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(100))) {
+    cb = qnh_done_cb;
+    user = qnh_done_user;
+    qnh_done_cb = NULL;
+    qnh_done_user = NULL;
+    qnh = metar_data.qnh;
+    xSemaphoreGive(metar_mutex);
+  }
+  if (cb) cb(ok, qnh, user);
+}
+
 static void metar_task(void* parameter) {
 #ifdef DEBUG_MODE
   Serial.println("[QNH] Task started");
@@ -363,6 +333,7 @@ static void metar_task(void* parameter) {
 #ifdef DEBUG_MODE
         Serial.println("[QNH] WiFi not available after 30s timeout");
 #endif
+        qnh_notify(false);
         continue;
       }
 
@@ -378,13 +349,16 @@ static void metar_task(void* parameter) {
 #ifdef DEBUG_MODE
         Serial.println("[QNH] Waiting for GPS fix...");
 #endif
+        qnh_notify(false);
         continue;
       }
       float lat = g_sensor_data.gps.latitude;
       float lon = g_sensor_data.gps.longitude;
 #endif
 
-      if (fetch_qnh_openmeteo(lat, lon)) {
+      bool ok = fetch_qnh(lat, lon);
+      qnh_notify(ok);
+      if (ok) {
         last_fetch = xTaskGetTickCount();
         last_qnh_lat = lat;
         last_qnh_lon = lon;
@@ -423,9 +397,28 @@ void metar_start(void) {
 #endif
 }
 
+// Demande non bloquante: rend la main tout de suite, la requete HTTPS est
+// faite par metar_task et cb (si non NULL) recoit le resultat depuis cette
+// tache. false si la tache n'est pas lancee ou si une autre demande avec
+// callback est en cours.
+bool metar_fetch_async(qnh_done_cb_t cb, void *user) {
+  if (!metar_event_group || !metar_mutex) return false;
+  if (cb) {
+    if (!xSemaphoreTake(metar_mutex, pdMS_TO_TICKS(50))) return false;
+    bool busy = qnh_done_cb != NULL;
+    if (!busy) {
+      qnh_done_cb = cb;
+      qnh_done_user = user;
+    }
+    xSemaphoreGive(metar_mutex);
+    if (busy) return false;
+  }
+  xEventGroupSetBits(metar_event_group, METAR_FETCH_BIT);
+  return true;
+}
+
 void metar_fetch(void) {
-  if (metar_event_group)
-    xEventGroupSetBits(metar_event_group, METAR_FETCH_BIT);
+  metar_fetch_async(NULL, NULL);
 }
 
 void metar_stop(void) {
@@ -6,6 +6,8 @@
 #include <math.h>
 #include "lvgl.h"
 #include "constants.h"
+#include "src/storage_service.h"
+#include "src/tile_coverage_store.h"
 
 // ===== SYSTEME DE CACHE MULTI-ZOOM ASYNCHRONE =====
 
@@ -193,6 +195,11 @@ static void tile_cache_task(void* parameter) {
                             continue;
                         }
                         
+                        // Tuile hors couverture: ni allocation ni acces carte
+                        if(tile_coverage_check(target_zoom, tile_x, tile_y) == TILE_COVERAGE_ABSENT) {
+                            continue;
+                        }
+                        
                         if(cached->data) {
                             heap_caps_free(cached->data);
                             cached->data = NULL;
@@ -221,36 +228,10 @@ static void tile_cache_task(void* parameter) {
                         snprintf(tile_path, sizeof(tile_path), "%s/%s/%d/%d/%d.bin", 
                                OSM_TILES_DIR, OSM_SERVER_NAME, target_zoom, tile_x, tile_y);
                         
-                        bool loaded = false;
-                        if(SD_MMC.exists(tile_path)) {
-                            File tile_file = SD_MMC.open(tile_path, FILE_READ);
-                            if(tile_file) {
-                                size_t expected = OSM_TILE_SIZE * OSM_TILE_SIZE * 2;
-                                if(tile_file.size() == expected) {
-                                    // Lecture par chunks avec pauses
-                                    const size_t chunk_size = 8192;
-                                    size_t bytes_read = 0;
-                                    loaded = true;
-                                    
-                                    while(bytes_read < expected) {
-                                        size_t to_read = min(chunk_size, expected - bytes_read);
-                                        size_t chunk_bytes = tile_file.read(
-                                            ((uint8_t*)tile_data) + bytes_read, 
-                                            to_read
-                                        );
-                                        
-                                        if(chunk_bytes != to_read) {
-                                            loaded = false;
-                                            break;
-                                        }
-                                        
-                                        bytes_read += chunk_bytes;
-                                        vTaskDelay(pdMS_TO_TICKS(12));
-                                    }
-                                }
-                                tile_file.close();
-                            }
-                        }
+                        // Prechargement: cede la carte au journal, au terrain et aux tuiles visibles
+                        bool loaded = storage_read(tile_path, 0, tile_data,
+                                                   OSM_TILE_SIZE * OSM_TILE_SIZE * 2,
+                                                   STORAGE_PRIO_TILE_PREFETCH);
                         
                         if(xSemaphoreTake(cache_mutex, pdMS_TO_TICKS(50)) == pdTRUE) {
                             if(loaded) {
@@ -337,56 +318,44 @@ static bool load_single_tile(int zoom, int tile_x, int tile_y, uint16_t* buffer)
         return true;
     }
     
+    if(tile_coverage_check(zoom, tile_x, tile_y) == TILE_COVERAGE_ABSENT) {
+        return false;
+    }
+    
     char tile_path[128];
     snprintf(tile_path, sizeof(tile_path), "%s/%s/%d/%d/%d.bin", 
              OSM_TILES_DIR, OSM_SERVER_NAME, zoom, tile_x, tile_y);
     
-    if(!SD_MMC.exists(tile_path)) {
+    if(!storage_read(tile_path, 0, buffer, OSM_TILE_SIZE * OSM_TILE_SIZE * 2, STORAGE_PRIO_TILE_VISIBLE)) {
 #ifdef DEBUG_MODE
         Serial.printf("[OSM] Tile not found: %s\n", tile_path);
 #endif
         return false;
     }
     
-    File tile_file = SD_MMC.open(tile_path, FILE_READ);
-    if(!tile_file) {
-        return false;
-    }
-    
-    size_t expected_size = OSM_TILE_SIZE * OSM_TILE_SIZE * 2;
-    if(tile_file.size() != expected_size) {
-        tile_file.close();
-        return false;
-    }
-    
-    size_t bytes_read = tile_file.read((uint8_t*)buffer, expected_size);
-    tile_file.close();
-    
-    if(bytes_read != expected_size) {
-        return false;
-    }
-    
     return true;
 }
 
 // ===== CREATION DE LA VUE CARTE =====
 
+// Agrandissement des tuiles a l'affichage (x2, x3 au-dela du zoom max des tuiles)
+static int map_view_scale(int zoom, int* actual_zoom) {
+    if(zoom > MAP_ZOOM_MAX) {
+        *actual_zoom = MAP_ZOOM_MAX;
+        return 3;
+    }
+    *actual_zoom = zoom;
+    return 2;
+}
+
 static lv_obj_t* create_map_view(lv_obj_t* parent, double lat, double lon, int zoom,
                                  int view_width, int view_height) {
 #ifdef DEBUG_MODE
     unsigned long start_time = millis();
 #endif
     
-    int upscale_factor = 2;
-    int actual_zoom = zoom;
-    
-    if(zoom > MAP_ZOOM_MAX) {
-        upscale_factor = 3;
-        actual_zoom = MAP_ZOOM_MAX;
-#ifdef DEBUG_MODE
-        Serial.println("[OSM] Super zoom x3 mode activated");
-#endif
-    }
+    int actual_zoom;
+    int upscale_factor = map_view_scale(zoom, &actual_zoom);
     
 #ifdef DEBUG_MODE
     Serial.printf("[OSM] Creating map view: %dx%d at zoom %d (actual: %d, scale: %dx)\n", 
@@ -33,6 +33,10 @@ static inline const char* psram_str_get(const char* str) {
   return str ? str : "";
 }
 
+// Chaines du blob de parametres en PSRAM
+#define PARAMS_BLOB_STR_SET(dest, src) psram_str_set(dest, src)
+#include "src/params/params_blob.h"
+
 // Structure pour tous les parametres du vario
 typedef struct {
   // Parametres pilote - alloues en PSRAM
@@ -91,6 +95,9 @@ static inline void params_reset_to_defaults(void) {
   psram_str_set(&params.pilot_firstname, "");
   psram_str_set(&params.pilot_wing, "");
   psram_str_set(&params.pilot_phone, "");
+  psram_str_set(&params.ice_name, "");
+  psram_str_set(&params.ice_firstname, "");
+  psram_str_set(&params.ice_phone, "");
 
   for (int i = 0; i < 4; i++) {
     psram_str_set(&params.wifi_ssid[i], "");
@@ -121,176 +128,317 @@ static inline void params_reset_to_defaults(void) {
 }
 
 // ============================================================================
-// INIT
+// SCHEMA DU BLOB
 // ============================================================================
 
-static inline void params_init(void) {
-#ifdef DEBUG_MODE
-  Serial.println("Initializing params...");
-#endif
-
-  // Initialiser les pointeurs a NULL
-  params.pilot_name = nullptr;
-  params.pilot_firstname = nullptr;
-  params.pilot_wing = nullptr;
-  params.pilot_phone = nullptr;
-  params.ice_name = nullptr;
-  params.ice_firstname = nullptr;
-  params.ice_phone = nullptr;
-  for (int i = 0; i < 4; i++) {
-    params.wifi_ssid[i] = nullptr;
-    params.wifi_password[i] = nullptr;
-  }
+// Une seule entree NVS pour tous les parametres. Ajouter un champ: l'ajouter a
+// la fin de la table avec since = nouvelle version et incrementer
+// PARAMS_BLOB_VERSION. Retirer un champ: until = nouvelle version et offset
+// PARAMS_BLOB_NO_OFFSET. Les conversions de valeurs vont dans params_migrate().
+#define PARAMS_NVS_NAMESPACE "vario"
+#define PARAMS_BLOB_KEY "params"
+#define PARAMS_BLOB_BACKUP_KEY "params_bad"  // Dernier blob illisible, garde pour analyse
+#define PARAMS_BLOB_VERSION 1
+
+static_assert(sizeof(int) == 4 && sizeof(Language) == 4, "Champs I32 du blob");
+
+#define PARAMS_FIELD(type, member) \
+  { PARAMS_FIELD_##type, 1, 0, offsetof(VarioParams, member) }
+
+static const params_field_t params_fields[] = {
+  // Pilote
+  PARAMS_FIELD(STR, pilot_name),
+  PARAMS_FIELD(STR, pilot_firstname),
+  PARAMS_FIELD(STR, pilot_wing),
+  PARAMS_FIELD(STR, pilot_phone),
+  // ICE
+  PARAMS_FIELD(STR, ice_name),
+  PARAMS_FIELD(STR, ice_firstname),
+  PARAMS_FIELD(STR, ice_phone),
+  // WiFi
+  PARAMS_FIELD(STR, wifi_ssid[0]),
+  PARAMS_FIELD(STR, wifi_password[0]),
+  PARAMS_FIELD(STR, wifi_ssid[1]),
+  PARAMS_FIELD(STR, wifi_password[1]),
+  PARAMS_FIELD(STR, wifi_ssid[2]),
+  PARAMS_FIELD(STR, wifi_password[2]),
+  PARAMS_FIELD(STR, wifi_ssid[3]),
+  PARAMS_FIELD(STR, wifi_password[3]),
+  // Vario
+  PARAMS_FIELD(I32, vario_integration_period),
+  PARAMS_FIELD(U16, vario_audio_frequencies[0]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[1]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[2]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[3]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[4]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[5]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[6]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[7]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[8]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[9]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[10]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[11]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[12]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[13]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[14]),
+  PARAMS_FIELD(U16, vario_audio_frequencies[15]),
+  // Carte
+  PARAMS_FIELD(I32, map_zoom),
+  PARAMS_FIELD(I32, map_tile_server),
+  PARAMS_FIELD(I32, map_track_points),
+  PARAMS_FIELD(BOOL, map_vario_colors),
+  // Systeme
+  PARAMS_FIELD(I32, system_brightness),
+  PARAMS_FIELD(I32, system_language),
+  // Calibration
+  PARAMS_FIELD(F32, touch_offset_x),
+  PARAMS_FIELD(F32, touch_offset_y),
+  PARAMS_FIELD(F32, touch_scale_x),
+  PARAMS_FIELD(F32, touch_scale_y),
+};
 
-  prefs.begin("vario", false);
+// Corrections de valeurs apres lecture d'un blob plus ancien
+static void params_migrate(void *obj, uint16_t from_version) {
+  (void)obj;
+  (void)from_version;
+}
 
-  // Pilote - Charger depuis preferences en PSRAM
-  String temp = prefs.getString("pilot_name", "");
-  psram_str_set(&params.pilot_name, temp.c_str());
+static const params_schema_t params_schema = {
+  params_fields,
+  sizeof(params_fields) / sizeof(params_fields[0]),
+  PARAMS_BLOB_VERSION,
+  params_migrate
+};
 
-  temp = prefs.getString("pilot_fname", "");
-  psram_str_set(&params.pilot_firstname, temp.c_str());
+static uint32_t params_saved_crc = 0;  // CRC du dernier blob en NVS
 
-  temp = prefs.getString("pilot_wing", "");
-  psram_str_set(&params.pilot_wing, temp.c_str());
+// ============================================================================
+// ANCIEN FORMAT (une cle NVS par valeur)
+// ============================================================================
 
-  temp = prefs.getString("pilot_phone", "");
-  psram_str_set(&params.pilot_phone, temp.c_str());
+static void params_load_legacy_string(const char* key, char** dest) {
+  char buf[PARAMS_BLOB_STR_MAX + 1];
+  buf[0] = '\0';
+  if (prefs.isKey(key)) prefs.getString(key, buf, sizeof(buf));
+  psram_str_set(dest, buf);
+}
 
-  // ICE - Charger depuis preferences en PSRAM
-  temp = prefs.getString("ice_name", "");
-  psram_str_set(&params.ice_name, temp.c_str());
+// Lecture unique au premier demarrage apres mise a jour
+static void params_load_legacy(void) {
+  char key[16];
 
-  temp = prefs.getString("ice_fname", "");
-  psram_str_set(&params.ice_firstname, temp.c_str());
+  params_load_legacy_string("pilot_name", &params.pilot_name);
+  params_load_legacy_string("pilot_fname", &params.pilot_firstname);
+  params_load_legacy_string("pilot_wing", &params.pilot_wing);
+  params_load_legacy_string("pilot_phone", &params.pilot_phone);
 
-  temp = prefs.getString("ice_phone", "");
-  psram_str_set(&params.ice_phone, temp.c_str());
+  params_load_legacy_string("ice_name", &params.ice_name);
+  params_load_legacy_string("ice_fname", &params.ice_firstname);
+  params_load_legacy_string("ice_phone", &params.ice_phone);
 
-  // WiFi
   for (int i = 0; i < 4; i++) {
-    String ssid_key = "wifi_ssid" + String(i);
-    String pass_key = "wifi_pass" + String(i);
-
-    temp = prefs.getString(ssid_key.c_str(), "");
-    psram_str_set(&params.wifi_ssid[i], temp.c_str());
+    snprintf(key, sizeof(key), "wifi_ssid%d", i);
+    params_load_legacy_string(key, &params.wifi_ssid[i]);
+    snprintf(key, sizeof(key), "wifi_pass%d", i);
+    params_load_legacy_string(key, &params.wifi_password[i]);
+  }
 
-    temp = prefs.getString(pass_key.c_str(), "");
-    psram_str_set(&params.wifi_password[i], temp.c_str());
+  params.vario_integration_period = prefs.getInt("vario_int", params.vario_integration_period);
+  for (int i = 0; i < 16; i++) {
+    snprintf(key, sizeof(key), "vario_freq%d", i);
+    params.vario_audio_frequencies[i] = prefs.getUShort(key, params.vario_audio_frequencies[i]);
   }
 
-  // Vario
-  params.vario_integration_period = prefs.getInt("vario_int", 5);
+  params.map_zoom = prefs.getInt("map_zoom", params.map_zoom);
+  params.map_tile_server = prefs.getInt("map_tile_srv", params.map_tile_server);
+  params.map_track_points = prefs.getInt("map_track_pts", params.map_track_points);
+  params.map_vario_colors = prefs.getBool("map_vario_col", params.map_vario_colors);
+
+  params.system_brightness = prefs.getInt("sys_bright", params.system_brightness);
+  params.system_language = (Language)prefs.getInt("sys_lang", params.system_language);
+
+  params.touch_offset_x = prefs.getFloat("touch_off_x", params.touch_offset_x);
+  params.touch_offset_y = prefs.getFloat("touch_off_y", params.touch_offset_y);
+  params.touch_scale_x = prefs.getFloat("touch_scl_x", params.touch_scale_x);
+  params.touch_scale_y = prefs.getFloat("touch_scl_y", params.touch_scale_y);
+}
 
+// Cles de l'ancien format (hors tableaux indexes)
+static const char* const params_legacy_keys[] = {
+  "pilot_name", "pilot_fname", "pilot_wing", "pilot_phone", "ice_name", "ice_fname", "ice_phone",
+  "vario_int", "map_zoom", "map_tile_srv", "map_track_pts", "map_vario_col", "sys_bright", "sys_lang",
+  "touch_off_x", "touch_off_y", "touch_scl_x", "touch_scl_y"
+};
+
+// Suppression cle par cle, le blob reste en place meme si elle est interrompue
+static void params_remove_legacy(void) {
+  char key[16];
+  for (size_t i = 0; i < sizeof(params_legacy_keys) / sizeof(params_legacy_keys[0]); i++) {
+    if (prefs.isKey(params_legacy_keys[i])) prefs.remove(params_legacy_keys[i]);
+  }
+  for (int i = 0; i < 4; i++) {
+    snprintf(key, sizeof(key), "wifi_ssid%d", i);
+    if (prefs.isKey(key)) prefs.remove(key);
+    snprintf(key, sizeof(key), "wifi_pass%d", i);
+    if (prefs.isKey(key)) prefs.remove(key);
+  }
   for (int i = 0; i < 16; i++) {
-    String key = "vario_freq" + String(i);
-    params.vario_audio_frequencies[i] = prefs.getUShort(key.c_str(),
-                                                        pgm_read_word(&default_audio_frequencies[i]));
+    snprintf(key, sizeof(key), "vario_freq%d", i);
+    if (prefs.isKey(key)) prefs.remove(key);
   }
+}
 
-  // Carte
-  params.map_zoom = prefs.getInt("map_zoom", 13);
-  params.map_tile_server = prefs.getInt("map_tile_srv", 0);
-  params.map_track_points = prefs.getInt("map_track_pts", 200);
-  params.map_vario_colors = prefs.getBool("map_vario_col", true);
-
-  // Systeme
-  params.system_brightness = prefs.getInt("sys_bright", 80);
-  params.system_language = (Language)prefs.getInt("sys_lang", LANG_FR);
+// ============================================================================
+// ECRITURE
+// ============================================================================
 
-  // Calibration
-  params.touch_offset_x = prefs.getFloat("touch_off_x", 0.0f);
-  params.touch_offset_y = prefs.getFloat("touch_off_y", 0.0f);
-  params.touch_scale_x = prefs.getFloat("touch_scl_x", 1.0f);
-  params.touch_scale_y = prefs.getFloat("touch_scl_y", 1.0f);
+// Ecrit le blob si son contenu differe de la NVS (CRC); une seule ecriture
+// NVS, atomique (l'ancienne entree n'est effacee qu'une fois la nouvelle ecrite).
+// Le blob est toujours ecrit en entier: pas de suivi par groupe de parametres.
+static bool params_commit(bool force) {
+  size_t size = params_blob_size(&params_schema, &params);
+  uint8_t* buf = (uint8_t*)malloc(size);
+  if (!buf) return false;
+  params_blob_write(&params_schema, &params, buf, size);
+
+  // Meme contenu que la NVS: rien a ecrire
+  uint32_t crc = params_blob_get32(buf + size - 4);
+  bool changed = force || crc != params_saved_crc;
+  bool ok = true;
+  if (changed) {
+    ok = prefs.putBytes(PARAMS_BLOB_KEY, buf, size) == size;
+    if (ok) params_saved_crc = crc;
+  }
+  free(buf);
 
 #ifdef DEBUG_MODE
-  Serial.println("Params initialized");
-  Serial.printf("Free PSRAM after params init: %u\n", ESP.getFreePsram());
+  Serial.printf("Params saved (%u bytes): %s\n", (unsigned)size, !changed ? "unchanged" : ok ? "OK" : "FAILED");
 #endif
+  return ok;
+}
+
+// Relecture du blob ecrit: entete, CRC et meme contenu que la derniere ecriture
+static bool params_verify_saved(void) {
+  size_t size = prefs.getBytesLength(PARAMS_BLOB_KEY);
+  uint8_t* buf = size ? (uint8_t*)malloc(size) : NULL;
+  if (!buf) return false;
+  uint16_t version = 0;
+  bool ok = prefs.getBytes(PARAMS_BLOB_KEY, buf, size) == size &&
+            params_blob_check(&params_schema, buf, size, &version) == PARAMS_BLOB_OK &&
+            params_blob_get32(buf + size - 4) == params_saved_crc;
+  free(buf);
+  return ok;
 }
 
 // ============================================================================
-// SAVE
+// INIT
 // ============================================================================
 
-static inline void params_save_pilot(void) {
-  prefs.putString("pilot_name", psram_str_get(params.pilot_name));
-  prefs.putString("pilot_fname", psram_str_get(params.pilot_firstname));
-  prefs.putString("pilot_wing", psram_str_get(params.pilot_wing));
-  prefs.putString("pilot_phone", psram_str_get(params.pilot_phone));
-
+static inline void params_init(void) {
 #ifdef DEBUG_MODE
-  Serial.println("Pilot params saved");
+  Serial.println("Initializing params...");
 #endif
-}
 
-static inline void params_save_wifi(void) {
+  // Initialiser les pointeurs a NULL
+  params.pilot_name = nullptr;
+  params.pilot_firstname = nullptr;
+  params.pilot_wing = nullptr;
+  params.pilot_phone = nullptr;
+  params.ice_name = nullptr;
+  params.ice_firstname = nullptr;
+  params.ice_phone = nullptr;
   for (int i = 0; i < 4; i++) {
-    String ssid_key = "wifi_ssid" + String(i);
-    String pass_key = "wifi_pass" + String(i);
-    prefs.putString(ssid_key.c_str(), psram_str_get(params.wifi_ssid[i]));
-    prefs.putString(pass_key.c_str(), psram_str_get(params.wifi_password[i]));
+    params.wifi_ssid[i] = nullptr;
+    params.wifi_password[i] = nullptr;
+  }
+  params_reset_to_defaults();
+
+  prefs.begin(PARAMS_NVS_NAMESPACE, false);
+
+  params_blob_result_t r = PARAMS_BLOB_BAD_HEADER;
+  size_t size = prefs.getBytesLength(PARAMS_BLOB_KEY);
+  uint8_t* buf = size ? (uint8_t*)malloc(size) : NULL;
+  if (buf) {
+    if (prefs.getBytes(PARAMS_BLOB_KEY, buf, size) == size) {
+      r = params_blob_read(&params_schema, &params, buf, size);
+      if (r == PARAMS_BLOB_OK) params_saved_crc = params_blob_get32(buf + size - 4);
+    }
   }
 
+  if (r == PARAMS_BLOB_MIGRATED) {
+    params_commit(true);
+  } else if (r == PARAMS_BLOB_TOO_NEW) {
+    // Firmware plus ancien que le blob: valeurs par defaut, blob conserve
+    // jusqu'a la prochaine sauvegarde
+    params_reset_to_defaults();
+  } else if (size == 0) {
+    // Pas de blob: premier demarrage apres mise a jour, repartir des cles de
+    // l'ancien format (ou des valeurs par defaut). Les anciennes cles ne sont
+    // supprimees qu'une fois le blob ecrit et relu: une coupure entre les deux
+    // refait simplement la migration au demarrage suivant
+    params_reset_to_defaults();
+    params_load_legacy();
+    if (params_commit(true) && params_verify_saved()) {
+      params_remove_legacy();
+    }
 #ifdef DEBUG_MODE
-  Serial.println("WiFi params saved");
+    else {
+      Serial.println("Params blob not verified, legacy keys kept");
+    }
 #endif
-}
-
-static inline void params_save_vario(void) {
-  prefs.putInt("vario_int", params.vario_integration_period);
-
-  for (int i = 0; i < 16; i++) {
-    String key = "vario_freq" + String(i);
-    prefs.putUShort(key.c_str(), params.vario_audio_frequencies[i]);
+  } else if (!buf) {
+    // Pas de memoire pour le lire: valeurs par defaut, blob intact
+    params_reset_to_defaults();
+  } else if (r != PARAMS_BLOB_OK) {
+    // Blob present mais illisible (CRC, tronque): valeurs par defaut, copie
+    // brute gardee sous PARAMS_BLOB_BACKUP_KEY, pas d'effacement du namespace
+#ifdef DEBUG_MODE
+    Serial.printf("Params blob unreadable (%u bytes), defaults restored, backup in '%s'\n",
+                  (unsigned)size, PARAMS_BLOB_BACKUP_KEY);
+#endif
+    prefs.putBytes(PARAMS_BLOB_BACKUP_KEY, buf, size);
+    params_reset_to_defaults();
+    params_commit(true);
   }
+  free(buf);
 
 #ifdef DEBUG_MODE
-  Serial.println("Vario params saved");
+  static const char* const results[] = { "OK", "migrated", "bad header", "bad CRC", "truncated", "too new" };
+  Serial.printf("Params initialized (blob v%d: %s)\n", PARAMS_BLOB_VERSION, results[r]);
+  Serial.printf("Free PSRAM after params init: %u\n", ESP.getFreePsram());
 #endif
 }
 
-static inline void params_save_map(void) {
-  prefs.putInt("map_zoom", params.map_zoom);
-  prefs.putInt("map_tile_srv", params.map_tile_server);
-  prefs.putInt("map_track_pts", params.map_track_points);
-  prefs.putBool("map_vario_col", params.map_vario_colors);
+// ============================================================================
+// SAVE
+// ============================================================================
 
-#ifdef DEBUG_MODE
-  Serial.println("Map params saved");
-#endif
+static inline void params_save_pilot(void) {
+  params_commit(false);
 }
 
-static inline void params_save_system(void) {
-  prefs.putInt("sys_bright", params.system_brightness);
-  prefs.putInt("sys_lang", (int)params.system_language);
+static inline void params_save_wifi(void) {
+  params_commit(false);
+}
 
-#ifdef DEBUG_MODE
-  Serial.println("System params saved");
-#endif
+static inline void params_save_vario(void) {
+  params_commit(false);
 }
 
-static inline void params_save_calibration(void) {
-  prefs.putFloat("touch_off_x", params.touch_offset_x);
-  prefs.putFloat("touch_off_y", params.touch_offset_y);
-  prefs.putFloat("touch_scl_x", params.touch_scale_x);
-  prefs.putFloat("touch_scl_y", params.touch_scale_y);
+static inline void params_save_map(void) {
+  params_commit(false);
+}
 
-#ifdef DEBUG_MODE
-  Serial.println("Calibration params saved");
-#endif
+static inline void params_save_system(void) {
+  params_commit(false);
 }
 
-// Ajouter cette nouvelle fonction de sauvegarde:
-static inline void params_save_ice(void) {
-  prefs.putString("ice_name", psram_str_get(params.ice_name));
-  prefs.putString("ice_fname", psram_str_get(params.ice_firstname));
-  prefs.putString("ice_phone", psram_str_get(params.ice_phone));
+static inline void params_save_calibration(void) {
+  params_commit(false);
+}
 
-#ifdef DEBUG_MODE
-  Serial.println("ICE params saved");
-#endif
+static inline void params_save_ice(void) {
+  params_commit(false);
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,256 @@
+#ifndef PARAMS_BLOB_H
+#define PARAMS_BLOB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Blob binaire versionne des parametres: une seule entree NVS au lieu d'une
+// cle par valeur. Le contenu est decrit par une table de champs (type, offset
+// dans la structure, version d'apparition/de retrait), ce qui donne la
+// migration: un blob ancien est relu champ par champ selon sa version, les
+// champs apparus depuis gardent leur valeur par defaut, les champs retires
+// sont lus puis ignores, et un hook de migration corrige le reste.
+// Calcul pur sans Arduino ni ESP-IDF: se compile sur PC.
+//
+// Format (petit-boutiste):
+//   "VPRM" | version u16 | nb champs u16 | taille donnees u32
+//   donnees: champs de la table presents dans cette version, dans l'ordre
+//     U8/BOOL: 1 octet, U16: 2, I32/F32: 4, STR: longueur u16 + octets (sans 0)
+//   CRC-32 (zlib) de tout ce qui precede, u32
+// =============================================================================
+
+#ifndef PARAMS_BLOB_STR_SET
+// Remplace la chaine *dest par src (terminee par 0)
+#define PARAMS_BLOB_STR_SET(dest, src) \
+  do { \
+    free(*(dest)); \
+    *(dest) = (src)[0] ? strdup(src) : NULL; \
+  } while (0)
+#endif
+
+#define PARAMS_BLOB_MAGIC "VPRM"
+#define PARAMS_BLOB_HEADER_SIZE 12
+#define PARAMS_BLOB_STR_MAX 127        // Chaines tronquees au-dela
+#define PARAMS_BLOB_NO_OFFSET ((size_t)-1)  // Champ retire: lu puis ignore
+
+typedef enum {
+  PARAMS_FIELD_U8 = 0,
+  PARAMS_FIELD_BOOL,
+  PARAMS_FIELD_U16,
+  PARAMS_FIELD_I32,
+  PARAMS_FIELD_F32,
+  PARAMS_FIELD_STR     // char* dans la structure
+} params_field_type_t;
+
+typedef struct {
+  uint8_t type;        // params_field_type_t
+  uint16_t since;      // Version du blob ou le champ apparait
+  uint16_t until;      // Version ou il est retire (0: toujours present)
+  size_t offset;       // offsetof() dans la structure, PARAMS_BLOB_NO_OFFSET si retire
+} params_field_t;
+
+typedef struct {
+  const params_field_t *fields;
+  size_t count;
+  uint16_t version;    // Version courante ecrite
+  // Corrections apres lecture d'un blob plus ancien (peut etre NULL)
+  void (*migrate)(void *obj, uint16_t from_version);
+} params_schema_t;
+
+typedef enum {
+  PARAMS_BLOB_OK = 0,
+  PARAMS_BLOB_MIGRATED,     // Blob ancien relu et converti: a reecrire
+  PARAMS_BLOB_BAD_HEADER,
+  PARAMS_BLOB_BAD_CRC,
+  PARAMS_BLOB_TRUNCATED,
+  PARAMS_BLOB_TOO_NEW       // Ecrit par un firmware plus recent
+} params_blob_result_t;
+
+// ============================================================================
+// Primitives
+// ============================================================================
+
+static uint32_t params_blob_crc32(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+  }
+  return ~crc;
+}
+
+static inline void params_blob_put16(uint8_t *p, uint16_t v) {
+  p[0] = v; p[1] = v >> 8;
+}
+
+static inline void params_blob_put32(uint8_t *p, uint32_t v) {
+  p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static inline uint16_t params_blob_get16(const uint8_t *p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t params_blob_get32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline bool params_field_in_version(const params_field_t *f, uint16_t version) {
+  return version >= f->since && (f->until == 0 || version < f->until);
+}
+
+static inline size_t params_field_str_len(const char *s) {
+  size_t n = s ? strlen(s) : 0;
+  return n > PARAMS_BLOB_STR_MAX ? PARAMS_BLOB_STR_MAX : n;
+}
+
+static size_t params_field_size(const params_field_t *f, const void *obj) {
+  switch (f->type) {
+    case PARAMS_FIELD_U8:
+    case PARAMS_FIELD_BOOL: return 1;
+    case PARAMS_FIELD_U16: return 2;
+    case PARAMS_FIELD_I32:
+    case PARAMS_FIELD_F32: return 4;
+    case PARAMS_FIELD_STR: return 2 + params_field_str_len(*(char *const *)((const uint8_t *)obj + f->offset));
+  }
+  return 0;
+}
+
+// ============================================================================
+// Ecriture
+// ============================================================================
+
+static size_t params_blob_size(const params_schema_t *s, const void *obj) {
+  size_t n = PARAMS_BLOB_HEADER_SIZE + 4;
+  for (size_t i = 0; i < s->count; i++) {
+    if (params_field_in_version(&s->fields[i], s->version)) n += params_field_size(&s->fields[i], obj);
+  }
+  return n;
+}
+
+// out doit faire params_blob_size() octets; retourne la taille ecrite
+static size_t params_blob_write(const params_schema_t *s, const void *obj, uint8_t *out, size_t cap) {
+  size_t size = params_blob_size(s, obj);
+  if (cap < size) return 0;
+
+  const uint8_t *src = (const uint8_t *)obj;
+  uint8_t *p = out + PARAMS_BLOB_HEADER_SIZE;
+  uint16_t n_fields = 0;
+  for (size_t i = 0; i < s->count; i++) {
+    const params_field_t *f = &s->fields[i];
+    if (!params_field_in_version(f, s->version)) continue;
+    const uint8_t *v = src + f->offset;
+    switch (f->type) {
+      case PARAMS_FIELD_U8: *p++ = *v; break;
+      case PARAMS_FIELD_BOOL: *p++ = *(const bool *)v ? 1 : 0; break;
+      case PARAMS_FIELD_U16: params_blob_put16(p, *(const uint16_t *)v); p += 2; break;
+      case PARAMS_FIELD_I32: params_blob_put32(p, (uint32_t) * (const int32_t *)v); p += 4; break;
+      case PARAMS_FIELD_F32: {
+        uint32_t bits;
+        memcpy(&bits, v, 4);
+        params_blob_put32(p, bits);
+        p += 4;
+        break;
+      }
+      case PARAMS_FIELD_STR: {
+        const char *str = *(char *const *)v;
+        size_t len = params_field_str_len(str);
+        params_blob_put16(p, (uint16_t)len);
+        if (len) memcpy(p + 2, str, len);
+        p += 2 + len;
+        break;
+      }
+    }
+    n_fields++;
+  }
+
+  memcpy(out, PARAMS_BLOB_MAGIC, 4);
+  params_blob_put16(out + 4, s->version);
+  params_blob_put16(out + 6, n_fields);
+  params_blob_put32(out + 8, (uint32_t)(p - out - PARAMS_BLOB_HEADER_SIZE));
+  params_blob_put32(p, params_blob_crc32(0, out, p - out));
+  return size;
+}
+
+// ============================================================================
+// Lecture
+// ============================================================================
+
+// Verification seule (entete + CRC), version du blob dans *version
+static params_blob_result_t params_blob_check(const params_schema_t *s, const uint8_t *data, size_t len,
+                                              uint16_t *version) {
+  if (len < PARAMS_BLOB_HEADER_SIZE + 4 || memcmp(data, PARAMS_BLOB_MAGIC, 4) != 0) return PARAMS_BLOB_BAD_HEADER;
+  uint32_t body = params_blob_get32(data + 8);
+  if ((size_t)body != len - PARAMS_BLOB_HEADER_SIZE - 4) return PARAMS_BLOB_TRUNCATED;
+  if (params_blob_crc32(0, data, len - 4) != params_blob_get32(data + len - 4)) return PARAMS_BLOB_BAD_CRC;
+  *version = params_blob_get16(data + 4);
+  if (*version == 0) return PARAMS_BLOB_BAD_HEADER;  // Jamais ecrite: blob abime
+  if (*version > s->version) return PARAMS_BLOB_TOO_NEW;
+  return PARAMS_BLOB_OK;
+}
+
+// obj doit deja contenir les valeurs par defaut: seuls les champs presents dans
+// le blob sont remplaces. En cas d'erreur obj peut etre partiellement modifie.
+static params_blob_result_t params_blob_read(const params_schema_t *s, void *obj, const uint8_t *data, size_t len) {
+  uint16_t version = 0;
+  params_blob_result_t r = params_blob_check(s, data, len, &version);
+  if (r != PARAMS_BLOB_OK) return r;
+
+  uint8_t *dst = (uint8_t *)obj;
+  const uint8_t *p = data + PARAMS_BLOB_HEADER_SIZE;
+  const uint8_t *end = data + len - 4;
+  uint16_t n_fields = 0;
+  for (size_t i = 0; i < s->count; i++) {
+    const params_field_t *f = &s->fields[i];
+    if (!params_field_in_version(f, version)) continue;
+    bool keep = f->offset != PARAMS_BLOB_NO_OFFSET;
+    uint8_t *v = keep ? dst + f->offset : NULL;
+    switch (f->type) {
+      case PARAMS_FIELD_U8:
+      case PARAMS_FIELD_BOOL:
+        if (end - p < 1) return PARAMS_BLOB_TRUNCATED;
+        if (keep && f->type == PARAMS_FIELD_U8) *v = *p;
+        if (keep && f->type == PARAMS_FIELD_BOOL) *(bool *)v = *p != 0;
+        p += 1;
+        break;
+      case PARAMS_FIELD_U16:
+        if (end - p < 2) return PARAMS_BLOB_TRUNCATED;
+        if (keep) *(uint16_t *)v = params_blob_get16(p);
+        p += 2;
+        break;
+      case PARAMS_FIELD_I32:
+      case PARAMS_FIELD_F32: {
+        if (end - p < 4) return PARAMS_BLOB_TRUNCATED;
+        uint32_t bits = params_blob_get32(p);
+        if (keep) memcpy(v, &bits, 4);
+        p += 4;
+        break;
+      }
+      case PARAMS_FIELD_STR: {
+        if (end - p < 2) return PARAMS_BLOB_TRUNCATED;
+        size_t n = params_blob_get16(p);
+        if (n > PARAMS_BLOB_STR_MAX || (size_t)(end - p - 2) < n) return PARAMS_BLOB_TRUNCATED;
+        if (keep) {
+          char tmp[PARAMS_BLOB_STR_MAX + 1];
+          memcpy(tmp, p + 2, n);
+          tmp[n] = '\0';
+          PARAMS_BLOB_STR_SET((char **)v, tmp);
+        }
+        p += 2 + n;
+        break;
+      }
+    }
+    n_fields++;
+  }
+  if (p != end || n_fields != params_blob_get16(data + 6)) return PARAMS_BLOB_TRUNCATED;
+
+  if (version == s->version) return PARAMS_BLOB_OK;
+  if (s->migrate) s->migrate(obj, version);
+  return PARAMS_BLOB_MIGRATED;
+}
+
+#endif
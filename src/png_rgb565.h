@@ -0,0 +1,590 @@
+#ifndef PNG_RGB565_H
+#define PNG_RGB565_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Decodeur PNG -> RGB565 en flux pour les tuiles telechargees.
+// Les octets sont tires de la source (read) au fil du decodage, le flux zlib
+// est decompresse dans une fenetre de 32 Ko et chaque ligne complete est
+// defiltree puis convertie directement dans l'image de sortie. Aucune
+// allocation: tout l'etat tient dans png_rgb565_t (taille fixe, bornee par
+// PNG_RGB565_WORK_MAX), place ou l'appelant le souhaite.
+// Formats: gris, RGB, palette, gris+alpha, RGBA; profondeurs 1 a 16 bits;
+// largeur <= PNG_RGB565_MAX_WIDTH; pas d'entrelacement (Adam7). L'alpha est
+// compose sur fond blanc. Tramage ordonne 4x4 optionnel.
+// Calcul pur sans LVGL ni ESP-IDF: se compile sur PC (tools/png_rgb565_bench.cpp).
+// =============================================================================
+
+#define PNG_RGB565_MAX_WIDTH 256
+#define PNG_RGB565_MAX_HEIGHT 4096
+#define PNG_RGB565_WINDOW 32768             // Fenetre deflate (distance max)
+#define PNG_RGB565_IN_BUF 512
+#define PNG_RGB565_ROW_MAX (PNG_RGB565_MAX_WIDTH * 8)  // RGBA 16 bits
+#define PNG_RGB565_LUT_BITS 9               // Decodage Huffman direct jusqu'a 9 bits
+#define PNG_RGB565_WORK_MAX (44 * 1024)     // Borne de l'etat complet
+
+#define PNG_RGB565_DITHER 0x01              // Tramage ordonne (degrades plus doux)
+
+#define PNG_COLOR_GRAY 0
+#define PNG_COLOR_RGB 2
+#define PNG_COLOR_PALETTE 3
+#define PNG_COLOR_GRAY_ALPHA 4
+#define PNG_COLOR_RGBA 6
+
+// Lecture de la source: nombre d'octets lus, 0 en fin de donnees ou erreur
+typedef size_t (*png_read_fn_t)(void *user, uint8_t *buf, size_t len);
+
+typedef struct {
+  uint32_t width, height;
+  uint8_t depth;
+  uint8_t color;
+  uint8_t channels;
+  uint32_t row_bytes;     // Sans l'octet de filtre
+  uint8_t pixel_bytes;    // Pas du filtre (>= 1)
+} png_info_t;
+
+typedef struct {
+  uint16_t counts[16];
+  uint16_t symbols[288];
+  uint16_t lut[1 << PNG_RGB565_LUT_BITS];   // symbole << 4 | longueur, 0: code plus long
+} png_huff_t;
+
+typedef struct {
+  // Source
+  png_read_fn_t read;
+  void *user;
+  uint8_t in[PNG_RGB565_IN_BUF];
+  size_t in_pos, in_len;
+  uint32_t idat_left;     // Octets restants dans le chunk IDAT courant
+  bool idat_end;          // Chunk suivant n'est plus un IDAT
+  uint32_t bit_buf;
+  int bit_count;
+  bool error;
+
+  // Inflate
+  uint8_t window[PNG_RGB565_WINDOW];
+  uint32_t win_pos;
+  png_huff_t lit, dist;
+  uint8_t lengths[288 + 32];
+
+  // Lignes
+  png_info_t info;
+  uint8_t rows[2][PNG_RGB565_ROW_MAX + 1];
+  uint8_t cur;            // Ligne en cours dans rows
+  uint32_t row_pos;
+  uint32_t y;
+  uint8_t flags;
+  uint16_t *out;
+  uint32_t out_stride;
+  uint8_t palette_rgb[256][3];
+  uint16_t palette[256];
+} png_rgb565_t;
+
+// Cette borne est la memoire totale du decodeur (pile mise a part, < 200 o)
+static_assert(sizeof(png_rgb565_t) <= PNG_RGB565_WORK_MAX, "Etat du decodeur PNG trop grand");
+
+// ============================================================================
+// Source
+// ============================================================================
+
+static inline uint32_t png_get32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+#define PNG_CHUNK(a, b, c, d) (((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+
+static bool png_fill(png_rgb565_t *d) {
+  if (d->in_pos < d->in_len) return true;
+  d->in_len = d->read(d->user, d->in, sizeof(d->in));
+  d->in_pos = 0;
+  return d->in_len > 0;
+}
+
+static bool png_read_bytes(png_rgb565_t *d, uint8_t *buf, size_t n) {
+  while (n) {
+    if (!png_fill(d)) return false;
+    size_t k = d->in_len - d->in_pos < n ? d->in_len - d->in_pos : n;
+    memcpy(buf, d->in + d->in_pos, k);
+    d->in_pos += k;
+    buf += k;
+    n -= k;
+  }
+  return true;
+}
+
+static bool png_skip(png_rgb565_t *d, uint32_t n) {
+  while (n) {
+    if (!png_fill(d)) return false;
+    size_t k = d->in_len - d->in_pos < n ? d->in_len - d->in_pos : n;
+    d->in_pos += k;
+    n -= k;
+  }
+  return true;
+}
+
+// En-tete du chunk suivant (longueur, type)
+static bool png_chunk_header(png_rgb565_t *d, uint32_t *len, uint32_t *type) {
+  uint8_t h[8];
+  if (!png_read_bytes(d, h, 8)) return false;
+  *len = png_get32(h);
+  *type = png_get32(h + 4);
+  return *len < 0x80000000u;
+}
+
+// Octet suivant du flux zlib, a cheval sur plusieurs IDAT; false a la fin des IDAT
+static bool png_idat_byte(png_rgb565_t *d, uint8_t *b) {
+  while (d->idat_left == 0) {
+    if (d->idat_end) return false;
+    uint32_t len, type;
+    if (!png_skip(d, 4) || !png_chunk_header(d, &len, &type)) {
+      d->error = true;
+      return false;
+    }
+    if (type != PNG_CHUNK('I', 'D', 'A', 'T')) {
+      d->idat_end = true;
+      return false;
+    }
+    d->idat_left = len;
+  }
+  if (!png_fill(d)) {
+    d->error = true;
+    return false;
+  }
+  d->idat_left--;
+  *b = d->in[d->in_pos++];
+  return true;
+}
+
+// Remplit le tampon de bits sans depasser la fin des IDAT
+static inline void png_refill(png_rgb565_t *d) {
+  while (d->bit_count <= 24) {
+    uint8_t b;
+    if (!png_idat_byte(d, &b)) return;
+    d->bit_buf |= (uint32_t)b << d->bit_count;
+    d->bit_count += 8;
+  }
+}
+
+static inline uint32_t png_bits(png_rgb565_t *d, int n) {
+  if (n == 0) return 0;
+  if (d->bit_count < n) {
+    png_refill(d);
+    if (d->bit_count < n) {
+      d->error = true;
+      return 0;
+    }
+  }
+  uint32_t v = d->bit_buf & ((1u << n) - 1);
+  d->bit_buf >>= n;
+  d->bit_count -= n;
+  return v;
+}
+
+// ============================================================================
+// Inflate (RFC 1951)
+// ============================================================================
+
+static const uint16_t png_len_base[29] = {
+  3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t png_len_extra[29] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t png_dist_base[30] = {
+  1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t png_dist_extra[30] = {
+  0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+  7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// Table canonique + table directe des codes courts (bits inverses: ordre du flux)
+static void png_huff_build(png_huff_t *t, const uint8_t *lengths, int n) {
+  uint16_t offs[16], next[16];
+  memset(t->counts, 0, sizeof(t->counts));
+  memset(t->lut, 0, sizeof(t->lut));
+  for (int i = 0; i < n; i++) t->counts[lengths[i]]++;
+  t->counts[0] = 0;
+  uint16_t sum = 0, code = 0;
+  for (int i = 0; i < 16; i++) {
+    offs[i] = sum;
+    sum += t->counts[i];
+    code = (code + (i ? t->counts[i - 1] : 0)) << 1;
+    next[i] = code;
+  }
+  for (int i = 0; i < n; i++) {
+    int len = lengths[i];
+    if (!len) continue;
+    t->symbols[offs[len]++] = i;
+    uint32_t c = next[len]++;
+    if (len > PNG_RGB565_LUT_BITS) continue;
+    uint32_t rev = 0;
+    for (int k = 0; k < len; k++) rev |= ((c >> k) & 1) << (len - 1 - k);
+    for (uint32_t j = rev; j < (1u << PNG_RGB565_LUT_BITS); j += 1u << len) t->lut[j] = (uint16_t)((i << 4) | len);
+  }
+}
+
+static int png_huff_decode(png_rgb565_t *d, const png_huff_t *t) {
+  if (d->bit_count < PNG_RGB565_LUT_BITS) png_refill(d);
+  if (d->bit_count >= PNG_RGB565_LUT_BITS) {
+    uint16_t e = t->lut[d->bit_buf & ((1u << PNG_RGB565_LUT_BITS) - 1)];
+    if (e) {
+      d->bit_buf >>= (e & 15);
+      d->bit_count -= (e & 15);
+      return e >> 4;
+    }
+  }
+  // Code long ou fin du flux: bit a bit
+  int code = 0, first = 0, index = 0;
+  for (int len = 1; len < 16; len++) {
+    code |= png_bits(d, 1);
+    if (d->error) return 0;
+    int count = t->counts[len];
+    if (code - first < count) return t->symbols[index + code - first];
+    index += count;
+    first = (first + count) << 1;
+    code <<= 1;
+  }
+  d->error = true;
+  return 0;
+}
+
+static bool png_inflate_dynamic_tables(png_rgb565_t *d) {
+  static const uint8_t order[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+  uint8_t *lengths = d->lengths;
+  int hlit = png_bits(d, 5) + 257;
+  int hdist = png_bits(d, 5) + 1;
+  int hclen = png_bits(d, 4) + 4;
+  if (hlit > 286 || hdist > 30) return false;
+
+  // Table des longueurs construite temporairement dans d->dist
+  memset(lengths, 0, 19);
+  for (int i = 0; i < hclen; i++) lengths[order[i]] = png_bits(d, 3);
+  png_huff_build(&d->dist, lengths, 19);
+
+  for (int n = 0; n < hlit + hdist && !d->error;) {
+    int sym = png_huff_decode(d, &d->dist);
+    int rep = 0;
+    uint8_t val = 0;
+    if (sym < 16) {
+      lengths[n++] = sym;
+      continue;
+    } else if (sym == 16) {
+      if (n == 0) return false;
+      val = lengths[n - 1];
+      rep = 3 + png_bits(d, 2);
+    } else if (sym == 17) {
+      rep = 3 + png_bits(d, 3);
+    } else {
+      rep = 11 + png_bits(d, 7);
+    }
+    if (n + rep > hlit + hdist) return false;
+    while (rep--) lengths[n++] = val;
+  }
+  png_huff_build(&d->lit, lengths, hlit);
+  png_huff_build(&d->dist, lengths + hlit, hdist);
+  return !d->error;
+}
+
+// ============================================================================
+// Lignes
+// ============================================================================
+
+static inline uint8_t png_paeth(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+  if (pa <= pb && pa <= pc) return a;
+  return pb <= pc ? b : c;
+}
+
+static bool png_unfilter(uint8_t filter, uint8_t *row, const uint8_t *prev, uint32_t n, uint32_t bpp) {
+  switch (filter) {
+    case 0: break;
+    case 1:
+      for (uint32_t i = bpp; i < n; i++) row[i] += row[i - bpp];
+      break;
+    case 2:
+      for (uint32_t i = 0; i < n; i++) row[i] += prev[i];
+      break;
+    case 3:
+      for (uint32_t i = 0; i < bpp; i++) row[i] += prev[i] >> 1;
+      for (uint32_t i = bpp; i < n; i++) row[i] += (row[i - bpp] + prev[i]) >> 1;
+      break;
+    case 4:
+      for (uint32_t i = 0; i < bpp; i++) row[i] += prev[i];
+      for (uint32_t i = bpp; i < n; i++) row[i] += png_paeth(row[i - bpp], prev[i], prev[i - bpp]);
+      break;
+    default: return false;
+  }
+  return true;
+}
+
+static inline uint16_t png_rgb565(uint32_t r, uint32_t g, uint32_t b) {
+  return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+// Composition sur fond blanc
+static inline uint32_t png_over_white(uint32_t c, uint32_t a) {
+  return (c * a + 255 * (255 - a) + 127) / 255;
+}
+
+// Seuils Bayer 4x4 (0..15)
+static const uint8_t png_bayer[4][4] = {
+  { 0, 8, 2, 10 }, { 12, 4, 14, 6 }, { 3, 11, 1, 9 }, { 15, 7, 13, 5 }
+};
+
+static inline uint32_t png_dither(uint32_t c, int offset) {
+  int v = (int)c + offset;
+  return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+// Echantillon x (canal ch) ramene sur 8 bits
+static inline uint32_t png_sample(const png_info_t *info, const uint8_t *row, uint32_t x, int ch) {
+  if (info->depth == 8) return row[x * info->channels + ch];
+  if (info->depth == 16) return row[(x * info->channels + ch) * 2];
+  // 1, 2, 4 bits: un seul canal (gris ou palette)
+  uint32_t bit = x * info->depth;
+  uint32_t v = (row[bit >> 3] >> (8 - info->depth - (bit & 7))) & ((1u << info->depth) - 1);
+  return info->color == PNG_COLOR_PALETTE ? v : v * 255 / ((1u << info->depth) - 1);
+}
+
+static void png_convert_row(png_rgb565_t *d, const uint8_t *row) {
+  const png_info_t *info = &d->info;
+  uint16_t *out = d->out + (size_t)d->y * d->out_stride;
+  bool dither = d->flags & PNG_RGB565_DITHER;
+  const uint8_t *bayer = png_bayer[d->y & 3];
+
+  for (uint32_t x = 0; x < info->width; x++) {
+    uint32_t r, g, b, a = 255;
+    switch (info->color) {
+      case PNG_COLOR_PALETTE: {
+        uint32_t i = png_sample(info, row, x, 0);
+        if (!dither) {
+          out[x] = d->palette[i];
+          continue;
+        }
+        r = d->palette_rgb[i][0];
+        g = d->palette_rgb[i][1];
+        b = d->palette_rgb[i][2];
+        break;
+      }
+      case PNG_COLOR_GRAY:
+      case PNG_COLOR_GRAY_ALPHA:
+        r = g = b = png_sample(info, row, x, 0);
+        if (info->color == PNG_COLOR_GRAY_ALPHA) a = png_sample(info, row, x, 1);
+        break;
+      default:
+        r = png_sample(info, row, x, 0);
+        g = png_sample(info, row, x, 1);
+        b = png_sample(info, row, x, 2);
+        if (info->color == PNG_COLOR_RGBA) a = png_sample(info, row, x, 3);
+        break;
+    }
+    if (a != 255) {
+      r = png_over_white(r, a);
+      g = png_over_white(g, a);
+      b = png_over_white(b, a);
+    }
+    if (dither) {
+      // Pas de quantification: 8 (R, B sur 5 bits), 4 (G sur 6 bits)
+      int t = bayer[x & 3];
+      r = png_dither(r, (t >> 1) - 4);
+      g = png_dither(g, (t >> 2) - 2);
+      b = png_dither(b, (t >> 1) - 4);
+    }
+    out[x] = png_rgb565(r, g, b);
+  }
+}
+
+// Octet decompresse: fenetre + ligne en cours; false quand l'image est complete
+static inline bool png_emit(png_rgb565_t *d, uint8_t b) {
+  d->window[d->win_pos++ & (PNG_RGB565_WINDOW - 1)] = b;
+  uint8_t *row = d->rows[d->cur];
+  row[d->row_pos++] = b;
+  if (d->row_pos < d->info.row_bytes + 1) return true;
+
+  const uint8_t *prev = d->rows[d->cur ^ 1] + 1;
+  if (!png_unfilter(row[0], row + 1, prev, d->info.row_bytes, d->info.pixel_bytes)) {
+    d->error = true;
+    return false;
+  }
+  png_convert_row(d, row + 1);
+  d->cur ^= 1;
+  d->row_pos = 0;
+  return ++d->y < d->info.height;
+}
+
+// Decompresse jusqu'a la derniere ligne de l'image
+static bool png_inflate(png_rgb565_t *d) {
+  uint32_t cmf = png_bits(d, 8), flg = png_bits(d, 8);
+  if ((cmf & 0x0F) != 8 || ((cmf << 8) | flg) % 31 != 0 || (flg & 0x20)) return false;
+
+  bool final = false;
+  while (!final && !d->error) {
+    final = png_bits(d, 1);
+    uint32_t type = png_bits(d, 2);
+    if (type == 0) {
+      // Alignement: les octets entiers deja charges restent dans bit_buf
+      png_bits(d, d->bit_count & 7);
+      uint32_t n = png_bits(d, 16);
+      uint32_t nn = png_bits(d, 16);
+      if ((n ^ 0xFFFF) != nn) return false;
+      while (n-- && !d->error) {
+        if (!png_emit(d, (uint8_t)png_bits(d, 8))) return !d->error;
+      }
+      continue;
+    }
+    if (type == 1) {
+      uint8_t *lengths = d->lengths;
+      memset(lengths, 8, 144);
+      memset(lengths + 144, 9, 112);
+      memset(lengths + 256, 7, 24);
+      memset(lengths + 280, 8, 8);
+      memset(lengths + 288, 5, 30);
+      png_huff_build(&d->lit, lengths, 288);
+      png_huff_build(&d->dist, lengths + 288, 30);
+    } else if (type != 2 || !png_inflate_dynamic_tables(d)) {
+      return false;
+    }
+
+    while (!d->error) {
+      int sym = png_huff_decode(d, &d->lit);
+      if (sym < 256) {
+        if (!png_emit(d, sym)) return !d->error;
+        continue;
+      }
+      if (sym == 256) break;
+      sym -= 257;
+      if (sym >= 29) return false;
+      uint32_t len = png_len_base[sym] + png_bits(d, png_len_extra[sym]);
+      int dsym = png_huff_decode(d, &d->dist);
+      if (dsym >= 30) return false;
+      uint32_t dist = png_dist_base[dsym] + png_bits(d, png_dist_extra[dsym]);
+      if (dist > d->win_pos) return false;
+      while (len--) {
+        uint8_t b = d->window[(d->win_pos - dist) & (PNG_RGB565_WINDOW - 1)];
+        if (!png_emit(d, b)) return !d->error;
+      }
+    }
+  }
+  return false;  // Flux termine avant la derniere ligne
+}
+
+// ============================================================================
+// API
+// ============================================================================
+
+// Signature et IHDR
+static bool png_read_header(png_rgb565_t *d) {
+  static const uint8_t sig[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+  uint8_t b[13];
+  uint32_t len, type;
+  if (!png_read_bytes(d, b, 8) || memcmp(b, sig, 8) != 0) return false;
+  if (!png_chunk_header(d, &len, &type) || type != PNG_CHUNK('I', 'H', 'D', 'R') || len != 13) return false;
+  if (!png_read_bytes(d, b, 13) || !png_skip(d, 4)) return false;
+
+  png_info_t *info = &d->info;
+  info->width = png_get32(b);
+  info->height = png_get32(b + 4);
+  info->depth = b[8];
+  info->color = b[9];
+  if (b[10] != 0 || b[11] != 0 || b[12] != 0) return false;  // Compression, filtre, entrelacement
+  switch (info->color) {
+    case PNG_COLOR_GRAY: info->channels = 1; break;
+    case PNG_COLOR_RGB: info->channels = 3; break;
+    case PNG_COLOR_PALETTE: info->channels = 1; break;
+    case PNG_COLOR_GRAY_ALPHA: info->channels = 2; break;
+    case PNG_COLOR_RGBA: info->channels = 4; break;
+    default: return false;
+  }
+  uint8_t dp = info->depth;
+  bool sub_byte = (dp == 1 || dp == 2 || dp == 4);
+  if (!(dp == 8 || dp == 16 || (sub_byte && info->channels == 1)) || (info->color == PNG_COLOR_PALETTE && dp == 16)) return false;
+  if (info->width == 0 || info->height == 0 || info->width > PNG_RGB565_MAX_WIDTH || info->height > PNG_RGB565_MAX_HEIGHT) return false;
+  info->row_bytes = (info->width * info->channels * dp + 7) / 8;
+  info->pixel_bytes = (info->channels * dp + 7) / 8;
+  return true;
+}
+
+// Decode le PNG lu par read dans out (largeur out_w, hauteur out_h, l'image
+// doit avoir exactement ces dimensions). Les octets apres le dernier IDAT
+// utile ne sont pas lus.
+static bool png_rgb565_decode_stream(png_rgb565_t *d, png_read_fn_t read, void *user, uint16_t *out, uint32_t out_w,
+                                     uint32_t out_h, uint8_t flags) {
+  d->read = read;
+  d->user = user;
+  d->in_pos = d->in_len = 0;
+  d->idat_left = 0;
+  d->idat_end = false;
+  d->bit_buf = 0;
+  d->bit_count = 0;
+  d->error = false;
+  d->win_pos = 0;
+  d->cur = 0;
+  d->row_pos = 0;
+  d->y = 0;
+  d->flags = flags;
+  d->out = out;
+  d->out_stride = out_w;
+  if (!png_read_header(d) || d->info.width != out_w || d->info.height != out_h) return false;
+
+  // PLTE / tRNS jusqu'au premier IDAT
+  uint8_t alpha[256];
+  memset(d->palette_rgb, 0, sizeof(d->palette_rgb));
+  memset(alpha, 255, sizeof(alpha));
+  while (true) {
+    uint32_t len, type;
+    if (!png_chunk_header(d, &len, &type)) return false;
+    if (type == PNG_CHUNK('I', 'D', 'A', 'T')) {
+      d->idat_left = len;
+      break;
+    }
+    if (type == PNG_CHUNK('I', 'E', 'N', 'D')) return false;
+    if (type == PNG_CHUNK('P', 'L', 'T', 'E') && len <= 768 && len % 3 == 0) {
+      if (!png_read_bytes(d, &d->palette_rgb[0][0], len)) return false;
+      len = 0;
+    } else if (type == PNG_CHUNK('t', 'R', 'N', 'S') && d->info.color == PNG_COLOR_PALETTE && len <= 256) {
+      if (!png_read_bytes(d, alpha, len)) return false;
+      len = 0;
+    }
+    if (!png_skip(d, len + 4)) return false;
+  }
+  for (int i = 0; i < 256; i++) {
+    for (int c = 0; c < 3; c++) d->palette_rgb[i][c] = png_over_white(d->palette_rgb[i][c], alpha[i]);
+    d->palette[i] = png_rgb565(d->palette_rgb[i][0], d->palette_rgb[i][1], d->palette_rgb[i][2]);
+  }
+
+  // Ligne precedente de la premiere ligne: zeros
+  memset(d->rows[1], 0, d->info.row_bytes + 1);
+  return png_inflate(d) && !d->error && d->y == d->info.height;
+}
+
+// Source en memoire pour png_rgb565_decode
+typedef struct {
+  const uint8_t *data;
+  size_t len;
+} png_mem_src_t;
+
+static size_t png_mem_read(void *user, uint8_t *buf, size_t len) {
+  png_mem_src_t *s = (png_mem_src_t *)user;
+  size_t n = s->len < len ? s->len : len;
+  memcpy(buf, s->data, n);
+  s->data += n;
+  s->len -= n;
+  return n;
+}
+
+static inline bool png_rgb565_decode(png_rgb565_t *d, const uint8_t *png, size_t len, uint16_t *out, uint32_t out_w,
+                                     uint32_t out_h, uint8_t flags) {
+  png_mem_src_t src = { png, len };
+  return png_rgb565_decode_stream(d, png_mem_read, &src, out, out_w, out_h, flags);
+}
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef QNH_FETCH_H
+#define QNH_FETCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdio.h>
+#include "src/http_chunked.h"
+#include "src/json_stream.h"
+
+// =============================================================================
+// Recuperation du QNH sans tampon de reponse: la reponse HTTP est analysee
+// octet par octet (ligne de statut, en-tetes, corps Content-Length ou
+// chunked) et le corps passe dans un lecteur JSON au fil de l'eau dont le
+// rappel ne retient que les champs utiles (Open-Meteo: current.pressure_msl).
+// Cache du dernier QNH par maille lat/lon avec son age.
+// Calcul pur sans Arduino ni ESP-IDF: se compile sur PC
+// (tools/qnh_fetch_bench.cpp, tools/qnh_stub_server.py).
+// =============================================================================
+
+#define QNH_HTTP_LINE_MAX 64          // Suffisant pour les en-tetes utiles
+#define QNH_CACHE_SIZE 16
+#define QNH_CACHE_CELL_DEG 0.25f      // ~28 km en latitude
+#define QNH_MIN_HPA 850.0f
+#define QNH_MAX_HPA 1100.0f
+
+static inline bool qnh_plausible(float qnh) {
+  return qnh >= QNH_MIN_HPA && qnh <= QNH_MAX_HPA;
+}
+
+// ============================================================================
+// Reponse HTTP
+// ============================================================================
+
+typedef enum {
+  QNH_HTTP_STATUS = 0,
+  QNH_HTTP_HEADERS,
+  QNH_HTTP_BODY,
+  QNH_HTTP_DONE,
+  QNH_HTTP_ERROR
+} qnh_http_state_t;
+
+typedef struct {
+  qnh_http_state_t state;
+  int status;
+  int32_t content_length;   // -1: absent
+  uint32_t body_got;
+  bool chunked;
+  bool close;               // Connection: close (connexion non reutilisable)
+  http_chunked_t chunk;
+  bool has_date;            // En-tete Date: heure UTC du serveur
+  uint8_t date_day;
+  uint8_t date_hour;
+  uint8_t date_minute;
+  char line[QNH_HTTP_LINE_MAX];
+  uint16_t line_len;
+  json_stream_t json;       // Corps, remis au rappel de l'appelant
+} qnh_http_t;
+
+static void qnh_http_init(qnh_http_t *h, json_stream_cb_t cb, void *user) {
+  memset(h, 0, sizeof(*h));
+  h->content_length = -1;
+  json_stream_init(&h->json, cb, user);
+}
+
+static bool qnh_http_header_is(const char *line, const char *name) {
+  size_t n = strlen(name);
+  for (size_t i = 0; i < n; i++) {
+    char c = line[i];
+    if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    if (c != name[i]) return false;
+  }
+  return true;
+}
+
+static bool qnh_http_value_has(const char *value, const char *token) {
+  for (const char *p = value; *p; p++) {
+    if (qnh_http_header_is(p, token)) return true;
+  }
+  return false;
+}
+
+static void qnh_http_line(qnh_http_t *h) {
+  h->line[h->line_len] = '\0';
+  const char *l = h->line;
+  if (h->state == QNH_HTTP_STATUS) {
+    if (strncmp(l, "HTTP/1.", 7) != 0 || l[8] != ' ') {
+      h->state = QNH_HTTP_ERROR;
+      return;
+    }
+    h->status = atoi(l + 9);
+    h->close = l[7] == '0';   // HTTP/1.0: fermeture par defaut
+    h->state = QNH_HTTP_HEADERS;
+    return;
+  }
+  if (h->line_len == 0) {
+    // Fin des en-tetes
+    bool empty = h->content_length == 0 || h->status == 204 || h->status == 304;
+    h->state = empty ? QNH_HTTP_DONE : QNH_HTTP_BODY;
+    return;
+  }
+  const char *v = strchr(l, ':');
+  if (!v) return;
+  v++;
+  while (*v == ' ' || *v == '\t') v++;
+  unsigned day, hour, minute;
+  if (qnh_http_header_is(l, "content-length:")) h->content_length = atol(v);
+  else if (qnh_http_header_is(l, "date:")) {
+    // "Sat, 01 Jun 2024 12:34:56 GMT"
+    const char *d = strchr(v, ',');
+    if (d && sscanf(d + 1, "%u %*s %*u %u:%u", &day, &hour, &minute) == 3 && day >= 1 && day <= 31 && hour < 24 &&
+        minute < 60) {
+      h->date_day = day;
+      h->date_hour = hour;
+      h->date_minute = minute;
+      h->has_date = true;
+    }
+  }
+  else if (qnh_http_header_is(l, "transfer-encoding:")) h->chunked = qnh_http_value_has(v, "chunked");
+  else if (qnh_http_header_is(l, "connection:")) {
+    if (qnh_http_value_has(v, "close")) h->close = true;
+    else if (qnh_http_value_has(v, "keep-alive")) h->close = false;
+  }
+}
+
+// Consomme len octets de la reponse (buf modifie en place par le decodage
+// chunked). Retourne le nombre d'octets utilises (corps Content-Length: les
+// suivants n'appartiennent pas a cette reponse).
+static size_t qnh_http_feed(qnh_http_t *h, uint8_t *buf, size_t len) {
+  size_t i = 0;
+  while (i < len && (h->state == QNH_HTTP_STATUS || h->state == QNH_HTTP_HEADERS)) {
+    char c = (char)buf[i++];
+    if (c == '\r') continue;
+    if (c == '\n') {
+      qnh_http_line(h);
+      h->line_len = 0;
+    } else if (h->line_len < QNH_HTTP_LINE_MAX - 1) {
+      h->line[h->line_len++] = c;
+    }
+  }
+  if (h->state != QNH_HTTP_BODY || i == len) return i;
+
+  uint8_t *body = buf + i;
+  size_t n = len - i;
+  if (h->chunked) {
+    size_t out = http_chunked_decode(&h->chunk, body, n);
+    if (h->chunk.error) {
+      h->state = QNH_HTTP_ERROR;
+      return len;
+    }
+    json_stream_feed(&h->json, body, out);
+    h->body_got += out;
+    if (http_chunked_done(&h->chunk)) h->state = QNH_HTTP_DONE;
+    return len;
+  }
+  if (h->content_length >= 0 && n > (uint32_t)h->content_length - h->body_got) {
+    n = h->content_length - h->body_got;
+  }
+  json_stream_feed(&h->json, body, n);
+  h->body_got += n;
+  if (h->content_length >= 0 && h->body_got == (uint32_t)h->content_length) h->state = QNH_HTTP_DONE;
+  return i + n;
+}
+
+// Connexion fermee par le serveur: fin du corps sans longueur
+static void qnh_http_eof(qnh_http_t *h) {
+  if (h->state == QNH_HTTP_BODY && !h->chunked && h->content_length < 0) h->state = QNH_HTTP_DONE;
+  else if (h->state != QNH_HTTP_DONE) h->state = QNH_HTTP_ERROR;
+  h->close = true;
+}
+
+// Reponse complete, 200 et JSON bien forme
+static bool qnh_http_ok(const qnh_http_t *h) {
+  return h->state == QNH_HTTP_DONE && h->status == 200 && !h->json.error && h->json.depth == 0;
+}
+
+// ============================================================================
+// Open-Meteo
+// ============================================================================
+
+typedef struct {
+  float qnh;
+  bool found;
+} qnh_openmeteo_t;
+
+// Rappel JSON: {"current": {"pressure_msl": 1013.2, ...}, ...}
+static void qnh_openmeteo_cb(json_stream_t *s, json_stream_event_t ev, const char *value) {
+  qnh_openmeteo_t *om = (qnh_openmeteo_t *)s->user;
+  if (ev != JSON_STREAM_NUMBER || !json_stream_at(s, 2, "pressure_msl")) return;
+  if (strcmp(json_stream_key(s, 1), "current") != 0) return;
+  char *end;
+  float v = strtof(value, &end);
+  if (end != value && *end == '\0' && qnh_plausible(v)) {
+    om->qnh = v;
+    om->found = true;
+  }
+}
+
+// ============================================================================
+// Cache par maille
+// ============================================================================
+
+typedef struct {
+  int16_t lat_cell;
+  int16_t lon_cell;
+  float qnh;
+  uint32_t time_ms;
+  bool used;
+} qnh_cache_entry_t;
+
+typedef struct {
+  qnh_cache_entry_t entries[QNH_CACHE_SIZE];
+} qnh_cache_t;
+
+static inline void qnh_cache_cell(float lat, float lon, int16_t *lat_cell, int16_t *lon_cell) {
+  *lat_cell = (int16_t)floorf(lat / QNH_CACHE_CELL_DEG);
+  *lon_cell = (int16_t)floorf(lon / QNH_CACHE_CELL_DEG);
+}
+
+// QNH de la maille de (lat, lon) s'il a moins de max_age_ms
+static bool qnh_cache_get(const qnh_cache_t *c, float lat, float lon, uint32_t now_ms, uint32_t max_age_ms, float *qnh,
+                          uint32_t *age_ms) {
+  int16_t la, lo;
+  qnh_cache_cell(lat, lon, &la, &lo);
+  for (int i = 0; i < QNH_CACHE_SIZE; i++) {
+    const qnh_cache_entry_t *e = &c->entries[i];
+    if (!e->used || e->lat_cell != la || e->lon_cell != lo) continue;
+    uint32_t age = now_ms - e->time_ms;
+    if (age > max_age_ms) return false;
+    *qnh = e->qnh;
+    if (age_ms) *age_ms = age;
+    return true;
+  }
+  return false;
+}
+
+// Remplace l'entree de la meme maille, sinon une libre, sinon la plus ancienne
+static void qnh_cache_put(qnh_cache_t *c, float lat, float lon, float qnh, uint32_t now_ms) {
+  int16_t la, lo;
+  qnh_cache_cell(lat, lon, &la, &lo);
+  qnh_cache_entry_t *slot = NULL;
+  for (int i = 0; i < QNH_CACHE_SIZE && !slot; i++) {
+    qnh_cache_entry_t *e = &c->entries[i];
+    if (e->used && e->lat_cell == la && e->lon_cell == lo) slot = e;
+  }
+  for (int i = 0; i < QNH_CACHE_SIZE && !slot; i++) {
+    if (!c->entries[i].used) slot = &c->entries[i];
+  }
+  if (!slot) {
+    slot = &c->entries[0];
+    for (int i = 1; i < QNH_CACHE_SIZE; i++) {
+      if (now_ms - c->entries[i].time_ms > now_ms - slot->time_ms) slot = &c->entries[i];
+    }
+  }
+  slot->lat_cell = la;
+  slot->lon_cell = lo;
+  slot->qnh = qnh;
+  slot->time_ms = now_ms;
+  slot->used = true;
+}
+
+#endif
@@ -13,21 +13,6 @@ SemaphoreHandle_t sem_gui_ready = NULL;
 
 static esp_lcd_panel_handle_t panel_handle = NULL;
 
-// Callback VSYNC - appelé par le hardware lors du vertical blank
-static bool IRAM_ATTR on_vsync_event(esp_lcd_panel_handle_t panel,
-                                     const esp_lcd_rgb_panel_event_data_t *event_data,
-                                     void *user_ctx) {
-  BaseType_t high_task_awoken = pdFALSE;
-  
-  // Vérifier si LVGL a un frame prêt
-  if (xSemaphoreTakeFromISR(sem_gui_ready, &high_task_awoken) == pdTRUE) {
-    // Signal que le swap peut se faire
-    xSemaphoreGiveFromISR(sem_vsync_end, &high_task_awoken);
-  }
-  
-  return high_task_awoken == pdTRUE;
-}
-
 IRAM_ATTR static bool rgb_lcd_on_vsync_event(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx) {
   return lvgl_port_notify_rgb_vsync();
 }
@@ -43,12 +28,12 @@ esp_lcd_panel_handle_t waveshare_esp32_s3_rgb_lcd_init() {
       .pclk_hz = LCD_PIXEL_CLOCK_HZ,
       .h_res = LCD_H_RES,
       .v_res = LCD_V_RES,
-      .hsync_pulse_width = 162,
-      .hsync_back_porch = 152,
-      .hsync_front_porch = 48,
-      .vsync_pulse_width = 45,
-      .vsync_back_porch = 13,
-      .vsync_front_porch = 3,
+      .hsync_pulse_width = LCD_HSYNC_PULSE_WIDTH,
+      .hsync_back_porch = LCD_HSYNC_BACK_PORCH,
+      .hsync_front_porch = LCD_HSYNC_FRONT_PORCH,
+      .vsync_pulse_width = LCD_VSYNC_PULSE_WIDTH,
+      .vsync_back_porch = LCD_VSYNC_BACK_PORCH,
+      .vsync_front_porch = LCD_VSYNC_FRONT_PORCH,
       .flags = {
         .pclk_active_neg = 1,
       },
@@ -95,6 +80,10 @@ esp_lcd_panel_handle_t waveshare_esp32_s3_rgb_lcd_init() {
 
   ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
 
+  // Poignee de main flush LVGL <-> fin de trame (voir lvgl_port_notify_rgb_vsync)
+  sem_vsync_end = xSemaphoreCreateBinary();
+  sem_gui_ready = xSemaphoreCreateBinary();
+
   esp_lcd_rgb_panel_event_callbacks_t cbs = {};
 #if RGB_BOUNCE_BUFFER_SIZE > 0
   cbs.on_bounce_frame_finish = rgb_lcd_on_vsync_event;
@@ -6,6 +6,9 @@
 #include "io_extension/io_extension.h"
 #include "constants.h"
 
+// Acces bas niveau a SD_MMC: hors demarrage, a appeler depuis la tache
+// stockage (storage_call / storage_call_async, voir storage_service.h)
+
 // Variables globales
 static bool sd_card_ready = false;
 
@@ -257,6 +260,7 @@ bool sd_get_capacity(uint64_t* total_kb, uint64_t* available_kb) {
 }
 
 // ===== COMPTAGE FICHIERS =====
+// Parcours synchrones: l'UI lit les valeurs en cache de storage_index.h
 /**
  * @brief Compte recursivement les fichiers dans un repertoire
  * @param dirPath Chemin du repertoire
@@ -0,0 +1,146 @@
+#ifndef SENSOR_METRICS_H
+#define SENSOR_METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "constants.h"
+
+// =============================================================================
+// Metriques capteurs: durees de lecture I2C, age des echantillons a la
+// consommation par le Kalman, lectures en echec et depassements de boucle.
+// Compteurs de taille fixe, aucune allocation. Le coeur (enregistrement +
+// serialisation) ne depend que de stdint/string et se compile sur PC.
+// =============================================================================
+
+// Index capteurs
+enum {
+  METRICS_SENSOR_BMP390 = 0,
+  METRICS_SENSOR_BNO080,
+  METRICS_SENSOR_GPS,
+  METRICS_SENSOR_COUNT
+};
+
+// Index taches surveillees
+enum {
+  METRICS_TASK_SENSORS = 0,
+  METRICS_TASK_KALMAN,
+  METRICS_TASK_COUNT
+};
+
+// Compteurs par capteur (histogrammes log2)
+typedef struct {
+  uint32_t read_ok;                          // Lectures reussies
+  uint32_t read_failed;                      // Lectures en echec
+  uint32_t read_empty;                       // Lectures sans nouvelle donnee (BNO080 sans evenement)
+  uint32_t consumed;                         // Echantillons consommes par le Kalman
+  uint32_t stale;                            // Echantillons trop vieux a la consommation
+  uint32_t read_us_max;                      // Duree lecture max (us)
+  uint32_t read_us_hist[METRICS_HIST_BUCKETS];  // Duree lecture (us)
+  uint32_t age_ms_hist[METRICS_HIST_BUCKETS];   // Age a la consommation (ms)
+} sensor_metrics_sensor_t;
+
+// Compteurs par tache
+typedef struct {
+  uint32_t loops;        // Iterations
+  uint32_t overruns;     // Iterations plus longues que la periode
+  uint32_t loop_us_max;  // Duree iteration max (us)
+} sensor_metrics_task_t;
+
+// Bloc complet (uniquement des uint32_t: pas de padding, dump direct)
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t uptime_ms;
+  sensor_metrics_sensor_t sensor[METRICS_SENSOR_COUNT];
+  sensor_metrics_task_t task[METRICS_TASK_COUNT];
+} sensor_metrics_t;
+
+static sensor_metrics_t g_sensor_metrics = { METRICS_MAGIC, METRICS_VERSION, 0, {}, {} };
+
+// Seuil d'age (ms) au-dela duquel un echantillon est compte comme perime
+static const uint32_t metrics_stale_ms[METRICS_SENSOR_COUNT] = {
+  METRICS_STALE_BMP390_MS,
+  METRICS_STALE_BNO080_MS,
+  METRICS_STALE_GPS_MS
+};
+
+// Bucket log2: 0 -> [0,1], k -> [2^(k-1)+1, 2^k], dernier bucket = depassement
+static inline uint8_t sensor_metrics_bucket(uint32_t value) {
+  uint8_t b = 0;
+  if (value > 1) b = 32 - __builtin_clz(value - 1);
+  return (b < METRICS_HIST_BUCKETS) ? b : (METRICS_HIST_BUCKETS - 1);
+}
+
+static inline void sensor_metrics_reset(sensor_metrics_t *m) {
+  memset(m, 0, sizeof(sensor_metrics_t));
+  m->magic = METRICS_MAGIC;
+  m->version = METRICS_VERSION;
+}
+
+// Lecture capteur terminee (duree en us)
+static inline void sensor_metrics_record_read(sensor_metrics_t *m, int sensor, uint32_t duration_us, bool ok) {
+  sensor_metrics_sensor_t *s = &m->sensor[sensor];
+  if (ok) s->read_ok++;
+  else s->read_failed++;
+  s->read_us_hist[sensor_metrics_bucket(duration_us)]++;
+  if (duration_us > s->read_us_max) s->read_us_max = duration_us;
+}
+
+// Lecture sans nouvelle donnee: ni succes ni echec (duree quand meme mesuree)
+static inline void sensor_metrics_record_empty(sensor_metrics_t *m, int sensor, uint32_t duration_us) {
+  sensor_metrics_sensor_t *s = &m->sensor[sensor];
+  s->read_empty++;
+  s->read_us_hist[sensor_metrics_bucket(duration_us)]++;
+  if (duration_us > s->read_us_max) s->read_us_max = duration_us;
+}
+
+// Echantillon consomme par le Kalman (age en ms)
+static inline void sensor_metrics_record_age(sensor_metrics_t *m, int sensor, uint32_t age_ms) {
+  sensor_metrics_sensor_t *s = &m->sensor[sensor];
+  if ((int32_t)age_ms < 0) age_ms = 0;  // Echantillon ecrit apres lecture de millis()
+  s->consumed++;
+  s->age_ms_hist[sensor_metrics_bucket(age_ms)]++;
+  if (age_ms > metrics_stale_ms[sensor]) s->stale++;
+}
+
+// Fin d'iteration d'une tache periodique
+static inline void sensor_metrics_record_loop(sensor_metrics_t *m, int task, uint32_t duration_us, uint32_t period_us) {
+  sensor_metrics_task_t *t = &m->task[task];
+  t->loops++;
+  if (duration_us > period_us) t->overruns++;
+  if (duration_us > t->loop_us_max) t->loop_us_max = duration_us;
+}
+
+// Copie binaire (little-endian natif) dans buf, retourne la taille ou 0
+static inline size_t sensor_metrics_serialize(const sensor_metrics_t *m, uint32_t uptime_ms, uint8_t *buf, size_t len) {
+  if (!buf || len < sizeof(sensor_metrics_t)) return 0;
+  memcpy(buf, m, sizeof(sensor_metrics_t));
+  memcpy(buf + offsetof(sensor_metrics_t, uptime_ms), &uptime_ms, sizeof(uint32_t));
+  return sizeof(sensor_metrics_t);
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include "esp_timer.h"
+
+// Horodatage us pour mesurer les lectures (esp_timer, ~1 us par appel)
+static inline uint32_t sensor_metrics_now_us() {
+  return (uint32_t)esp_timer_get_time();
+}
+
+// Dump binaire sur le port serie: "SMET" + taille (uint16) + bloc
+static void sensor_metrics_dump_serial() {
+  static uint8_t buf[sizeof(sensor_metrics_t)];
+  size_t n = sensor_metrics_serialize(&g_sensor_metrics, millis(), buf, sizeof(buf));
+  if (n == 0) return;
+
+  uint16_t len = (uint16_t)n;
+  Serial.write((const uint8_t *)"SMET", 4);
+  Serial.write((const uint8_t *)&len, sizeof(len));
+  Serial.write(buf, n);
+  Serial.flush();
+}
+#endif
+
+#endif
@@ -9,6 +9,7 @@
 #include "src/i2c/i2c.h"
 #include "constants.h"
 #include "globals.h"
+#include "sensor_metrics.h"
 
 static BMP3XX_ESP32 bmp390;
 static BNO08x_ESP32 bno080(BNO080_RESET_PIN);
@@ -24,8 +25,13 @@ static void sensors_i2c_task(void *pvParameters) {
 #endif
 
   while (1) {
+    uint32_t loop_start_us = sensor_metrics_now_us();
+
     // Lecture BMP390
-    if (bmp390.performReading()) {
+    uint32_t t0 = sensor_metrics_now_us();
+    bool bmp_ok = bmp390.performReading();
+    sensor_metrics_record_read(&g_sensor_metrics, METRICS_SENSOR_BMP390, sensor_metrics_now_us() - t0, bmp_ok);
+    if (bmp_ok) {
       g_sensor_data.bmp390.temperature = bmp390.temperature;
       g_sensor_data.bmp390.pressure = bmp390.pressure;
       g_sensor_data.bmp390.timestamp = millis();
@@ -46,7 +52,13 @@ static void sensors_i2c_task(void *pvParameters) {
     }
     // Lecture BNO080
     sh2_SensorValue_t sensorValue;
-    if (bno080.getSensorEvent(&sensorValue)) {
+    t0 = sensor_metrics_now_us();
+    bool bno_ok = bno080.getSensorEvent(&sensorValue);
+    uint32_t bno_read_us = sensor_metrics_now_us() - t0;
+    // Pas d'evenement en attente: cas normal entre deux rapports, pas un echec
+    if (bno_ok) sensor_metrics_record_read(&g_sensor_metrics, METRICS_SENSOR_BNO080, bno_read_us, true);
+    else sensor_metrics_record_empty(&g_sensor_metrics, METRICS_SENSOR_BNO080, bno_read_us);
+    if (bno_ok) {
       switch (sensorValue.sensorId) {
         case SH2_ROTATION_VECTOR:
           g_sensor_data.bno080.quat_i = sensorValue.un.rotationVector.i;
@@ -87,11 +99,15 @@ static void sensors_i2c_task(void *pvParameters) {
     }
 
     // Lecture GPS
-    // Lecture GPS
+    t0 = sensor_metrics_now_us();
     char c = GPS_I2C_ESP32_read(&gps);
+    uint32_t gps_read_us = sensor_metrics_now_us() - t0;
     if (c) {
       if (GPS_I2C_ESP32_new_nmea_received(&gps)) {
-        if (GPS_I2C_ESP32_parse(&gps, GPS_I2C_ESP32_last_nmea(&gps))) {
+        bool gps_ok = GPS_I2C_ESP32_parse(&gps, GPS_I2C_ESP32_last_nmea(&gps));
+        // Une trame complete = une lecture au sens des metriques
+        sensor_metrics_record_read(&g_sensor_metrics, METRICS_SENSOR_GPS, gps_read_us, gps_ok);
+        if (gps_ok) {
           // Copier trame brute
           strncpy(g_sensor_data.gps.lastline,
                   GPS_I2C_ESP32_last_nmea(&gps),
@@ -137,10 +153,25 @@ static void sensors_i2c_task(void *pvParameters) {
       }
     }
 
+    sensor_metrics_record_loop(&g_sensor_metrics, METRICS_TASK_SENSORS,
+                               sensor_metrics_now_us() - loop_start_us, 1000000 / BMP390_SAMPLE_RATE_HZ);
+
     vTaskDelayUntil(&xLastWakeTime, xFrequency);
   }
 }
 
+// Envoi d'une commande PMTK et attente de son $PMTK001, un seul renvoi si pas d'acquittement
+static bool gps_send_acked(const char *cmd) {
+  for (int attempt = 0; attempt < 2; attempt++) {
+    GPS_I2C_ESP32_send_command(&gps, cmd);
+    if (GPS_I2C_ESP32_wait_for_sentence(&gps, "$PMTK001", GPS_ACK_MAX_SENTENCES, GPS_ACK_TIMEOUT_MS)) return true;
+#ifdef DEBUG_MODE
+    Serial.printf("[SENSORS] GPS no ack for %s\n", cmd);
+#endif
+  }
+  return false;
+}
+
 static bool sensors_i2c_init() {
   // Recuperer le bus I2C existant
   DEV_I2C_Port i2c_port = DEV_I2C_Get_Handle();
@@ -199,19 +230,20 @@ static bool sensors_i2c_init() {
     return false;
   }
 
-  // Attendre stabilisation
-  vTaskDelay(pdMS_TO_TICKS(500));
+  // Attendre la premiere trame NMEA (module pret) au lieu d'un delai fixe
+  if (!GPS_I2C_ESP32_wait_for_sentence(&gps, "$G", 1, GPS_READY_TIMEOUT_MS)) {
+#ifdef DEBUG_MODE
+    Serial.println("[SENSORS] GPS no NMEA before timeout");
+#endif
+  }
 
-  // Configuration GPS: trames RMC+GGA uniquement a 2Hz
-  GPS_I2C_ESP32_send_command(&gps, PMTK_SET_NMEA_OUTPUT_RMCGGA);
-  vTaskDelay(pdMS_TO_TICKS(100));
-  GPS_I2C_ESP32_send_command(&gps, PMTK_SET_NMEA_UPDATE_2HZ);
-  vTaskDelay(pdMS_TO_TICKS(100));
-  GPS_I2C_ESP32_send_command(&gps, PMTK_API_SET_FIX_CTL_2HZ);
-  vTaskDelay(pdMS_TO_TICKS(100));
+  // Configuration GPS: trames RMC+GGA uniquement a 2Hz, chaque commande acquittee par $PMTK001
+  bool gps_acked = gps_send_acked(PMTK_SET_NMEA_OUTPUT_RMCGGA);
+  gps_acked = gps_send_acked(PMTK_SET_NMEA_UPDATE_2HZ) && gps_acked;
+  gps_acked = gps_send_acked(PMTK_API_SET_FIX_CTL_2HZ) && gps_acked;
 
 #ifdef DEBUG_MODE
-  Serial.println("[SENSORS] GPS init OK (2Hz, RMC+GGA)");
+  Serial.printf("[SENSORS] GPS init OK (2Hz, RMC+GGA)%s\n", gps_acked ? "" : ", config not acked");
 #endif
 
   return true;
@@ -0,0 +1,412 @@
+#ifndef STORAGE_INDEX_H
+#define STORAGE_INDEX_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD_MMC.h>
+#include "constants.h"
+#include "src/sd_card.h"
+#include "src/storage_service.h"
+#include "src/tile_coverage_store.h"
+
+// =============================================================================
+// Index du stockage: espace libre, taille et nombre de fichiers par repertoire,
+// couverture des tuiles par zoom. Maintenu par la tache stockage:
+// - parcours complet decoupe en tranches (priorite web, jamais d'attente
+//   pour le journal ou les tuiles visibles)
+// - mise a jour incrementale a chaque ecriture/suppression du service; celles
+//   faites pendant un parcours sont reportees sur son resultat
+// - capacite relue paresseusement quand elle est trop ancienne
+// L'UI ne lit que la copie en memoire (storage_index_get).
+// =============================================================================
+
+#define STORAGE_INDEX_ZOOM_LEVELS 20   // Zooms 0..19
+#define STORAGE_INDEX_WALK_DEPTH 5     // /osm_tiles/<serveur>/<z>/<x>/<y>.bin
+
+typedef enum {
+  STORAGE_DIR_FLIGHTS = 0,
+  STORAGE_DIR_LOGS,
+  STORAGE_DIR_TILES,
+  STORAGE_DIR_CONFIG,
+  STORAGE_DIR_COUNT
+} storage_dir_t;
+
+typedef struct {
+  uint32_t files;
+  uint64_t bytes;
+} storage_dir_stats_t;
+
+typedef struct {
+  bool capacity_valid;
+  bool scan_valid;              // Au moins un parcours complet termine
+  bool scanning;
+  uint64_t total_kb;
+  uint64_t free_kb;
+  storage_dir_stats_t dirs[STORAGE_DIR_COUNT];  // Tuiles: fichiers <z>/<x>/<y>.bin seulement
+  uint32_t igc_files;
+  uint32_t tiles_per_zoom[STORAGE_INDEX_ZOOM_LEVELS];
+  uint32_t capacity_ms;         // millis() de la derniere lecture capacite
+  uint32_t scan_ms;             // millis() de fin du dernier parcours
+  uint32_t scan_duration_ms;
+} storage_index_t;
+
+static const char *const storage_index_dirs[STORAGE_DIR_COUNT] = {
+  FLIGHTS_DIR, LOGS_DIR, OSM_TILES_DIR, CONFIG_DIR
+};
+
+static storage_index_t storage_index = { 0 };
+static SemaphoreHandle_t storage_index_mutex = NULL;
+static volatile bool storage_index_capacity_pending = false;
+
+// Etat du parcours en cours (tache stockage uniquement)
+typedef struct {
+  int dir;                                  // Repertoire racine en cours
+  File stack[STORAGE_INDEX_WALK_DEPTH];
+  uint8_t depth;
+  int zoom;                                 // Zoom du sous-arbre de tuiles en cours
+  bool finished;
+  uint32_t start_ms;
+  storage_dir_stats_t dirs[STORAGE_DIR_COUNT];
+  uint32_t igc_files;
+  uint32_t tiles_per_zoom[STORAGE_INDEX_ZOOM_LEVELS];
+
+  // Changements du service pendant le parcours, dans des repertoires deja
+  // parcourus (ou en cours): ajoutes au resultat final
+  int32_t delta_files[STORAGE_DIR_COUNT];
+  int64_t delta_bytes[STORAGE_DIR_COUNT];
+  int32_t delta_igc;
+  int32_t delta_tiles[STORAGE_INDEX_ZOOM_LEVELS];
+} storage_index_walk_t;
+
+static storage_index_walk_t storage_index_walk;
+
+// ============================================================================
+// Classement d'un chemin
+// ============================================================================
+
+static int storage_index_dir_of(const char *path) {
+  for (int d = 0; d < STORAGE_DIR_COUNT; d++) {
+    size_t n = strlen(storage_index_dirs[d]);
+    if (strncmp(path, storage_index_dirs[d], n) == 0 && path[n] == '/') return d;
+  }
+  return -1;
+}
+
+// n chiffres decimaux exactement (atoi accepterait "abc" comme 0)
+static bool storage_index_is_number(const char *s, size_t n) {
+  if (n == 0) return false;
+  for (size_t i = 0; i < n; i++) {
+    if (!isdigit((unsigned char)s[i])) return false;
+  }
+  return true;
+}
+
+// Zoom d'une tuile "/osm_tiles/<serveur>/<z>/<x>/<y>.bin" (-1 sinon)
+static int storage_index_tile_zoom(const char *path) {
+  const char *p = path + strlen(OSM_TILES_DIR);
+  if (*p != '/') return -1;
+  p = strchr(p + 1, '/');  // Apres le serveur
+  if (!p) return -1;
+  const char *x = strchr(p + 1, '/');
+  if (!x || !storage_index_is_number(p + 1, x - p - 1)) return -1;
+  const char *y = strchr(x + 1, '/');
+  if (!y || !storage_index_is_number(x + 1, y - x - 1)) return -1;  // Pas un fichier <z>/<x>/<y>
+  int z = atoi(p + 1);
+  return (z >= 0 && z < STORAGE_INDEX_ZOOM_LEVELS) ? z : -1;
+}
+
+// Tuile "<z>/<x>/<y>.bin" (coverage.bin, download.job... exclus)
+static bool storage_index_is_tile_name(const char *name) {
+  size_t n = strlen(name);
+  return n >= 5 && strcmp(name + n - 4, ".bin") == 0 && storage_index_is_number(name, n - 4);
+}
+
+static int storage_index_tile_zoom_of_file(const char *path) {
+  const char *name = strrchr(path, '/');
+  return (name && storage_index_is_tile_name(name + 1)) ? storage_index_tile_zoom(path) : -1;
+}
+
+static bool storage_index_is_igc(const char *path) {
+  size_t n = strlen(path);
+  return n >= 4 && strcasecmp(path + n - 4, ".igc") == 0;
+}
+
+static bool storage_index_lock(void) {
+  return storage_index_mutex && xSemaphoreTake(storage_index_mutex, pdMS_TO_TICKS(10)) == pdTRUE;
+}
+
+static void storage_index_unlock(void) {
+  xSemaphoreGive(storage_index_mutex);
+}
+
+// ============================================================================
+// Mise a jour incrementale (appelee par le service apres chaque ecriture)
+// ============================================================================
+
+// Tache stockage (comme le parcours): pas de course avec storage_index_walk
+static void storage_index_on_change(const char *path, int32_t delta_files, int64_t delta_bytes) {
+  int d = storage_index_dir_of(path);
+  int z = (d == STORAGE_DIR_TILES) ? storage_index_tile_zoom_of_file(path) : -1;
+  if (d == STORAGE_DIR_TILES && z < 0) d = -1;  // Fichiers annexes des tuiles: pas comptes
+  bool igc = d == STORAGE_DIR_FLIGHTS && storage_index_is_igc(path);
+  if (d == STORAGE_DIR_TILES && delta_files > 0) tile_coverage_note_write(path);
+
+  // Parcours en cours: les repertoires pas encore atteints seront lus a jour
+  storage_index_walk_t *w = &storage_index_walk;
+  if (storage_index.scanning && d >= 0 && d <= w->dir) {
+    w->delta_files[d] += delta_files;
+    w->delta_bytes[d] += delta_bytes;
+    if (igc) w->delta_igc += delta_files;
+    if (z >= 0) w->delta_tiles[z] += delta_files;
+  }
+
+  if (!storage_index_lock()) return;
+  if (d >= 0) {
+    storage_dir_stats_t *ds = &storage_index.dirs[d];
+    ds->files = (uint32_t)max((int64_t)0, (int64_t)ds->files + delta_files);
+    ds->bytes = (uint64_t)max((int64_t)0, (int64_t)ds->bytes + delta_bytes);
+    if (igc) storage_index.igc_files = (uint32_t)max((int64_t)0, (int64_t)storage_index.igc_files + delta_files);
+    if (z >= 0) storage_index.tiles_per_zoom[z] = (uint32_t)max((int64_t)0, (int64_t)storage_index.tiles_per_zoom[z] + delta_files);
+  }
+
+  // Estimation jusqu'a la prochaine relecture (arrondi aux clusters ignore)
+  if (storage_index.capacity_valid) {
+    int64_t free_kb = (int64_t)storage_index.free_kb - delta_bytes / 1024;
+    storage_index.free_kb = (uint64_t)max((int64_t)0, free_kb);
+  }
+  storage_index_unlock();
+}
+
+// ============================================================================
+// Capacite
+// ============================================================================
+
+static bool storage_index_capacity_read(void *user) {
+  uint64_t total_kb, free_kb;
+  if (!sd_get_capacity(&total_kb, &free_kb)) return false;
+  if (storage_index_lock()) {
+    storage_index.total_kb = total_kb;
+    storage_index.free_kb = free_kb;
+    storage_index.capacity_valid = true;
+    storage_index.capacity_ms = millis();
+    storage_index_unlock();
+  }
+  return true;
+}
+
+static void storage_index_capacity_done(const storage_req_t *req) {
+  storage_index_capacity_pending = false;
+}
+
+static void storage_index_refresh_capacity(void) {
+  if (storage_index_capacity_pending) return;
+  storage_index_capacity_pending = true;
+  if (!storage_call_async(storage_index_capacity_read, NULL, STORAGE_PRIO_WEB, storage_index_capacity_done)) {
+    storage_index_capacity_pending = false;
+  }
+}
+
+// ============================================================================
+// Parcours complet par tranches
+// ============================================================================
+
+static void storage_index_walk_close(storage_index_walk_t *w) {
+  while (w->depth > 0) {
+    w->depth--;
+    w->stack[w->depth].close();
+    w->stack[w->depth] = File();
+  }
+}
+
+// Une tranche: au plus STORAGE_INDEX_SLICE_ENTRIES entrees; true quand termine
+static bool storage_index_walk_slice(storage_index_walk_t *w) {
+  uint32_t entries = 0;
+
+  while (entries < STORAGE_INDEX_SLICE_ENTRIES) {
+    // Repertoire racine suivant
+    if (w->depth == 0) {
+      if (w->dir >= STORAGE_DIR_COUNT) return true;
+      File root = SD_MMC.open(storage_index_dirs[w->dir]);
+      if (root && root.isDirectory()) {
+        w->stack[w->depth++] = root;
+      } else {
+        if (root) root.close();
+        w->dir++;
+      }
+      continue;
+    }
+
+    File *dir = &w->stack[w->depth - 1];
+    File entry = dir->openNextFile();
+    entries++;
+
+    if (!entry) {
+      dir->close();
+      *dir = File();
+      w->depth--;
+      if (w->depth == 0) w->dir++;
+      continue;
+    }
+
+    if (entry.isDirectory()) {
+      // Niveau zoom: /osm_tiles/<serveur>/<z>; autre nom: sous-arbre non compte
+      if (w->dir == STORAGE_DIR_TILES && w->depth == 2) {
+        const char *name = entry.name();
+        w->zoom = storage_index_is_number(name, strlen(name)) ? atoi(name) : -1;
+      }
+      if (w->depth < STORAGE_INDEX_WALK_DEPTH) {
+        w->stack[w->depth++] = entry;
+        continue;
+      }
+    } else if (w->dir != STORAGE_DIR_TILES) {
+      w->dirs[w->dir].files++;
+      w->dirs[w->dir].bytes += entry.size();
+      if (w->dir == STORAGE_DIR_FLIGHTS && storage_index_is_igc(entry.name())) w->igc_files++;
+    } else if (w->depth == 4 && w->zoom >= 0 && w->zoom < STORAGE_INDEX_ZOOM_LEVELS &&
+               storage_index_is_tile_name(entry.name()) &&
+               storage_index_is_number(w->stack[3].name(), strlen(w->stack[3].name()))) {
+      // Tuiles seulement: coverage.bin, download.job... ignores
+      w->dirs[w->dir].files++;
+      w->dirs[w->dir].bytes += entry.size();
+      w->tiles_per_zoom[w->zoom]++;
+      // stack: racine, serveur, zoom, x
+      tile_coverage_collect(w->stack[1].name(), w->zoom, (uint32_t)atoi(w->stack[3].name()),
+                            (uint32_t)atoi(entry.name()));
+    }
+    entry.close();
+  }
+  return false;
+}
+
+static inline uint32_t storage_index_add(uint32_t v, int64_t delta) {
+  return (uint32_t)max((int64_t)0, (int64_t)v + delta);
+}
+
+// Une tranche: true si le parcours avance (w->finished a la fin), false sur
+// erreur (carte retiree): la demande compte alors comme un echec du service
+static bool storage_index_scan_step(void *user) {
+  storage_index_walk_t *w = &storage_index_walk;
+  if (!sd_is_ready()) return false;
+  if (!storage_index_walk_slice(w)) return true;
+  w->finished = true;
+  tile_coverage_collect_end(true);
+
+  // Parcours termine: resultat + changements faits pendant le parcours
+  if (storage_index_lock()) {
+    for (int d = 0; d < STORAGE_DIR_COUNT; d++) {
+      storage_index.dirs[d].files = storage_index_add(w->dirs[d].files, w->delta_files[d]);
+      storage_index.dirs[d].bytes = (uint64_t)max((int64_t)0, (int64_t)w->dirs[d].bytes + w->delta_bytes[d]);
+    }
+    for (int z = 0; z < STORAGE_INDEX_ZOOM_LEVELS; z++) {
+      storage_index.tiles_per_zoom[z] = storage_index_add(w->tiles_per_zoom[z], w->delta_tiles[z]);
+    }
+    storage_index.igc_files = storage_index_add(w->igc_files, w->delta_igc);
+    storage_index.scan_valid = true;
+    storage_index.scan_ms = millis();
+    storage_index.scan_duration_ms = storage_index.scan_ms - w->start_ms;
+    storage_index_unlock();
+  }
+#ifdef DEBUG_MODE
+  Serial.printf("[INDEX] Scan done in %lu ms: %lu flights, %lu tiles\n",
+                (unsigned long)(millis() - w->start_ms),
+                (unsigned long)w->dirs[STORAGE_DIR_FLIGHTS].files,
+                (unsigned long)w->dirs[STORAGE_DIR_TILES].files);
+#endif
+  return true;
+}
+
+// Debut du parcours, sur la tache stockage comme les tranches et
+// storage_index_on_change: l'etat du parcours n'est jamais touche ailleurs
+static bool storage_index_scan_begin(void *user) {
+  storage_index_walk_t *w = &storage_index_walk;
+  storage_index_walk_close(w);
+  w->dir = 0;
+  w->zoom = -1;
+  w->finished = false;
+  w->igc_files = 0;
+  memset(w->dirs, 0, sizeof(w->dirs));
+  memset(w->tiles_per_zoom, 0, sizeof(w->tiles_per_zoom));
+  memset(w->delta_files, 0, sizeof(w->delta_files));
+  memset(w->delta_bytes, 0, sizeof(w->delta_bytes));
+  w->delta_igc = 0;
+  memset(w->delta_tiles, 0, sizeof(w->delta_tiles));
+  w->start_ms = millis();
+  tile_coverage_collect_begin();
+  return storage_index_scan_step(user);
+}
+
+// Tranche suivante re-postee en file: les demandes prioritaires passent entre deux
+static void storage_index_scan_done(const storage_req_t *req) {
+  if (req->ok && storage_index_walk.finished) {
+    storage_index.scanning = false;
+    return;
+  }
+  if (!req->ok || !storage_call_async(storage_index_scan_step, NULL, STORAGE_PRIO_WEB, storage_index_scan_done)) {
+    storage_index_walk_close(&storage_index_walk);
+    tile_coverage_collect_end(false);
+    storage_index.scanning = false;
+  }
+}
+
+// ============================================================================
+// API publique
+// ============================================================================
+
+// A appeler apres storage_service_start()
+void storage_index_init(void) {
+  if (storage_index_mutex == NULL) storage_index_mutex = xSemaphoreCreateMutex();
+  storage_set_change_cb(storage_index_on_change);
+}
+
+// Parcours complet en arriere-plan (ignore si deja en cours). Appelable de
+// toute tache: seul le drapeau est pris ici, sous le mutex, le parcours
+// est initialise par storage_index_scan_begin sur la tache stockage.
+void storage_index_rescan(void) {
+  if (!sd_is_ready() || !storage_index_lock()) return;
+  bool busy = storage_index.scanning;
+  storage_index.scanning = true;
+  storage_index_unlock();
+  if (busy) return;
+
+  if (!storage_call_async(storage_index_scan_begin, NULL, STORAGE_PRIO_WEB, storage_index_scan_done)) {
+    storage_index.scanning = false;
+  }
+  storage_index_refresh_capacity();
+}
+
+// Copie des valeurs en cache, jamais d'acces carte. Relance paresseusement
+// la capacite si trop ancienne et un parcours s'il n'a jamais eu lieu.
+bool storage_index_get(storage_index_t *out) {
+  if (!storage_index_lock()) return false;
+  *out = storage_index;
+  storage_index_unlock();
+
+  if (sd_is_ready()) {
+    if (!out->capacity_valid || millis() - out->capacity_ms > STORAGE_INDEX_CAPACITY_MAX_AGE_MS) {
+      storage_index_refresh_capacity();
+    }
+    if (!out->scan_valid && !out->scanning) storage_index_rescan();
+  }
+  return true;
+}
+
+// Couverture des tuiles reconstruite par un nouveau parcours (apres telechargement)
+void storage_index_rebuild_coverage(void) {
+  storage_index_rescan();
+}
+
+// Nombre de zooms ayant au moins une tuile, et bornes
+int storage_index_tile_zoom_range(const storage_index_t *idx, int *zmin, int *zmax) {
+  int n = 0;
+  *zmin = -1;
+  *zmax = -1;
+  for (int z = 0; z < STORAGE_INDEX_ZOOM_LEVELS; z++) {
+    if (idx->tiles_per_zoom[z] == 0) continue;
+    if (*zmin < 0) *zmin = z;
+    *zmax = z;
+    n++;
+  }
+  return n;
+}
+
+#endif
@@ -0,0 +1,499 @@
+#ifndef STORAGE_SERVICE_H
+#define STORAGE_SERVICE_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SD_MMC.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "esp_timer.h"
+#include "constants.h"
+#include "globals.h"
+#include "src/sd_card.h"
+
+// =============================================================================
+// Service de stockage: une seule tache possede la carte SD et sert les
+// demandes des autres taches par ordre de priorite (journal de vol > terrain >
+// tuiles visibles > prechargement > telechargements web).
+// Les transferts longs sont decoupes en blocs de STORAGE_IO_BUF_SIZE; entre deux
+// blocs, les demandes plus prioritaires passent devant. Les blocs transitent
+// par un tampon SRAM interne aligne: le controleur SDMMC fait un seul DMA
+// multi-secteurs au lieu d'une copie par secteur depuis la PSRAM.
+// =============================================================================
+
+typedef enum {
+  STORAGE_PRIO_LOG = 0,         // Ecritures journal de vol
+  STORAGE_PRIO_TERRAIN,
+  STORAGE_PRIO_TILE_VISIBLE,    // Tuiles de la vue affichee (thread LVGL)
+  STORAGE_PRIO_TILE_PREFETCH,
+  STORAGE_PRIO_WEB,             // Serveur de fichiers, statistiques carte
+  STORAGE_PRIO_COUNT
+} storage_prio_t;
+
+typedef enum {
+  STORAGE_OP_READ,    // buf[len] <- fichier a partir de offset
+  STORAGE_OP_WRITE,   // Fichier recree avec buf[len]
+  STORAGE_OP_APPEND,
+  STORAGE_OP_SIZE,    // Taille du fichier dans done
+  STORAGE_OP_REMOVE,
+  STORAGE_OP_CALL     // fn(user) executee par la tache, carte reservee
+} storage_op_t;
+
+typedef struct storage_req_s storage_req_t;
+
+// Fin de demande asynchrone, appelee depuis la tache stockage
+typedef void (*storage_done_cb_t)(const storage_req_t *req);
+typedef bool (*storage_fn_t)(void *user);
+
+// Fichier cree, modifie ou supprime par le service (mise a jour de l'index)
+typedef void (*storage_change_cb_t)(const char *path, int32_t delta_files, int64_t delta_bytes);
+
+struct storage_req_s {
+  storage_op_t op;
+  storage_prio_t prio;
+  char path[STORAGE_PATH_MAX];
+  uint8_t *buf;                 // Doit rester valide jusqu'a la fin de la demande
+  size_t offset;
+  size_t len;
+  storage_fn_t fn;
+  storage_done_cb_t cb;
+  void *user;
+
+  // Resultat
+  bool ok;
+  size_t done;                  // Octets transferes (ou taille pour STORAGE_OP_SIZE)
+
+  // Interne
+  uint32_t submit_ms;
+  storage_req_t *origin;        // Demande bloquante: resultat recopie ici
+  SemaphoreHandle_t done_sem;
+};
+
+typedef struct {
+  uint32_t requests;
+  uint32_t failures;
+  uint32_t bytes;
+  uint32_t wait_sum_ms;         // Attente en file (moyenne = wait_sum_ms / requests)
+  uint32_t wait_max_ms;
+} storage_prio_stats_t;
+
+typedef struct {
+  storage_prio_stats_t prio[STORAGE_PRIO_COUNT];
+  uint64_t bytes_read;
+  uint64_t bytes_written;
+  uint64_t busy_us;             // Temps carte occupee (debit = octets / busy_us)
+  uint32_t preemptions;         // Demandes servies entre deux blocs d'une autre
+  uint32_t rejected;            // File pleine
+  bool io_buf_internal;         // Tampon SRAM DMA obtenu
+} storage_stats_t;
+
+static TaskHandle_t storage_task_handle = NULL;
+static QueueHandle_t storage_queues[STORAGE_PRIO_COUNT] = { NULL };
+static SemaphoreHandle_t storage_wake = NULL;
+static uint8_t *storage_io_buf = NULL;
+static storage_stats_t storage_stats = { 0 };
+static storage_change_cb_t storage_change_cb = NULL;
+static uint8_t storage_depth = 0;  // Demandes imbriquees (preemption)
+static char storage_last_append[STORAGE_PATH_MAX] = { 0 };  // Dernier ajout reussi: le fichier existe
+
+static bool storage_execute(storage_req_t *req, bool preemptible);
+
+// ============================================================================
+// Tampons alignes
+// ============================================================================
+
+// Tampon DMA: SRAM interne si possible, sinon PSRAM alignee
+static void *storage_buf_alloc(size_t size) {
+  void *p = heap_caps_aligned_alloc(STORAGE_BUF_ALIGN, size, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  if (!p) p = heap_caps_aligned_alloc(STORAGE_BUF_ALIGN, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  return p;
+}
+
+static void storage_buf_free(void *p) {
+  heap_caps_free(p);
+}
+
+static inline bool storage_buf_direct(const void *p) {
+  return esp_ptr_dma_capable(p) && ((uintptr_t)p % 4) == 0;
+}
+
+// ============================================================================
+// Execution (tache stockage uniquement)
+// ============================================================================
+
+static bool storage_higher_pending(storage_prio_t prio) {
+  for (int p = 0; p < (int)prio; p++) {
+    if (uxQueueMessagesWaiting(storage_queues[p]) > 0) return true;
+  }
+  return false;
+}
+
+// Sert les demandes strictement plus prioritaires qu'un transfert en cours
+static void storage_serve_higher(storage_prio_t prio) {
+  storage_req_t other;
+  for (int p = 0; p < (int)prio; p++) {
+    while (xQueueReceive(storage_queues[p], &other, 0) == pdTRUE) {
+      storage_stats.preemptions++;
+      storage_execute(&other, false);
+    }
+  }
+}
+
+static bool storage_do_read(storage_req_t *req, bool preemptible) {
+  if (!SD_MMC.exists(req->path)) return false;
+  File f = SD_MMC.open(req->path, FILE_READ);
+  if (!f) return false;
+  if (req->offset && !f.seek(req->offset)) {
+    f.close();
+    return false;
+  }
+
+  uint8_t *dst = req->buf;
+  size_t left = req->len;
+  while (left > 0) {
+    size_t n = min(left, (size_t)STORAGE_IO_BUF_SIZE);
+    uint8_t *io = (storage_buf_direct(dst) || !storage_io_buf) ? dst : storage_io_buf;
+    size_t got = f.read(io, n);
+    if (io != dst) memcpy(dst, io, got);
+    req->done += got;
+    dst += got;
+    left -= got;
+    if (got != n) break;
+    if (preemptible && left > 0 && storage_higher_pending(req->prio)) {
+      f.close();  // Fichier ferme pendant les demandes prioritaires (FATFS partage)
+      storage_serve_higher(req->prio);
+      f = SD_MMC.open(req->path, FILE_READ);
+      if (!f || !f.seek(req->offset + req->done)) break;
+    }
+  }
+  if (f) f.close();
+  storage_stats.bytes_read += req->done;
+  return req->done == req->len;
+}
+
+static bool storage_do_write(storage_req_t *req, bool preemptible) {
+  File f = SD_MMC.open(req->path, req->op == STORAGE_OP_APPEND ? FILE_APPEND : FILE_WRITE);
+  if (!f) return false;
+
+  const uint8_t *src = req->buf;
+  size_t left = req->len;
+  while (left > 0) {
+    size_t n = min(left, (size_t)STORAGE_IO_BUF_SIZE);
+    const uint8_t *io = src;
+    if (!storage_buf_direct(src) && storage_io_buf) {
+      memcpy(storage_io_buf, src, n);
+      io = storage_io_buf;
+    }
+    size_t put = f.write(io, n);
+    req->done += put;
+    src += put;
+    left -= put;
+    if (put != n) break;
+    if (preemptible && left > 0 && storage_higher_pending(req->prio)) {
+      f.close();
+      storage_serve_higher(req->prio);
+      f = SD_MMC.open(req->path, FILE_APPEND);
+      if (!f) break;
+    }
+  }
+  if (f) f.close();
+  storage_stats.bytes_written += req->done;
+  return req->done == req->len;
+}
+
+// Taille d'un fichier existant (false si absent)
+static bool storage_stat_size(const char *path, size_t *size) {
+  if (!SD_MMC.exists(path)) return false;
+  File f = SD_MMC.open(path, FILE_READ);
+  if (!f) return false;
+  *size = f.size();
+  f.close();
+  return true;
+}
+
+static bool storage_execute(storage_req_t *req, bool preemptible) {
+  uint32_t now_ms = millis();
+  uint32_t wait_ms = now_ms - req->submit_ms;
+  int64_t t0 = esp_timer_get_time();
+
+  req->done = 0;
+  req->ok = false;
+  storage_depth++;
+  if (req->op == STORAGE_OP_CALL) {
+    req->ok = req->fn ? req->fn(req->user) : false;
+  } else if (sd_is_ready()) {
+    switch (req->op) {
+      case STORAGE_OP_READ:
+        req->ok = storage_do_read(req, preemptible);
+        break;
+      case STORAGE_OP_WRITE:
+      case STORAGE_OP_APPEND: {
+        // L'index a besoin de l'ancienne taille pour une reecriture; pour un
+        // ajout, seulement de savoir si le fichier est nouveau (journal: deja connu)
+        size_t old_size = 0;
+        bool existed = false;
+        if (storage_change_cb) {
+          if (req->op == STORAGE_OP_WRITE) {
+            existed = storage_stat_size(req->path, &old_size);
+          } else {
+            existed = strcmp(req->path, storage_last_append) == 0 || SD_MMC.exists(req->path);
+          }
+        }
+        req->ok = storage_do_write(req, preemptible);
+        if (req->op == STORAGE_OP_APPEND && req->ok) {
+          strlcpy(storage_last_append, req->path, sizeof(storage_last_append));
+        } else if (strcmp(req->path, storage_last_append) == 0) {
+          storage_last_append[0] = '\0';
+        }
+        if (storage_change_cb && req->done > 0) {
+          int64_t delta = (req->op == STORAGE_OP_WRITE) ? (int64_t)req->done - (int64_t)old_size : (int64_t)req->done;
+          storage_change_cb(req->path, existed ? 0 : 1, delta);
+        }
+        break;
+      }
+      case STORAGE_OP_SIZE:
+        if (SD_MMC.exists(req->path)) {
+          File f = SD_MMC.open(req->path, FILE_READ);
+          if (f) {
+            req->done = f.size();
+            req->ok = true;
+            f.close();
+          }
+        }
+        break;
+      case STORAGE_OP_REMOVE: {
+        size_t old_size = 0;
+        bool existed = storage_change_cb && storage_stat_size(req->path, &old_size);
+        req->ok = SD_MMC.remove(req->path);
+        if (strcmp(req->path, storage_last_append) == 0) storage_last_append[0] = '\0';
+        if (req->ok && existed) storage_change_cb(req->path, -1, -(int64_t)old_size);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  // Temps d'une demande preemptee deja compte par la demande englobante
+  if (--storage_depth == 0) storage_stats.busy_us += esp_timer_get_time() - t0;
+  storage_prio_stats_t *ps = &storage_stats.prio[req->prio];
+  ps->requests++;
+  if (!req->ok) ps->failures++;
+  ps->bytes += req->done;
+  ps->wait_sum_ms += wait_ms;
+  if (wait_ms > ps->wait_max_ms) ps->wait_max_ms = wait_ms;
+
+  if (req->origin) {
+    req->origin->ok = req->ok;
+    req->origin->done = req->done;
+  }
+  if (req->cb) req->cb(req);
+  if (req->done_sem) xSemaphoreGive(req->done_sem);
+  return req->ok;
+}
+
+static void storage_task(void *pvParameters) {
+#ifdef DEBUG_MODE
+  Serial.printf("[STORAGE] Task started (tampon %s)\n", storage_stats.io_buf_internal ? "SRAM DMA" : "PSRAM");
+#endif
+
+  storage_req_t req;
+  while (1) {
+    xSemaphoreTake(storage_wake, portMAX_DELAY);
+
+    // Toujours la demande la plus prioritaire en tete
+    bool served = true;
+    while (served) {
+      served = false;
+      for (int p = 0; p < STORAGE_PRIO_COUNT && !served; p++) {
+        if (xQueueReceive(storage_queues[p], &req, 0) == pdTRUE) {
+          storage_execute(&req, true);
+          served = true;
+        }
+      }
+    }
+  }
+}
+
+// ============================================================================
+// API publique
+// ============================================================================
+
+bool storage_service_start(void) {
+  if (storage_task_handle != NULL) return true;
+
+  for (int p = 0; p < STORAGE_PRIO_COUNT; p++) {
+    storage_queues[p] = xQueueCreate(STORAGE_QUEUE_DEPTH, sizeof(storage_req_t));
+    if (!storage_queues[p]) return false;
+  }
+  storage_wake = xSemaphoreCreateBinary();
+  if (!storage_wake) return false;
+
+  storage_io_buf = (uint8_t *)heap_caps_aligned_alloc(STORAGE_BUF_ALIGN, STORAGE_IO_BUF_SIZE,
+                                                      MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  storage_stats.io_buf_internal = (storage_io_buf != NULL);
+
+  BaseType_t ret = xTaskCreatePinnedToCore(
+    storage_task,
+    "storage",
+    STORAGE_TASK_STACK_SIZE,
+    NULL,
+    STORAGE_TASK_PRIORITY,
+    &storage_task_handle,
+    0);
+
+  return (ret == pdPASS);
+}
+
+// Demande asynchrone (copiee): cb appele depuis la tache stockage
+bool storage_submit(const storage_req_t *req) {
+  if ((unsigned)req->prio >= STORAGE_PRIO_COUNT) return false;
+  storage_req_t copy = *req;
+  copy.submit_ms = millis();
+  copy.done = 0;
+  copy.ok = false;
+
+  // Service absent (demarrage) ou appel bloquant depuis la tache elle-meme: execution directe.
+  // Une demande asynchrone emise par la tache (suite d'un traitement decoupe) passe par la file.
+  bool from_service = (xTaskGetCurrentTaskHandle() == storage_task_handle);
+  if (storage_task_handle == NULL || (from_service && copy.done_sem != NULL)) {
+    bool locked = (storage_task_handle == NULL && sd_mutex != NULL);
+    if (locked && !xSemaphoreTake(sd_mutex, portMAX_DELAY)) return false;
+    storage_execute(&copy, false);
+    if (locked) xSemaphoreGive(sd_mutex);
+    return true;
+  }
+
+  TickType_t wait = from_service ? 0 : pdMS_TO_TICKS(STORAGE_SUBMIT_TIMEOUT_MS);
+  if (xQueueSend(storage_queues[copy.prio], &copy, wait) != pdTRUE) {
+    storage_stats.rejected++;
+    return false;
+  }
+  xSemaphoreGive(storage_wake);
+  return true;
+}
+
+// Demande bloquante: resultat dans req->ok / req->done
+bool storage_run(storage_req_t *req) {
+  StaticSemaphore_t sem_buf;
+  req->origin = req;
+  req->cb = NULL;
+  req->done_sem = xSemaphoreCreateBinaryStatic(&sem_buf);
+  req->ok = false;
+
+  bool queued = storage_submit(req);
+  // Execution directe: semaphore deja donne
+  if (queued) xSemaphoreTake(req->done_sem, portMAX_DELAY);
+  vSemaphoreDelete(req->done_sem);
+  req->done_sem = NULL;
+  return queued && req->ok;
+}
+
+static void storage_req_init(storage_req_t *req, storage_op_t op, storage_prio_t prio, const char *path) {
+  memset(req, 0, sizeof(storage_req_t));
+  req->op = op;
+  req->prio = prio;
+  if (path) strlcpy(req->path, path, sizeof(req->path));
+}
+
+// --- Raccourcis bloquants ---
+
+bool storage_read(const char *path, size_t offset, void *buf, size_t len, storage_prio_t prio, size_t *got = NULL) {
+  storage_req_t req;
+  storage_req_init(&req, STORAGE_OP_READ, prio, path);
+  req.buf = (uint8_t *)buf;
+  req.offset = offset;
+  req.len = len;
+  bool ok = storage_run(&req);
+  if (got) *got = req.done;
+  return ok;
+}
+
+bool storage_write(const char *path, const void *data, size_t len, storage_prio_t prio) {
+  storage_req_t req;
+  storage_req_init(&req, STORAGE_OP_WRITE, prio, path);
+  req.buf = (uint8_t *)data;
+  req.len = len;
+  return storage_run(&req);
+}
+
+bool storage_append(const char *path, const void *data, size_t len, storage_prio_t prio) {
+  storage_req_t req;
+  storage_req_init(&req, STORAGE_OP_APPEND, prio, path);
+  req.buf = (uint8_t *)data;
+  req.len = len;
+  return storage_run(&req);
+}
+
+bool storage_file_size(const char *path, size_t *size, storage_prio_t prio) {
+  storage_req_t req;
+  storage_req_init(&req, STORAGE_OP_SIZE, prio, path);
+  bool ok = storage_run(&req);
+  if (ok) *size = req.done;
+  return ok;
+}
+
+bool storage_remove(const char *path, storage_prio_t prio) {
+  storage_req_t req;
+  storage_req_init(&req, STORAGE_OP_REMOVE, prio, path);
+  return storage_run(&req);
+}
+
+// A appeler entre deux blocs d'une fonction STORAGE_OP_CALL longue (tache
+// stockage): sert les demandes plus prioritaires que prio, fichiers laisses ouverts
+void storage_yield_higher(storage_prio_t prio) {
+  if (storage_higher_pending(prio)) storage_serve_higher(prio);
+}
+
+// Sequence d'acces libre (seek, repertoires...) executee par la tache stockage
+bool storage_call(storage_fn_t fn, void *user, storage_prio_t prio) {
+  storage_req_t req;
+  storage_req_init(&req, STORAGE_OP_CALL, prio, NULL);
+  req.fn = fn;
+  req.user = user;
+  return storage_run(&req);
+}
+
+// --- Raccourcis asynchrones ---
+
+bool storage_append_async(const char *path, const void *data, size_t len, storage_prio_t prio,
+                          storage_done_cb_t cb, void *user) {
+  storage_req_t req;
+  storage_req_init(&req, STORAGE_OP_APPEND, prio, path);
+  req.buf = (uint8_t *)data;
+  req.len = len;
+  req.cb = cb;
+  req.user = user;
+  return storage_submit(&req);
+}
+
+bool storage_call_async(storage_fn_t fn, void *user, storage_prio_t prio, storage_done_cb_t cb) {
+  storage_req_t req;
+  storage_req_init(&req, STORAGE_OP_CALL, prio, NULL);
+  req.fn = fn;
+  req.user = user;
+  req.cb = cb;
+  return storage_submit(&req);
+}
+
+void storage_set_change_cb(storage_change_cb_t cb) {
+  storage_change_cb = cb;
+}
+
+void storage_get_stats(storage_stats_t *out) {
+  *out = storage_stats;
+}
+
+// Demandes en attente, tous niveaux
+uint32_t storage_pending(void) {
+  uint32_t n = 0;
+  for (int p = 0; p < STORAGE_PRIO_COUNT; p++) {
+    if (storage_queues[p]) n += uxQueueMessagesWaiting(storage_queues[p]);
+  }
+  return n;
+}
+
+#endif
@@ -0,0 +1,187 @@
+#ifndef TASK_PROFILER_H
+#define TASK_PROFILER_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_heap_caps.h"
+#include "constants.h"
+
+// =============================================================================
+// Profileur taches: echantillonne periodiquement la part CPU, la marge de pile
+// des taches applicatives et l'etat SRAM/PSRAM dans un buffer circulaire.
+// =============================================================================
+
+// Taches suivies (noms passes a xTaskCreatePinnedToCore)
+static const char *const profiler_task_names[PROFILER_TASK_COUNT] = {
+  "sensors_i2c",
+  "kalman",
+  "FlightData",
+  "LVGL",
+  "TileCache",
+  "metar_task",
+  "file_server",
+  "audio_vario",
+  "storage"
+};
+
+// Un echantillon
+typedef struct {
+  uint16_t cpu_permille[PROFILER_TASK_COUNT];  // Part d'un coeur (0-1000), PROFILER_NOT_RUNNING si absente
+  bool cpu_available;                          // false sans configGENERATE_RUN_TIME_STATS (cpu_permille a 0)
+  uint32_t stack_free[PROFILER_TASK_COUNT];    // Marge de pile minimale (octets)
+  uint32_t sram_free;
+  uint32_t sram_largest;
+  uint32_t psram_free;
+  uint32_t psram_largest;
+  uint32_t timestamp;  // millis()
+} profiler_sample_t;
+
+static profiler_sample_t *profiler_ring = NULL;
+static uint16_t profiler_head = 0;
+static uint16_t profiler_count = 0;
+static SemaphoreHandle_t profiler_mutex = NULL;
+static TaskHandle_t profiler_task_handle = NULL;
+static TaskStatus_t *profiler_status = NULL;
+static uint32_t profiler_prev_runtime[PROFILER_TASK_COUNT] = { 0 };
+static uint32_t profiler_prev_total = 0;
+
+// Fragmentation en %: 0 = un seul bloc libre, 100 = totalement fragmente
+static inline uint8_t task_profiler_fragmentation(uint32_t free_bytes, uint32_t largest_block) {
+  if (free_bytes == 0) return 0;
+  return (uint8_t)(100 - (uint64_t)largest_block * 100 / free_bytes);
+}
+
+static int profiler_find_task(const char *name) {
+  for (int i = 0; i < PROFILER_TASK_COUNT; i++) {
+    if (strcmp(name, profiler_task_names[i]) == 0) return i;
+  }
+  return -1;
+}
+
+// Prise d'un echantillon
+static void profiler_take_sample(profiler_sample_t *s) {
+  for (int i = 0; i < PROFILER_TASK_COUNT; i++) {
+    s->cpu_permille[i] = PROFILER_NOT_RUNNING;
+    s->stack_free[i] = 0;
+  }
+
+  uint32_t total = 0;
+  UBaseType_t n = uxTaskGetSystemState(profiler_status, PROFILER_MAX_TASKS, &total);
+  uint32_t total_delta = total - profiler_prev_total;
+
+  for (UBaseType_t x = 0; x < n; x++) {
+    int idx = profiler_find_task(profiler_status[x].pcTaskName);
+    if (idx < 0) continue;
+
+    // Sous ESP-IDF la pile est comptee en octets
+    s->stack_free[idx] = profiler_status[x].usStackHighWaterMark;
+
+#if configGENERATE_RUN_TIME_STATS
+    uint32_t runtime = profiler_status[x].ulRunTimeCounter;
+    uint32_t delta = runtime - profiler_prev_runtime[idx];
+    profiler_prev_runtime[idx] = runtime;
+    uint32_t permille = (profiler_prev_total && total_delta) ? (uint32_t)((uint64_t)delta * 1000 / total_delta) : 0;
+    s->cpu_permille[idx] = (permille > 1000) ? 1000 : (uint16_t)permille;
+#else
+    s->cpu_permille[idx] = 0;
+#endif
+  }
+  profiler_prev_total = total;
+  s->cpu_available = configGENERATE_RUN_TIME_STATS;
+
+  s->sram_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+  s->sram_largest = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL);
+  s->psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+  s->psram_largest = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+  s->timestamp = millis();
+}
+
+static void task_profiler_task(void *pvParameters) {
+  TickType_t last_wake = xTaskGetTickCount();
+  profiler_sample_t sample;
+
+#ifdef DEBUG_MODE
+  Serial.println("[PROFILER] Task started");
+#endif
+
+  while (1) {
+    profiler_take_sample(&sample);
+
+    if (xSemaphoreTake(profiler_mutex, pdMS_TO_TICKS(5))) {
+      profiler_ring[profiler_head] = sample;
+      profiler_head = (profiler_head + 1) % PROFILER_HISTORY_SIZE;
+      if (profiler_count < PROFILER_HISTORY_SIZE) profiler_count++;
+      xSemaphoreGive(profiler_mutex);
+    }
+
+    vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(PROFILER_SAMPLE_PERIOD_MS));
+  }
+}
+
+// Demarrage
+bool task_profiler_start(void) {
+  if (profiler_task_handle != NULL) return true;
+
+  if (!profiler_ring) {
+    profiler_ring = (profiler_sample_t *)heap_caps_calloc(PROFILER_HISTORY_SIZE, sizeof(profiler_sample_t), MALLOC_CAP_SPIRAM);
+    profiler_status = (TaskStatus_t *)heap_caps_malloc(PROFILER_MAX_TASKS * sizeof(TaskStatus_t), MALLOC_CAP_SPIRAM);
+  }
+  if (!profiler_mutex) profiler_mutex = xSemaphoreCreateMutex();
+
+  if (!profiler_ring || !profiler_status || !profiler_mutex) {
+#ifdef DEBUG_MODE
+    Serial.println("[PROFILER] Allocation failed");
+#endif
+    return false;
+  }
+
+  BaseType_t ret = xTaskCreatePinnedToCore(
+    task_profiler_task,
+    "profiler",
+    PROFILER_TASK_STACK_SIZE,
+    NULL,
+    PROFILER_TASK_PRIORITY,
+    &profiler_task_handle,
+    0);
+
+  if (ret != pdPASS) {
+#ifdef DEBUG_MODE
+    Serial.println("[PROFILER] Task creation failed");
+#endif
+    return false;
+  }
+
+  return true;
+}
+
+// Dernier echantillon
+bool task_profiler_get_latest(profiler_sample_t *out) {
+  if (!profiler_mutex || profiler_count == 0) return false;
+
+  if (xSemaphoreTake(profiler_mutex, pdMS_TO_TICKS(10))) {
+    *out = profiler_ring[(profiler_head + PROFILER_HISTORY_SIZE - 1) % PROFILER_HISTORY_SIZE];
+    xSemaphoreGive(profiler_mutex);
+    return true;
+  }
+  return false;
+}
+
+// Historique du plus ancien au plus recent, retourne le nombre copie
+int task_profiler_get_history(profiler_sample_t *out, int max_samples) {
+  if (!profiler_mutex || profiler_count == 0) return 0;
+
+  int n = 0;
+  if (xSemaphoreTake(profiler_mutex, pdMS_TO_TICKS(10))) {
+    n = (profiler_count < max_samples) ? profiler_count : max_samples;
+    int start = (profiler_head + PROFILER_HISTORY_SIZE - n) % PROFILER_HISTORY_SIZE;
+    for (int i = 0; i < n; i++) {
+      out[i] = profiler_ring[(start + i) % PROFILER_HISTORY_SIZE];
+    }
+    xSemaphoreGive(profiler_mutex);
+  }
+  return n;
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "SD_MMC.h"
 #include "constants.h"
+#include "src/storage_service.h"
 
 class TerrainElevation {
 private:
@@ -50,27 +51,14 @@ private:
       return true;
     }
 
-    extern SemaphoreHandle_t sd_mutex;
-    if (!sd_mutex || !xSemaphoreTake(sd_mutex, pdMS_TO_TICKS(1000))) {
-#ifdef DEBUG_MODE
-      Serial.println("[TERRAIN] SD mutex timeout");
-#endif
-      return false;
-    }
-
-    File file = SD_MMC.open(filename.c_str(), FILE_READ);
-    if (!file) {
+    size_t fileSize = 0;
+    if (!storage_file_size(filename.c_str(), &fileSize, STORAGE_PRIO_TERRAIN)) {
 #ifdef DEBUG_MODE
       Serial.printf("[TERRAIN] Cannot open: %s\n", filename.c_str());
 #endif
-      xSemaphoreGive(sd_mutex);
       return false;
     }
 
-    size_t fileSize = file.size();
-    file.close();
-    xSemaphoreGive(sd_mutex);
-
     if (fileSize == 1201 * 1201 * sizeof(int16_t)) {
       gridSize = HGT_SRTM3_SIZE;
 #ifdef DEBUG_MODE
@@ -99,6 +87,50 @@ private:
     return true;
   }
 
+  // Lecture ligne par ligne de la zone (execute par la tache stockage)
+  bool readCacheRows() {
+    File file = SD_MMC.open(cachedFilename.c_str(), FILE_READ);
+    if (!file) {
+#ifdef DEBUG_MODE
+      Serial.printf("[TERRAIN] Cannot reopen: %s\n", cachedFilename.c_str());
+#endif
+      return false;
+    }
+
+    uint8_t lineBuffer[CACHE_MAX_SIZE * 2];
+
+    for (int r = 0; r < cacheSize; r++) {
+      int fileRow = cacheStartRow + r;
+      size_t offset = fileRow * gridSize * sizeof(int16_t) + cacheStartCol * sizeof(int16_t);
+
+      file.seek(offset);
+      size_t bytesToRead = cacheSize * sizeof(int16_t);
+      size_t bytesRead = file.read(lineBuffer, bytesToRead);
+
+      if (bytesRead != bytesToRead) {
+#ifdef DEBUG_MODE
+        Serial.printf("[TERRAIN] Read error row %d\n", r);
+#endif
+        file.close();
+        return false;
+      }
+
+      // Conversion big-endian
+      for (int c = 0; c < cacheSize; c++) {
+        uint8_t high = lineBuffer[c * 2];
+        uint8_t low = lineBuffer[c * 2 + 1];
+        cacheData[r * CACHE_MAX_SIZE + c] = (int16_t)((high << 8) | low);
+      }
+    }
+
+    file.close();
+    return true;
+  }
+
+  static bool readCacheRowsCb(void* self) {
+    return ((TerrainElevation*)self)->readCacheRows();
+  }
+
   // Charge zone carrée autour position
   bool loadCacheAround(float lat, float lon) {
     // Vérifier si position encore dans cache valide
@@ -150,54 +182,11 @@ private:
                   cacheSize, cacheSize, halfSize * pixelSizeM);
 #endif
 
-    extern SemaphoreHandle_t sd_mutex;
-    if (!sd_mutex || !xSemaphoreTake(sd_mutex, pdMS_TO_TICKS(2000))) {
-#ifdef DEBUG_MODE
-      Serial.println("[TERRAIN] SD mutex timeout");
-#endif
-      return false;
-    }
-
-    File file = SD_MMC.open(cachedFilename.c_str(), FILE_READ);
-    if (!file) {
-#ifdef DEBUG_MODE
-      Serial.printf("[TERRAIN] Cannot reopen: %s\n", cachedFilename.c_str());
-#endif
-      xSemaphoreGive(sd_mutex);
+    // Lecture de la zone par la tache stockage (seek + lignes, carte reservee)
+    if (!storage_call(readCacheRowsCb, this, STORAGE_PRIO_TERRAIN)) {
       return false;
     }
 
-    // Lecture ligne par ligne de la zone
-    uint8_t lineBuffer[CACHE_MAX_SIZE * 2];
-
-    for (int r = 0; r < cacheSize; r++) {
-      int fileRow = cacheStartRow + r;
-      size_t offset = fileRow * gridSize * sizeof(int16_t) + cacheStartCol * sizeof(int16_t);
-
-      file.seek(offset);
-      size_t bytesToRead = cacheSize * sizeof(int16_t);
-      size_t bytesRead = file.read(lineBuffer, bytesToRead);
-
-      if (bytesRead != bytesToRead) {
-#ifdef DEBUG_MODE
-        Serial.printf("[TERRAIN] Read error row %d\n", r);
-#endif
-        file.close();
-        xSemaphoreGive(sd_mutex);
-        return false;
-      }
-
-      // Conversion big-endian
-      for (int c = 0; c < cacheSize; c++) {
-        uint8_t high = lineBuffer[c * 2];
-        uint8_t low = lineBuffer[c * 2 + 1];
-        cacheData[r * CACHE_MAX_SIZE + c] = (int16_t)((high << 8) | low);
-      }
-    }
-
-    file.close();
-    xSemaphoreGive(sd_mutex);
-
     cacheCenterLat = lat;
     cacheCenterLon = lon;
     cacheValid = true;
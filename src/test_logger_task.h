@@ -8,13 +8,20 @@
 #include "FS.h"
 #include "SD_MMC.h"
 #include "src/sd_card.h"
+#include "src/storage_service.h"
 
 #ifdef TEST_MODE
 
 static TaskHandle_t test_logger_task_handle = NULL;
-static File test_log_file;
+static char test_log_path[64] = "";
 static bool test_logging_active = false;
-static SemaphoreHandle_t sd_mutex = NULL;
+
+// Double tampon: un bloc se remplit pendant que l'autre part sur la carte
+static char *test_log_block[2] = { NULL, NULL };
+static size_t test_log_fill = 0;
+static uint8_t test_log_current = 0;
+static volatile bool test_log_busy[2] = { false, false };
+static uint32_t test_log_dropped = 0;
 
 // Variables pour calcul vario brut simplifie (derivee simple)
 static float last_alt = 0.0f;
@@ -43,76 +50,74 @@ static float calculate_raw_vario_simple(float current_alt, uint32_t current_time
   return vario;
 }
 
+// Fin d'ecriture d'un bloc (tache stockage)
+static void test_logger_block_done(const storage_req_t *req) {
+  test_log_busy[(uintptr_t)req->user] = false;
+}
+
+// Envoi du bloc courant au service de stockage (priorite journal)
+static void test_logger_flush_block(void) {
+  if (test_log_fill == 0) return;
+  uint8_t b = test_log_current;
+  test_log_busy[b] = true;
+  if (!storage_append_async(test_log_path, test_log_block[b], test_log_fill, STORAGE_PRIO_LOG,
+                            test_logger_block_done, (void *)(uintptr_t)b)) {
+    test_log_busy[b] = false;
+    test_log_dropped++;
+  }
+  test_log_current ^= 1;
+  test_log_fill = 0;
+}
+
 // Creation fichier
 static bool test_logger_create_file() {
-  if (sd_mutex == NULL) {
-    sd_mutex = xSemaphoreCreateMutex();
-  }
-  
-  if (!xSemaphoreTake(sd_mutex, pdMS_TO_TICKS(1000))) {
-    return false;
-  }
-  
-  char filename[64];
   if (!sd_is_ready()) {
 #ifdef DEBUG_MODE
     Serial.println("[TEST_LOG] SD not ready");
 #endif
-    xSemaphoreGive(sd_mutex);
     return false;
   }
-  
-  File dir = SD_MMC.open(FLIGHTS_DIR);
-  if (!dir || !dir.isDirectory()) {
-    SD_MMC.mkdir(FLIGHTS_DIR);
+
+  for (int i = 0; i < 2; i++) {
+    if (!test_log_block[i]) test_log_block[i] = (char *)storage_buf_alloc(TEST_LOG_BLOCK_SIZE);
+    if (!test_log_block[i]) return false;
   }
-  if (dir) dir.close();
-  
-  char file_only[40];
-  snprintf(file_only, sizeof(file_only), "test_%lu.csv", millis());
-  snprintf(filename, sizeof(filename), "%s/%s", FLIGHTS_DIR, file_only);
-  
+
+  snprintf(test_log_path, sizeof(test_log_path), "%s/test_%lu.csv", FLIGHTS_DIR, millis());
+
 #ifdef DEBUG_MODE
-  Serial.printf("[TEST_LOG] Creating file: %s\n", filename);
+  Serial.printf("[TEST_LOG] Creating file: %s\n", test_log_path);
 #endif
-  
-  test_log_file = SD_MMC.open(filename, FILE_WRITE);
-  if (!test_log_file) {
+
+  // Header CSV
+  static const char header[] =
+    "Timestamp_ms,Date,Time,"
+    "Pressure_hPa,Temp_C,Pressure_Alt_m,Vario_Raw_Baro_ms,Alt_QNE_m,"
+    "BNO_Quat_W,BNO_Quat_X,BNO_Quat_Y,BNO_Quat_Z,"
+    "BNO_Accel_X_ms2,BNO_Accel_Y_ms2,BNO_Accel_Z_ms2,"
+    "GPS_Longitude,GPS_Latitude,GPS_Alt_m,GPS_Speed_knots,GPS_Course_deg,GPS_Satellites,GPS_FixQuality,"
+    "Kalman_Alt_m,Kalman_Vario_ms,Kalman_Alt_QNE_m,Kalman_Alt_QNH_m,Kalman_Alt_QFE_m,"
+    "Kalman_P00,Kalman_P11,Kalman_P22,"
+    "Valid_BMP,Valid_BNO,Valid_GPS\r\n";
+
+  if (!storage_write(test_log_path, header, sizeof(header) - 1, STORAGE_PRIO_LOG)) {
 #ifdef DEBUG_MODE
-    Serial.printf("[TEST_LOG] Cannot create file: %s\n", filename);
+    Serial.printf("[TEST_LOG] Cannot create file: %s\n", test_log_path);
 #endif
-    xSemaphoreGive(sd_mutex);
     return false;
   }
-  
-  // Header CSV
-  test_log_file.print("Timestamp_ms,Date,Time,");
-  test_log_file.print("Pressure_hPa,Temp_C,Pressure_Alt_m,Vario_Raw_Baro_ms,Alt_QNE_m,");
-  test_log_file.print("BNO_Quat_W,BNO_Quat_X,BNO_Quat_Y,BNO_Quat_Z,");
-  test_log_file.print("BNO_Accel_X_ms2,BNO_Accel_Y_ms2,BNO_Accel_Z_ms2,");
-  test_log_file.print("GPS_Longitude,GPS_Latitude,GPS_Alt_m,GPS_Speed_knots,GPS_Course_deg,GPS_Satellites,GPS_FixQuality,");
-  test_log_file.print("Kalman_Alt_m,Kalman_Vario_ms,Kalman_Alt_QNE_m,Kalman_Alt_QNH_m,Kalman_Alt_QFE_m,");
-  test_log_file.print("Kalman_P00,Kalman_P11,Kalman_P22,");
-  test_log_file.println("Valid_BMP,Valid_BNO,Valid_GPS");
-  
-  test_log_file.flush();
-  
+
 #ifdef DEBUG_MODE
-  Serial.printf("[TEST_LOG] File created: %s\n", filename);
+  Serial.printf("[TEST_LOG] File created: %s\n", test_log_path);
 #endif
-  
-  xSemaphoreGive(sd_mutex);
+
+  test_log_fill = 0;
+  test_log_current = 0;
   return true;
 }
 
-// Ecriture ligne OPTIMISEE
+// Ecriture ligne OPTIMISEE: formatee en SRAM, ecrite par blocs
 static void test_logger_write_line() {
-  if (!test_log_file) return;
-  
-  if (!xSemaphoreTake(sd_mutex, pdMS_TO_TICKS(100))) {
-    return;
-  }
-  
   uint32_t now = millis();
   
   // Kalman
@@ -172,24 +177,41 @@ static void test_logger_write_line() {
   float p11 = kf.P[1][1];
   float p22 = kf.P[2][2];
   
-  // Ecriture CSV
-  test_log_file.printf("%lu,%s,%s,", now, date_str, time_str);
-  test_log_file.printf("%.2f,%.2f,%.2f,%.3f,%.2f,",
-                       pressure_hpa, temp_c, pressure_alt, vario_raw, alt_qne);
-  test_log_file.printf("%.4f,%.4f,%.4f,%.4f,", qw, qx, qy, qz);
-  test_log_file.printf("%.4f,%.4f,%.4f,", ax, ay, az);  // OPTIMISE: 3 valeurs au lieu de 4
-  test_log_file.printf("%.6f,%.6f,%.2f,%.2f,%.2f,%d,%d,",
-                       gps_lon, gps_lat, gps_alt, gps_speed, gps_course, gps_sat, gps_fix);
-  test_log_file.printf("%.2f,%.3f,%.2f,%.2f,%.2f,", 
-                       kdata.altitude, kdata.vario, kdata.altitude_qne, 
-                       kdata.altitude_qnh, kdata.altitude_qfe);
-  test_log_file.printf("%.4f,%.4f,%.4f,", p00, p11, p22);
-  test_log_file.printf("%d,%d,%d\n",
-                       g_sensor_data.bmp390.valid ? 1 : 0,
-                       g_sensor_data.bno080.valid ? 1 : 0,
-                       g_sensor_data.gps.valid ? 1 : 0);
-  
-  xSemaphoreGive(sd_mutex);
+  // Ligne CSV
+  char line[512];
+  int len = snprintf(line, sizeof(line),
+                     "%lu,%s,%s,"
+                     "%.2f,%.2f,%.2f,%.3f,%.2f,"
+                     "%.4f,%.4f,%.4f,%.4f,"
+                     "%.4f,%.4f,%.4f,"
+                     "%.6f,%.6f,%.2f,%.2f,%.2f,%d,%d,"
+                     "%.2f,%.3f,%.2f,%.2f,%.2f,"
+                     "%.4f,%.4f,%.4f,"
+                     "%d,%d,%d\n",
+                     now, date_str, time_str,
+                     pressure_hpa, temp_c, pressure_alt, vario_raw, alt_qne,
+                     qw, qx, qy, qz,
+                     ax, ay, az,  // OPTIMISE: 3 valeurs au lieu de 4
+                     gps_lon, gps_lat, gps_alt, gps_speed, gps_course, gps_sat, gps_fix,
+                     kdata.altitude, kdata.vario, kdata.altitude_qne,
+                     kdata.altitude_qnh, kdata.altitude_qfe,
+                     p00, p11, p22,
+                     g_sensor_data.bmp390.valid ? 1 : 0,
+                     g_sensor_data.bno080.valid ? 1 : 0,
+                     g_sensor_data.gps.valid ? 1 : 0);
+  if (len <= 0) return;
+  if (len >= (int)sizeof(line)) len = sizeof(line) - 1;
+
+  if (test_log_fill + len > TEST_LOG_BLOCK_SIZE) {
+    test_logger_flush_block();
+  }
+  // Bloc suivant encore en cours d'ecriture: carte trop lente, ligne perdue
+  if (test_log_busy[test_log_current]) {
+    test_log_dropped++;
+    return;
+  }
+  memcpy(test_log_block[test_log_current] + test_log_fill, line, len);
+  test_log_fill += len;
 }
 
 // Tache logger
@@ -216,12 +238,10 @@ static void test_logger_task(void *pvParameters) {
     vTaskDelayUntil(&last_wake, log_period);
   }
   
-  if (test_log_file) {
-    test_log_file.close();
-  }
+  test_logger_flush_block();
   
 #ifdef DEBUG_MODE
-  Serial.println("[TEST_LOG] Task stopped");
+  Serial.printf("[TEST_LOG] Task stopped (%lu lignes perdues)\n", test_log_dropped);
 #endif
   
   vTaskDelete(NULL);
@@ -0,0 +1,315 @@
+#ifndef TILE_COVERAGE_H
+#define TILE_COVERAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+// =============================================================================
+// Couverture des tuiles OSM: un bitmap par zoom sur la boite englobante des
+// tuiles presentes. Une tuile absente se repond sans aucun acces carte.
+// Calcul pur sans LVGL ni ESP-IDF: se compile sur PC (format partage avec
+// tools/tile_coverage.py).
+//
+// Format du fichier (petit-boutiste):
+//   "TCOV" | version u16 | nb zooms u16
+//   par zoom: z u8 | drapeaux u8 | 2 octets nuls | min_x u32 | min_y u32 |
+//             largeur u32 | hauteur u32 | tuiles u32 | bitmap ceil(largeur*hauteur/8)
+//             octets (bit i = (y - min_y) * largeur + (x - min_x), octet i/8, bit i%8)
+//   drapeaux: bit0 = pas de bitmap (zoom trop etendu), bit1 = hors boite inconnu
+//   CRC-32 (zlib) de tout ce qui precede, u32
+// =============================================================================
+
+#ifndef TILE_COVERAGE_ALLOC
+#define TILE_COVERAGE_ALLOC(size) malloc(size)
+#define TILE_COVERAGE_FREE(p) free(p)
+#endif
+
+#define TILE_COVERAGE_VERSION 1
+#define TILE_COVERAGE_MAX_ZOOMS 20
+#define TILE_COVERAGE_MAX_BITMAP_BYTES (256 * 1024)   // Au-dela: zoom inconnu (I/O normale)
+#define TILE_COVERAGE_HEADER_SIZE 8
+#define TILE_COVERAGE_ZOOM_HEADER_SIZE 24
+#define TILE_COVERAGE_FLAG_NO_BITMAP 0x01
+#define TILE_COVERAGE_FLAG_OPEN 0x02
+
+typedef enum {
+  TILE_COVERAGE_UNKNOWN = 0,  // Pas d'information: tenter la lecture
+  TILE_COVERAGE_ABSENT,
+  TILE_COVERAGE_PRESENT
+} tile_coverage_result_t;
+
+typedef struct {
+  bool used;
+  bool open;          // Tuiles ajoutees hors boite depuis la construction: hors boite inconnu
+  uint32_t min_x, min_y;
+  uint32_t w, h;
+  uint32_t tiles;
+  uint8_t *bits;      // NULL si trop grand
+} tile_coverage_zoom_t;
+
+typedef struct {
+  bool valid;
+  tile_coverage_zoom_t zooms[TILE_COVERAGE_MAX_ZOOMS];
+} tile_coverage_t;
+
+// Tuiles collectees pendant un parcours: z(5 bits) | x(24 bits) | y(24 bits)
+typedef struct {
+  uint64_t *items;
+  size_t count;
+  size_t cap;
+  bool overflow;
+} tile_coverage_builder_t;
+
+static inline size_t tile_coverage_bitmap_bytes(uint32_t w, uint32_t h) {
+  return (size_t)(((uint64_t)w * h + 7) / 8);
+}
+
+static uint32_t tile_coverage_crc32(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+  }
+  return ~crc;
+}
+
+static void tile_coverage_free(tile_coverage_t *c) {
+  for (int z = 0; z < TILE_COVERAGE_MAX_ZOOMS; z++) {
+    if (c->zooms[z].bits) TILE_COVERAGE_FREE(c->zooms[z].bits);
+  }
+  memset(c, 0, sizeof(tile_coverage_t));
+}
+
+// ============================================================================
+// Requetes
+// ============================================================================
+
+static inline tile_coverage_result_t tile_coverage_query(const tile_coverage_t *c, int z, uint32_t x, uint32_t y) {
+  if (!c->valid || z < 0 || z >= TILE_COVERAGE_MAX_ZOOMS) return TILE_COVERAGE_UNKNOWN;
+  const tile_coverage_zoom_t *zm = &c->zooms[z];
+  if (!zm->used) return TILE_COVERAGE_ABSENT;
+  if (!zm->bits) return TILE_COVERAGE_UNKNOWN;
+  if (x < zm->min_x || y < zm->min_y || x - zm->min_x >= zm->w || y - zm->min_y >= zm->h) {
+    return zm->open ? TILE_COVERAGE_UNKNOWN : TILE_COVERAGE_ABSENT;
+  }
+  uint64_t i = (uint64_t)(y - zm->min_y) * zm->w + (x - zm->min_x);
+  return (zm->bits[i >> 3] & (1u << (i & 7))) ? TILE_COVERAGE_PRESENT : TILE_COVERAGE_ABSENT;
+}
+
+// Tuile ajoutee apres construction (telechargement)
+static void tile_coverage_add(tile_coverage_t *c, int z, uint32_t x, uint32_t y) {
+  if (!c->valid || z < 0 || z >= TILE_COVERAGE_MAX_ZOOMS) return;
+  tile_coverage_zoom_t *zm = &c->zooms[z];
+  if (!zm->used || !zm->bits || x < zm->min_x || y < zm->min_y
+      || x - zm->min_x >= zm->w || y - zm->min_y >= zm->h) {
+    zm->used = true;
+    zm->open = true;  // Reste exact dans la boite, inconnu ailleurs
+    return;
+  }
+  uint64_t i = (uint64_t)(y - zm->min_y) * zm->w + (x - zm->min_x);
+  if (!(zm->bits[i >> 3] & (1u << (i & 7)))) zm->tiles++;
+  zm->bits[i >> 3] |= (uint8_t)(1u << (i & 7));
+}
+
+// ============================================================================
+// Construction depuis une liste de tuiles
+// ============================================================================
+
+static void tile_coverage_builder_reset(tile_coverage_builder_t *b) {
+  if (b->items) TILE_COVERAGE_FREE(b->items);
+  memset(b, 0, sizeof(tile_coverage_builder_t));
+}
+
+static bool tile_coverage_builder_push(tile_coverage_builder_t *b, int z, uint32_t x, uint32_t y, size_t max_items) {
+  if (b->overflow || z < 0 || z >= TILE_COVERAGE_MAX_ZOOMS) return false;
+  if (b->count == b->cap) {
+    size_t cap = b->cap ? b->cap * 2 : 1024;
+    if (cap > max_items) cap = max_items;
+    if (cap <= b->count) {
+      b->overflow = true;
+      return false;
+    }
+    uint64_t *items = (uint64_t *)TILE_COVERAGE_ALLOC(cap * sizeof(uint64_t));
+    if (!items) {
+      b->overflow = true;
+      return false;
+    }
+    if (b->items) {
+      memcpy(items, b->items, b->count * sizeof(uint64_t));
+      TILE_COVERAGE_FREE(b->items);
+    }
+    b->items = items;
+    b->cap = cap;
+  }
+  b->items[b->count++] = ((uint64_t)z << 48) | ((uint64_t)(x & 0xFFFFFF) << 24) | (y & 0xFFFFFF);
+  return true;
+}
+
+// Remplit c (libere au prealable); false si la liste a deborde
+static bool tile_coverage_build(tile_coverage_t *c, const tile_coverage_builder_t *b) {
+  tile_coverage_free(c);
+  if (b->overflow) return false;
+
+  // Boites englobantes
+  uint32_t max_x[TILE_COVERAGE_MAX_ZOOMS], max_y[TILE_COVERAGE_MAX_ZOOMS];
+  for (size_t i = 0; i < b->count; i++) {
+    int z = (int)(b->items[i] >> 48);
+    uint32_t x = (uint32_t)(b->items[i] >> 24) & 0xFFFFFF;
+    uint32_t y = (uint32_t)b->items[i] & 0xFFFFFF;
+    tile_coverage_zoom_t *zm = &c->zooms[z];
+    if (!zm->used) {
+      zm->used = true;
+      zm->min_x = max_x[z] = x;
+      zm->min_y = max_y[z] = y;
+    }
+    if (x < zm->min_x) zm->min_x = x;
+    if (y < zm->min_y) zm->min_y = y;
+    if (x > max_x[z]) max_x[z] = x;
+    if (y > max_y[z]) max_y[z] = y;
+  }
+
+  for (int z = 0; z < TILE_COVERAGE_MAX_ZOOMS; z++) {
+    tile_coverage_zoom_t *zm = &c->zooms[z];
+    if (!zm->used) continue;
+    zm->w = max_x[z] - zm->min_x + 1;
+    zm->h = max_y[z] - zm->min_y + 1;
+    size_t bytes = tile_coverage_bitmap_bytes(zm->w, zm->h);
+    if (bytes <= TILE_COVERAGE_MAX_BITMAP_BYTES) {
+      zm->bits = (uint8_t *)TILE_COVERAGE_ALLOC(bytes);
+      if (zm->bits) memset(zm->bits, 0, bytes);
+    }
+  }
+
+  for (size_t i = 0; i < b->count; i++) {
+    int z = (int)(b->items[i] >> 48);
+    uint32_t x = (uint32_t)(b->items[i] >> 24) & 0xFFFFFF;
+    uint32_t y = (uint32_t)b->items[i] & 0xFFFFFF;
+    tile_coverage_zoom_t *zm = &c->zooms[z];
+    if (!zm->bits) {
+      zm->tiles++;
+      continue;
+    }
+    uint64_t k = (uint64_t)(y - zm->min_y) * zm->w + (x - zm->min_x);
+    if (!(zm->bits[k >> 3] & (1u << (k & 7)))) zm->tiles++;
+    zm->bits[k >> 3] |= (uint8_t)(1u << (k & 7));
+  }
+
+  c->valid = true;
+  return true;
+}
+
+// Memes zooms, boites, nombres de tuiles et bitmaps (ajouts hors boite compris)
+static bool tile_coverage_same(const tile_coverage_t *a, const tile_coverage_t *b) {
+  if (a->valid != b->valid) return false;
+  for (int z = 0; z < TILE_COVERAGE_MAX_ZOOMS; z++) {
+    const tile_coverage_zoom_t *za = &a->zooms[z], *zb = &b->zooms[z];
+    if (za->used != zb->used) return false;
+    if (!za->used) continue;
+    if (za->open != zb->open || za->min_x != zb->min_x || za->min_y != zb->min_y || za->w != zb->w
+        || za->h != zb->h || za->tiles != zb->tiles || !za->bits != !zb->bits) return false;
+    if (za->bits && memcmp(za->bits, zb->bits, tile_coverage_bitmap_bytes(za->w, za->h)) != 0) return false;
+  }
+  return true;
+}
+
+// ============================================================================
+// Fichier
+// ============================================================================
+
+static inline void tile_coverage_put32(uint8_t *p, uint32_t v) {
+  p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static inline uint32_t tile_coverage_get32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static size_t tile_coverage_serialized_size(const tile_coverage_t *c) {
+  size_t n = TILE_COVERAGE_HEADER_SIZE + 4;
+  for (int z = 0; z < TILE_COVERAGE_MAX_ZOOMS; z++) {
+    if (!c->zooms[z].used) continue;
+    n += TILE_COVERAGE_ZOOM_HEADER_SIZE;
+    if (c->zooms[z].bits) n += tile_coverage_bitmap_bytes(c->zooms[z].w, c->zooms[z].h);
+  }
+  return n;
+}
+
+static size_t tile_coverage_serialize(const tile_coverage_t *c, uint8_t *out, size_t cap) {
+  size_t need = tile_coverage_serialized_size(c);
+  if (cap < need) return 0;
+
+  uint16_t count = 0;
+  uint8_t *p = out + TILE_COVERAGE_HEADER_SIZE;
+  for (int z = 0; z < TILE_COVERAGE_MAX_ZOOMS; z++) {
+    const tile_coverage_zoom_t *zm = &c->zooms[z];
+    if (!zm->used) continue;
+    memset(p, 0, 4);
+    p[0] = (uint8_t)z;
+    p[1] = (zm->bits ? 0 : TILE_COVERAGE_FLAG_NO_BITMAP) | (zm->open ? TILE_COVERAGE_FLAG_OPEN : 0);
+    tile_coverage_put32(p + 4, zm->min_x);
+    tile_coverage_put32(p + 8, zm->min_y);
+    tile_coverage_put32(p + 12, zm->w);
+    tile_coverage_put32(p + 16, zm->h);
+    tile_coverage_put32(p + 20, zm->tiles);
+    p += TILE_COVERAGE_ZOOM_HEADER_SIZE;
+    if (zm->bits) {
+      size_t bytes = tile_coverage_bitmap_bytes(zm->w, zm->h);
+      memcpy(p, zm->bits, bytes);
+      p += bytes;
+    }
+    count++;
+  }
+
+  memcpy(out, "TCOV", 4);
+  out[4] = TILE_COVERAGE_VERSION & 0xFF;
+  out[5] = TILE_COVERAGE_VERSION >> 8;
+  out[6] = count & 0xFF;
+  out[7] = count >> 8;
+  tile_coverage_put32(p, tile_coverage_crc32(0, out, p - out));
+  return need;
+}
+
+// false si fichier invalide (c reste vide)
+static bool tile_coverage_parse(tile_coverage_t *c, const uint8_t *data, size_t len) {
+  tile_coverage_free(c);
+  if (len < TILE_COVERAGE_HEADER_SIZE + 4 || memcmp(data, "TCOV", 4) != 0) return false;
+  if ((data[4] | (data[5] << 8)) != TILE_COVERAGE_VERSION) return false;
+  if (tile_coverage_crc32(0, data, len - 4) != tile_coverage_get32(data + len - 4)) return false;
+
+  uint16_t count = data[6] | (data[7] << 8);
+  const uint8_t *p = data + TILE_COVERAGE_HEADER_SIZE;
+  const uint8_t *end = data + len - 4;
+  for (uint16_t i = 0; i < count; i++) {
+    if (end - p < TILE_COVERAGE_ZOOM_HEADER_SIZE) goto fail;
+    int z = p[0];
+    uint8_t flags = p[1];
+    if (z >= TILE_COVERAGE_MAX_ZOOMS || c->zooms[z].used) goto fail;
+    tile_coverage_zoom_t *zm = &c->zooms[z];
+    zm->used = true;
+    zm->open = (flags & TILE_COVERAGE_FLAG_OPEN) != 0;
+    zm->min_x = tile_coverage_get32(p + 4);
+    zm->min_y = tile_coverage_get32(p + 8);
+    zm->w = tile_coverage_get32(p + 12);
+    zm->h = tile_coverage_get32(p + 16);
+    zm->tiles = tile_coverage_get32(p + 20);
+    p += TILE_COVERAGE_ZOOM_HEADER_SIZE;
+    if (flags & TILE_COVERAGE_FLAG_NO_BITMAP) continue;
+
+    size_t bytes = tile_coverage_bitmap_bytes(zm->w, zm->h);
+    if (zm->w == 0 || zm->h == 0 || bytes > TILE_COVERAGE_MAX_BITMAP_BYTES || (size_t)(end - p) < bytes) goto fail;
+    zm->bits = (uint8_t *)TILE_COVERAGE_ALLOC(bytes);
+    if (!zm->bits) goto fail;
+    memcpy(zm->bits, p, bytes);
+    p += bytes;
+  }
+  c->valid = true;
+  return true;
+
+fail:
+  tile_coverage_free(c);
+  return false;
+}
+
+#endif
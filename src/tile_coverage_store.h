@@ -0,0 +1,196 @@
+#ifndef TILE_COVERAGE_STORE_H
+#define TILE_COVERAGE_STORE_H
+
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+#include "constants.h"
+
+// Bitmaps et liste de construction en PSRAM
+#define TILE_COVERAGE_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define TILE_COVERAGE_FREE(p) heap_caps_free(p)
+#include "src/tile_coverage.h"
+#include "src/storage_service.h"
+
+// =============================================================================
+// Couverture des tuiles du serveur OSM_SERVER_NAME, chargee depuis la carte au
+// demarrage. Chaque parcours de l'index du stockage la reconstruit et remplace
+// celle en memoire; le fichier n'est reecrit que si elle a change (tuiles
+// copiees ou effacees par USB, fichier perime ou absent).
+// Les tuiles ecrites par le service sont ajoutees au fil de l'eau.
+// =============================================================================
+
+#define TILE_COVERAGE_PATH OSM_TILES_DIR "/" OSM_SERVER_NAME "/coverage.bin"
+
+typedef struct {
+  uint32_t absent;      // Lectures evitees
+  uint32_t present;
+  uint32_t unknown;
+  uint32_t builds;
+  bool loaded;          // Couverture disponible
+  bool dirty;           // Modifiee depuis la derniere ecriture
+} tile_coverage_stats_t;
+
+static tile_coverage_t tile_coverage = { 0 };
+static tile_coverage_builder_t tile_coverage_builder = { 0 };
+static SemaphoreHandle_t tile_coverage_mutex = NULL;
+static bool tile_coverage_collecting = false;   // Parcours en cours (tache stockage uniquement)
+static tile_coverage_stats_t tile_coverage_stats = { 0 };
+
+// "<z>/<x>/<y>.bin" apres le repertoire du serveur
+static bool tile_coverage_parse_path(const char *path, int *z, uint32_t *x, uint32_t *y) {
+  static const char prefix[] = OSM_TILES_DIR "/" OSM_SERVER_NAME "/";
+  if (strncmp(path, prefix, sizeof(prefix) - 1) != 0) return false;
+  unsigned zz, xx, yy;
+  char ext[8];
+  if (sscanf(path + sizeof(prefix) - 1, "%u/%u/%u.%7s", &zz, &xx, &yy, ext) != 4) return false;
+  if (strcmp(ext, "bin") != 0 || zz >= TILE_COVERAGE_MAX_ZOOMS) return false;
+  *z = (int)zz;
+  *x = xx;
+  *y = yy;
+  return true;
+}
+
+// ============================================================================
+// Fichier (tache stockage)
+// ============================================================================
+
+static bool tile_coverage_read_file(void *user) {
+  size_t size = 0;
+  if (!storage_stat_size(TILE_COVERAGE_PATH, &size) || size == 0) return false;
+
+  uint8_t *buf = (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!buf) return false;
+
+  bool ok = false;
+  File f = SD_MMC.open(TILE_COVERAGE_PATH, FILE_READ);
+  if (f) {
+    ok = (f.read(buf, size) == size);
+    f.close();
+  }
+
+  tile_coverage_t loaded = { 0 };
+  ok = ok && tile_coverage_parse(&loaded, buf, size);
+  heap_caps_free(buf);
+  if (!ok) return false;
+
+  xSemaphoreTake(tile_coverage_mutex, portMAX_DELAY);
+  tile_coverage_free(&tile_coverage);
+  tile_coverage = loaded;
+  tile_coverage_stats.loaded = true;
+  tile_coverage_stats.dirty = false;
+  xSemaphoreGive(tile_coverage_mutex);
+  return true;
+}
+
+// Ecriture de la couverture courante (copie serialisee sous verrou)
+static bool tile_coverage_write_file(void *user) {
+  xSemaphoreTake(tile_coverage_mutex, portMAX_DELAY);
+  size_t size = tile_coverage.valid ? tile_coverage_serialized_size(&tile_coverage) : 0;
+  uint8_t *buf = size ? (uint8_t *)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT) : NULL;
+  if (buf) tile_coverage_serialize(&tile_coverage, buf, size);
+  tile_coverage_stats.dirty = false;
+  xSemaphoreGive(tile_coverage_mutex);
+  if (!buf) return false;
+
+  bool ok = storage_write(TILE_COVERAGE_PATH, buf, size, STORAGE_PRIO_WEB);
+  heap_caps_free(buf);
+#ifdef DEBUG_MODE
+  Serial.printf("[COVERAGE] Saved %u bytes: %s\n", (unsigned)size, ok ? "OK" : "FAILED");
+#endif
+  return ok;
+}
+
+// ============================================================================
+// Construction pendant le parcours de l'index (tache stockage)
+// ============================================================================
+
+static void tile_coverage_collect_begin(void) {
+  tile_coverage_builder_reset(&tile_coverage_builder);
+  tile_coverage_collecting = true;
+}
+
+static void tile_coverage_collect(const char *server, int z, uint32_t x, uint32_t y) {
+  if (!tile_coverage_collecting || strcmp(server, OSM_SERVER_NAME) != 0) return;
+  tile_coverage_builder_push(&tile_coverage_builder, z, x, y, TILE_COVERAGE_MAX_TILES);
+}
+
+static void tile_coverage_collect_end(bool complete) {
+  if (!tile_coverage_collecting) return;
+  tile_coverage_collecting = false;
+
+  tile_coverage_t built = { 0 };
+  bool ok = complete && tile_coverage_build(&built, &tile_coverage_builder);
+  tile_coverage_builder_reset(&tile_coverage_builder);
+  if (!ok) {
+#ifdef DEBUG_MODE
+    Serial.println("[COVERAGE] Build failed (too many tiles or incomplete scan)");
+#endif
+    return;
+  }
+
+  xSemaphoreTake(tile_coverage_mutex, portMAX_DELAY);
+  bool changed = !tile_coverage_same(&built, &tile_coverage);
+  tile_coverage_free(&tile_coverage);
+  tile_coverage = built;
+  tile_coverage_stats.loaded = true;
+  tile_coverage_stats.builds++;
+  tile_coverage_stats.dirty = tile_coverage_stats.dirty || changed;
+  xSemaphoreGive(tile_coverage_mutex);
+
+#ifdef DEBUG_MODE
+  if (changed) Serial.println("[COVERAGE] Differs from the scan, rewritten");
+#endif
+  if (tile_coverage_stats.dirty) tile_coverage_write_file(NULL);
+}
+
+// ============================================================================
+// API publique
+// ============================================================================
+
+// Chargement au demarrage (verifie au premier parcours); false: absente
+// jusqu'a la fin de ce parcours
+bool tile_coverage_init(void) {
+  if (tile_coverage_mutex == NULL) tile_coverage_mutex = xSemaphoreCreateMutex();
+  bool ok = storage_call(tile_coverage_read_file, NULL, STORAGE_PRIO_WEB);
+#ifdef DEBUG_MODE
+  Serial.printf("[COVERAGE] %s\n", ok ? "Loaded" : "Missing, will be built by the storage index scan");
+#endif
+  return ok;
+}
+
+// Tuile ecrite par le service (telechargement)
+static void tile_coverage_note_write(const char *path) {
+  int z;
+  uint32_t x, y;
+  if (!tile_coverage_mutex || !tile_coverage_parse_path(path, &z, &x, &y)) return;
+  xSemaphoreTake(tile_coverage_mutex, portMAX_DELAY);
+  tile_coverage_add(&tile_coverage, z, x, y);
+  tile_coverage_stats.dirty = true;
+  xSemaphoreGive(tile_coverage_mutex);
+  // Parcours en cours: la tuile peut etre dans un repertoire deja lu
+  if (tile_coverage_collecting) tile_coverage_builder_push(&tile_coverage_builder, z, x, y, TILE_COVERAGE_MAX_TILES);
+}
+
+// Ecriture differee des ajouts (fin d'une serie de telechargements)
+void tile_coverage_flush(void) {
+  if (tile_coverage_stats.dirty) storage_call_async(tile_coverage_write_file, NULL, STORAGE_PRIO_WEB, NULL);
+}
+
+// Reponse sans acces carte: ABSENT -> ne pas lire la tuile
+tile_coverage_result_t tile_coverage_check(int z, int x, int y) {
+  tile_coverage_result_t r = TILE_COVERAGE_UNKNOWN;
+  if (x >= 0 && y >= 0 && tile_coverage_mutex && xSemaphoreTake(tile_coverage_mutex, pdMS_TO_TICKS(5)) == pdTRUE) {
+    r = tile_coverage_query(&tile_coverage, z, (uint32_t)x, (uint32_t)y);
+    xSemaphoreGive(tile_coverage_mutex);
+  }
+  if (r == TILE_COVERAGE_ABSENT) tile_coverage_stats.absent++;
+  else if (r == TILE_COVERAGE_PRESENT) tile_coverage_stats.present++;
+  else tile_coverage_stats.unknown++;
+  return r;
+}
+
+void tile_coverage_get_stats(tile_coverage_stats_t *out) {
+  *out = tile_coverage_stats;
+}
+
+#endif
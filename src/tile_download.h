@@ -0,0 +1,158 @@
+#ifndef TILE_DOWNLOAD_H
+#define TILE_DOWNLOAD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "src/http_chunked.h"
+
+// =============================================================================
+// Plan d'un telechargement de tuiles: zone (lat/lon) et plage de zooms,
+// numerotation des tuiles (z croissant, puis x, puis y) pour la reprise,
+// expansion des URL {z}/{x}/{y}/{a-c} et fichier de reprise texte.
+// Calcul pur sans Arduino ni ESP-IDF: se compile sur PC.
+// =============================================================================
+
+#define TILE_DL_MAX_ZOOMS 20
+#define TILE_DL_URL_MAX 160
+
+typedef struct {
+  uint8_t z;
+  uint32_t x0, x1, y0, y1;   // Bornes incluses
+  uint32_t first;            // Index de la premiere tuile de ce zoom
+} tile_dl_range_t;
+
+typedef struct {
+  float lat_min, lon_min, lat_max, lon_max;
+  uint8_t z_min, z_max;
+  char url[TILE_DL_URL_MAX];  // Modele {z}/{x}/{y}
+  uint32_t next;              // Reprise: premiere tuile non terminee
+} tile_dl_job_t;
+
+typedef struct {
+  tile_dl_range_t ranges[TILE_DL_MAX_ZOOMS];
+  int count;
+  uint32_t total;
+} tile_dl_plan_t;
+
+// ============================================================================
+// Plan
+// ============================================================================
+
+static void tile_dl_lat_lon_to_tile(double lat, double lon, int z, uint32_t *x, uint32_t *y) {
+  double n = ldexp(1.0, z);
+  double lat_rad = lat * M_PI / 180.0;
+  double fx = (lon + 180.0) / 360.0 * n;
+  double fy = (1.0 - asinh(tan(lat_rad)) / M_PI) / 2.0 * n;
+  if (fx < 0) fx = 0;
+  if (fy < 0) fy = 0;
+  if (fx > n - 1) fx = n - 1;
+  if (fy > n - 1) fy = n - 1;
+  *x = (uint32_t)fx;
+  *y = (uint32_t)fy;
+}
+
+// false si la zone est vide ou depasse max_tiles
+static bool tile_dl_plan(tile_dl_plan_t *plan, const tile_dl_job_t *job, uint32_t max_tiles) {
+  memset(plan, 0, sizeof(*plan));
+  if (job->z_min > job->z_max || job->z_max >= TILE_DL_MAX_ZOOMS) return false;
+  if (job->lat_min > job->lat_max || job->lon_min > job->lon_max) return false;
+
+  uint64_t total = 0;
+  for (int z = job->z_min; z <= job->z_max; z++) {
+    tile_dl_range_t *r = &plan->ranges[plan->count++];
+    r->z = z;
+    // Latitude max -> y min
+    tile_dl_lat_lon_to_tile(job->lat_max, job->lon_min, z, &r->x0, &r->y0);
+    tile_dl_lat_lon_to_tile(job->lat_min, job->lon_max, z, &r->x1, &r->y1);
+    r->first = (uint32_t)total;
+    total += (uint64_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+    if (total > max_tiles) return false;
+  }
+  plan->total = (uint32_t)total;
+  return plan->total > 0;
+}
+
+static bool tile_dl_plan_at(const tile_dl_plan_t *plan, uint32_t index, int *z, uint32_t *x, uint32_t *y) {
+  if (index >= plan->total) return false;
+  int i = plan->count - 1;
+  while (i > 0 && plan->ranges[i].first > index) i--;
+  const tile_dl_range_t *r = &plan->ranges[i];
+  uint32_t k = index - r->first;
+  uint32_t h = r->y1 - r->y0 + 1;
+  *z = r->z;
+  *x = r->x0 + k / h;
+  *y = r->y0 + k % h;
+  return true;
+}
+
+// ============================================================================
+// URL
+// ============================================================================
+
+// {z} {x} {y} et {a-c}; le sous-domaine est fixe par shard (un par connexion
+// persistante, l'hote ne change jamais sur une meme connexion)
+static bool tile_dl_expand_url(const char *tmpl, int z, uint32_t x, uint32_t y, unsigned shard, char *out,
+                               size_t size) {
+  size_t o = 0;
+  for (const char *p = tmpl; *p;) {
+    char val[16] = "";
+    size_t skip = 0;
+    if (p[0] == '{' && p[1] && p[2] == '}') {
+      if (p[1] == 'z') snprintf(val, sizeof(val), "%d", z);
+      else if (p[1] == 'x') snprintf(val, sizeof(val), "%lu", (unsigned long)x);
+      else if (p[1] == 'y') snprintf(val, sizeof(val), "%lu", (unsigned long)y);
+      skip = val[0] ? 3 : 0;
+    } else if (p[0] == '{' && p[1] && p[2] == '-' && p[3] >= p[1] && p[4] == '}') {
+      int n = p[3] - p[1] + 1;
+      val[0] = p[1] + (char)(shard % n);
+      val[1] = '\0';
+      skip = 5;
+    }
+    if (skip) {
+      size_t n = strlen(val);
+      if (o + n >= size) return false;
+      memcpy(out + o, val, n);
+      o += n;
+      p += skip;
+    } else {
+      if (o + 1 >= size) return false;
+      out[o++] = *p++;
+    }
+  }
+  out[o] = '\0';
+  return true;
+}
+
+// ============================================================================
+// Fichier de reprise
+// ============================================================================
+
+// "TDL1 lat_min lon_min lat_max lon_max z_min z_max next url\n"
+static int tile_dl_job_format(const tile_dl_job_t *job, char *out, size_t size) {
+  return snprintf(out, size, "TDL1 %.6f %.6f %.6f %.6f %u %u %lu %s\n", job->lat_min, job->lon_min, job->lat_max,
+                  job->lon_max, job->z_min, job->z_max, (unsigned long)job->next, job->url);
+}
+
+static bool tile_dl_job_parse(tile_dl_job_t *job, const char *text) {
+  unsigned z0, z1;
+  unsigned long next;
+  int used = 0;
+  memset(job, 0, sizeof(*job));
+  if (sscanf(text, "TDL1 %f %f %f %f %u %u %lu %n", &job->lat_min, &job->lon_min, &job->lat_max, &job->lon_max, &z0,
+             &z1, &next, &used) != 7 || used == 0) {
+    return false;
+  }
+  size_t n = strcspn(text + used, "\r\n");
+  if (n == 0 || n >= sizeof(job->url) || z1 >= TILE_DL_MAX_ZOOMS) return false;
+  memcpy(job->url, text + used, n);
+  job->url[n] = '\0';
+  job->z_min = z0;
+  job->z_max = z1;
+  job->next = next;
+  return true;
+}
+
+#endif
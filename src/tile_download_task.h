@@ -0,0 +1,392 @@
+#ifndef TILE_DOWNLOAD_TASK_H
+#define TILE_DOWNLOAD_TASK_H
+
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <SD_MMC.h>
+#include "esp_heap_caps.h"
+#include "constants.h"
+#include "src/tile_download.h"
+#include "src/wifi_task.h"
+#include "src/storage_service.h"
+#include "src/tile_coverage_store.h"
+
+#include "src/png_rgb565.h"
+
+// =============================================================================
+// Telechargement de tuiles sur la carte SD: TILE_DL_WORKERS taches de basse
+// priorite (core 0) prennent les tuiles du plan dans l'ordre, les telechargent
+// (connexion persistante par tache), les decodent en RGB565 et les ecrivent
+// dans OSM_TILES_DIR/OSM_SERVER_NAME via le service de stockage (priorite WEB).
+// Seul OSM_SERVER_URL est accepte: c'est le serveur de ce repertoire.
+// Les tuiles deja presentes sont sautees; la progression est sauvegardee dans
+// TILE_DL_JOB_PATH et reprise au demarrage suivant.
+// Serveurs publics: User-Agent identifiant, une connexion, au plus une requete
+// toutes les TILE_DL_MIN_INTERVAL_MS, zones limitees a TILE_DL_MAX_TILES.
+// =============================================================================
+
+#define TILE_DL_TILE_BYTES (OSM_TILE_SIZE * OSM_TILE_SIZE * sizeof(uint16_t))
+#define TILE_DL_IDLE UINT32_MAX
+
+typedef struct {
+  bool running;
+  bool waiting_wifi;
+  uint32_t total;
+  uint32_t next;             // Prochaine tuile distribuee
+  uint32_t downloaded;
+  uint32_t skipped;          // Deja presentes
+  uint32_t failed;
+  uint32_t bytes;            // PNG recus
+  uint32_t last_tile_ms;     // Telechargement + decodage + ecriture
+} tile_dl_status_t;
+
+static tile_dl_job_t tile_dl_job;
+static tile_dl_plan_t tile_dl_plan_cur;
+static tile_dl_status_t tile_dl_status = { 0 };
+static SemaphoreHandle_t tile_dl_mutex = NULL;
+static uint32_t tile_dl_inflight[TILE_DL_WORKERS];
+static int tile_dl_active = 0;
+static uint32_t tile_dl_since_checkpoint = 0;
+static volatile bool tile_dl_stop_requested = false;
+
+typedef struct {
+  int index;
+  HTTPClient http;
+  png_rgb565_t *dec;     // Etat du decodeur (PSRAM)
+  uint16_t *tile;        // Tuile decodee (PSRAM)
+  char dir[STORAGE_PATH_MAX];  // Dernier repertoire cree
+} tile_dl_worker_t;
+
+// ============================================================================
+// Carte SD
+// ============================================================================
+
+// Cree le repertoire et ses parents (tache stockage)
+static bool tile_dl_mkdirs(void *user) {
+  const char *dir = (const char *)user;
+  char tmp[STORAGE_PATH_MAX];
+  for (const char *p = strchr(dir + 1, '/');; p = strchr(p + 1, '/')) {
+    size_t n = p ? (size_t)(p - dir) : strlen(dir);
+    memcpy(tmp, dir, n);
+    tmp[n] = '\0';
+    if (!SD_MMC.exists(tmp) && !SD_MMC.mkdir(tmp)) return false;
+    if (!p) return true;
+  }
+}
+
+// Fichier de reprise: premiere tuile non terminee
+static void tile_dl_save_job(void) {
+  xSemaphoreTake(tile_dl_mutex, portMAX_DELAY);
+  uint32_t next = tile_dl_status.next;
+  for (int w = 0; w < TILE_DL_WORKERS; w++) {
+    if (tile_dl_inflight[w] < next) next = tile_dl_inflight[w];
+  }
+  tile_dl_job.next = next;
+  char text[TILE_DL_URL_MAX + 96];
+  int n = tile_dl_job_format(&tile_dl_job, text, sizeof(text));
+  xSemaphoreGive(tile_dl_mutex);
+  storage_write(TILE_DL_JOB_PATH, text, n, STORAGE_PRIO_WEB);
+}
+
+// ============================================================================
+// Une tuile
+// ============================================================================
+
+// Corps de la reponse lu par le decodeur au fil de l'eau (Content-Length,
+// chunked ou jusqu'a la fermeture)
+typedef struct {
+  WiFiClient *stream;
+  int expected;           // -1: inconnu
+  bool chunked;
+  http_chunked_t dechunk;
+  size_t raw;             // Octets recus (avec l'encodage chunked)
+  size_t got;             // Octets utiles
+  bool closed;
+  bool failed;
+} tile_dl_body_t;
+
+static inline bool tile_dl_body_done(const tile_dl_body_t *b) {
+  if (b->chunked) return http_chunked_done(&b->dechunk);
+  return b->expected >= 0 ? b->got == (size_t)b->expected : b->closed;
+}
+
+static size_t tile_dl_body_read(void *user, uint8_t *buf, size_t len) {
+  tile_dl_body_t *b = (tile_dl_body_t *)user;
+  uint32_t last_rx = millis();
+  while (!tile_dl_body_done(b)) {
+    if (b->dechunk.error || tile_dl_stop_requested) break;
+    int avail = b->stream->available();
+    if (avail <= 0) {
+      if (!b->stream->connected()) {
+        b->closed = true;
+        if (b->chunked || b->expected >= 0) break;
+        continue;
+      }
+      if (millis() - last_rx > TILE_DL_HTTP_TIMEOUT_MS) break;
+      vTaskDelay(pdMS_TO_TICKS(2));
+      continue;
+    }
+    size_t want = len;
+    if (!b->chunked && b->expected >= 0 && want > (size_t)b->expected - b->got) want = b->expected - b->got;
+    int n = b->stream->read(buf, (size_t)avail < want ? avail : want);
+    if (n <= 0) continue;
+    last_rx = millis();
+    b->raw += n;
+    size_t m = b->chunked ? http_chunked_decode(&b->dechunk, buf, n) : n;
+    b->got += m;
+    if (m) return m;
+  }
+  b->failed = !tile_dl_body_done(b);
+  return 0;
+}
+
+// Telechargement et decodage direct dans w->tile
+static bool tile_dl_fetch(tile_dl_worker_t *w, const char *url, size_t *len) {
+  if (!w->http.begin(url)) return false;
+  int code = w->http.GET();
+  bool ok = false;
+  tile_dl_body_t body = { 0 };
+  if (code == HTTP_CODE_OK) {
+    body.stream = w->http.getStreamPtr();
+    body.expected = w->http.getSize();
+    body.chunked = w->http.header("Transfer-Encoding").equalsIgnoreCase("chunked");
+    ok = png_rgb565_decode_stream(w->dec, tile_dl_body_read, &body, w->tile, OSM_TILE_SIZE, OSM_TILE_SIZE,
+                                  TILE_DL_DITHER ? PNG_RGB565_DITHER : 0);
+    // Fin du PNG (IEND) non lue par le decodeur: vider pour garder la connexion
+    uint8_t tail[64];
+    while (ok && !body.failed && !tile_dl_body_done(&body) && tile_dl_body_read(&body, tail, sizeof(tail)) > 0) {}
+  }
+  // Corps non lu en entier: la connexion ne peut pas etre reutilisee
+  if ((!ok || !tile_dl_body_done(&body)) && w->http.connected()) w->http.getStreamPtr()->stop();
+  w->http.end();
+#ifdef DEBUG_MODE
+  if (!ok) Serial.printf("[TILE_DL] %s: HTTP %d, %u bytes, %s\n", url, code, (unsigned)body.got,
+                         body.failed ? "transfer failed" : "decode failed");
+#endif
+  *len += body.raw;
+  return ok;
+}
+
+typedef enum {
+  TILE_DL_DONE = 0,
+  TILE_DL_SKIPPED,
+  TILE_DL_FAILED
+} tile_dl_result_t;
+
+static tile_dl_result_t tile_dl_one(tile_dl_worker_t *w, uint32_t index, size_t *png_len) {
+  int z;
+  uint32_t x, y;
+  if (!tile_dl_plan_at(&tile_dl_plan_cur, index, &z, &x, &y)) return TILE_DL_FAILED;
+
+  char path[STORAGE_PATH_MAX];
+  snprintf(path, sizeof(path), "%s/%s/%d/%lu/%lu.bin", OSM_TILES_DIR, OSM_SERVER_NAME, z,
+           (unsigned long)x, (unsigned long)y);
+
+  // Reprise: tuile deja sur la carte
+  tile_coverage_result_t cov = tile_coverage_check(z, x, y);
+  size_t size = 0;
+  if (cov == TILE_COVERAGE_PRESENT ||
+      (cov == TILE_COVERAGE_UNKNOWN && storage_file_size(path, &size, STORAGE_PRIO_WEB) && size == TILE_DL_TILE_BYTES)) {
+    return TILE_DL_SKIPPED;
+  }
+
+  char url[TILE_DL_URL_MAX + 32];
+  if (!tile_dl_expand_url(tile_dl_job.url, z, x, y, w->index, url, sizeof(url))) return TILE_DL_FAILED;
+
+  size_t len = 0;
+  bool ok = false;
+  for (int attempt = 0; attempt <= TILE_DL_RETRIES && !ok && !tile_dl_stop_requested; attempt++) {
+    if (attempt) vTaskDelay(pdMS_TO_TICKS(TILE_DL_RETRY_DELAY_MS));
+    ok = tile_dl_fetch(w, url, &len);
+  }
+  *png_len = len;
+  if (!ok) return TILE_DL_FAILED;
+
+  // Repertoire <z>/<x> une seule fois par colonne
+  char dir[STORAGE_PATH_MAX];
+  snprintf(dir, sizeof(dir), "%s/%s/%d/%lu", OSM_TILES_DIR, OSM_SERVER_NAME, z, (unsigned long)x);
+  if (strcmp(dir, w->dir) != 0) {
+    if (!storage_call(tile_dl_mkdirs, dir, STORAGE_PRIO_WEB)) return TILE_DL_FAILED;
+    strcpy(w->dir, dir);
+  }
+  return storage_write(path, w->tile, TILE_DL_TILE_BYTES, STORAGE_PRIO_WEB) ? TILE_DL_DONE : TILE_DL_FAILED;
+}
+
+// ============================================================================
+// Taches
+// ============================================================================
+
+static void tile_dl_finish(void) {
+  bool complete = tile_dl_status.next >= tile_dl_status.total && !tile_dl_stop_requested;
+  if (complete) storage_remove(TILE_DL_JOB_PATH, STORAGE_PRIO_WEB);
+  else tile_dl_save_job();
+  tile_coverage_flush();
+  tile_dl_status.running = false;
+  tile_dl_status.waiting_wifi = false;
+#ifdef DEBUG_MODE
+  Serial.printf("[TILE_DL] %s: %lu downloaded, %lu skipped, %lu failed, %lu KB\n",
+                complete ? "Done" : "Stopped", (unsigned long)tile_dl_status.downloaded,
+                (unsigned long)tile_dl_status.skipped, (unsigned long)tile_dl_status.failed,
+                (unsigned long)(tile_dl_status.bytes / 1024));
+#endif
+}
+
+static void tile_dl_worker_task(void *pvParameters) {
+  tile_dl_worker_t *w = (tile_dl_worker_t *)pvParameters;
+  static const char *headers[] = { "Transfer-Encoding" };
+  w->http.setReuse(true);
+  w->http.setUserAgent(TILE_DL_USER_AGENT);
+  w->http.setTimeout(TILE_DL_HTTP_TIMEOUT_MS);
+  w->http.collectHeaders(headers, 1);
+  w->dir[0] = '\0';
+
+  while (!tile_dl_stop_requested) {
+    // Pas de WiFi: attendre sans consommer de tuile
+    if (!wifi_get_connected_status()) {
+      tile_dl_status.waiting_wifi = true;
+      vTaskDelay(pdMS_TO_TICKS(1000));
+      continue;
+    }
+    tile_dl_status.waiting_wifi = false;
+
+    xSemaphoreTake(tile_dl_mutex, portMAX_DELAY);
+    uint32_t index = tile_dl_status.next;
+    bool have = index < tile_dl_status.total;
+    if (have) {
+      tile_dl_status.next++;
+      tile_dl_inflight[w->index] = index;
+    }
+    xSemaphoreGive(tile_dl_mutex);
+    if (!have) break;
+
+    uint32_t t0 = millis();
+    size_t len = 0;
+    tile_dl_result_t r = tile_dl_one(w, index, &len);
+
+    xSemaphoreTake(tile_dl_mutex, portMAX_DELAY);
+    tile_dl_inflight[w->index] = TILE_DL_IDLE;
+    tile_dl_status.bytes += len;
+    if (r == TILE_DL_DONE) {
+      tile_dl_status.downloaded++;
+      tile_dl_status.last_tile_ms = millis() - t0;
+    } else if (r == TILE_DL_SKIPPED) {
+      tile_dl_status.skipped++;
+    } else if (!tile_dl_stop_requested) {
+      tile_dl_status.failed++;
+    }
+    bool checkpoint = ++tile_dl_since_checkpoint >= TILE_DL_CHECKPOINT_TILES;
+    if (checkpoint) tile_dl_since_checkpoint = 0;
+    xSemaphoreGive(tile_dl_mutex);
+
+    if (checkpoint) tile_dl_save_job();
+
+    // Debit limite pour les tuiles demandees au serveur
+    uint32_t elapsed = millis() - t0;
+    uint32_t wait = TILE_DL_YIELD_MS;
+    if (r != TILE_DL_SKIPPED && elapsed < TILE_DL_MIN_INTERVAL_MS) wait = max((uint32_t)TILE_DL_YIELD_MS, TILE_DL_MIN_INTERVAL_MS - elapsed);
+    vTaskDelay(pdMS_TO_TICKS(wait));
+  }
+
+  w->http.end();
+  heap_caps_free(w->dec);
+  heap_caps_free(w->tile);
+
+  // Derniere tache: reprise ou fin du travail
+  xSemaphoreTake(tile_dl_mutex, portMAX_DELAY);
+  bool last = (--tile_dl_active == 0);
+  xSemaphoreGive(tile_dl_mutex);
+  delete w;
+  if (last) tile_dl_finish();
+  vTaskDelete(NULL);
+}
+
+// ============================================================================
+// API publique
+// ============================================================================
+
+// Lance un telechargement (job->next: reprise); false si deja en cours,
+// serveur autre que OSM_SERVER_URL, zone invalide ou trop grande
+bool tile_download_start(const tile_dl_job_t *job) {
+  if (tile_dl_mutex == NULL) tile_dl_mutex = xSemaphoreCreateMutex();
+  if (tile_dl_status.running) return false;
+
+  // Un seul repertoire (et une seule couverture) par serveur: pas de melange de styles
+  if (strcmp(job->url, OSM_SERVER_URL) != 0) {
+#ifdef DEBUG_MODE
+    Serial.printf("[TILE_DL] Server not stored in %s: %s\n", OSM_SERVER_NAME, job->url);
+#endif
+    return false;
+  }
+
+  tile_dl_plan_t plan;
+  if (!tile_dl_plan(&plan, job, TILE_DL_MAX_TILES)) {
+#ifdef DEBUG_MODE
+    Serial.println("[TILE_DL] Empty or too large area");
+#endif
+    return false;
+  }
+
+  tile_dl_job = *job;
+  tile_dl_plan_cur = plan;
+  memset(&tile_dl_status, 0, sizeof(tile_dl_status));
+  tile_dl_status.total = plan.total;
+  tile_dl_status.next = job->next < plan.total ? job->next : plan.total;
+  tile_dl_since_checkpoint = 0;
+  tile_dl_stop_requested = false;
+  for (int i = 0; i < TILE_DL_WORKERS; i++) tile_dl_inflight[i] = TILE_DL_IDLE;
+  tile_dl_save_job();
+
+  // Les taches attendent le verrou: aucune ne peut finir avant la derniere creation
+  xSemaphoreTake(tile_dl_mutex, portMAX_DELAY);
+  tile_dl_status.running = true;
+  tile_dl_active = 0;
+  for (int i = 0; i < TILE_DL_WORKERS; i++) {
+    tile_dl_worker_t *w = new tile_dl_worker_t();
+    w->index = i;
+    w->dec = (png_rgb565_t *)heap_caps_malloc(sizeof(png_rgb565_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    w->tile = (uint16_t *)heap_caps_malloc(TILE_DL_TILE_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    char name[12];
+    snprintf(name, sizeof(name), "tile_dl%d", i);
+    bool ok = w->dec && w->tile &&
+              xTaskCreatePinnedToCore(tile_dl_worker_task, name, TILE_DL_TASK_STACK_SIZE, w, TILE_DL_TASK_PRIORITY,
+                                      NULL, TILE_DL_TASK_CORE) == pdPASS;
+    if (ok) tile_dl_active++;
+    if (!ok) {
+      heap_caps_free(w->dec);
+      heap_caps_free(w->tile);
+      delete w;
+    }
+  }
+  if (tile_dl_active == 0) tile_dl_status.running = false;
+  xSemaphoreGive(tile_dl_mutex);
+
+#ifdef DEBUG_MODE
+  Serial.printf("[TILE_DL] %lu tiles z%u-%u from #%lu, %d workers\n", (unsigned long)plan.total, job->z_min,
+                job->z_max, (unsigned long)tile_dl_status.next, tile_dl_active);
+#endif
+  return tile_dl_status.running;
+}
+
+// Reprise d'un telechargement interrompu (fichier de reprise sur la carte)
+bool tile_download_resume(void) {
+  size_t size = 0;
+  char text[TILE_DL_URL_MAX + 96];
+  if (!storage_file_size(TILE_DL_JOB_PATH, &size, STORAGE_PRIO_WEB) || size == 0 || size >= sizeof(text)) return false;
+  if (!storage_read(TILE_DL_JOB_PATH, 0, text, size, STORAGE_PRIO_WEB)) return false;
+  text[size] = '\0';
+
+  tile_dl_job_t job;
+  if (!tile_dl_job_parse(&job, text)) return false;
+  return tile_download_start(&job);
+}
+
+// Arret apres la tuile en cours; la reprise reste possible
+void tile_download_stop(void) {
+  if (tile_dl_status.running) tile_dl_stop_requested = true;
+}
+
+void tile_download_get_status(tile_dl_status_t *out) {
+  *out = tile_dl_status;
+}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef TOUCH_GESTURE_H
+#define TOUCH_GESTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <math.h>
+
+// =============================================================================
+// Reconnaissance de gestes a partir des points tactiles calibres (1 ou 2 doigts):
+// swipe avec vitesse, appui long, pincement par crans (zoom carte).
+// Calcul pur sans LVGL ni ESP-IDF: se compile sur PC.
+// =============================================================================
+
+#define TOUCH_GESTURE_SLOP_PX 20           // Deplacement toleree pour un appui immobile
+#define TOUCH_GESTURE_SWIPE_MIN_PX 80      // Swipe lent: distance minimale
+#define TOUCH_GESTURE_FLICK_MIN_PX 30      // Swipe rapide: distance minimale...
+#define TOUCH_GESTURE_FLICK_MIN_PX_S 600   // ...et vitesse minimale (px/s)
+#define TOUCH_GESTURE_LONG_PRESS_MS 600
+#define TOUCH_GESTURE_PINCH_STEP 1.4f      // Rapport d'ecartement pour un cran de zoom
+
+typedef enum {
+  TOUCH_GESTURE_NONE = 0,
+  TOUCH_GESTURE_SWIPE_LEFT,
+  TOUCH_GESTURE_SWIPE_RIGHT,
+  TOUCH_GESTURE_SWIPE_UP,
+  TOUCH_GESTURE_SWIPE_DOWN,
+  TOUCH_GESTURE_LONG_PRESS,
+  TOUCH_GESTURE_PINCH_IN,   // Doigts rapproches d'un cran (zoom arriere)
+  TOUCH_GESTURE_PINCH_OUT   // Doigts ecartes d'un cran (zoom avant)
+} touch_gesture_type_t;
+
+typedef struct {
+  touch_gesture_type_t type;
+  int16_t x, y;     // Point de depart (swipe, appui long) ou centre du pincement
+  float velocity;   // Swipe: vitesse moyenne (px/s)
+} touch_gesture_t;
+
+typedef struct {
+  bool down;
+  bool multi;           // Deux doigts vus pendant ce contact: pas de swipe/appui long
+  bool long_fired;
+  bool moved;           // Sorti de la zone de tolerance
+  uint32_t start_ms;
+  uint32_t last_ms;
+  int16_t start_x, start_y;
+  int16_t last_x, last_y;
+  float pinch_ref;      // Ecartement de reference du cran en cours
+} touch_gesture_ctx_t;
+
+static inline void touch_gesture_reset(touch_gesture_ctx_t *g) {
+  g->down = false;
+  g->multi = false;
+  g->long_fired = false;
+  g->moved = false;
+  g->pinch_ref = 0.0f;
+}
+
+// Un echantillon par lecture du controleur; true si un geste est reconnu
+static inline bool touch_gesture_update(touch_gesture_ctx_t *g, uint32_t now_ms, uint8_t points,
+                                        const int16_t *x, const int16_t *y, touch_gesture_t *out) {
+  out->type = TOUCH_GESTURE_NONE;
+
+  // --- Relache: fin du contact, decision swipe ---
+  if (points == 0) {
+    if (!g->down) return false;
+    bool single = !g->multi && !g->long_fired;
+    int32_t dx = g->last_x - g->start_x;
+    int32_t dy = g->last_y - g->start_y;
+    uint32_t dt = g->last_ms - g->start_ms;
+    touch_gesture_reset(g);
+    if (!single) return false;
+
+    int32_t adx = abs(dx), ady = abs(dy);
+    int32_t dist = (adx > ady) ? adx : ady;
+    float velocity = dt ? dist * 1000.0f / dt : 0.0f;
+    bool swipe = dist >= TOUCH_GESTURE_SWIPE_MIN_PX
+                 || (dist >= TOUCH_GESTURE_FLICK_MIN_PX && velocity >= TOUCH_GESTURE_FLICK_MIN_PX_S);
+    if (!swipe) return false;
+
+    if (adx > ady) out->type = (dx < 0) ? TOUCH_GESTURE_SWIPE_LEFT : TOUCH_GESTURE_SWIPE_RIGHT;
+    else out->type = (dy < 0) ? TOUCH_GESTURE_SWIPE_UP : TOUCH_GESTURE_SWIPE_DOWN;
+    out->x = g->last_x - dx;
+    out->y = g->last_y - dy;
+    out->velocity = velocity;
+    return true;
+  }
+
+  // --- Premier contact ---
+  if (!g->down) {
+    g->down = true;
+    g->start_ms = now_ms;
+    g->start_x = x[0];
+    g->start_y = y[0];
+  }
+  g->last_ms = now_ms;
+  g->last_x = x[0];
+  g->last_y = y[0];
+
+  // --- Deux doigts: pincement par crans ---
+  if (points >= 2) {
+    g->multi = true;
+    float dist = hypotf((float)(x[1] - x[0]), (float)(y[1] - y[0]));
+    if (dist < 1.0f) return false;
+    if (g->pinch_ref <= 0.0f) {
+      g->pinch_ref = dist;
+      return false;
+    }
+
+    float ratio = dist / g->pinch_ref;
+    if (ratio >= TOUCH_GESTURE_PINCH_STEP) out->type = TOUCH_GESTURE_PINCH_OUT;
+    else if (ratio <= 1.0f / TOUCH_GESTURE_PINCH_STEP) out->type = TOUCH_GESTURE_PINCH_IN;
+    else return false;
+
+    g->pinch_ref = dist;  // Cran suivant a partir d'ici
+    out->x = (x[0] + x[1]) / 2;
+    out->y = (y[0] + y[1]) / 2;
+    out->velocity = 0.0f;
+    return true;
+  }
+  g->pinch_ref = 0.0f;  // Retour a un doigt: nouveau cran au prochain pincement
+
+  // --- Un doigt: appui long si immobile ---
+  if (abs(x[0] - g->start_x) > TOUCH_GESTURE_SLOP_PX || abs(y[0] - g->start_y) > TOUCH_GESTURE_SLOP_PX) {
+    g->moved = true;
+  }
+  if (!g->multi && !g->moved && !g->long_fired && now_ms - g->start_ms >= TOUCH_GESTURE_LONG_PRESS_MS) {
+    g->long_fired = true;
+    out->type = TOUCH_GESTURE_LONG_PRESS;
+    out->x = g->start_x;
+    out->y = g->start_y;
+    out->velocity = 0.0f;
+    return true;
+  }
+  return false;
+}
+
+#endif
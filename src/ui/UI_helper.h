@@ -5,6 +5,7 @@
 #include "constants.h"
 #include "lang.h"
 #include "graphical.h"
+#include "src/lvgl_port/lvgl_mem.h"
 
 // ============================================================================
 // VARIABLES GLOBALES BARRE DE STATUT
@@ -41,23 +42,6 @@ static inline void ui_clear_standard_flags(lv_obj_t *obj) {
   lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
 }
 
-/**
- * @brief Clear flags standards (scrollable + clickable)
- */
-static inline lv_obj_t * ui_create_position_marker(lv_obj_t *parent) {
-  lv_obj_t *position_marker = lv_label_create(parent);
-  lv_label_set_text(position_marker, LV_SYMBOL_GPS);
-  lv_obj_set_style_text_font(position_marker, &lv_font_montserrat_32, 0);
-  lv_obj_set_style_text_color(position_marker, lv_color_hex(UI_COLOR_GPS_MARKER), 0);  // Bleu fonce
-  lv_obj_set_style_bg_opa(position_marker, LV_OPA_TRANSP, 0);
-  lv_obj_center(position_marker);
-  lv_obj_move_foreground(position_marker);
-  lv_obj_set_style_transform_angle(position_marker, -450, 0);
-
-  return position_marker;
-
-}
-
 /**
  * @brief Configure un container transparent (bg opa 0, border 0, pad 0)
  */
@@ -344,15 +328,20 @@ static inline void ui_keyboard_common_event_cb(lv_event_t *e) {
 void ui_switch_screen(void (*init_func)(void)) {
   lv_obj_t *old_screen = lv_scr_act();
   if (lvgl_port_lock(-1)) {
+    lvgl_mem_screen_begin();
     current_screen = lv_obj_create(NULL);
     init_func();
+    lvgl_mem_screen_created();
+    lvgl_port_set_target_fps(LVGL_PORT_FPS_SETTINGS);
     lv_screen_load(current_screen);
-    force_full_refresh();
+    lvgl_port_refresh_now();  // Le chargement invalide deja tout l'ecran
+    // Destruction et bilan memoire sous le meme verrou que la creation
+    if (old_screen != current_screen && old_screen != NULL) {
+      lv_obj_del(old_screen);
+      lvgl_mem_screen_deleted("menu");
+    }
     lvgl_port_unlock();
   }
-  if (old_screen != current_screen && old_screen != NULL) {
-    lv_obj_del(old_screen);
-  }
 }
 
 /**
@@ -473,7 +462,7 @@ static inline lv_obj_t *ui_create_screen(void) {
 static inline lv_obj_t *ui_create_title(lv_obj_t *parent, const char *text) {
   lv_obj_t *title = lv_label_create(parent);
   lv_label_set_text(title, text);
-  lv_obj_set_style_text_font(title, &lv_font_montserrat_48, 0);
+  lv_obj_set_style_text_font(title, UI_FONT_SCREEN_TITLE, 0);
   lv_obj_set_style_text_color(title, lv_color_hex(UI_COLOR_PRIMARY), 0);
   lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 5);
   return title;
@@ -1,6 +1,8 @@
 #ifndef GRAPHICAL_H
 #define GRAPHICAL_H
 
+#include "lvgl.h"
+
 /*=============================================================================
  * GRAPHICAL.H - Configuration centralisée de l'interface utilisateur
  * 
@@ -100,6 +102,7 @@
 #define UI_MAP_PREVIEW_H          360
 #define UI_MAP_CANVAS_W           440
 #define UI_MAP_CANVAS_H           350
+#define UI_MAP_VIEW_SIZE          527        // Carte de l'ecran de vol (carree)
 #define UI_SEPARATOR_H              1         // Hauteur séparateur horizontal
 
 /* --- Marges et paddings --- */
@@ -150,6 +153,19 @@
 #define UI_FONT_NORMAL            &lv_font_montserrat_20     // Texte normal
 #define UI_FONT_SMALL             &lv_font_montserrat_18     // Texte petit
 #define UI_FONT_DATA              &lv_font_montserrat_32     // Données numériques
+#define UI_FONT_FLIGHT_VALUE      &lv_font_montserrat_48     // Grands chiffres de vol (atlas)
+
+/* --- Petites tailles, repli si VARIO_FONTS_MINIMAL (lv_conf.h) --- */
+#if LV_FONT_MONTSERRAT_12
+#define UI_FONT_TINY              &lv_font_montserrat_12     // Axes de graphes
+#else
+#define UI_FONT_TINY              &lv_font_montserrat_14
+#endif
+#if LV_FONT_MONTSERRAT_16
+#define UI_FONT_CAPTION           &lv_font_montserrat_16     // Legendes
+#else
+#define UI_FONT_CAPTION           UI_FONT_SMALL
+#endif
 
 /* --- Alias par usage --- */
 #define UI_FONT_SCREEN_TITLE      UI_FONT_TITLE
@@ -0,0 +1,127 @@
+#ifndef UI_BINDING_H
+#define UI_BINDING_H
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "lvgl.h"
+
+// =============================================================================
+// Liaison donnees -> labels: une valeur n'est formatee et poussee dans LVGL
+// que si sa valeur affichee (quantifiee a la resolution du label) change.
+// Les couleurs ne sont appliquees que sur changement de teinte.
+// =============================================================================
+
+#define UI_BIND_MAX_VALUES 3
+
+typedef enum {
+  UI_BIND_SHOWN_NONE = 0,  // Rien affiche par la liaison (force la 1ere ecriture)
+  UI_BIND_SHOWN_INVALID,   // Texte "donnee invalide"
+  UI_BIND_SHOWN_VALUE
+} ui_bind_shown_t;
+
+// Ecriture du texte / de la couleur (par defaut: lv_label)
+typedef void (*ui_bind_text_fn_t)(lv_obj_t *obj, const char *text);
+typedef void (*ui_bind_color_fn_t)(lv_obj_t *obj, uint32_t color_hex);
+
+typedef struct {
+  lv_obj_t *label;
+  ui_bind_text_fn_t set_text;    // NULL = lv_label_set_text
+  ui_bind_color_fn_t set_color;  // NULL = style text_color
+  const char *fmt;      // Format printf, une conversion flottante par valeur
+  const char *invalid;  // Texte si donnee invalide
+  float step;           // Resolution affichee (1.0 = unite, 0.1 = dixieme)
+  uint8_t count;        // Nombre de valeurs dans le format
+  uint8_t shown;        // ui_bind_shown_t
+  int32_t shown_q[UI_BIND_MAX_VALUES];
+  uint32_t shown_color;
+  bool color_set;
+} ui_bind_label_t;
+
+// Compteurs globaux (evaluations vs ecritures effectives)
+typedef struct {
+  uint32_t evaluated;
+  uint32_t text_updates;
+  uint32_t color_updates;
+} ui_bind_stats_t;
+
+static ui_bind_stats_t ui_bind_stats = { 0 };
+
+static inline int32_t ui_bind_quantize(float value, float step) {
+  return (int32_t)lroundf(value / step);
+}
+
+static inline void ui_bind_label_init(ui_bind_label_t *b, lv_obj_t *label, const char *fmt,
+                                      const char *invalid, float step, uint8_t count) {
+  memset(b, 0, sizeof(ui_bind_label_t));
+  b->label = label;
+  b->fmt = fmt;
+  b->invalid = invalid;
+  b->step = step;
+  b->count = (count > UI_BIND_MAX_VALUES) ? UI_BIND_MAX_VALUES : count;
+}
+
+// Cible autre qu'un lv_label (ex. label atlas de glyphes)
+static inline void ui_bind_label_set_hooks(ui_bind_label_t *b, ui_bind_text_fn_t set_text,
+                                           ui_bind_color_fn_t set_color) {
+  b->set_text = set_text;
+  b->set_color = set_color;
+}
+
+static inline void ui_bind_write_text(ui_bind_label_t *b, const char *text) {
+  if (b->set_text) b->set_text(b->label, text);
+  else lv_label_set_text(b->label, text);
+}
+
+// Nouvelles valeurs: true si le texte a ete reecrit
+static inline bool ui_bind_label_set_n(ui_bind_label_t *b, bool valid, const float *values) {
+  if (!b->label) return false;
+  ui_bind_stats.evaluated++;
+
+  if (!valid) {
+    if (b->shown == UI_BIND_SHOWN_INVALID) return false;
+    ui_bind_write_text(b, b->invalid);
+    b->shown = UI_BIND_SHOWN_INVALID;
+    ui_bind_stats.text_updates++;
+    return true;
+  }
+
+  int32_t q[UI_BIND_MAX_VALUES] = { 0 };
+  bool changed = (b->shown != UI_BIND_SHOWN_VALUE);
+  for (uint8_t i = 0; i < b->count; i++) {
+    q[i] = ui_bind_quantize(values[i], b->step);
+    if (q[i] != b->shown_q[i]) changed = true;
+  }
+  if (!changed) return false;
+
+  // Formatage sur la valeur quantifiee: l'affichage ne depend que de q
+  char text[48];
+  float v0 = q[0] * b->step, v1 = q[1] * b->step, v2 = q[2] * b->step;
+  switch (b->count) {
+    case 1: snprintf(text, sizeof(text), b->fmt, v0); break;
+    case 2: snprintf(text, sizeof(text), b->fmt, v0, v1); break;
+    default: snprintf(text, sizeof(text), b->fmt, v0, v1, v2); break;
+  }
+  ui_bind_write_text(b, text);
+
+  memcpy(b->shown_q, q, sizeof(q));
+  b->shown = UI_BIND_SHOWN_VALUE;
+  ui_bind_stats.text_updates++;
+  return true;
+}
+
+static inline bool ui_bind_label_set(ui_bind_label_t *b, bool valid, float value) {
+  return ui_bind_label_set_n(b, valid, &value);
+}
+
+// Couleur du texte, appliquee seulement si elle change
+static inline void ui_bind_label_color(ui_bind_label_t *b, uint32_t color_hex) {
+  if (!b->label || (b->color_set && b->shown_color == color_hex)) return;
+  if (b->set_color) b->set_color(b->label, color_hex);
+  else lv_obj_set_style_text_color(b->label, lv_color_hex(color_hex), 0);
+  b->shown_color = color_hex;
+  b->color_set = true;
+  ui_bind_stats.color_updates++;
+}
+
+#endif
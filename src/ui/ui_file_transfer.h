@@ -9,6 +9,7 @@
 #include "globals.h"
 #include "src/wifi_task.h"
 #include "src/file_server_task.h"
+#include "src/storage_index.h"
 
 
 #ifdef TEST_MODE
@@ -18,9 +19,30 @@
 static lv_obj_t *label_status = NULL;
 static lv_obj_t *label_ssid = NULL;
 static lv_obj_t *label_ip = NULL;
+static lv_obj_t *label_storage = NULL;
 static lv_timer_t *status_timer = NULL;
 
 // Timer pour mettre a jour le statut WiFi
+// Contenu de la carte depuis l'index (aucun parcours de repertoire ici)
+static void storage_summary_update(void) {
+  storage_index_t idx;
+  if (!label_storage || !storage_index_get(&idx)) return;
+
+  if (!idx.scan_valid) {
+    lv_label_set_text(label_storage, LV_SYMBOL_SD_CARD " Indexing SD card...");
+    return;
+  }
+  int zmin, zmax;
+  int zooms = storage_index_tile_zoom_range(&idx, &zmin, &zmax);
+  char zoom_txt[24] = "";
+  if (zooms > 0) snprintf(zoom_txt, sizeof(zoom_txt), ", z%d-%d", zmin, zmax);
+  ui_label_set_formatted_text(label_storage, LV_SYMBOL_SD_CARD " Flights: %lu (%lu KB) | Tiles: %lu%s | Free: %lu MB",
+                              (unsigned long)idx.dirs[STORAGE_DIR_FLIGHTS].files,
+                              (unsigned long)(idx.dirs[STORAGE_DIR_FLIGHTS].bytes / 1024),
+                              (unsigned long)idx.dirs[STORAGE_DIR_TILES].files, zoom_txt,
+                              (unsigned long)(idx.free_kb / 1024));
+}
+
 static void status_update_timer_cb(lv_timer_t *timer) {
   if (!label_status || !label_ssid || !label_ip) {
     return;
@@ -39,6 +61,8 @@ static void status_update_timer_cb(lv_timer_t *timer) {
     lv_label_set_text(label_ssid, "Trying WiFi networks...");
     lv_label_set_text(label_ip, "");
   }
+
+  storage_summary_update();
 }
 
 // Callback pour le bouton sortie
@@ -98,6 +122,13 @@ void ui_file_transfer_init(void) {
   lv_obj_set_style_text_align(label_ip, LV_TEXT_ALIGN_CENTER, 0);
   lv_obj_set_width(label_ip, lv_pct(100));
 
+  // Contenu carte SD
+  label_storage = ui_create_label(main_left, "",
+                                  UI_FONT_NORMAL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+  lv_obj_set_style_text_align(label_storage, LV_TEXT_ALIGN_CENTER, 0);
+  lv_obj_set_width(label_storage, lv_pct(100));
+  storage_summary_update();
+
   // Separator
   lv_obj_t *sep = ui_create_h_separator(main_left, lv_color_hex(UI_SEPARATOR_COLOR));
 
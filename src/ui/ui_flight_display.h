@@ -4,6 +4,9 @@
 #include "lvgl.h"
 #include "UI_helper.h"
 #include "graphical.h"
+#include "ui_binding.h"
+#include "ui_gauges.h"
+#include "ui_glyph_atlas.h"
 #include "src/flight_data.h"
 
 // Enumeration pour les modes d'affichage altitude
@@ -28,6 +31,8 @@ static lv_obj_t *tab_agl = NULL;
 static lv_obj_t *tab_gps = NULL;
 static lv_obj_t *label_altitude_main = NULL;
 static lv_obj_t *label_altitude_sub = NULL;
+static ui_bind_label_t bind_altitude_main;
+static ui_bind_label_t bind_altitude_sub;
 
 static altitude_mode_t current_altitude_mode = ALT_MODE_QNH;
 
@@ -37,7 +42,11 @@ static lv_obj_t *tab_vario_int = NULL;
 static lv_obj_t *tab_vario_raw = NULL;
 static lv_obj_t *label_vario_main = NULL;
 static lv_obj_t *vario_bar = NULL;
-static lv_obj_t *vario_bar_fill = NULL;
+static ui_bind_label_t bind_vario_main;
+
+// Instruments dessines (colonne droite de la page centrale)
+static lv_obj_t *gauge_vario_needle = NULL;
+static lv_obj_t *gauge_altitude_tape = NULL;
 
 static vario_mode_t current_vario_mode = VARIO_MODE_INT;
 
@@ -161,14 +170,14 @@ static lv_obj_t *create_vario_tab(lv_obj_t *parent, const char *text, bool activ
   return tab;
 }
 
-// Fonction pour obtenir couleur vario selon valeur
-static lv_color_t get_vario_color(float vario) {
-  if (vario <= -10.0f) return lv_color_hex(0x00004D);      // Bleu tres fonce
-  if (vario <= -5.0f) return lv_color_hex(0x0000AA);       // Bleu fonce
-  if (vario <= 0.0f) return lv_color_hex(0x0055FF);        // Bleu
-  if (vario <= 2.0f) return lv_color_hex(0x00DD00);        // Vert
-  if (vario <= 5.0f) return lv_color_hex(0xFF8800);        // Orange
-  return lv_color_hex(0xDD0000);                            // Rouge fonce
+// Fonction pour obtenir couleur vario selon valeur (hex: comparable d'une mise a jour a l'autre)
+static uint32_t get_vario_color(float vario) {
+  if (vario <= -10.0f) return 0x00004D;      // Bleu tres fonce
+  if (vario <= -5.0f) return 0x0000AA;       // Bleu fonce
+  if (vario <= 0.0f) return 0x0055FF;        // Bleu
+  if (vario <= 2.0f) return 0x00DD00;        // Vert
+  if (vario <= 5.0f) return 0xFF8800;        // Orange
+  return 0xDD0000;                            // Rouge fonce
 }
 
 // Creation de la zone vario complete
@@ -198,33 +207,17 @@ lv_obj_t *ui_create_vario_zone(lv_obj_t *parent) {
   tab_vario_int = create_vario_tab(tabs_container, "INT", true);
   tab_vario_raw = create_vario_tab(tabs_container, "RAW", false);
   
-  // Label vario principal (70px)
-  label_vario_main = lv_label_create(vario_zone);
-  lv_label_set_text(label_vario_main, "---");
-  lv_obj_set_style_text_font(label_vario_main, &lv_font_montserrat_48, 0);
-  lv_obj_set_style_text_color(label_vario_main, lv_color_hex(UI_COLOR_TEXT_PRIMARY), 0);
+  // Label vario principal (70px), glyphes pre-rendus
+  label_vario_main = ui_atlas_label_create(vario_zone, ui_flight_atlas_get(), lv_pct(100));
+  ui_atlas_label_set_text(label_vario_main, "---");
   lv_obj_align(label_vario_main, LV_ALIGN_TOP_MID, 0, 40);
+  ui_bind_label_init(&bind_vario_main, label_vario_main, "%+.1f m/s", "--- m/s", 0.1f, 1);
+  ui_bind_label_set_hooks(&bind_vario_main, ui_atlas_label_set_text, ui_atlas_label_set_color);
   
-  // Barre de fond (40px)
-  vario_bar = lv_obj_create(vario_zone);
-  lv_obj_set_size(vario_bar, lv_pct(95), 40);
+  // Barre vario dessinee (40px)
+  vario_bar = ui_vario_bar_create(vario_zone, lv_pct(95), 40, UI_GAUGE_VARIO_RANGE);
   lv_obj_align(vario_bar, LV_ALIGN_BOTTOM_MID, 0, -15);
-  lv_obj_set_style_bg_color(vario_bar, lv_color_hex(0x222222), 0);
-  lv_obj_set_style_border_width(vario_bar, 1, 0);
-  lv_obj_set_style_border_color(vario_bar, lv_color_hex(0x555555), 0);
-  lv_obj_set_style_radius(vario_bar, 5, 0);
-  lv_obj_set_style_pad_all(vario_bar, 2, 0);
-  lv_obj_clear_flag(vario_bar, LV_OBJ_FLAG_SCROLLABLE);
-  
-  // Barre de remplissage
-  vario_bar_fill = lv_obj_create(vario_bar);
-  lv_obj_set_size(vario_bar_fill, 0, lv_pct(100));
-  lv_obj_align(vario_bar_fill, LV_ALIGN_LEFT_MID, 0, 0);
-  lv_obj_set_style_bg_color(vario_bar_fill, lv_color_hex(0x00DD00), 0);
-  lv_obj_set_style_border_width(vario_bar_fill, 0, 0);
-  lv_obj_set_style_radius(vario_bar_fill, 3, 0);
-  lv_obj_clear_flag(vario_bar_fill, LV_OBJ_FLAG_SCROLLABLE);
-  
+
   // Graduations (15px)
   lv_obj_t *label_grad = lv_label_create(vario_zone);
   lv_label_set_text(label_grad, "-10    -5     0     +5    +10");
@@ -236,66 +229,24 @@ lv_obj_t *ui_create_vario_zone(lv_obj_t *parent) {
 }
 
 // Mise a jour de l'affichage vario
-void ui_update_vario_display(void) {
-  extern flight_data_t g_flight_data;
-  extern SemaphoreHandle_t flight_data_mutex;
-  
-  if (!flight_data_mutex || !label_vario_main || !vario_bar_fill) {
+static void update_vario_display(const flight_data_t *data) {
+  if (!label_vario_main || !vario_bar) {
     return;
   }
-  
-  flight_data_t data;
-  if (xSemaphoreTake(flight_data_mutex, pdMS_TO_TICKS(5))) {
-    data = g_flight_data;
-    xSemaphoreGive(flight_data_mutex);
-  } else {
-    return;
-  }
-  
+
   // Selectionner la valeur selon le mode
-  float vario_value = (current_vario_mode == VARIO_MODE_INT) ? 
-                      data.vario_integrated : data.vario_raw;
-  
-  // Mettre a jour le label
-  static char vario_text[32];
-  if (data.valid) {
-    snprintf(vario_text, sizeof(vario_text), "%+.1f m/s", vario_value);
-    lv_label_set_text(label_vario_main, vario_text);
-    
-    // Couleur du texte selon valeur
-    lv_obj_set_style_text_color(label_vario_main, get_vario_color(vario_value), 0);
-  } else {
-    lv_label_set_text(label_vario_main, "--- m/s");
-    lv_obj_set_style_text_color(label_vario_main, lv_color_hex(UI_COLOR_TEXT_PRIMARY), 0);
-  }
-  
-  // Mettre a jour la barre (toujours avec vario integre pour stabilite visuelle)
-  if (data.valid) {
-    float vario_bar_value = data.vario_integrated;
-    
-    // Limiter entre -10 et +10
-    if (vario_bar_value < -10.0f) vario_bar_value = -10.0f;
-    if (vario_bar_value > 10.0f) vario_bar_value = 10.0f;
-    
-    // Convertir en pourcentage (0 = centre)
-    int bar_width = lv_obj_get_width(vario_bar) - 4;
-    int center = bar_width / 2;
-    int offset = (int)(vario_bar_value * center / 10.0f);
-    
-    if (vario_bar_value >= 0) {
-      // Montee : depuis centre vers droite
-      lv_obj_set_width(vario_bar_fill, offset);
-      lv_obj_align(vario_bar_fill, LV_ALIGN_LEFT_MID, center, 0);
-    } else {
-      // Descente : depuis centre vers gauche
-      lv_obj_set_width(vario_bar_fill, -offset);
-      lv_obj_align(vario_bar_fill, LV_ALIGN_LEFT_MID, center + offset, 0);
-    }
-    
-    // Couleur de la barre
-    lv_obj_set_style_bg_color(vario_bar_fill, get_vario_color(vario_bar_value), 0);
-  } else {
-    lv_obj_set_width(vario_bar_fill, 0);
+  float vario_value = (current_vario_mode == VARIO_MODE_INT) ?
+                      data->vario_integrated : data->vario_raw;
+
+  // Label: reecrit seulement si le dixieme affiche change
+  ui_bind_label_set(&bind_vario_main, data->valid, vario_value);
+  ui_bind_label_color(&bind_vario_main, data->valid ? get_vario_color(vario_value) : UI_COLOR_TEXT_PRIMARY);
+
+  // Barre et aiguille (toujours avec vario integre pour stabilite visuelle)
+  uint32_t color = get_vario_color(data->vario_integrated);
+  ui_vario_bar_set(vario_bar, data->valid, data->vario_integrated, color);
+  if (gauge_vario_needle) {
+    ui_vario_needle_set(gauge_vario_needle, data->valid, data->vario_integrated, color);
   }
 }
 
@@ -328,12 +279,12 @@ lv_obj_t *ui_create_altitude_zone(lv_obj_t *parent) {
   tab_agl = create_altitude_tab(tabs_container, "AGL", false);
   tab_gps = create_altitude_tab(tabs_container, "GPS", false);
   
-  // Label altitude principale (100px)
-  label_altitude_main = lv_label_create(altitude_zone);
-  lv_label_set_text(label_altitude_main, "---");
-  lv_obj_set_style_text_font(label_altitude_main, &lv_font_montserrat_48, 0);
-  lv_obj_set_style_text_color(label_altitude_main, lv_color_hex(UI_COLOR_TEXT_PRIMARY), 0);
+  // Label altitude principale (100px), glyphes pre-rendus
+  label_altitude_main = ui_atlas_label_create(altitude_zone, ui_flight_atlas_get(), lv_pct(100));
+  ui_atlas_label_set_text(label_altitude_main, "---");
   lv_obj_align(label_altitude_main, LV_ALIGN_CENTER, 0, -15);
+  ui_bind_label_init(&bind_altitude_main, label_altitude_main, "%.0f m", "--- m", 1.0f, 1);
+  ui_bind_label_set_hooks(&bind_altitude_main, ui_atlas_label_set_text, ui_atlas_label_set_color);
   
   // Label sous-valeurs (20px)
   label_altitude_sub = lv_label_create(altitude_zone);
@@ -341,17 +292,16 @@ lv_obj_t *ui_create_altitude_zone(lv_obj_t *parent) {
   lv_obj_set_style_text_font(label_altitude_sub, UI_FONT_SMALL, 0);
   lv_obj_set_style_text_color(label_altitude_sub, lv_color_hex(UI_COLOR_TEXT_SECONDARY), 0);
   lv_obj_align(label_altitude_sub, LV_ALIGN_BOTTOM_MID, 0, -5);
+  ui_bind_label_init(&bind_altitude_sub, label_altitude_sub, "BARO:%.0f  AGL:%.0f  GPS:%.0f",
+                     "BARO:---  AGL:---  GPS:---", 1.0f, 3);
   
   return altitude_zone;
 }
 
 // Mise a jour de l'affichage altitude
-void ui_update_altitude_display(void) {
-  extern flight_data_t g_flight_data;
-  extern SemaphoreHandle_t flight_data_mutex;
-  
+static void update_altitude_display(const flight_data_t *data) {
   // Verifications critiques
-  if (!flight_data_mutex || !label_altitude_main || !label_altitude_sub) {
+  if (!label_altitude_main || !label_altitude_sub) {
 #ifdef DEBUG_MODE
     static bool error_logged = false;
     if (!error_logged) {
@@ -361,59 +311,80 @@ void ui_update_altitude_display(void) {
 #endif
     return;
   }
-  
-  flight_data_t data;
-  if (xSemaphoreTake(flight_data_mutex, pdMS_TO_TICKS(5))) {
-    data = g_flight_data;
-    xSemaphoreGive(flight_data_mutex);
-  } else {
-    return;
-  }
-  
-  // Mettre a jour la valeur principale selon le mode
+
+  // Valeur principale selon le mode
   float main_value = 0.0f;
-  const char *unit = "m";
-  
+
   switch (current_altitude_mode) {
     case ALT_MODE_QNH:
-      main_value = data.altitude_qnh;
+      main_value = data->altitude_qnh;
       break;
     case ALT_MODE_BARO:
-      main_value = data.altitude_qne;  // Baro brut = QNE (1013.25)
+      main_value = data->altitude_qne;  // Baro brut = QNE (1013.25)
       break;
     case ALT_MODE_AGL:
-      main_value = data.altitude_agl;
+      main_value = data->altitude_agl;
       break;
     case ALT_MODE_GPS:
-      main_value = data.altitude_gps;
+      main_value = data->altitude_gps;
       break;
     default:
-      main_value = data.altitude_qnh;
+      main_value = data->altitude_qnh;
       break;
   }
-  
-  // Buffer statique pour eviter problemes memoire
-  static char alt_text[32];
-  static char sub_text[64];
-  
-  if (data.valid) {
-    snprintf(alt_text, sizeof(alt_text), "%.0f %s", main_value, unit);
-    lv_label_set_text(label_altitude_main, alt_text);
-  } else {
-    lv_label_set_text(label_altitude_main, "--- m");
+
+  ui_bind_label_set(&bind_altitude_main, data->valid, main_value);
+
+  // Sous-valeurs
+  float sub_values[3] = { data->altitude_qne, data->altitude_agl, data->altitude_gps };
+  ui_bind_label_set_n(&bind_altitude_sub, data->valid, sub_values);
+
+  if (gauge_altitude_tape) {
+    ui_altitude_tape_set(gauge_altitude_tape, data->valid, data->altitude_qnh);
   }
-  
-  // Mettre a jour les sous-valeurs
-  if (data.valid) {
-    snprintf(sub_text, sizeof(sub_text), 
-             "BARO:%.0f  AGL:%.0f  GPS:%.0f",
-             data.altitude_qne,
-             data.altitude_agl,
-             data.altitude_gps);
-    lv_label_set_text(label_altitude_sub, sub_text);
+}
+
+// Creation des instruments: vario a aiguille + bande altitude QNH
+void ui_create_gauges_zone(lv_obj_t *parent) {
+  gauge_vario_needle = ui_vario_needle_create(parent, UI_GAUGE_NEEDLE_SIZE, UI_GAUGE_VARIO_RANGE);
+  lv_obj_align(gauge_vario_needle, LV_ALIGN_LEFT_MID, 0, 0);
+
+  gauge_altitude_tape = ui_altitude_tape_create(parent, UI_GAUGE_TAPE_W, UI_GAUGE_TAPE_H, UI_GAUGE_TAPE_PX_PER_M);
+  lv_obj_align(gauge_altitude_tape, LV_ALIGN_RIGHT_MID, 0, 0);
+}
+
+// Ecran detruit: les instruments disparaissent avec lui
+void ui_flight_display_reset(void) {
+  label_vario_main = NULL;
+  label_altitude_main = NULL;
+  label_altitude_sub = NULL;
+  bind_vario_main.label = NULL;
+  bind_altitude_main.label = NULL;
+  bind_altitude_sub.label = NULL;
+  vario_bar = NULL;
+  gauge_vario_needle = NULL;
+  gauge_altitude_tape = NULL;
+}
+
+// Mise a jour des zones vol: un seul instantane des donnees pour tous les widgets
+void ui_update_flight_display(void) {
+  extern flight_data_t g_flight_data;
+  extern SemaphoreHandle_t flight_data_mutex;
+
+  if (!flight_data_mutex) {
+    return;
+  }
+
+  flight_data_t data;
+  if (xSemaphoreTake(flight_data_mutex, pdMS_TO_TICKS(5))) {
+    data = g_flight_data;
+    xSemaphoreGive(flight_data_mutex);
   } else {
-    lv_label_set_text(label_altitude_sub, "BARO:---  AGL:---  GPS:---");
+    return;
   }
+
+  update_altitude_display(&data);
+  update_vario_display(&data);
 }
 
 #endif // UI_FLIGHT_DISPLAY_H
\ No newline at end of file
@@ -0,0 +1,165 @@
+#ifndef UI_GAUGE_GEOM_H
+#define UI_GAUGE_GEOM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+// =============================================================================
+// Geometrie des instruments dessines (barre vario, aiguille, bande altitude).
+// Calculs purs sans LVGL: valeur -> pixels et zone a redessiner entre deux
+// etats. Se compile sur PC.
+// =============================================================================
+
+// Rectangle en pixels, bornes incluses (vide si x2 < x1 ou y2 < y1)
+typedef struct {
+  int32_t x1, y1, x2, y2;
+} gauge_rect_t;
+
+static inline bool gauge_rect_empty(const gauge_rect_t *r) {
+  return r->x2 < r->x1 || r->y2 < r->y1;
+}
+
+// --- Barre centree sur 0 ----------------------------------------------------
+
+// Segment rempli [lo, hi[ (px depuis le bord gauche) pour une valeur dans +-range
+static inline void gauge_bar_span(float value, float range, int32_t width, int32_t *lo, int32_t *hi) {
+  if (value > range) value = range;
+  if (value < -range) value = -range;
+
+  int32_t center = width / 2;
+  int32_t offset = (int32_t)lroundf(value * center / range);
+
+  if (offset >= 0) {
+    *lo = center;
+    *hi = center + offset;
+  } else {
+    *lo = center + offset;
+    *hi = center;
+  }
+}
+
+// Colonnes qui changent entre deux segments [lo, hi[ (les deux partent du centre):
+// union des bords modifies. false si rien ne change.
+static inline bool gauge_bar_delta(int32_t old_lo, int32_t old_hi, int32_t new_lo, int32_t new_hi,
+                                   int32_t *d_lo, int32_t *d_hi) {
+  if (old_lo == new_lo && old_hi == new_hi) return false;
+
+  // Segments vides: seul l'autre compte
+  if (old_lo == old_hi) {
+    *d_lo = new_lo;
+    *d_hi = new_hi;
+    return new_lo != new_hi;
+  }
+  if (new_lo == new_hi) {
+    *d_lo = old_lo;
+    *d_hi = old_hi;
+    return true;
+  }
+
+  int32_t lo = INT32_MAX, hi = INT32_MIN;
+  if (old_lo != new_lo) {
+    lo = (old_lo < new_lo) ? old_lo : new_lo;
+    hi = (old_lo < new_lo) ? new_lo : old_lo;
+  }
+  if (old_hi != new_hi) {
+    int32_t a = (old_hi < new_hi) ? old_hi : new_hi;
+    int32_t b = (old_hi < new_hi) ? new_hi : old_hi;
+    if (a < lo) lo = a;
+    if (b > hi) hi = b;
+  }
+  *d_lo = lo;
+  *d_hi = hi;
+  return true;
+}
+
+// Rectangle a redessiner (px relatifs a l'objet, cadre pad) entre deux etats
+// de la barre de hauteur h. Changement de teinte: tout le segment ancien et
+// nouveau; sinon les colonnes du delta, elargies de GAUGE_BAR_CORNER_PX pour
+// l'arrondi des coins du remplissage. false si rien a redessiner.
+#define GAUGE_BAR_CORNER_PX 4
+
+static inline bool gauge_bar_dirty(int32_t old_lo, int32_t old_hi, int32_t new_lo, int32_t new_hi, bool recolor,
+                                   int32_t pad, int32_t h, gauge_rect_t *r) {
+  r->y1 = 0;
+  r->y2 = h - 1;
+  if (recolor && old_hi > old_lo) {
+    r->x1 = pad + ((new_lo < old_lo) ? new_lo : old_lo);
+    r->x2 = pad + ((new_hi > old_hi) ? new_hi : old_hi);
+    return true;
+  }
+  int32_t d_lo, d_hi;
+  if (!gauge_bar_delta(old_lo, old_hi, new_lo, new_hi, &d_lo, &d_hi)) return false;
+  r->x1 = pad + d_lo - GAUGE_BAR_CORNER_PX;
+  r->x2 = pad + d_hi + GAUGE_BAR_CORNER_PX;
+  return true;
+}
+
+// --- Aiguille ---------------------------------------------------------------
+
+// Une position d'aiguille par degre sur le balayage
+#define GAUGE_NEEDLE_SWEEP_DEG 270
+#define GAUGE_NEEDLE_STEPS (GAUGE_NEEDLE_SWEEP_DEG + 1)
+
+// Extremites precalculees (relatives au centre) pour chaque pas angulaire
+typedef struct {
+  int16_t x_in[GAUGE_NEEDLE_STEPS];
+  int16_t y_in[GAUGE_NEEDLE_STEPS];
+  int16_t x_out[GAUGE_NEEDLE_STEPS];
+  int16_t y_out[GAUGE_NEEDLE_STEPS];
+  float range;  // Valeur pleine echelle (+-)
+} gauge_needle_geom_t;
+
+// Angle 0 = -range (bas gauche), sens horaire, ecran y vers le bas
+static inline void gauge_needle_init(gauge_needle_geom_t *g, int32_t r_in, int32_t r_out, float range) {
+  const float start_deg = 90.0f + (360.0f - GAUGE_NEEDLE_SWEEP_DEG) / 2.0f;
+  for (int i = 0; i < GAUGE_NEEDLE_STEPS; i++) {
+    float a = (start_deg + i) * (float)M_PI / 180.0f;
+    float c = cosf(a), s = sinf(a);
+    g->x_in[i] = (int16_t)lroundf(c * r_in);
+    g->y_in[i] = (int16_t)lroundf(s * r_in);
+    g->x_out[i] = (int16_t)lroundf(c * r_out);
+    g->y_out[i] = (int16_t)lroundf(s * r_out);
+  }
+  g->range = range;
+}
+
+static inline int32_t gauge_needle_step(const gauge_needle_geom_t *g, float value) {
+  if (value > g->range) value = g->range;
+  if (value < -g->range) value = -g->range;
+  return (int32_t)lroundf((value + g->range) * (GAUGE_NEEDLE_STEPS - 1) / (2.0f * g->range));
+}
+
+// Boite englobante de l'aiguille au pas donne, elargie de la demi-epaisseur
+static inline gauge_rect_t gauge_needle_bbox(const gauge_needle_geom_t *g, int32_t step, int32_t cx, int32_t cy,
+                                             int32_t half_width) {
+  int32_t xa = cx + g->x_in[step], ya = cy + g->y_in[step];
+  int32_t xb = cx + g->x_out[step], yb = cy + g->y_out[step];
+  gauge_rect_t r;
+  r.x1 = ((xa < xb) ? xa : xb) - half_width;
+  r.x2 = ((xa < xb) ? xb : xa) + half_width;
+  r.y1 = ((ya < yb) ? ya : yb) - half_width;
+  r.y2 = ((ya < yb) ? yb : ya) + half_width;
+  return r;
+}
+
+// --- Bande altitude ----------------------------------------------------------
+
+// Decalage de defilement (px) pour une altitude: la bande ne se redessine
+// que si ce decalage change
+static inline int32_t gauge_tape_offset(float altitude, float px_per_m) {
+  return (int32_t)lroundf(altitude * px_per_m);
+}
+
+// Ordonnee d'une graduation (m) dans une bande de hauteur h centree sur offset
+static inline int32_t gauge_tape_y(int32_t mark_m, float px_per_m, int32_t offset, int32_t h) {
+  return h / 2 - ((int32_t)lroundf(mark_m * px_per_m) - offset);
+}
+
+// Premiere graduation (multiple de step_m) visible en bas de bande
+static inline int32_t gauge_tape_first_mark(int32_t offset, float px_per_m, int32_t h, int32_t step_m) {
+  float bottom_m = (offset - h / 2) / px_per_m;
+  return (int32_t)floorf(bottom_m / step_m) * step_m;
+}
+
+#endif
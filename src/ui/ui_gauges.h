@@ -0,0 +1,309 @@
+#ifndef UI_GAUGES_H
+#define UI_GAUGES_H
+
+#include "lvgl.h"
+#include "graphical.h"
+#include "ui_gauge_geom.h"
+
+// =============================================================================
+// Instruments dessines en un seul evenement DRAW_MAIN (pas d'objets enfants,
+// pas de layout). Chaque setter n'invalide que la zone qui change.
+// =============================================================================
+
+#define GAUGE_COLOR_BG 0x222222
+#define GAUGE_COLOR_BORDER 0x555555
+#define GAUGE_COLOR_SCALE 0xAAAAAA
+
+// Etat commun (alloue avec l'objet, libere a sa suppression)
+typedef struct {
+  float range;         // Pleine echelle (barre, aiguille) ou m/px (bande)
+  uint32_t color;      // Couleur remplissage / aiguille
+  bool valid;
+  int32_t lo, hi;      // Barre: segment affiche
+  int32_t step;        // Aiguille: pas angulaire affiche
+  int32_t offset;      // Bande: decalage affiche (px)
+  gauge_needle_geom_t *needle;
+} ui_gauge_t;
+
+static void ui_gauge_delete_cb(lv_event_t *e) {
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_target(e);
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  if (g) {
+    if (g->needle) lv_free(g->needle);
+    lv_free(g);
+    lv_obj_set_user_data(obj, NULL);
+  }
+}
+
+static lv_obj_t *ui_gauge_create(lv_obj_t *parent, int32_t w, int32_t h, lv_event_cb_t draw_cb) {
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, w, h);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+
+  ui_gauge_t *g = (ui_gauge_t *)lv_malloc(sizeof(ui_gauge_t));
+  lv_memzero(g, sizeof(ui_gauge_t));
+  lv_obj_set_user_data(obj, g);
+
+  lv_obj_add_event_cb(obj, draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, ui_gauge_delete_cb, LV_EVENT_DELETE, NULL);
+  return obj;
+}
+
+// Invalidation d'un rectangle relatif a l'objet
+static void ui_gauge_invalidate(lv_obj_t *obj, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+  lv_area_t c, a;
+  lv_obj_get_coords(obj, &c);
+  a.x1 = c.x1 + x1;
+  a.y1 = c.y1 + y1;
+  a.x2 = c.x1 + x2;
+  a.y2 = c.y1 + y2;
+  lv_obj_invalidate_area(obj, &a);
+}
+
+// ============================================================================
+// BARRE VARIO (horizontale, centree sur 0)
+// ============================================================================
+
+#define GAUGE_BAR_PAD 3  // Cadre + marge autour du remplissage
+
+static void ui_vario_bar_draw_cb(lv_event_t *e) {
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_target(e);
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  lv_layer_t *layer = lv_event_get_layer(e);
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  const lv_area_t *c = &coords;
+
+  // Fond et cadre
+  lv_draw_rect_dsc_t bg;
+  lv_draw_rect_dsc_init(&bg);
+  bg.bg_color = lv_color_hex(GAUGE_COLOR_BG);
+  bg.border_color = lv_color_hex(GAUGE_COLOR_BORDER);
+  bg.border_width = 1;
+  bg.radius = 5;
+  lv_draw_rect(layer, &bg, c);
+
+  // Remplissage
+  if (g->valid && g->hi > g->lo) {
+    lv_draw_rect_dsc_t fill;
+    lv_draw_rect_dsc_init(&fill);
+    fill.bg_color = lv_color_hex(g->color);
+    fill.radius = 3;
+    lv_area_t a = { c->x1 + GAUGE_BAR_PAD + g->lo, c->y1 + GAUGE_BAR_PAD,
+                    c->x1 + GAUGE_BAR_PAD + g->hi - 1, c->y2 - GAUGE_BAR_PAD };
+    lv_draw_rect(layer, &fill, &a);
+  }
+
+  // Repere zero
+  lv_draw_rect_dsc_t mark;
+  lv_draw_rect_dsc_init(&mark);
+  mark.bg_color = lv_color_hex(GAUGE_COLOR_SCALE);
+  int32_t center = c->x1 + GAUGE_BAR_PAD + (lv_area_get_width(c) - 2 * GAUGE_BAR_PAD) / 2;
+  lv_area_t m = { center, c->y1 + 1, center, c->y2 - 1 };
+  lv_draw_rect(layer, &mark, &m);
+}
+
+lv_obj_t *ui_vario_bar_create(lv_obj_t *parent, int32_t w, int32_t h, float range) {
+  lv_obj_t *obj = ui_gauge_create(parent, w, h, ui_vario_bar_draw_cb);
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  g->range = range;
+  return obj;
+}
+
+// Nouvelle valeur: seules les colonnes entre l'ancien et le nouveau bord sont redessinees
+void ui_vario_bar_set(lv_obj_t *obj, bool valid, float value, uint32_t color) {
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  if (!g) return;
+
+  int32_t inner_w = lv_obj_get_width(obj) - 2 * GAUGE_BAR_PAD;
+  if (inner_w <= 0) return;  // Pas encore dimensionnee (layout en attente)
+  int32_t lo = inner_w / 2, hi = inner_w / 2;
+  if (valid) gauge_bar_span(value, g->range, inner_w, &lo, &hi);
+
+  gauge_rect_t r;
+  if (gauge_bar_dirty(g->lo, g->hi, lo, hi, color != g->color, GAUGE_BAR_PAD, lv_obj_get_height(obj), &r)) {
+    ui_gauge_invalidate(obj, r.x1, r.y1, r.x2, r.y2);
+  }
+
+  g->lo = lo;
+  g->hi = hi;
+  g->color = color;
+  g->valid = valid;
+}
+
+// ============================================================================
+// VARIO A AIGUILLE
+// ============================================================================
+
+#define GAUGE_NEEDLE_WIDTH 6
+
+static void ui_vario_needle_draw_cb(lv_event_t *e) {
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_target(e);
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  lv_layer_t *layer = lv_event_get_layer(e);
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  const lv_area_t *c = &coords;
+  int32_t cx = c->x1 + lv_area_get_width(c) / 2;
+  int32_t cy = c->y1 + lv_area_get_height(c) / 2;
+  const gauge_needle_geom_t *n = g->needle;
+
+  // Graduations (1 m/s, longues tous les 5 m/s)
+  lv_draw_line_dsc_t tick;
+  lv_draw_line_dsc_init(&tick);
+  tick.color = lv_color_hex(GAUGE_COLOR_SCALE);
+  for (int v = -(int)n->range; v <= (int)n->range; v++) {
+    int32_t s = gauge_needle_step(n, (float)v);
+    bool major = (v % 5) == 0;
+    tick.width = major ? 3 : 1;
+    // Graduation longue = dernier quart du rayon exterieur, courte = dernier huitieme
+    tick.p1.x = cx + n->x_out[s] * (major ? 6 : 7) / 8;
+    tick.p1.y = cy + n->y_out[s] * (major ? 6 : 7) / 8;
+    tick.p2.x = cx + n->x_out[s];
+    tick.p2.y = cy + n->y_out[s];
+    lv_draw_line(layer, &tick);
+  }
+
+  // Aiguille
+  if (g->valid) {
+    lv_draw_line_dsc_t needle;
+    lv_draw_line_dsc_init(&needle);
+    needle.color = lv_color_hex(g->color);
+    needle.width = GAUGE_NEEDLE_WIDTH;
+    needle.round_start = 1;
+    needle.round_end = 1;
+    needle.p1.x = cx + n->x_in[g->step];
+    needle.p1.y = cy + n->y_in[g->step];
+    needle.p2.x = cx + n->x_out[g->step] * 7 / 8;
+    needle.p2.y = cy + n->y_out[g->step] * 7 / 8;
+    lv_draw_line(layer, &needle);
+  }
+}
+
+lv_obj_t *ui_vario_needle_create(lv_obj_t *parent, int32_t size, float range) {
+  lv_obj_t *obj = ui_gauge_create(parent, size, size, ui_vario_needle_draw_cb);
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  g->needle = (gauge_needle_geom_t *)lv_malloc(sizeof(gauge_needle_geom_t));
+  gauge_needle_init(g->needle, size / 10, size / 2 - 4, range);
+  g->range = range;
+  g->step = gauge_needle_step(g->needle, 0.0f);
+  return obj;
+}
+
+// Nouvelle valeur: invalidation des boites de l'ancienne et de la nouvelle aiguille
+void ui_vario_needle_set(lv_obj_t *obj, bool valid, float value, uint32_t color) {
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  if (!g || !g->needle) return;
+
+  int32_t step = gauge_needle_step(g->needle, value);
+  if (step == g->step && valid == g->valid && color == g->color) return;
+
+  int32_t cx = lv_obj_get_width(obj) / 2;
+  int32_t cy = lv_obj_get_height(obj) / 2;
+  gauge_rect_t r_old = gauge_needle_bbox(g->needle, g->step, cx, cy, GAUGE_NEEDLE_WIDTH);
+  gauge_rect_t r_new = gauge_needle_bbox(g->needle, step, cx, cy, GAUGE_NEEDLE_WIDTH);
+  if (g->valid) ui_gauge_invalidate(obj, r_old.x1, r_old.y1, r_old.x2, r_old.y2);
+  if (valid) ui_gauge_invalidate(obj, r_new.x1, r_new.y1, r_new.x2, r_new.y2);
+
+  g->step = step;
+  g->valid = valid;
+  g->color = color;
+}
+
+// ============================================================================
+// BANDE ALTITUDE (defilement vertical)
+// ============================================================================
+
+#define GAUGE_TAPE_TICK_M 10   // Graduation
+#define GAUGE_TAPE_LABEL_M 50  // Graduation chiffree
+
+static void ui_altitude_tape_draw_cb(lv_event_t *e) {
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_target(e);
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  lv_layer_t *layer = lv_event_get_layer(e);
+  lv_area_t coords;
+  lv_obj_get_coords(obj, &coords);
+  const lv_area_t *c = &coords;
+  int32_t w = lv_area_get_width(c);
+  int32_t h = lv_area_get_height(c);
+  float px_per_m = g->range;
+
+  lv_draw_rect_dsc_t bg;
+  lv_draw_rect_dsc_init(&bg);
+  bg.bg_color = lv_color_hex(GAUGE_COLOR_BG);
+  bg.border_color = lv_color_hex(GAUGE_COLOR_BORDER);
+  bg.border_width = 1;
+  bg.radius = 5;
+  lv_draw_rect(layer, &bg, c);
+
+  if (!g->valid) return;
+
+  lv_draw_line_dsc_t tick;
+  lv_draw_line_dsc_init(&tick);
+  tick.color = lv_color_hex(GAUGE_COLOR_SCALE);
+
+  lv_draw_label_dsc_t text;
+  lv_draw_label_dsc_init(&text);
+  text.color = lv_color_hex(UI_COLOR_TEXT_PRIMARY);
+  text.font = UI_FONT_SMALL;
+  char buf[12];
+
+  int32_t mark = gauge_tape_first_mark(g->offset, px_per_m, h, GAUGE_TAPE_TICK_M);
+  for (;; mark += GAUGE_TAPE_TICK_M) {
+    int32_t y = gauge_tape_y(mark, px_per_m, g->offset, h);
+    if (y < 0) break;
+    if (y >= h) continue;
+
+    bool major = (mark % GAUGE_TAPE_LABEL_M) == 0;
+    tick.width = major ? 2 : 1;
+    tick.p1.x = c->x1 + 1;
+    tick.p1.y = c->y1 + y;
+    tick.p2.x = c->x1 + (major ? w / 3 : w / 6);
+    tick.p2.y = c->y1 + y;
+    lv_draw_line(layer, &tick);
+
+    if (major) {
+      lv_snprintf(buf, sizeof(buf), "%ld", (long)mark);
+      text.text = buf;
+      lv_area_t a = { c->x1 + w / 3 + 6, c->y1 + y - 10, c->x2 - 4, c->y1 + y + 10 };
+      lv_draw_label(layer, &text, &a);
+    }
+  }
+
+  // Repere altitude courante
+  lv_draw_line_dsc_t ref;
+  lv_draw_line_dsc_init(&ref);
+  ref.color = lv_color_hex(g->color);
+  ref.width = 3;
+  ref.p1.x = c->x1 + 1;
+  ref.p1.y = c->y1 + h / 2;
+  ref.p2.x = c->x2 - 1;
+  ref.p2.y = c->y1 + h / 2;
+  lv_draw_line(layer, &ref);
+}
+
+lv_obj_t *ui_altitude_tape_create(lv_obj_t *parent, int32_t w, int32_t h, float px_per_m) {
+  lv_obj_t *obj = ui_gauge_create(parent, w, h, ui_altitude_tape_draw_cb);
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  g->range = px_per_m;
+  g->color = UI_COLOR_PRIMARY;
+  g->offset = INT32_MIN;
+  return obj;
+}
+
+// La bande defile en entier: redessinee seulement si le decalage pixel change
+void ui_altitude_tape_set(lv_obj_t *obj, bool valid, float altitude) {
+  ui_gauge_t *g = (ui_gauge_t *)lv_obj_get_user_data(obj);
+  if (!g) return;
+
+  int32_t offset = valid ? gauge_tape_offset(altitude, g->range) : g->offset;
+  if (offset == g->offset && valid == g->valid) return;
+
+  g->offset = offset;
+  g->valid = valid;
+  lv_obj_invalidate(obj);
+}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef UI_GLYPH_ATLAS_H
+#define UI_GLYPH_ATLAS_H
+
+#include <string.h>
+#include "lvgl.h"
+#include "graphical.h"
+
+#ifdef ARDUINO
+#include "esp_heap_caps.h"
+#define UI_ATLAS_MALLOC(size) heap_caps_malloc((size), MALLOC_CAP_SPIRAM)
+#else
+#include <stdlib.h>
+#define UI_ATLAS_MALLOC(size) malloc(size)
+#endif
+
+// =============================================================================
+// Atlas de glyphes pre-rasterises pour les grands chiffres de vol: chaque
+// caractere est rendu une fois (anticrenele, pre-melange sur le fond des zones)
+// en RGB565 en PSRAM, puis simplement copie a chaque mise a jour.
+// Une variante par couleur de texte, creee a la premiere utilisation et
+// comptee par label: seule une variante sans label peut etre recyclee.
+// =============================================================================
+
+#define UI_ATLAS_CHARSET "0123456789+-. m/s"
+#define UI_ATLAS_GLYPHS (sizeof(UI_ATLAS_CHARSET) - 1)
+#define UI_ATLAS_MAX_VARIANTS 8  // Blanc + 6 teintes vario + marge
+#define UI_ATLAS_MAX_TEXT 16
+
+typedef struct {
+  uint32_t fg;    // Couleur du texte (hex)
+  uint16_t refs;  // Labels qui affichent cette variante
+  uint8_t *pixels;
+  lv_image_dsc_t glyph[UI_ATLAS_GLYPHS];
+} ui_atlas_variant_t;
+
+typedef struct {
+  const lv_font_t *font;
+  uint32_t bg;                 // Fond de pre-melange (hex)
+  int32_t height;              // Hauteur de ligne
+  int32_t width[UI_ATLAS_GLYPHS];
+  int32_t total_width;
+  ui_atlas_variant_t variant[UI_ATLAS_MAX_VARIANTS];
+  uint8_t variant_count;
+} ui_glyph_atlas_t;
+
+static inline int ui_atlas_index(char c) {
+  const char *p = strchr(UI_ATLAS_CHARSET, c);
+  return (c && p) ? (int)(p - UI_ATLAS_CHARSET) : -1;
+}
+
+void ui_atlas_init(ui_glyph_atlas_t *a, const lv_font_t *font, uint32_t bg) {
+  memset(a, 0, sizeof(ui_glyph_atlas_t));
+  a->font = font;
+  a->bg = bg;
+  a->height = lv_font_get_line_height(font);
+  for (size_t i = 0; i < UI_ATLAS_GLYPHS; i++) {
+    a->width[i] = lv_font_get_glyph_width(font, UI_ATLAS_CHARSET[i], 0);
+    a->total_width += a->width[i];
+  }
+}
+
+// Rasterisation de tous les glyphes dans une couleur (via un canvas temporaire)
+static bool ui_atlas_render_variant(ui_glyph_atlas_t *a, ui_atlas_variant_t *v, uint32_t fg) {
+  size_t stride = a->total_width * 2;
+  bool recycled = v->pixels != NULL;
+  if (!v->pixels) {
+    v->pixels = (uint8_t *)UI_ATLAS_MALLOC(stride * a->height);
+    if (!v->pixels) return false;
+  }
+  v->fg = fg;
+
+  lv_obj_t *canvas = lv_canvas_create(lv_layer_sys());
+  lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+  lv_canvas_set_buffer(canvas, v->pixels, a->total_width, a->height, LV_COLOR_FORMAT_RGB565);
+  lv_canvas_fill_bg(canvas, lv_color_hex(a->bg), LV_OPA_COVER);
+
+  lv_layer_t layer;
+  lv_canvas_init_layer(canvas, &layer);
+
+  lv_draw_label_dsc_t dsc;
+  lv_draw_label_dsc_init(&dsc);
+  dsc.font = a->font;
+  dsc.color = lv_color_hex(fg);
+
+  char text[2] = { 0, 0 };
+  int32_t x = 0;
+  for (size_t i = 0; i < UI_ATLAS_GLYPHS; i++) {
+    text[0] = UI_ATLAS_CHARSET[i];
+    dsc.text = text;
+    dsc.text_local = 1;
+    lv_area_t area = { x, 0, x + a->width[i] - 1, a->height - 1 };
+    lv_draw_label(&layer, &dsc, &area);
+    x += a->width[i];
+  }
+  lv_canvas_finish_layer(canvas, &layer);
+  lv_obj_del(canvas);
+
+  // Une image par glyphe, pointant dans la bande commune
+  x = 0;
+  for (size_t i = 0; i < UI_ATLAS_GLYPHS; i++) {
+    lv_image_dsc_t *img = &v->glyph[i];
+    memset(img, 0, sizeof(lv_image_dsc_t));
+    img->header.magic = LV_IMAGE_HEADER_MAGIC;
+    img->header.cf = LV_COLOR_FORMAT_RGB565;
+    img->header.w = a->width[i];
+    img->header.h = a->height;
+    img->header.stride = stride;
+    img->data = v->pixels + x * 2;
+    img->data_size = stride * a->height - x * 2;
+    x += a->width[i];
+  }
+
+  // Slot recycle: le cache d'images LVGL peut garder ses anciens glyphes
+  if (recycled) {
+    for (size_t i = 0; i < UI_ATLAS_GLYPHS; i++) lv_image_cache_drop(&v->glyph[i]);
+  }
+  return true;
+}
+
+// Variante d'une couleur, prise par l'appelant (refs + 1) et rendue par
+// ui_atlas_release_variant(). Creee dans un slot libre ou a la place d'une
+// variante plus affichee; NULL si tous les slots sont pris ou memoire insuffisante.
+ui_atlas_variant_t *ui_atlas_get_variant(ui_glyph_atlas_t *a, uint32_t fg) {
+  ui_atlas_variant_t *v = NULL;
+  for (uint8_t i = 0; i < a->variant_count; i++) {
+    if (a->variant[i].fg == fg) {
+      a->variant[i].refs++;
+      return &a->variant[i];
+    }
+    if (!v && a->variant[i].refs == 0) v = &a->variant[i];
+  }
+
+  if (a->variant_count < UI_ATLAS_MAX_VARIANTS) {
+    v = &a->variant[a->variant_count];
+    if (!ui_atlas_render_variant(a, v, fg)) return NULL;
+    a->variant_count++;
+  } else {
+    if (!v) return NULL;
+    if (!ui_atlas_render_variant(a, v, fg)) return NULL;
+  }
+  v->refs = 1;
+  return v;
+}
+
+static inline void ui_atlas_release_variant(ui_atlas_variant_t *v) {
+  if (v && v->refs) v->refs--;
+}
+
+// Atlas partage des ecrans de vol (chiffres 48px sur fond des zones), jamais libere
+static ui_glyph_atlas_t ui_flight_atlas = { 0 };
+
+ui_glyph_atlas_t *ui_flight_atlas_get(void) {
+  if (!ui_flight_atlas.font) {
+    ui_atlas_init(&ui_flight_atlas, UI_FONT_FLIGHT_VALUE, UI_COLOR_SURFACE);
+  }
+  return &ui_flight_atlas;
+}
+
+// Largeur d'un texte en pixels (caracteres hors atlas ignores)
+static inline int32_t ui_atlas_text_width(const ui_glyph_atlas_t *a, const char *text) {
+  int32_t w = 0;
+  for (; *text; text++) {
+    int idx = ui_atlas_index(*text);
+    if (idx >= 0) w += a->width[idx];
+  }
+  return w;
+}
+
+// ============================================================================
+// LABEL ATLAS: objet sans style, texte centre dessine par copie de glyphes
+// ============================================================================
+
+typedef struct {
+  ui_glyph_atlas_t *atlas;
+  ui_atlas_variant_t *variant;  // NULL: pas de slot, texte dessine par lv_draw_label
+  uint32_t fg;
+  char text[UI_ATLAS_MAX_TEXT];
+} ui_atlas_label_t;
+
+static void ui_atlas_label_draw_cb(lv_event_t *e) {
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_target(e);
+  ui_atlas_label_t *l = (ui_atlas_label_t *)lv_obj_get_user_data(obj);
+  if (!l) return;
+
+  lv_layer_t *layer = lv_event_get_layer(e);
+  lv_area_t c;
+  lv_obj_get_coords(obj, &c);
+
+  const ui_glyph_atlas_t *a = l->atlas;
+
+  // Variante indisponible (slots pris, PSRAM): rendu normal, plus lent
+  if (!l->variant) {
+    lv_draw_label_dsc_t label;
+    lv_draw_label_dsc_init(&label);
+    label.font = a->font;
+    label.color = lv_color_hex(l->fg);
+    label.align = LV_TEXT_ALIGN_CENTER;
+    label.text = l->text;
+    label.text_local = 1;
+    lv_draw_label(layer, &label, &c);
+    return;
+  }
+  int32_t x = c.x1 + (lv_area_get_width(&c) - ui_atlas_text_width(a, l->text)) / 2;
+  int32_t y = c.y1 + (lv_area_get_height(&c) - a->height) / 2;
+
+  lv_draw_image_dsc_t dsc;
+  lv_draw_image_dsc_init(&dsc);
+
+  for (const char *p = l->text; *p; p++) {
+    int idx = ui_atlas_index(*p);
+    if (idx < 0) continue;
+    dsc.src = &l->variant->glyph[idx];
+    lv_area_t area = { x, y, x + a->width[idx] - 1, y + a->height - 1 };
+    lv_draw_image(layer, &dsc, &area);
+    x += a->width[idx];
+  }
+}
+
+static void ui_atlas_label_delete_cb(lv_event_t *e) {
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_target(e);
+  ui_atlas_label_t *l = (ui_atlas_label_t *)lv_obj_get_user_data(obj);
+  if (l) ui_atlas_release_variant(l->variant);
+  lv_free(l);
+  lv_obj_set_user_data(obj, NULL);
+}
+
+// Sans memoire pour l'etat du label: simple lv_label centre, les fonctions
+// ui_atlas_label_set_* le reconnaissent
+lv_obj_t *ui_atlas_label_create(lv_obj_t *parent, ui_glyph_atlas_t *atlas, int32_t w) {
+  ui_atlas_label_t *l = (ui_atlas_label_t *)lv_malloc(sizeof(ui_atlas_label_t));
+  if (!l) {
+    lv_obj_t *label = lv_label_create(parent);
+    lv_obj_set_width(label, w);
+    lv_obj_set_style_text_font(label, atlas->font, 0);
+    lv_obj_set_style_text_color(label, lv_color_hex(UI_COLOR_TEXT_PRIMARY), 0);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(label, "");
+    return label;
+  }
+
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, w, atlas->height);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+
+  lv_memzero(l, sizeof(ui_atlas_label_t));
+  l->atlas = atlas;
+  l->fg = UI_COLOR_TEXT_PRIMARY;
+  l->variant = ui_atlas_get_variant(atlas, UI_COLOR_TEXT_PRIMARY);
+  lv_obj_set_user_data(obj, l);
+
+  lv_obj_add_event_cb(obj, ui_atlas_label_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, ui_atlas_label_delete_cb, LV_EVENT_DELETE, NULL);
+  return obj;
+}
+
+void ui_atlas_label_set_text(lv_obj_t *obj, const char *text) {
+  if (lv_obj_check_type(obj, &lv_label_class)) {
+    lv_label_set_text(obj, text);
+    return;
+  }
+  ui_atlas_label_t *l = (ui_atlas_label_t *)lv_obj_get_user_data(obj);
+  if (!l || strncmp(l->text, text, UI_ATLAS_MAX_TEXT) == 0) return;
+  strncpy(l->text, text, UI_ATLAS_MAX_TEXT - 1);
+  lv_obj_invalidate(obj);
+}
+
+void ui_atlas_label_set_color(lv_obj_t *obj, uint32_t color_hex) {
+  if (lv_obj_check_type(obj, &lv_label_class)) {
+    lv_obj_set_style_text_color(obj, lv_color_hex(color_hex), 0);
+    return;
+  }
+  ui_atlas_label_t *l = (ui_atlas_label_t *)lv_obj_get_user_data(obj);
+  if (!l || l->fg == color_hex) return;
+  // Tous les slots affiches: dessin sans atlas dans la nouvelle couleur
+  ui_atlas_release_variant(l->variant);
+  l->variant = ui_atlas_get_variant(l->atlas, color_hex);
+  l->fg = color_hex;
+  lv_obj_invalidate(obj);
+}
+
+#endif
@@ -2,91 +2,102 @@
 #define UI_MAIN_SCREENS_H
 
 #include "lvgl.h"
+#include "esp_timer.h"
 #include "constants.h"
 #include "UI_helper.h"
 #include "graphical.h"
 #include "globals.h"
 #include "ui_flight_display.h"
+#include "ui_map_layers.h"
+#include "src/lvgl_port/lvgl_port.h"
 
 // Indice ecran courant (0=gauche, 1=centre, 2=droite)
 static uint8_t current_screen_index = 1;
 
+// Les 3 pages de vol sont construites une seule fois dans le meme ecran LVGL,
+// le swipe ne fait que basculer leur visibilite
+#define UI_FLIGHT_PAGE_COUNT 3
+static lv_obj_t *flight_screen = NULL;
+static lv_obj_t *flight_pages[UI_FLIGHT_PAGE_COUNT] = { NULL };
+static lv_timer_t *flight_update_timer = NULL;
+
+// Instrumentation des changements de page (us)
+typedef struct {
+  uint32_t build_us;        // Construction initiale des 3 pages
+  uint32_t count;           // Nombre de changements
+  uint32_t last_switch_us;  // Bascule de visibilite
+  uint32_t last_frame_us;   // Du swipe a la fin du frame affiche
+  uint32_t max_frame_us;
+} ui_page_switch_stats_t;
+
+static ui_page_switch_stats_t page_switch_stats = { 0 };
+static int64_t page_switch_start_us = 0;  // 0 = pas de changement en attente de frame
+
 // Forward declarations
-void ui_screen_left_init(void);
-void ui_screen_center_init(void);
-void ui_screen_right_init(void);
+static void ui_page_left_build(lv_obj_t *page);
+static void ui_page_center_build(lv_obj_t *page);
+static void ui_page_right_build(lv_obj_t *page);
 
-// Variables pour gestion du swipe
-static lv_point_t touch_start_point;
-static bool touch_started = false;
 static int current_map_zoom = 0;
 static lv_obj_t *map_canvas = NULL;
 static lv_obj_t *map_container = NULL;
 static lv_obj_t *btn_zoom_in = NULL;
 static lv_obj_t *btn_zoom_out = NULL;
-static lv_obj_t *position_marker = NULL;
+static lv_obj_t *map_overlay = NULL;
+
+// Timers propres a chaque page: actifs uniquement si la page est visible
+static void flight_page_timers_set(uint8_t index, bool running) {
+  if (index == 1 && flight_update_timer) {
+    if (running) {
+      lv_timer_resume(flight_update_timer);
+      lv_timer_ready(flight_update_timer);  // Valeurs a jour des l'affichage
+    } else {
+      lv_timer_pause(flight_update_timer);
+    }
+  }
+}
+
+// Fin du premier frame apres un changement de page
+static void page_switch_refr_ready_cb(lv_event_t *e) {
+  if (page_switch_start_us == 0) return;
+
+  uint32_t frame_us = (uint32_t)(esp_timer_get_time() - page_switch_start_us);
+  page_switch_start_us = 0;
+  page_switch_stats.last_frame_us = frame_us;
+  if (frame_us > page_switch_stats.max_frame_us) page_switch_stats.max_frame_us = frame_us;
+
+#ifdef DEBUG_MODE
+  Serial.printf("[UI] Page switch: %lu us logic, %lu us to frame\n",
+                (unsigned long)page_switch_stats.last_switch_us, (unsigned long)frame_us);
+#endif
+}
 
 // Fonction pour changer d'ecran
 static void switch_to_screen(uint8_t index) {
-  current_screen_index = index;
+  if (index >= UI_FLIGHT_PAGE_COUNT || !flight_pages[index]) return;
 
-  // Recreer l'ecran selon l'index
-  switch (index) {
-    case 0:
-      ui_screen_left_init();
-      break;
-    case 1:
-      ui_screen_center_init();
-      break;
-    case 2:
-      ui_screen_right_init();
-      break;
+  int64_t start = esp_timer_get_time();
+
+  if (index != current_screen_index) {
+    flight_page_timers_set(current_screen_index, false);
+    lv_obj_add_flag(flight_pages[current_screen_index], LV_OBJ_FLAG_HIDDEN);
   }
+  lv_obj_clear_flag(flight_pages[index], LV_OBJ_FLAG_HIDDEN);
+  flight_page_timers_set(index, true);
+  current_screen_index = index;
+
+  page_switch_stats.count++;
+  page_switch_stats.last_switch_us = (uint32_t)(esp_timer_get_time() - start);
+  page_switch_start_us = start;
 
 #ifdef DEBUG_MODE
   Serial.printf("Switch to screen: %d\n", index);
 #endif
 }
 
-// Event handler pour gestion du swipe
-static void swipe_event_handler(lv_event_t *e) {
-  lv_event_code_t code = lv_event_get_code(e);
-  lv_obj_t *screen = (lv_obj_t *)lv_event_get_target(e);
-
-  if (code == LV_EVENT_PRESSED) {
-    lv_indev_t *indev = lv_indev_active();
-    if (indev) {
-      lv_indev_get_point(indev, &touch_start_point);
-      touch_started = true;
-    }
-  } else if (code == LV_EVENT_RELEASED) {
-    if (touch_started) {
-      lv_indev_t *indev = lv_indev_active();
-      if (indev) {
-        lv_point_t touch_end_point;
-        lv_indev_get_point(indev, &touch_end_point);
-
-        int32_t diff_x = touch_end_point.x - touch_start_point.x;
-        int32_t diff_y = touch_end_point.y - touch_start_point.y;
-
-        // Detection swipe horizontal (threshold: 80px)
-        if (abs(diff_x) > 80 && abs(diff_x) > abs(diff_y)) {
-          if (diff_x > 0) {
-            // Swipe vers droite -> ecran precedent
-            if (current_screen_index > 0) {
-              switch_to_screen(current_screen_index - 1);
-            }
-          } else {
-            // Swipe vers gauche -> ecran suivant
-            if (current_screen_index < 2) {
-              switch_to_screen(current_screen_index + 1);
-            }
-          }
-        }
-      }
-      touch_started = false;
-    }
-  }
+// Statistiques changement de page
+void ui_main_screens_get_switch_stats(ui_page_switch_stats_t *out) {
+  *out = page_switch_stats;
 }
 
 // Fonction pour mettre a jour l'etat des boutons zoom
@@ -106,6 +117,55 @@ static void update_zoom_buttons_state(void) {
   }
 }
 
+// Position affichee sur la carte (GPS, ou point de test)
+static void map_display_position(double *lat, double *lon) {
+#ifdef FLIGHT_TEST_MODE
+  *lat = TEST_LAT;
+  *lon = TEST_LON;
+#else
+  *lat = g_sensor_data.gps.valid ? g_sensor_data.gps.latitude : TEST_LAT;
+  *lon = g_sensor_data.gps.valid ? g_sensor_data.gps.longitude : TEST_LON;
+#endif
+}
+
+// Couche de base recreee (nouveau zoom ou recentrage), sous les couches dynamiques et les boutons.
+// Creation precedente echouee (memoire): nouvel essai a chaque appel
+static void map_rebuild(void) {
+  if (!map_container) return;
+
+  double lat, lon;
+  map_display_position(&lat, &lon);
+
+  if (map_canvas) lv_obj_del(map_canvas);
+  map_canvas = create_map_view(map_container, lat, lon, current_map_zoom, UI_MAP_VIEW_SIZE, UI_MAP_VIEW_SIZE);
+  if (map_canvas) {
+    lv_obj_align(map_canvas, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_move_to_index(map_canvas, 0);
+  }
+
+  ui_map_set_reference(lat, lon, current_map_zoom);
+  ui_map_marker_set(lat, lon, g_sensor_data.gps.angle);
+  if (map_overlay) lv_obj_invalidate(map_overlay);  // Nouvelle reference: toutes les couches
+}
+
+// Marqueur avion: couche dynamique du compositeur, la carte n'est redessinee
+// que lorsque l'avion s'eloigne du centre
+static void map_update_marker(void) {
+  static uint32_t map_retry_tick = 0;
+  double lat, lon;
+  map_display_position(&lat, &lon);
+  bool retry = !map_canvas && lv_tick_elaps(map_retry_tick) >= UI_MAP_RETRY_MS;
+  if (retry) map_retry_tick = lv_tick_get();
+  if (retry || (map_canvas && ui_map_needs_recenter(lat, lon))) {
+#ifdef DEBUG_MODE
+    Serial.println(map_canvas ? "[MAP] Recentrage" : "[MAP] Nouvel essai de creation");
+#endif
+    map_rebuild();
+    return;
+  }
+  ui_map_marker_set(lat, lon, g_sensor_data.gps.angle);
+}
+
 // Callbacks pour les boutons zoom
 static void btn_zoom_in_cb(lv_event_t *e) {
   if (current_map_zoom < MAP_ZOOM_MAX) {
@@ -116,32 +176,7 @@ static void btn_zoom_in_cb(lv_event_t *e) {
     Serial.printf("Zoom in: level=%d\n", current_map_zoom);
 #endif
 
-    // Recreer la carte avec nouveau zoom
-    if (map_canvas) {
-      lv_obj_del(map_canvas);
-#ifdef FLIGHT_TEST_MODE
-      map_canvas = create_map_view(map_container, TEST_LAT, TEST_LON,
-                                   current_map_zoom, 527, 527);
-#else
-      double display_lat = g_sensor_data.gps.valid ? g_sensor_data.gps.latitude : TEST_LAT;
-      double display_lon = g_sensor_data.gps.valid ? g_sensor_data.gps.longitude : TEST_LON;
-      map_canvas = create_map_view(map_container, display_lat, display_lon,
-                                   current_map_zoom, 527, 527);
-#endif
-      if (map_canvas) {
-        lv_obj_align(map_canvas, LV_ALIGN_CENTER, 0, 0);
-      }
-
-      // Remonter les boutons au premier plan
-      if (btn_zoom_in) lv_obj_move_foreground(btn_zoom_in);
-      if (btn_zoom_out) lv_obj_move_foreground(btn_zoom_out);
-
-      // Recreer le marqueur position
-      if (position_marker) {
-        lv_obj_del(position_marker);
-      }
-      position_marker = ui_create_position_marker(map_container);
-    }
+    map_rebuild();
   }
 }
 
@@ -154,53 +189,46 @@ static void btn_zoom_out_cb(lv_event_t *e) {
     Serial.printf("Zoom out: level=%d\n", current_map_zoom);
 #endif
 
-    // Recreer la carte avec nouveau zoom
-    if (map_canvas) {
-      lv_obj_del(map_canvas);
-#ifdef FLIGHT_TEST_MODE
-      map_canvas = create_map_view(map_container, TEST_LAT, TEST_LON,
-                                   current_map_zoom, 527, 527);
-#else
-      double display_lat = g_sensor_data.gps.valid ? g_sensor_data.gps.latitude : TEST_LAT;
-      double display_lon = g_sensor_data.gps.valid ? g_sensor_data.gps.longitude : TEST_LON;
-      map_canvas = create_map_view(map_container, display_lat, display_lon,
-                                   current_map_zoom, 527, 527);
-#endif
-      if (map_canvas) {
-        lv_obj_align(map_canvas, LV_ALIGN_CENTER, 0, 0);
-      }
-
-      // Remonter les boutons au premier plan
-      if (btn_zoom_in) lv_obj_move_foreground(btn_zoom_in);
-      if (btn_zoom_out) lv_obj_move_foreground(btn_zoom_out);
-
-      // Recreer le marqueur position
-      if (position_marker) {
-        lv_obj_del(position_marker);
-      }
-      position_marker = ui_create_position_marker(map_container);
-    }
+    map_rebuild();
   }
 }
 
-// Initialisation ecran gauche
-void ui_screen_left_init(void) {
-  // Nettoyer l'ecran s'il existe
-  if (current_screen != NULL) {
-    lv_obj_clean(current_screen);
-  } else {
-    current_screen = lv_obj_create(NULL);
-  }
+// Gestes tactiles (reconnus par le port): swipe = page, pincement = zoom carte.
+// Action differee apres la lecture tactile (le zoom recree des objets).
+static void flight_gesture_apply(void *arg) {
+  touch_gesture_type_t type = (touch_gesture_type_t)(intptr_t)arg;
+  if (!flight_screen) return;
 
-  lv_obj_set_style_bg_color(current_screen, lv_color_hex(UI_COLOR_BACKGROUND), 0);
-  lv_obj_clear_flag(current_screen, LV_OBJ_FLAG_SCROLLABLE);
+  switch (type) {
+    case TOUCH_GESTURE_SWIPE_RIGHT:  // -> ecran precedent
+      if (current_screen_index > 0) switch_to_screen(current_screen_index - 1);
+      break;
+    case TOUCH_GESTURE_SWIPE_LEFT:   // -> ecran suivant
+      if (current_screen_index < UI_FLIGHT_PAGE_COUNT - 1) switch_to_screen(current_screen_index + 1);
+      break;
+    case TOUCH_GESTURE_PINCH_OUT:
+      if (current_screen_index == 1) btn_zoom_in_cb(NULL);
+      break;
+    case TOUCH_GESTURE_PINCH_IN:
+      if (current_screen_index == 1) btn_zoom_out_cb(NULL);
+      break;
+    default:
+      break;
+  }
+}
 
-  // Barre de statut
-  ui_create_status_bar(current_screen);
+static void flight_gesture_cb(const touch_gesture_t *gesture) {
+#ifdef DEBUG_MODE
+  Serial.printf("[UI] Gesture %d at (%d,%d) %.0f px/s\n", gesture->type, gesture->x, gesture->y, gesture->velocity);
+#endif
+  lv_async_call(flight_gesture_apply, (void *)(intptr_t)gesture->type);
+}
 
-  lv_obj_t *frame = lv_obj_create(current_screen);
+// Page gauche
+static void ui_page_left_build(lv_obj_t *page) {
+  lv_obj_t *frame = lv_obj_create(page);
   lv_obj_set_size(frame, LCD_H_RES, LCD_V_RES - 60);
-  lv_obj_align(frame, LV_ALIGN_TOP_MID, 0, 60);
+  lv_obj_align(frame, LV_ALIGN_TOP_MID, 0, 5);
   lv_obj_set_style_bg_color(frame, lv_color_hex(UI_COLOR_BACKGROUND), 0);
   lv_obj_set_style_bg_opa(frame, LV_OPA_COVER, 0);
   lv_obj_set_style_border_width(frame, 3, 0);
@@ -213,56 +241,19 @@ void ui_screen_left_init(void) {
   // Texte identifiant
   lv_obj_t *label = lv_label_create(frame);
   lv_label_set_text(label, "Ecran Gauche");
-  lv_obj_set_style_text_font(label, &lv_font_montserrat_32, 0);
+  lv_obj_set_style_text_font(label, UI_FONT_DATA, 0);
   lv_obj_set_style_text_color(label, lv_color_hex(UI_COLOR_PRIMARY), 0);
   lv_obj_center(label);
-
-  // Ajouter handler swipe sur l'ecran complet
-  lv_obj_add_event_cb(current_screen, swipe_event_handler, LV_EVENT_PRESSED, NULL);
-  lv_obj_add_event_cb(current_screen, swipe_event_handler, LV_EVENT_RELEASED, NULL);
-  if (lvgl_port_lock(-1)) {
-    lv_screen_load(current_screen);
-    lvgl_port_unlock();
-  }
-
-#ifdef DEBUG_MODE
-  Serial.println("Left screen initialized");
-#endif
 }
 
-// Initialisation ecran central
-void ui_screen_center_init(void) {
-  // Nettoyer l'ecran s'il existe
-  if (current_screen != NULL) {
-    lv_obj_clean(current_screen);
-  } else {
-    current_screen = lv_obj_create(NULL);
-  }
-
-  lv_obj_set_style_bg_color(current_screen, lv_color_hex(UI_COLOR_BACKGROUND), 0);
-  lv_obj_clear_flag(current_screen, LV_OBJ_FLAG_SCROLLABLE);
-
-  // Barre de statut
-  ui_create_status_bar(current_screen);
-
-  lv_obj_t *frame = lv_obj_create(current_screen);
-  lv_obj_set_size(frame, LCD_H_RES, LCD_V_RES - 55);
-  lv_obj_align(frame, LV_ALIGN_TOP_MID, 0, 55);
-  lv_obj_set_style_bg_color(frame, lv_color_hex(UI_COLOR_BACKGROUND), 0);
-  lv_obj_set_style_bg_opa(frame, LV_OPA_COVER, 0);
-  lv_obj_set_style_border_width(frame, 0, 0);
-  lv_obj_set_style_border_color(frame, lv_color_hex(UI_COLOR_BACKGROUND), 0);
-  lv_obj_set_style_radius(frame, 0, 0);
-  lv_obj_set_style_pad_all(frame, 0, 0);
-  lv_obj_clear_flag(frame, LV_OBJ_FLAG_SCROLLABLE);
-  lv_obj_clear_flag(frame, LV_OBJ_FLAG_CLICKABLE);
-
+// Page centrale (altitude / vario / carte)
+static void ui_page_center_build(lv_obj_t *page) {
   int16_t col_height = 540;
   int16_t col_center_width = 540;
   int16_t col_side_width = 479;
 
   // Colonne gauche
-  lv_obj_t *col_left = lv_obj_create(frame);
+  lv_obj_t *col_left = lv_obj_create(page);
   lv_obj_set_size(col_left, col_side_width, col_height);
   lv_obj_set_pos(col_left, 0, 5);
   lv_obj_set_style_bg_color(col_left, lv_color_hex(UI_COLOR_BACKGROUND), 0);
@@ -279,23 +270,19 @@ void ui_screen_center_init(void) {
 
   ui_create_altitude_zone(col_left);
   ui_create_vario_zone(col_left);
-  // Creer timer pour mise a jour
-  static lv_timer_t *flight_update_timer = NULL;
-  if (flight_update_timer) {
-    lv_timer_del(flight_update_timer);
-  }
+  // Creer timer pour mise a jour (suspendu quand la page est cachee)
   flight_update_timer = lv_timer_create([](lv_timer_t *t) {
-    ui_update_altitude_display();
-    ui_update_vario_display();
+    ui_update_flight_display();
+    map_update_marker();
   },
-                                        500, NULL);  // Mise a jour toutes les 500ms
+                                        UI_FLIGHT_UPDATE_PERIOD_MS, NULL);
 #ifdef DEBUG_MODE
   Serial.println("[UI] Flight data update timer created");
 #endif
 
 
   // Colonne centrale (carte)
-  map_container = lv_obj_create(frame);
+  map_container = lv_obj_create(page);
   lv_obj_set_size(map_container, col_center_width, col_height);
   lv_obj_set_pos(map_container, col_side_width + 5, 5);
   lv_obj_set_style_bg_color(map_container, lv_color_hex(UI_COLOR_BACKGROUND), 0);
@@ -310,21 +297,24 @@ void ui_screen_center_init(void) {
   // Initialiser zoom depuis parametres
   current_map_zoom = params.map_zoom;
 
-// Affichage carte OSM initial
-#ifdef FLIGHT_TEST_MODE
-  map_canvas = create_map_view(map_container, TEST_LAT, TEST_LON,
-                               current_map_zoom, 527, 527);
-#else
-  double display_lat = g_sensor_data.gps.valid ? g_sensor_data.gps.latitude : TEST_LAT;
-  double display_lon = g_sensor_data.gps.valid ? g_sensor_data.gps.longitude : TEST_LON;
+  // Affichage carte OSM initial (couche de base)
+  double display_lat, display_lon;
+  map_display_position(&display_lat, &display_lon);
   map_canvas = create_map_view(map_container, display_lat, display_lon,
-                               current_map_zoom, 527, 527);
-#endif
+                               current_map_zoom, UI_MAP_VIEW_SIZE, UI_MAP_VIEW_SIZE);
 
   if (map_canvas) {
     lv_obj_align(map_canvas, LV_ALIGN_CENTER, 0, 0);
   }
 
+  // Couches dynamiques au-dessus de la carte (marqueur avion)
+  map_overlay = ui_map_overlay_create(map_container, UI_MAP_VIEW_SIZE, UI_MAP_VIEW_SIZE);
+  lv_obj_align(map_overlay, LV_ALIGN_CENTER, 0, 0);
+  lv_obj_update_layout(map_overlay);
+  ui_map_set_reference(display_lat, display_lon, current_map_zoom);
+  ui_map_marker_attach();
+  map_update_marker();
+
   // Boutons zoom
   btn_zoom_in = lv_btn_create(map_container);
   lv_obj_set_size(btn_zoom_in, 50, 50);
@@ -345,7 +335,7 @@ void ui_screen_center_init(void) {
   update_zoom_buttons_state();
 
   // Colonne droite
-  lv_obj_t *col_right = lv_obj_create(frame);
+  lv_obj_t *col_right = lv_obj_create(page);
   lv_obj_set_size(col_right, col_side_width, col_height);
   lv_obj_set_pos(col_right, col_side_width + col_center_width + 10, 5);
   lv_obj_set_style_bg_color(col_right, lv_color_hex(UI_COLOR_BACKGROUND), 0);
@@ -357,46 +347,14 @@ void ui_screen_center_init(void) {
   lv_obj_clear_flag(col_right, LV_OBJ_FLAG_SCROLLABLE);
   lv_obj_clear_flag(col_right, LV_OBJ_FLAG_CLICKABLE);
 
-  lv_obj_t *label_right = lv_label_create(col_right);
-  lv_label_set_text(label_right, "Droite");
-  lv_obj_set_style_text_font(label_right, UI_FONT_NORMAL, 0);
-  lv_obj_set_style_text_color(label_right, lv_color_hex(UI_COLOR_PRIMARY), 0);
-  lv_obj_center(label_right);
-
-  // Marqueur position sur carte
-  position_marker = ui_create_position_marker(map_container);
-
-  // Ajouter handler swipe sur l'ecran complet
-  lv_obj_add_event_cb(current_screen, swipe_event_handler, LV_EVENT_PRESSED, NULL);
-  lv_obj_add_event_cb(current_screen, swipe_event_handler, LV_EVENT_RELEASED, NULL);
-
-  if (lvgl_port_lock(-1)) {
-    lv_screen_load(current_screen);
-    lvgl_port_unlock();
-  }
-#ifdef DEBUG_MODE
-  Serial.println("Center screen initialized");
-#endif
+  ui_create_gauges_zone(col_right);
 }
 
-// Initialisation ecran droite
-void ui_screen_right_init(void) {
-  // Nettoyer l'ecran s'il existe
-  if (current_screen != NULL) {
-    lv_obj_clean(current_screen);
-  } else {
-    current_screen = lv_obj_create(NULL);
-  }
-
-  lv_obj_set_style_bg_color(current_screen, lv_color_hex(UI_COLOR_BACKGROUND), 0);
-  lv_obj_clear_flag(current_screen, LV_OBJ_FLAG_SCROLLABLE);
-
-  // Barre de statut
-  ui_create_status_bar(current_screen);
-
-  lv_obj_t *frame = lv_obj_create(current_screen);
+// Page droite
+static void ui_page_right_build(lv_obj_t *page) {
+  lv_obj_t *frame = lv_obj_create(page);
   lv_obj_set_size(frame, LCD_H_RES, LCD_V_RES - 60);
-  lv_obj_align(frame, LV_ALIGN_TOP_MID, 0, 60);
+  lv_obj_align(frame, LV_ALIGN_TOP_MID, 0, 5);
   lv_obj_set_style_bg_color(frame, lv_color_hex(UI_COLOR_BACKGROUND), 0);
   lv_obj_set_style_bg_opa(frame, LV_OPA_COVER, 0);
   lv_obj_set_style_border_width(frame, 3, 0);
@@ -409,24 +367,45 @@ void ui_screen_right_init(void) {
   // Texte identifiant
   lv_obj_t *label = lv_label_create(frame);
   lv_label_set_text(label, "Ecran Droite");
-  lv_obj_set_style_text_font(label, &lv_font_montserrat_32, 0);
+  lv_obj_set_style_text_font(label, UI_FONT_DATA, 0);
   lv_obj_set_style_text_color(label, lv_color_hex(UI_COLOR_PRIMARY), 0);
   lv_obj_center(label);
+}
 
-  // Ajouter handler swipe sur l'ecran complet
-  lv_obj_add_event_cb(current_screen, swipe_event_handler, LV_EVENT_PRESSED, NULL);
-  lv_obj_add_event_cb(current_screen, swipe_event_handler, LV_EVENT_RELEASED, NULL);
+// Conteneur plein ecran d'une page (sous la barre de statut)
+static lv_obj_t *ui_create_flight_page(lv_obj_t *parent) {
+  lv_obj_t *page = lv_obj_create(parent);
+  lv_obj_set_size(page, LCD_H_RES, LCD_V_RES - 55);
+  lv_obj_align(page, LV_ALIGN_TOP_MID, 0, 55);
+  lv_obj_set_style_bg_color(page, lv_color_hex(UI_COLOR_BACKGROUND), 0);
+  lv_obj_set_style_bg_opa(page, LV_OPA_COVER, 0);
+  lv_obj_set_style_border_width(page, 0, 0);
+  lv_obj_set_style_radius(page, 0, 0);
+  lv_obj_set_style_pad_all(page, 0, 0);
+  lv_obj_clear_flag(page, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_clear_flag(page, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_flag(page, LV_OBJ_FLAG_HIDDEN);
+  return page;
+}
 
-  if (lvgl_port_lock(-1)) {
-    lv_screen_load(current_screen);
-    lvgl_port_unlock();
+// Ecran detruit (retour menu): timers et pointeurs invalides
+static void flight_screen_delete_cb(lv_event_t *e) {
+  if (flight_update_timer) {
+    lv_timer_del(flight_update_timer);
+    flight_update_timer = NULL;
   }
-#ifdef DEBUG_MODE
-  Serial.println("Right screen initialized");
-#endif
+  for (int i = 0; i < UI_FLIGHT_PAGE_COUNT; i++) flight_pages[i] = NULL;
+  flight_screen = NULL;
+  map_canvas = NULL;
+  map_container = NULL;
+  btn_zoom_in = NULL;
+  btn_zoom_out = NULL;
+  map_overlay = NULL;
+  ui_flight_display_reset();
+  lvgl_port_set_gesture_cb(NULL);
 }
 
-// Initialisation des 3 ecrans
+// Initialisation des 3 ecrans (construits une fois, page centrale visible)
 void ui_main_screens_init(void) {
   // Nettoyer les objets globaux
   if (keyboard != NULL) {
@@ -438,12 +417,46 @@ void ui_main_screens_init(void) {
     ta_active = NULL;
   }
 
+  int64_t start = esp_timer_get_time();
+
+  flight_screen = lv_obj_create(NULL);
+  current_screen = flight_screen;
+  lv_obj_set_style_bg_color(flight_screen, lv_color_hex(UI_COLOR_BACKGROUND), 0);
+  lv_obj_clear_flag(flight_screen, LV_OBJ_FLAG_SCROLLABLE);
+
+  // Barre de statut commune aux 3 pages
+  ui_create_status_bar(flight_screen);
+
+  for (int i = 0; i < UI_FLIGHT_PAGE_COUNT; i++) {
+    flight_pages[i] = ui_create_flight_page(flight_screen);
+  }
+  ui_page_left_build(flight_pages[0]);
+  ui_page_center_build(flight_pages[1]);
+  ui_page_right_build(flight_pages[2]);
+
+  // Ajouter handler swipe sur l'ecran complet
+  lvgl_port_set_gesture_cb(flight_gesture_cb);
+  lv_obj_add_event_cb(flight_screen, flight_screen_delete_cb, LV_EVENT_DELETE, NULL);
+
+  static bool refr_cb_registered = false;
+  if (!refr_cb_registered) {
+    lv_display_add_event_cb(lv_display_get_default(), page_switch_refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+    refr_cb_registered = true;
+  }
+
   // Afficher ecran central au demarrage
-  ui_screen_center_init();
   current_screen_index = 1;
+  switch_to_screen(1);
+
+  page_switch_stats.build_us = (uint32_t)(esp_timer_get_time() - start);
+
+  if (lvgl_port_lock(-1)) {
+    lv_screen_load(flight_screen);
+    lvgl_port_unlock();
+  }
 
 #ifdef DEBUG_MODE
-  Serial.println("Main screens system initialized");
+  Serial.printf("Main screens system initialized (%lu us)\n", (unsigned long)page_switch_stats.build_us);
 #endif
 }
 
@@ -460,16 +473,24 @@ void ui_main_screens_show(void) {
     ta_active = NULL;
   }
 
-  ui_main_screens_init();
-
-  // Activer flag pour test logger
-  mainscreen_active = true;
-  // Detruire l'ancien ecran SI ce n'est pas le meme
-  if (old_screen != current_screen && old_screen != NULL) {
-    lv_obj_del(old_screen);
+  // Verrou recursif: ui_main_screens_init le reprend pour charger l'ecran
+  if (lvgl_port_lock(-1)) {
+    lvgl_mem_screen_begin();
+    ui_main_screens_init();
+    lvgl_mem_screen_created();
+    lvgl_port_set_target_fps(LVGL_PORT_FPS_FLIGHT);
+
+    // Activer flag pour test logger
+    mainscreen_active = true;
+    // Detruire l'ancien ecran SI ce n'est pas le meme
+    if (old_screen != current_screen && old_screen != NULL) {
+      lv_obj_del(old_screen);
+      lvgl_mem_screen_deleted("prestart");
 #ifdef DEBUG_MODE
-    Serial.println("[PRESTART] Old screen deleted");
+      Serial.println("[PRESTART] Old screen deleted");
 #endif
+    }
+    lvgl_port_unlock();
   }
 #ifdef DEBUG_MODE
   Serial.println("Main screens displayed");
@@ -0,0 +1,228 @@
+#ifndef UI_MAP_LAYERS_H
+#define UI_MAP_LAYERS_H
+
+#include <math.h>
+#include "lvgl.h"
+#include "constants.h"
+#include "graphical.h"
+#include "src/osm_tile_loader.h"
+
+// =============================================================================
+// Compositeur de la carte: le canvas des tuiles (couche de base) n'est jamais
+// redessine pour les elements dynamiques. Ceux-ci sont des couches dessinees
+// par un objet transparent pose au-dessus; chaque couche declare sa zone et
+// seule l'union ancienne/nouvelle zone est invalidee quand elle bouge.
+// =============================================================================
+
+#define UI_MAP_MAX_LAYERS 4
+#define UI_MAP_MARKER_SIZE 32          // Triangle avion (px)
+#define UI_MAP_MARKER_HEADING_STEP 5   // Redessin du cap par pas de 5 degres
+#define UI_MAP_MARKER_MARGIN 3         // Anticrenelage autour du triangle (px)
+#define UI_MAP_RECENTER_DIV 4          // Recentrage si l'avion s'ecarte de plus de 1/4 de carte du centre
+
+typedef struct ui_map_layer_s ui_map_layer_t;
+
+// Dessin d'une couche; origin = coin haut gauche de la carte (coordonnees ecran)
+typedef void (*ui_map_layer_draw_t)(ui_map_layer_t *layer, lv_layer_t *draw_layer, const lv_point_t *origin);
+
+struct ui_map_layer_s {
+  ui_map_layer_draw_t draw;
+  lv_area_t bounds;  // Zone occupee, relative a la carte (vide si x2 < x1)
+  void *user_data;
+};
+
+typedef struct {
+  lv_obj_t *overlay;
+  ui_map_layer_t *layers[UI_MAP_MAX_LAYERS];
+  uint8_t count;
+
+  // Reference geographique de la couche de base
+  bool geo_valid;
+  double center_gx;   // Centre de la carte en pixels tuiles globaux
+  double center_gy;
+  int tile_zoom;
+  int scale;          // Agrandissement des tuiles
+  int32_t w, h;
+} ui_map_compositor_t;
+
+static ui_map_compositor_t map_compositor = { 0 };
+
+static inline bool ui_map_area_empty(const lv_area_t *a) {
+  return a->x2 < a->x1 || a->y2 < a->y1;
+}
+
+// Invalide une zone relative a la carte (bornee a la carte)
+static void ui_map_invalidate_rel(const lv_area_t *rel) {
+  if (!map_compositor.overlay || ui_map_area_empty(rel)) return;
+
+  lv_area_t c;
+  lv_obj_get_coords(map_compositor.overlay, &c);
+  lv_area_t abs_area = { c.x1 + rel->x1, c.y1 + rel->y1, c.x1 + rel->x2, c.y1 + rel->y2 };
+  lv_area_t clipped;
+  if (!lv_area_intersect(&clipped, &abs_area, &c)) return;
+
+  lv_obj_invalidate_area(map_compositor.overlay, &clipped);
+}
+
+static void ui_map_overlay_draw_cb(lv_event_t *e) {
+  lv_obj_t *obj = (lv_obj_t *)lv_event_get_target(e);
+  lv_layer_t *layer = lv_event_get_layer(e);
+
+  lv_area_t c;
+  lv_obj_get_coords(obj, &c);
+  lv_point_t origin = { c.x1, c.y1 };
+
+  // Les appels de dessin sont ecretes a la zone invalidee par LVGL
+  for (uint8_t i = 0; i < map_compositor.count; i++) {
+    ui_map_layer_t *l = map_compositor.layers[i];
+    if (l->draw && !ui_map_area_empty(&l->bounds)) l->draw(l, layer, &origin);
+  }
+}
+
+static void ui_map_overlay_delete_cb(lv_event_t *e) {
+  memset(&map_compositor, 0, sizeof(map_compositor));
+}
+
+// Objet des couches dynamiques, a placer exactement sur le canvas de base
+lv_obj_t *ui_map_overlay_create(lv_obj_t *parent, int32_t w, int32_t h) {
+  memset(&map_compositor, 0, sizeof(map_compositor));
+
+  lv_obj_t *obj = lv_obj_create(parent);
+  lv_obj_remove_style_all(obj);
+  lv_obj_set_size(obj, w, h);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_event_cb(obj, ui_map_overlay_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+  lv_obj_add_event_cb(obj, ui_map_overlay_delete_cb, LV_EVENT_DELETE, NULL);
+
+  map_compositor.overlay = obj;
+  map_compositor.w = w;
+  map_compositor.h = h;
+  return obj;
+}
+
+bool ui_map_add_layer(ui_map_layer_t *layer) {
+  if (map_compositor.count >= UI_MAP_MAX_LAYERS) return false;
+  layer->bounds = (lv_area_t){ 0, 0, -1, -1 };
+  map_compositor.layers[map_compositor.count++] = layer;
+  return true;
+}
+
+// Nouvelle zone d'une couche: invalide l'ancienne et la nouvelle
+void ui_map_layer_move(ui_map_layer_t *layer, const lv_area_t *bounds) {
+  if (lv_area_is_equal(&layer->bounds, bounds)) return;
+  ui_map_invalidate_rel(&layer->bounds);
+  layer->bounds = *bounds;
+  ui_map_invalidate_rel(&layer->bounds);
+}
+
+// Contenu change, zone identique
+void ui_map_layer_invalidate(ui_map_layer_t *layer) {
+  ui_map_invalidate_rel(&layer->bounds);
+}
+
+// Reference de la couche de base (memes parametres que create_map_view)
+void ui_map_set_reference(double lat, double lon, int zoom) {
+  int tile_x, tile_y;
+  double px, py;
+  map_compositor.scale = map_view_scale(zoom, &map_compositor.tile_zoom);
+  lat_lon_to_tile_pixel(lat, lon, map_compositor.tile_zoom, &tile_x, &tile_y, &px, &py);
+  map_compositor.center_gx = (double)tile_x * OSM_TILE_SIZE + px;
+  map_compositor.center_gy = (double)tile_y * OSM_TILE_SIZE + py;
+  map_compositor.geo_valid = true;
+}
+
+// Position geographique -> pixel relatif a la carte
+bool ui_map_geo_to_px(double lat, double lon, int32_t *x, int32_t *y) {
+  if (!map_compositor.geo_valid) return false;
+  int tile_x, tile_y;
+  double px, py;
+  lat_lon_to_tile_pixel(lat, lon, map_compositor.tile_zoom, &tile_x, &tile_y, &px, &py);
+  double gx = (double)tile_x * OSM_TILE_SIZE + px;
+  double gy = (double)tile_y * OSM_TILE_SIZE + py;
+  *x = map_compositor.w / 2 + (int32_t)lround((gx - map_compositor.center_gx) * map_compositor.scale);
+  *y = map_compositor.h / 2 + (int32_t)lround((gy - map_compositor.center_gy) * map_compositor.scale);
+  return true;
+}
+
+// La couche de base ne suit pas l'avion: true quand il sort de la zone centrale
+// et que la carte doit etre recreee autour de lui
+bool ui_map_needs_recenter(double lat, double lon) {
+  int32_t x, y;
+  if (!ui_map_geo_to_px(lat, lon, &x, &y)) return false;
+  int32_t dx = x - map_compositor.w / 2, dy = y - map_compositor.h / 2;
+  return labs(dx) > map_compositor.w / UI_MAP_RECENTER_DIV || labs(dy) > map_compositor.h / UI_MAP_RECENTER_DIV;
+}
+
+// ============================================================================
+// COUCHE MARQUEUR AVION
+// ============================================================================
+
+typedef struct {
+  int32_t x, y;      // Centre relatif a la carte
+  int16_t heading;   // Degres, quantifie
+} ui_map_marker_t;
+
+static ui_map_marker_t map_marker_state;
+static ui_map_layer_t map_marker_layer = { NULL, { 0, 0, -1, -1 }, &map_marker_state };
+
+static void ui_map_marker_triangle(lv_layer_t *layer, const lv_point_t *origin, const ui_map_marker_t *m,
+                                   float size, uint32_t color) {
+  float a = m->heading * (float)M_PI / 180.0f;
+  float s = sinf(a), c = cosf(a);
+  // Pointe vers le cap, base en retrait (y ecran vers le bas)
+  const float shape[3][2] = { { 0.0f, -0.5f }, { 0.35f, 0.4f }, { -0.35f, 0.4f } };
+
+  lv_draw_triangle_dsc_t dsc;
+  lv_draw_triangle_dsc_init(&dsc);
+  dsc.bg_color = lv_color_hex(color);
+  dsc.bg_opa = LV_OPA_COVER;
+  for (int i = 0; i < 3; i++) {
+    float px = shape[i][0] * size, py = shape[i][1] * size;
+    dsc.p[i].x = origin->x + m->x + (px * c - py * s);
+    dsc.p[i].y = origin->y + m->y + (px * s + py * c);
+  }
+  lv_draw_triangle(layer, &dsc);
+}
+
+static void ui_map_marker_draw(ui_map_layer_t *layer, lv_layer_t *draw_layer, const lv_point_t *origin) {
+  const ui_map_marker_t *m = (const ui_map_marker_t *)layer->user_data;
+  ui_map_marker_triangle(draw_layer, origin, m, UI_MAP_MARKER_SIZE, UI_COLOR_TEXT_PRIMARY);       // Lisere
+  ui_map_marker_triangle(draw_layer, origin, m, UI_MAP_MARKER_SIZE - 8, UI_COLOR_GPS_MARKER);
+}
+
+void ui_map_marker_attach(void) {
+  map_marker_layer.draw = ui_map_marker_draw;
+  map_marker_state.heading = -1;
+  ui_map_add_layer(&map_marker_layer);
+}
+
+// Position et cap de l'avion: seule la zone du marqueur est redessinee
+void ui_map_marker_set(double lat, double lon, float heading_deg) {
+  int32_t x, y;
+  if (!map_compositor.overlay || !ui_map_geo_to_px(lat, lon, &x, &y)) return;
+
+  int16_t heading = (int16_t)(lroundf(heading_deg / UI_MAP_MARKER_HEADING_STEP) * UI_MAP_MARKER_HEADING_STEP) % 360;
+  if (heading < 0) heading += 360;
+
+  // Sommets arriere du triangle a 0.532 x taille du centre (17 px), plus la frange d'anticrenelage
+  const int32_t r = (UI_MAP_MARKER_SIZE * 54 + 99) / 100 + UI_MAP_MARKER_MARGIN;
+  lv_area_t bounds = { x - r, y - r, x + r, y + r };
+  if (x < -r || y < -r || x > map_compositor.w + r || y > map_compositor.h + r) {
+    bounds = (lv_area_t){ 0, 0, -1, -1 };  // Hors carte
+  }
+
+  bool turned = heading != map_marker_state.heading;
+  map_marker_state.x = x;
+  map_marker_state.y = y;
+  map_marker_state.heading = heading;
+
+  // Le dessin a lieu au prochain rafraichissement: invalider suffit
+  if (!lv_area_is_equal(&bounds, &map_marker_layer.bounds)) {
+    ui_map_layer_move(&map_marker_layer, &bounds);
+  } else if (turned) {
+    ui_map_layer_invalidate(&map_marker_layer);
+  }
+}
+
+#endif
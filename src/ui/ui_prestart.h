@@ -9,6 +9,7 @@
 #include "src/params/params.h"
 #include "src/ui/ui_main_screens.h"
 #include "src/sd_card.h"
+#include "src/storage_index.h"
 #include "src/ui/ui_file_transfer.h"
 #include "src/wifi_task.h"
 #include "src/metar_task.h"
@@ -26,6 +27,15 @@ static lv_obj_t *label_sd_status = NULL;
 static lv_obj_t *btn_start = NULL;
 static lv_timer_t *sensor_status_timer = NULL;
 
+// Demande QNH du prestart: a faire, en cours (metar_task), obtenue
+enum { PRESTART_QNH_TODO = 0, PRESTART_QNH_PENDING, PRESTART_QNH_DONE };
+static volatile uint8_t prestart_qnh_state = PRESTART_QNH_TODO;
+
+// Appelee depuis metar_task
+static void prestart_qnh_done(bool ok, float qnh, void *user) {
+  prestart_qnh_state = ok ? PRESTART_QNH_DONE : PRESTART_QNH_TODO;
+}
+
 // Verification conditions de demarrage
 static bool check_start_conditions() {
   bool sd_ok = sd_is_ready();
@@ -54,11 +64,12 @@ static void update_sensor_status_labels(void) {
   char buf[64];
 
   // SD Card
+  // Valeurs en cache de l'index: aucun acces carte depuis le thread LVGL
   if (sd_is_ready()) {
-    uint64_t total_kb, free_kb;
-    sd_get_capacity(&total_kb, &free_kb);
-    uint64_t total_gb = total_kb / (1024 * 1024);
-    uint64_t free_gb = free_kb / (1024 * 1024);
+    storage_index_t idx;
+    if (!storage_index_get(&idx)) memset(&idx, 0, sizeof(idx));
+    uint64_t total_gb = idx.total_kb / (1024 * 1024);
+    uint64_t free_gb = idx.free_kb / (1024 * 1024);
 
     snprintf(buf, sizeof(buf), "%s SD: %lluGB (%lluGB libre)",
              LV_SYMBOL_SD_CARD, total_gb, free_gb);
@@ -110,21 +121,21 @@ static void update_sensor_status_labels(void) {
     lv_label_set_text(label_wifi_status, buf);
     lv_obj_set_style_text_color(label_wifi_status, lv_color_hex(UI_COLOR_SUCCESS), 0);
 
-    // Lancer recuperation METAR si WiFi OK
-    static bool metar_fetched = false;
-
+    // Lancer recuperation METAR si WiFi OK (nouvel essai si la demande echoue)
 #ifdef FLIGHT_TEST_MODE
-    if (!metar_fetched) {
-      metar_fetch();
-      metar_fetched = true;
+    if (prestart_qnh_state == PRESTART_QNH_TODO) {
+      // En cours avant l'envoi: le callback peut arriver avant le retour
+      prestart_qnh_state = PRESTART_QNH_PENDING;
+      if (!metar_fetch_async(prestart_qnh_done, NULL)) prestart_qnh_state = PRESTART_QNH_TODO;
 #ifdef DEBUG_MODE
       Serial.println("[PRESTART] Flight Test - WiFi OK -> Fetch METAR");
 #endif
     }
 #else
-    if (!metar_fetched && g_sensor_data.gps.valid && g_sensor_data.gps.fix) {
-      metar_fetch();
-      metar_fetched = true;
+    if (prestart_qnh_state == PRESTART_QNH_TODO && g_sensor_data.gps.valid && g_sensor_data.gps.fix) {
+      // En cours avant l'envoi: le callback peut arriver avant le retour
+      prestart_qnh_state = PRESTART_QNH_PENDING;
+      if (!metar_fetch_async(prestart_qnh_done, NULL)) prestart_qnh_state = PRESTART_QNH_TODO;
 #ifdef DEBUG_MODE
       Serial.println("[PRESTART] GPS Fix + WiFi OK -> Fetch METAR");
 #endif
@@ -140,7 +151,8 @@ static void update_sensor_status_labels(void) {
   float qnh = metar_get_qnh();
   metar_data_t metar;
   if (metar_get_data(&metar) && metar.valid) {
-    snprintf(buf, sizeof(buf), "%s QNH: %.1f hPa (%s)", LV_SYMBOL_DOWN, qnh, metar.station);
+    snprintf(buf, sizeof(buf), "%s QNH: %.1f hPa (%s, %lu min)", LV_SYMBOL_DOWN, qnh, metar.station,
+             (unsigned long)((millis() - metar.timestamp) / 60000));
     lv_label_set_text(label_qnh_status, buf);
     lv_obj_set_style_text_color(label_qnh_status, lv_color_hex(UI_COLOR_SUCCESS), 0);
   } else {
@@ -10,6 +10,7 @@
 #include "ui_settings_wifi.h"
 #include "ui_settings_map.h"
 #include "ui_settings_system.h"
+#include "ui_settings_diag.h"
 #include "ui_settings_ice.h"
 
 // Forward declarations
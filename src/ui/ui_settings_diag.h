@@ -0,0 +1,253 @@
+#ifndef UI_SETTINGS_DIAG_H
+#define UI_SETTINGS_DIAG_H
+
+#include "lvgl.h"
+#include "constants.h"
+#include "UI_helper.h"
+#include "lang.h"
+#include "graphical.h"
+#include "globals.h"
+#include "src/task_profiler.h"
+#include "src/lvgl_port/lvgl_port.h"
+#include "src/lvgl_port/lvgl_mem.h"
+#include "src/storage_service.h"
+#include "src/tile_coverage_store.h"
+#include "src/tile_download_task.h"
+
+void ui_settings_system_show(void);
+
+// Widgets
+static lv_obj_t *label_diag_cpu[PROFILER_TASK_COUNT] = { NULL };
+static lv_obj_t *label_diag_stack[PROFILER_TASK_COUNT] = { NULL };
+static lv_obj_t *label_diag_sram = NULL;
+static lv_obj_t *label_diag_psram = NULL;
+static lv_obj_t *label_diag_flush = NULL;
+static lv_obj_t *label_diag_frame = NULL;
+static lv_obj_t *label_diag_lvmem = NULL;
+static lv_obj_t *label_diag_touch = NULL;
+static lv_obj_t *label_diag_storage = NULL;
+static lv_obj_t *label_diag_tile_dl = NULL;
+static lv_obj_t *chart_diag_frag = NULL;
+static lv_chart_series_t *series_diag_sram = NULL;
+static lv_chart_series_t *series_diag_psram = NULL;
+static lv_timer_t *diag_update_timer = NULL;
+static profiler_sample_t *diag_history = NULL;
+
+// Mise a jour des valeurs affichees
+static void update_diag_labels(void) {
+  if (!diag_history) {
+    diag_history = (profiler_sample_t *)heap_caps_malloc(PROFILER_HISTORY_SIZE * sizeof(profiler_sample_t), MALLOC_CAP_SPIRAM);
+    if (!diag_history) return;
+  }
+
+  int n = task_profiler_get_history(diag_history, PROFILER_HISTORY_SIZE);
+  if (n == 0) return;
+
+  const TextStrings *txt = get_text();
+
+  const profiler_sample_t *last = &diag_history[n - 1];
+
+  // Taches
+  for (int i = 0; i < PROFILER_TASK_COUNT; i++) {
+    if (last->cpu_permille[i] == PROFILER_NOT_RUNNING) {
+      lv_label_set_text(label_diag_cpu[i], "--");
+      lv_label_set_text(label_diag_stack[i], "--");
+      lv_obj_set_style_text_color(label_diag_cpu[i], lv_color_hex(UI_COLOR_TEXT_DISABLED), 0);
+      lv_obj_set_style_text_color(label_diag_stack[i], lv_color_hex(UI_COLOR_TEXT_DISABLED), 0);
+      continue;
+    }
+
+    if (!last->cpu_available) {
+      // Firmware sans statistiques d'execution FreeRTOS: pas de 0 % trompeur
+      lv_label_set_text(label_diag_cpu[i], txt->diag_cpu_unavailable);
+      lv_obj_set_style_text_color(label_diag_cpu[i], lv_color_hex(UI_COLOR_TEXT_DISABLED), 0);
+    } else {
+      lv_label_set_text_fmt(label_diag_cpu[i], "%d.%d %%", last->cpu_permille[i] / 10, last->cpu_permille[i] % 10);
+      lv_obj_set_style_text_color(label_diag_cpu[i],
+                                  last->cpu_permille[i] > 500 ? lv_color_hex(UI_COLOR_WARNING) : lv_color_hex(UI_COLOR_TEXT_PRIMARY), 0);
+    }
+
+    lv_label_set_text_fmt(label_diag_stack[i], txt->diag_fmt_stack, (unsigned long)last->stack_free[i]);
+    lv_obj_set_style_text_color(label_diag_stack[i],
+                                last->stack_free[i] < 512 ? lv_color_hex(UI_COLOR_ERROR) : lv_color_hex(UI_COLOR_SUCCESS), 0);
+  }
+
+  // Memoire
+  lv_label_set_text_fmt(label_diag_sram, txt->diag_fmt_heap,
+                        "SRAM", (unsigned long)(last->sram_free / 1024),
+                        task_profiler_fragmentation(last->sram_free, last->sram_largest));
+  lv_label_set_text_fmt(label_diag_psram, txt->diag_fmt_heap,
+                        "PSRAM", (unsigned long)(last->psram_free / 1024),
+                        task_profiler_fragmentation(last->psram_free, last->psram_largest));
+
+  // Affichage: cout PSRAM du dernier frame
+  lvgl_port_flush_stats_t fs;
+  lvgl_port_get_flush_stats(&fs);
+  lv_label_set_text_fmt(label_diag_flush, txt->diag_fmt_lcd,
+                        (unsigned long)fs.last_flushed_px, fs.last_areas,
+                        (unsigned long)fs.last_copied_px, (unsigned long)fs.full_frames);
+
+  lvgl_port_frame_stats_t fr;
+  lvgl_port_get_frame_stats(&fr);
+  uint32_t avg_render = fr.frames ? (uint32_t)(fr.sum_render_us / fr.frames) : 0;
+  uint32_t avg_wait = fr.frames ? (uint32_t)(fr.sum_flush_wait_us / fr.frames) : 0;
+  lv_label_set_text_fmt(label_diag_frame, txt->diag_fmt_frames,
+                        fr.target_fps, (unsigned long)avg_render, (unsigned long)fr.max_render_us,
+                        (unsigned long)avg_wait, (unsigned long)fr.missed_vsyncs);
+
+  // Pools SRAM LVGL: utilises/total par classe, debordements PSRAM
+  lvgl_mem_stats_t ms;
+  lvgl_mem_get_stats(&ms);
+  char pools_txt[96];
+  int len = 0;
+  uint32_t fallbacks = 0;
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    len += snprintf(pools_txt + len, sizeof(pools_txt) - len, "%u:%u/%u ", ms.pool[i].block_size,
+                    ms.pool[i].used, ms.pool[i].count);
+    fallbacks += ms.pool[i].fallbacks;
+  }
+  lv_label_set_text_fmt(label_diag_lvmem, txt->diag_fmt_lvgl,
+                        pools_txt, (unsigned long)(ms.psram_bytes / 1024), (unsigned long)fallbacks,
+                        (unsigned long)ms.leak_reports);
+
+  lvgl_port_touch_stats_t ts;
+  lvgl_port_get_touch_stats(&ts);
+  lv_label_set_text_fmt(label_diag_touch, txt->diag_fmt_touch,
+                        ts.irq_driven ? "INT" : txt->diag_touch_polling, (unsigned long)ts.irqs, (unsigned long)ts.reads,
+                        (unsigned long)ts.watchdog_reads, (unsigned long)ts.skipped_polls, (unsigned long)ts.gestures);
+
+  // Service SD: debit sur le temps carte occupee, attente max par priorite
+  storage_stats_t ss;
+  storage_get_stats(&ss);
+  uint32_t kbps = ss.busy_us ? (uint32_t)((ss.bytes_read + ss.bytes_written) * 1000ULL / ss.busy_us) : 0;
+  tile_coverage_stats_t cs;
+  tile_coverage_get_stats(&cs);
+  lv_label_set_text_fmt(label_diag_storage, txt->diag_fmt_storage,
+                        (unsigned long)kbps, (unsigned long)storage_pending(),
+                        (unsigned long)ss.prio[STORAGE_PRIO_LOG].wait_max_ms,
+                        (unsigned long)ss.prio[STORAGE_PRIO_TERRAIN].wait_max_ms,
+                        (unsigned long)ss.prio[STORAGE_PRIO_TILE_VISIBLE].wait_max_ms,
+                        (unsigned long)ss.prio[STORAGE_PRIO_TILE_PREFETCH].wait_max_ms,
+                        (unsigned long)ss.prio[STORAGE_PRIO_WEB].wait_max_ms,
+                        (unsigned long)ss.preemptions, (unsigned long)cs.absent);
+
+  // Telechargement de tuiles
+  tile_dl_status_t ds;
+  tile_download_get_status(&ds);
+  if (ds.total == 0) {
+    lv_label_set_text(label_diag_tile_dl, txt->diag_tiles_none);
+  } else {
+    lv_label_set_text_fmt(label_diag_tile_dl, txt->diag_fmt_tiles,
+                          ds.waiting_wifi ? txt->diag_waiting_wifi : (ds.running ? txt->diag_running : txt->diag_done),
+                          (unsigned long)ds.next, (unsigned long)ds.total, (unsigned long)ds.downloaded,
+                          (unsigned long)ds.skipped, (unsigned long)ds.failed, (unsigned long)(ds.bytes / 1024),
+                          (unsigned long)ds.last_tile_ms);
+  }
+
+  // Tendance fragmentation (points les plus anciens a gauche)
+  lv_chart_set_all_value(chart_diag_frag, series_diag_sram, LV_CHART_POINT_NONE);
+  lv_chart_set_all_value(chart_diag_frag, series_diag_psram, LV_CHART_POINT_NONE);
+  int offset = PROFILER_HISTORY_SIZE - n;
+  for (int i = 0; i < n; i++) {
+    lv_chart_set_value_by_id(chart_diag_frag, series_diag_sram, offset + i,
+                             task_profiler_fragmentation(diag_history[i].sram_free, diag_history[i].sram_largest));
+    lv_chart_set_value_by_id(chart_diag_frag, series_diag_psram, offset + i,
+                             task_profiler_fragmentation(diag_history[i].psram_free, diag_history[i].psram_largest));
+  }
+  lv_chart_refresh(chart_diag_frag);
+}
+
+static void diag_update_cb(lv_timer_t *timer) {
+  if (!chart_diag_frag || !lv_obj_is_valid(chart_diag_frag)) {
+    if (timer) {
+      lv_timer_del(timer);
+      diag_update_timer = NULL;
+    }
+    return;
+  }
+
+  update_diag_labels();
+}
+
+static void btn_back_diag_cb(lv_event_t *e) {
+  if (diag_update_timer != NULL) {
+    lv_timer_del(diag_update_timer);
+    diag_update_timer = NULL;
+  }
+
+  ui_settings_system_show();
+}
+
+void ui_settings_diag_init(void) {
+  const TextStrings *txt = get_text();
+
+  lv_obj_t *main_frame = ui_create_black_screen_with_frame(UI_BORDER_MEDIUM, UI_RADIUS_LARGE, &current_screen);
+  ui_create_main_frame(main_frame, true, txt->diagnostics);
+
+  // === TACHES ===
+  ui_create_label(main_left, txt->diag_tasks, UI_FONT_LARGE, lv_color_hex(UI_COLOR_PRIMARY));
+
+  for (int i = 0; i < PROFILER_TASK_COUNT; i++) {
+    lv_obj_t *row = ui_create_flex_container(main_left, LV_FLEX_FLOW_ROW);
+    lv_obj_set_width(row, lv_pct(100));
+    lv_obj_set_flex_align(row, LV_FLEX_ALIGN_SPACE_BETWEEN, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+
+    lv_obj_t *label_name = ui_create_label(row, profiler_task_names[i], UI_FONT_NORMAL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+    lv_obj_set_width(label_name, 180);
+
+    label_diag_cpu[i] = ui_create_label(row, "--", UI_FONT_NORMAL, lv_color_hex(UI_COLOR_TEXT_PRIMARY));
+    lv_obj_set_width(label_diag_cpu[i], 100);
+
+    label_diag_stack[i] = ui_create_label(row, "--", UI_FONT_NORMAL, lv_color_hex(UI_COLOR_TEXT_PRIMARY));
+    lv_obj_set_width(label_diag_stack[i], 120);
+  }
+
+  // === MEMOIRE ===
+  ui_create_label(main_right, txt->diag_memory, UI_FONT_LARGE, lv_color_hex(UI_COLOR_PRIMARY));
+  label_diag_sram = ui_create_label(main_right, "SRAM: --", UI_FONT_NORMAL, lv_color_hex(UI_COLOR_SUCCESS));
+  label_diag_psram = ui_create_label(main_right, "PSRAM: --", UI_FONT_NORMAL, lv_color_hex(UI_COLOR_INFO));
+  label_diag_flush = ui_create_label(main_right, "LCD: --", UI_FONT_SMALL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+  label_diag_frame = ui_create_label(main_right, "Frames: --", UI_FONT_SMALL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+  label_diag_lvmem = ui_create_label(main_right, "LVGL: --", UI_FONT_SMALL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+  label_diag_touch = ui_create_label(main_right, "--", UI_FONT_SMALL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+  label_diag_storage = ui_create_label(main_right, "SD: --", UI_FONT_SMALL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+  label_diag_tile_dl = ui_create_label(main_right, "--", UI_FONT_SMALL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+
+  ui_create_label(main_right, txt->diag_fragmentation, UI_FONT_SMALL, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+
+  chart_diag_frag = lv_chart_create(main_right);
+  lv_obj_set_size(chart_diag_frag, lv_pct(100), 220);
+  lv_chart_set_type(chart_diag_frag, LV_CHART_TYPE_LINE);
+  lv_chart_set_point_count(chart_diag_frag, PROFILER_HISTORY_SIZE);
+  lv_chart_set_range(chart_diag_frag, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
+  lv_chart_set_div_line_count(chart_diag_frag, 5, 6);
+  lv_obj_set_style_bg_color(chart_diag_frag, lv_color_hex(UI_COLOR_CHART_BG), 0);
+  lv_obj_set_style_border_color(chart_diag_frag, lv_color_hex(UI_COLOR_BORDER_PANEL), 0);
+  lv_obj_set_style_line_color(chart_diag_frag, lv_color_hex(UI_COLOR_CHART_LINE), LV_PART_MAIN);
+  lv_obj_set_style_size(chart_diag_frag, 0, 0, LV_PART_INDICATOR);
+
+  series_diag_sram = lv_chart_add_series(chart_diag_frag, lv_color_hex(UI_COLOR_SUCCESS), LV_CHART_AXIS_PRIMARY_Y);
+  series_diag_psram = lv_chart_add_series(chart_diag_frag, lv_color_hex(UI_COLOR_INFO), LV_CHART_AXIS_PRIMARY_Y);
+
+  // Bouton retour
+  lv_obj_t *btn_back_diag = ui_create_button(btn_container, txt->back, LV_SYMBOL_BACKSPACE, lv_color_hex(UI_COLOR_BTN_CANCEL),
+                                             UI_BTN_PRESTART_W, UI_BTN_PRESTART_H, UI_FONT_SMALL, UI_FONT_NORMAL, btn_back_diag_cb,
+                                             NULL, (lv_align_t)0, NULL, NULL);
+
+  update_diag_labels();
+
+  if (diag_update_timer != NULL) {
+    lv_timer_del(diag_update_timer);
+  }
+  diag_update_timer = lv_timer_create(diag_update_cb, PROFILER_SAMPLE_PERIOD_MS, NULL);
+
+#ifdef DEBUG_MODE
+  Serial.println("Diagnostics screen initialized");
+#endif
+}
+
+void ui_settings_diag_show(void) {
+  ui_switch_screen(ui_settings_diag_init);
+}
+
+#endif
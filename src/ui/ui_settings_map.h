@@ -8,6 +8,7 @@
 #include "globals.h"
 #include "src/params/params.h"
 #include "src/osm_tile_loader.h"
+#include "src/tile_download_task.h"
 
 // Variables statiques pour mise à jour carte
 static lv_obj_t *map_canvas_preview = NULL;
@@ -199,6 +200,7 @@ typedef struct {
   lv_obj_t *dropdown_tile_server;
   lv_obj_t *slider_track_points;
   lv_obj_t *switch_vario_colors;
+  lv_obj_t *label_download;  // Texte du bouton Telecharger / Arreter
 } map_widgets_t;
 
 static void btn_save_map_cb(lv_event_t *e) {
@@ -216,6 +218,58 @@ static void btn_cancel_map_cb(lv_event_t *e) {
   ui_settings_show();
 }
 
+static void update_download_label(map_widgets_t *widgets) {
+  tile_dl_status_t st;
+  tile_download_get_status(&st);
+  const TextStrings *txt = get_text();
+  if (widgets->label_download) lv_label_set_text(widgets->label_download, st.running ? txt->map_download_stop : txt->map_download);
+}
+
+// Telechargement de la zone affichee (serveur de la carte OSM_SERVER_URL, zoom
+// selectionne -2 a +1), ou arret du telechargement en cours (reprise possible)
+static void btn_download_map_cb(lv_event_t *e) {
+  map_widgets_t *widgets = (map_widgets_t *)lv_event_get_user_data(e);
+
+  tile_dl_status_t st;
+  tile_download_get_status(&st);
+  if (st.running) {
+    tile_download_stop();
+    // Arret effectif apres la tuile en cours
+    if (widgets->label_download) lv_label_set_text(widgets->label_download, get_text()->map_download);
+#ifdef DEBUG_MODE
+    Serial.println("Download map area stopped");
+#endif
+    return;
+  }
+
+#ifdef FLIGHT_TEST_MODE
+  double lat = TEST_LAT;
+  double lon = TEST_LON;
+#else
+  double lat = g_sensor_data.gps.valid ? g_sensor_data.gps.latitude : TEST_LAT;
+  double lon = g_sensor_data.gps.valid ? g_sensor_data.gps.longitude : TEST_LON;
+#endif
+  int zoom = lv_slider_get_value(widgets->slider_zoom);
+  double dlat = TILE_DL_AREA_KM / 111.32;
+  double dlon = dlat / cos(lat * M_PI / 180.0);
+
+  tile_dl_job_t job = { 0 };
+  job.lat_min = lat - dlat;
+  job.lat_max = lat + dlat;
+  job.lon_min = lon - dlon;
+  job.lon_max = lon + dlon;
+  job.z_min = (zoom - 2 < MAP_ZOOM_MIN) ? MAP_ZOOM_MIN : zoom - 2;
+  job.z_max = (zoom + 1 > MAP_ZOOM_MAX) ? MAP_ZOOM_MAX : zoom + 1;
+  strlcpy(job.url, OSM_SERVER_URL, sizeof(job.url));
+
+  bool ok = tile_download_start(&job);
+  update_download_label(widgets);
+  if (!ok && widgets->label_download) lv_label_set_text(widgets->label_download, get_text()->map_download_refused);
+#ifdef DEBUG_MODE
+  Serial.printf("Download map area clicked: %s\n", ok ? "started" : "refused");
+#endif
+}
+
 void ui_settings_map_init(void) {
   const TextStrings *txt = get_text();
 
@@ -301,6 +355,13 @@ void ui_settings_map_init(void) {
                                             UI_BTN_PRESTART_W, UI_BTN_PRESTART_H, UI_FONT_SMALL, UI_FONT_NORMAL, btn_save_map_cb,
                                             &widgets, (lv_align_t)0, NULL, NULL);
 
+  // Bouton Telecharger (zone autour de la position) / Arreter
+  lv_obj_t *btn_download_map = ui_create_button(btn_container, txt->map_download, LV_SYMBOL_DOWNLOAD, lv_color_hex(UI_COLOR_BTN_FILES),
+                                                UI_BTN_PRESTART_W, UI_BTN_PRESTART_H, UI_FONT_SMALL, UI_FONT_NORMAL, btn_download_map_cb,
+                                                &widgets, (lv_align_t)0, NULL, NULL);
+  widgets.label_download = lv_obj_get_child(btn_download_map, 1);  // Icone, puis texte
+  update_download_label(&widgets);
+
   // Bouton Cancel
   lv_obj_t *btn_cancel_map = ui_create_button(btn_container, txt->cancel, LV_SYMBOL_BACKSPACE, lv_color_hex(UI_COLOR_BTN_CANCEL),
                                               UI_BTN_PRESTART_W, UI_BTN_PRESTART_H, UI_FONT_SMALL, UI_FONT_NORMAL, btn_cancel_map_cb,
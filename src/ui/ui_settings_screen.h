@@ -7,6 +7,7 @@
 #include "lang.h"
 #include "globals.h"
 #include "src/gt911/gt911.h"
+#include "src/lvgl_port/lvgl_port.h"
 #include "src/params/params.h"
 
 void ui_settings_show(void);
@@ -55,6 +56,9 @@ static void save_calibration(void) {
 
   params_save_calibration();
 
+  lvgl_port_touch_calib_t calib = { calib_offset_x, calib_offset_y, calib_scale_x, calib_scale_y };
+  lvgl_port_set_touch_calibration(&calib);
+
 #ifdef DEBUG_MODE
   Serial.printf("Calibration saved to params: offset_x=%.3f offset_y=%.3f scale_x=%.3f scale_y=%.3f\n",
                 calib_offset_x, calib_offset_y, calib_scale_x, calib_scale_y);
@@ -217,6 +221,7 @@ static void btn_save_calib_cb(lv_event_t *e) {
   }
   test_point = NULL;
   test_mode = false;
+  lvgl_port_enable_touch_calibration(true);
   ui_settings_show();
 }
 
@@ -226,6 +231,7 @@ static void btn_cancel_calib_cb(lv_event_t *e) {
 #endif
   test_point = NULL;
   test_mode = false;
+  lvgl_port_enable_touch_calibration(true);
   ui_settings_show();
 }
 
@@ -238,6 +244,7 @@ void ui_settings_screen_init(void) {
   test_point = NULL;
 
   load_calibration();
+  lvgl_port_enable_touch_calibration(false);  // Points bruts pendant la capture
 
   current_screen = ui_create_screen();
   lv_obj_clear_flag(current_screen, LV_OBJ_FLAG_SCROLLABLE);
@@ -10,6 +10,7 @@
 #include "src/rgb_lcd_port/rgb_lcd_port.h"
 
 void ui_settings_show(void);
+void ui_settings_diag_show(void);
 
 // Variables pour les widgets
 static lv_obj_t *slider_brightness = NULL;
@@ -75,6 +76,13 @@ static void btn_cancel_system_cb(lv_event_t *e) {
   ui_settings_show();
 }
 
+static void btn_diag_system_cb(lv_event_t *e) {
+#ifdef DEBUG_MODE
+  Serial.println("Diagnostics clicked");
+#endif
+  ui_settings_diag_show();
+}
+
 void ui_settings_system_init(void) {
   const TextStrings *txt = get_text();
 
@@ -117,7 +125,7 @@ void ui_settings_system_init(void) {
   // Note d'information
   lv_obj_t *note = ui_create_label(main_left,
                                    "Note: Le changement de langue\nprend effet au redemarrage",
-                                   &lv_font_montserrat_16, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
+                                   UI_FONT_CAPTION, lv_color_hex(UI_COLOR_TEXT_SECONDARY));
   lv_obj_set_style_text_align(note, LV_TEXT_ALIGN_CENTER, 0);
 
   // Bouton Save
@@ -130,6 +138,10 @@ void ui_settings_system_init(void) {
                                                 UI_BTN_PRESTART_W, UI_BTN_PRESTART_H, UI_FONT_SMALL, UI_FONT_NORMAL, btn_cancel_system_cb,
                                                 NULL, (lv_align_t)0, NULL, NULL);
 
+  // Bouton Diagnostic
+  lv_obj_t *btn_diag = ui_create_button(btn_container, txt->diagnostics, LV_SYMBOL_EYE_OPEN, lv_color_hex(UI_COLOR_BTN_SETTINGS),
+                                        UI_BTN_PRESTART_W, UI_BTN_PRESTART_H, UI_FONT_SMALL, UI_FONT_NORMAL, btn_diag_system_cb,
+                                        NULL, (lv_align_t)0, NULL, NULL);
 
   // Charger les valeurs sauvegardees
   load_system_settings();
@@ -181,7 +181,7 @@ void ui_settings_vario_init(void) {
     int freq = 1400 - (i * 200);
     lv_obj_t *label_y = lv_label_create(chart_container);
     lv_label_set_text_fmt(label_y, "%d", freq);
-    lv_obj_set_style_text_font(label_y, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_font(label_y, UI_FONT_TINY, 0);
     lv_obj_set_style_text_color(label_y, lv_color_hex(UI_COLOR_TEXT_SECONDARY), 0);
     lv_obj_set_pos(label_y, 5, 20 + (i * 60));
   }
@@ -191,7 +191,7 @@ void ui_settings_vario_init(void) {
     int vario = i - 5;
     lv_obj_t *label_x = lv_label_create(chart_container);
     lv_label_set_text_fmt(label_x, "%d", vario);
-    lv_obj_set_style_text_font(label_x, &lv_font_montserrat_12, 0);
+    lv_obj_set_style_text_font(label_x, UI_FONT_TINY, 0);
     lv_obj_set_style_text_color(label_x, lv_color_hex(UI_COLOR_TEXT_SECONDARY), 0);
     lv_obj_set_pos(label_x, 45 + 6 + (i * 870 / 15) - 6, 275);
   }
@@ -8,6 +8,7 @@
 #include "globals.h"
 #include "graphical.h"
 #include "src/params/params.h"
+#include "src/wifi_task.h"
 
 void ui_settings_show(void);
 
@@ -151,6 +152,9 @@ static void btn_save_wifi_cb(lv_event_t *e) {
   // Liberer backup
   free_wifi_backup();
 
+  // Prendre en compte les nouveaux reseaux sans attendre le prochain scan
+  wifi_task_reload_networks();
+
 #ifdef DEBUG_MODE
   Serial.println("WiFi settings saved to NVS");
 #endif
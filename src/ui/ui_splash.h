@@ -4,6 +4,7 @@
 #include "lvgl.h"
 #include "constants.h"
 #include "src/lvgl_port/lvgl_port.h"
+#include "src/boot_sequence.h"
 
 // Forward declaration
 void ui_prestart_show(void);
@@ -12,11 +13,17 @@ void ui_prestart_show(void);
 LV_IMG_DECLARE(logo_bipbiphourra);
 
 static lv_timer_t *splash_timer = NULL;
+static uint32_t splash_start_ms = 0;
 
-// Callback pour fermer le splash screen
+// Callback pour fermer le splash screen des que les etapes vol sont pretes
 static void splash_timer_cb(lv_timer_t *timer) {
+  uint32_t elapsed = millis() - splash_start_ms;
+  if (elapsed < BOOT_SPLASH_MIN_MS) return;
+  if (!boot_is_flight_ready() && elapsed < BOOT_SPLASH_MAX_MS) return;
+
 #ifdef DEBUG_MODE
-  Serial.println("[SPLASH] Timer callback - closing splash");
+  Serial.printf("[SPLASH] Closing splash after %lu ms (flight ready: %d)\n",
+                (unsigned long)elapsed, boot_is_flight_ready());
 #endif
 
   // Supprimer le timer d'abord
@@ -26,7 +33,10 @@ static void splash_timer_cb(lv_timer_t *timer) {
   }
 
   // Appeler show() qui gère tout proprement
+  boot_stage_begin(BOOT_STAGE_UI);
   ui_prestart_show();
+  boot_stage_end(BOOT_STAGE_UI, true);
+  boot_print_timings();
 }
 
 void ui_splash_init(void) {
@@ -55,8 +65,8 @@ void ui_splash_init(void) {
 
   lvgl_port_unlock();
 
-  splash_timer = lv_timer_create(splash_timer_cb, 3000, NULL);
-  lv_timer_set_repeat_count(splash_timer, 1);
+  splash_start_ms = millis();
+  splash_timer = lv_timer_create(splash_timer_cb, BOOT_SPLASH_POLL_MS, NULL);
 
 #ifdef DEBUG_MODE
   Serial.println("[SPLASH] Screen loaded, timer started");
@@ -0,0 +1,318 @@
+#ifndef WIFI_MANAGER_H
+#define WIFI_MANAGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+// =============================================================================
+// Machine a etats de connexion WiFi: un seul scan, choix du meilleur reseau
+// connu (RSSI penalise par le rang de priorite), essais des candidats du
+// scan sans rescanner, puis BSSID/canal du dernier point d'acces memorises
+// pour reconnecter sans scan. Un reseau dont le mot de passe a ete refuse est
+// essaye en dernier aux scans suivants (un point d'acces absent ne compte pas
+// comme un refus). Point d'acces memorise et refus peuvent etre conserves
+// entre deux demarrages (wifi_mgr_saved_t). Les evenements (connecte, perdu, echec) sont
+// signales au rappel. La radio est vue a travers wifi_radio_t: WiFi Arduino
+// sur le vario (src/wifi_task.h), radio simulee sur PC
+// (tools/wifi_manager_check.cpp).
+// Calcul pur sans Arduino ni ESP-IDF: se compile sur PC.
+// =============================================================================
+
+#define WIFI_MGR_NETWORKS 4                 // Reseaux configures (params.wifi_ssid)
+#define WIFI_MGR_SSID_MAX 33
+#define WIFI_MGR_PASS_MAX 65
+#define WIFI_MGR_PRIORITY_DB 10             // Penalite RSSI par rang de priorite
+#define WIFI_MGR_MIN_RSSI (-88)             // Point d'acces trop faible: ignore
+#define WIFI_MGR_SCAN_TIMEOUT_MS 6000
+#define WIFI_MGR_FAST_TIMEOUT_MS 1000       // Reconnexion BSSID/canal memorises (~0.6 s), au-dela scan
+#define WIFI_MGR_REFUSED_PENALTY 256        // Score d'un reseau refuse: apres tous les autres
+#define WIFI_MGR_CONNECT_TIMEOUT_MS 8000
+#define WIFI_MGR_FAIL_GRACE_MS 300          // Etat d'echec precedent ignore apres connect()
+#define WIFI_MGR_RETRY_MIN_MS 5000          // Attente avant rescan, doublee a chaque echec
+#define WIFI_MGR_RETRY_MAX_MS 60000
+
+typedef struct {
+  char ssid[WIFI_MGR_SSID_MAX];
+  uint8_t bssid[6];
+  uint8_t channel;
+  int8_t rssi;
+} wifi_mgr_ap_t;
+
+typedef enum {
+  WIFI_LINK_DOWN = 0,                 // Pas de lien (ou connexion en cours)
+  WIFI_LINK_UP,                       // Associe avec une adresse IP
+  WIFI_LINK_FAILED,                   // Mot de passe refuse
+  WIFI_LINK_NOT_FOUND                 // Point d'acces absent
+} wifi_link_t;
+
+typedef struct {
+  bool (*scan_start)(void *user);
+  int (*scan_count)(void *user);      // -1: en cours, -2: echec, sinon nombre de resultats
+  bool (*scan_get)(void *user, int i, wifi_mgr_ap_t *ap);
+  void (*scan_free)(void *user);
+  void (*connect)(void *user, const char *ssid, const char *pass, const uint8_t *bssid, uint8_t channel);
+  wifi_link_t (*link)(void *user);
+  void (*disconnect)(void *user);
+  void *user;
+} wifi_radio_t;
+
+typedef enum {
+  WIFI_MGR_OFF = 0,
+  WIFI_MGR_FAST,                      // Connexion directe au point d'acces memorise
+  WIFI_MGR_SCAN,
+  WIFI_MGR_CONNECT,                   // Candidat du scan
+  WIFI_MGR_UP,
+  WIFI_MGR_WAIT                       // Aucun reseau: rescan apres retry_ms
+} wifi_mgr_state_t;
+
+typedef enum {
+  WIFI_MGR_EV_CONNECTED = 0,
+  WIFI_MGR_EV_LOST,
+  WIFI_MGR_EV_FAILED                  // Aucun reseau connu joignable
+} wifi_mgr_event_t;
+
+typedef struct {
+  int8_t net;                         // Index dans networks
+  int8_t rssi;
+  uint8_t bssid[6];
+  uint8_t channel;
+} wifi_mgr_candidate_t;
+
+// Etat conserve entre deux demarrages (NVS sur le vario)
+typedef struct {
+  char ssid[WIFI_MGR_SSID_MAX];       // Reseau du point d'acces memorise, vide: aucun
+  uint8_t bssid[6];
+  uint8_t channel;
+  uint8_t refused;
+} wifi_mgr_saved_t;
+
+typedef struct wifi_mgr_s wifi_mgr_t;
+typedef void (*wifi_mgr_cb_t)(wifi_mgr_t *m, wifi_mgr_event_t ev);
+
+struct wifi_mgr_s {
+  wifi_radio_t radio;
+  struct {
+    char ssid[WIFI_MGR_SSID_MAX];
+    char pass[WIFI_MGR_PASS_MAX];
+  } networks[WIFI_MGR_NETWORKS];
+  wifi_mgr_state_t state;
+  uint32_t since;                     // Entree dans l'etat (ms)
+  wifi_mgr_candidate_t candidates[WIFI_MGR_NETWORKS];  // Tries par score
+  uint8_t count;
+  uint8_t next;
+  wifi_mgr_candidate_t current;       // Essai en cours ou lien etabli
+  bool cached;                        // current memorise pour reconnexion rapide
+  uint8_t refused;                    // Bit i: mot de passe du reseau i refuse au dernier essai
+  uint32_t retry_ms;
+  wifi_mgr_cb_t cb;
+  void *user;
+};
+
+static void wifi_mgr_init(wifi_mgr_t *m, const wifi_radio_t *radio, wifi_mgr_cb_t cb, void *user) {
+  memset(m, 0, sizeof(*m));
+  m->radio = *radio;
+  m->cb = cb;
+  m->user = user;
+  m->retry_ms = WIFI_MGR_RETRY_MIN_MS;
+}
+
+// Reseau de priorite i (0: la plus haute); ssid vide: entree ignoree.
+// Le point d'acces memorise est oublie si son reseau change.
+static void wifi_mgr_set_network(wifi_mgr_t *m, int i, const char *ssid, const char *pass) {
+  if (i < 0 || i >= WIFI_MGR_NETWORKS) return;
+  if (strncmp(m->networks[i].ssid, ssid, WIFI_MGR_SSID_MAX - 1) == 0 &&
+      strncmp(m->networks[i].pass, pass, WIFI_MGR_PASS_MAX - 1) == 0) return;
+  strncpy(m->networks[i].ssid, ssid, WIFI_MGR_SSID_MAX - 1);
+  m->networks[i].ssid[WIFI_MGR_SSID_MAX - 1] = '\0';
+  strncpy(m->networks[i].pass, pass, WIFI_MGR_PASS_MAX - 1);
+  m->networks[i].pass[WIFI_MGR_PASS_MAX - 1] = '\0';
+  if (m->cached && m->current.net == i) m->cached = false;
+  m->refused &= (uint8_t)~(1u << i);
+}
+
+static inline bool wifi_mgr_connected(const wifi_mgr_t *m) {
+  return m->state == WIFI_MGR_UP;
+}
+
+// Reseau connecte (ou en cours d'essai), NULL si aucun
+static inline const char *wifi_mgr_ssid(const wifi_mgr_t *m) {
+  if (m->state != WIFI_MGR_UP && m->state != WIFI_MGR_FAST && m->state != WIFI_MGR_CONNECT) return NULL;
+  return m->networks[m->current.net].ssid;
+}
+
+// Etat a conserver (toujours rempli, ssid vide sans point d'acces memorise)
+static void wifi_mgr_get_saved(const wifi_mgr_t *m, wifi_mgr_saved_t *out) {
+  memset(out, 0, sizeof(*out));
+  out->refused = m->refused;
+  if (!m->cached) return;
+  strcpy(out->ssid, m->networks[m->current.net].ssid);
+  memcpy(out->bssid, m->current.bssid, 6);
+  out->channel = m->current.channel;
+}
+
+// Restauration avant wifi_mgr_start(), apres wifi_mgr_set_network(): le point
+// d'acces n'est repris que si son reseau est toujours configure
+static void wifi_mgr_restore(wifi_mgr_t *m, const wifi_mgr_saved_t *saved) {
+  if (m->state != WIFI_MGR_OFF) return;
+  m->refused = saved->refused & ((1u << WIFI_MGR_NETWORKS) - 1);
+  for (int i = 0; i < WIFI_MGR_NETWORKS; i++) {
+    if (!saved->ssid[0] || !saved->channel || strncmp(m->networks[i].ssid, saved->ssid, WIFI_MGR_SSID_MAX) != 0) continue;
+    m->current.net = (int8_t)i;
+    m->current.rssi = 0;
+    memcpy(m->current.bssid, saved->bssid, 6);
+    m->current.channel = saved->channel;
+    m->cached = true;
+    return;
+  }
+}
+
+static inline int wifi_mgr_score(const wifi_mgr_t *m, const wifi_mgr_candidate_t *c) {
+  int penalty = (m->refused & (1u << c->net)) ? WIFI_MGR_REFUSED_PENALTY : 0;
+  return c->rssi - c->net * WIFI_MGR_PRIORITY_DB - penalty;
+}
+
+// Meilleur point d'acces de chaque reseau connu vu au scan, tries par score
+static void wifi_mgr_select(wifi_mgr_t *m, int n) {
+  m->count = 0;
+  m->next = 0;
+  for (int i = 0; i < n; i++) {
+    wifi_mgr_ap_t ap;
+    if (!m->radio.scan_get(m->radio.user, i, &ap) || ap.ssid[0] == '\0' || ap.rssi < WIFI_MGR_MIN_RSSI) continue;
+    int net = -1;
+    for (int k = 0; k < WIFI_MGR_NETWORKS && net < 0; k++) {
+      if (m->networks[k].ssid[0] && strcmp(m->networks[k].ssid, ap.ssid) == 0) net = k;
+    }
+    if (net < 0) continue;
+
+    wifi_mgr_candidate_t c;
+    c.net = (int8_t)net;
+    c.rssi = ap.rssi;
+    memcpy(c.bssid, ap.bssid, 6);
+    c.channel = ap.channel;
+
+    // Meme reseau deja vu (plusieurs points d'acces): garder le plus fort
+    int pos = -1;
+    for (int k = 0; k < m->count && pos < 0; k++) {
+      if (m->candidates[k].net == net) pos = k;
+    }
+    if (pos >= 0) {
+      if (m->candidates[pos].rssi >= c.rssi) continue;
+      memmove(&m->candidates[pos], &m->candidates[pos + 1], (m->count - pos - 1) * sizeof(c));
+      m->count--;
+    }
+    pos = m->count;
+    while (pos > 0 && wifi_mgr_score(m, &m->candidates[pos - 1]) < wifi_mgr_score(m, &c)) pos--;
+    memmove(&m->candidates[pos + 1], &m->candidates[pos], (m->count - pos) * sizeof(c));
+    m->candidates[pos] = c;
+    m->count++;
+  }
+}
+
+static void wifi_mgr_enter(wifi_mgr_t *m, wifi_mgr_state_t state, uint32_t now) {
+  m->state = state;
+  m->since = now;
+}
+
+static void wifi_mgr_try(wifi_mgr_t *m, wifi_mgr_state_t state, uint32_t now) {
+  const char *ssid = m->networks[m->current.net].ssid;
+  const char *pass = m->networks[m->current.net].pass;
+  m->radio.connect(m->radio.user, ssid, pass, m->current.bssid, m->current.channel);
+  wifi_mgr_enter(m, state, now);
+}
+
+static void wifi_mgr_scan(wifi_mgr_t *m, uint32_t now) {
+  if (m->radio.scan_start(m->radio.user)) {
+    wifi_mgr_enter(m, WIFI_MGR_SCAN, now);
+    return;
+  }
+  wifi_mgr_enter(m, WIFI_MGR_WAIT, now);
+}
+
+// Candidat suivant du dernier scan, sinon attente avant rescan
+static void wifi_mgr_next(wifi_mgr_t *m, uint32_t now) {
+  if (m->next < m->count) {
+    m->current = m->candidates[m->next++];
+    wifi_mgr_try(m, WIFI_MGR_CONNECT, now);
+    return;
+  }
+  wifi_mgr_enter(m, WIFI_MGR_WAIT, now);
+  if (m->cb) m->cb(m, WIFI_MGR_EV_FAILED);
+}
+
+static void wifi_mgr_start(wifi_mgr_t *m, uint32_t now) {
+  if (m->state != WIFI_MGR_OFF) return;
+  m->retry_ms = WIFI_MGR_RETRY_MIN_MS;
+  if (m->cached) wifi_mgr_try(m, WIFI_MGR_FAST, now);
+  else wifi_mgr_scan(m, now);
+}
+
+static void wifi_mgr_stop(wifi_mgr_t *m) {
+  if (m->state == WIFI_MGR_OFF) return;
+  if (m->state == WIFI_MGR_SCAN) m->radio.scan_free(m->radio.user);
+  m->radio.disconnect(m->radio.user);
+  m->state = WIFI_MGR_OFF;
+}
+
+// A appeler periodiquement (quelques dizaines de ms)
+static void wifi_mgr_step(wifi_mgr_t *m, uint32_t now) {
+  uint32_t elapsed = now - m->since;
+  switch (m->state) {
+    case WIFI_MGR_OFF:
+      break;
+
+    case WIFI_MGR_SCAN: {
+      int n = m->radio.scan_count(m->radio.user);
+      if (n == -1 && elapsed < WIFI_MGR_SCAN_TIMEOUT_MS) break;
+      if (n > 0) wifi_mgr_select(m, n);
+      else m->count = m->next = 0;
+      m->radio.scan_free(m->radio.user);
+      wifi_mgr_next(m, now);
+      break;
+    }
+
+    case WIFI_MGR_FAST:
+    case WIFI_MGR_CONNECT: {
+      wifi_link_t link = m->radio.link(m->radio.user);
+      if (link == WIFI_LINK_UP) {
+        m->cached = true;
+        m->refused &= (uint8_t)~(1u << m->current.net);
+        m->retry_ms = WIFI_MGR_RETRY_MIN_MS;
+        wifi_mgr_enter(m, WIFI_MGR_UP, now);
+        if (m->cb) m->cb(m, WIFI_MGR_EV_CONNECTED);
+        break;
+      }
+      bool fast = m->state == WIFI_MGR_FAST;
+      bool failed = (link == WIFI_LINK_FAILED || link == WIFI_LINK_NOT_FOUND) && elapsed >= WIFI_MGR_FAIL_GRACE_MS;
+      if (!failed && elapsed < (fast ? WIFI_MGR_FAST_TIMEOUT_MS : WIFI_MGR_CONNECT_TIMEOUT_MS)) break;
+      m->radio.disconnect(m->radio.user);
+      if (fast) {
+        // Point d'acces memorise injoignable ou trop lent: scan complet
+        m->cached = false;
+        wifi_mgr_scan(m, now);
+      } else {
+        // Candidat vu au scan et refuse: mot de passe (pas un delai depasse
+        // ni un point d'acces disparu depuis le scan)
+        if (failed && link == WIFI_LINK_FAILED) m->refused |= (uint8_t)(1u << m->current.net);
+        wifi_mgr_next(m, now);
+      }
+      break;
+    }
+
+    case WIFI_MGR_UP:
+      if (m->radio.link(m->radio.user) == WIFI_LINK_UP) break;
+      m->radio.disconnect(m->radio.user);
+      if (m->cb) m->cb(m, WIFI_MGR_EV_LOST);
+      m->retry_ms = WIFI_MGR_RETRY_MIN_MS;
+      wifi_mgr_try(m, WIFI_MGR_FAST, now);
+      break;
+
+    case WIFI_MGR_WAIT:
+      if (elapsed < m->retry_ms) break;
+      m->retry_ms = m->retry_ms * 2 > WIFI_MGR_RETRY_MAX_MS ? WIFI_MGR_RETRY_MAX_MS : m->retry_ms * 2;
+      wifi_mgr_scan(m, now);
+      break;
+  }
+}
+
+#endif
@@ -2,12 +2,14 @@
 #define WIFI_TASK_H
 
 #include <WiFi.h>
+#include <Preferences.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
 #include "constants.h"
 #include "src/params/params.h"
 #include "globals.h"
+#include "src/wifi_manager.h"
 
 // ============================================================================
 // VARIABLES GLOBALES
@@ -17,6 +19,7 @@ static EventGroupHandle_t wifi_event_group = NULL;
 static bool wifi_is_connected = false;
 static char *wifi_current_ssid = NULL;
 static char *wifi_current_ip = NULL;
+static uint32_t wifi_start_ms = 0;
 
 // ============================================================================
 // FONCTIONS PUBLIQUES GETTER
@@ -51,83 +54,141 @@ static bool wifi_wait_connected(uint32_t timeout_ms) {
 }
 
 // ============================================================================
-// FONCTION DE CONNEXION WIFI OPTIMISEE
+// RADIO ARDUINO POUR LE GESTIONNAIRE (src/wifi_manager.h)
 // ============================================================================
-static bool wifi_connect_with_priority(void) {
-#ifdef DEBUG_MODE
-  Serial.printf("[WIFI] Free PSRAM: %u bytes\n", ESP.getFreePsram());
-#endif
+static bool wifi_radio_scan_start(void *user) {
+  // Scan actif asynchrone, canal par canal limite a WIFI_SCAN_MS_PER_CHANNEL
+  return WiFi.scanNetworks(true, false, false, WIFI_SCAN_MS_PER_CHANNEL) != WIFI_SCAN_FAILED;
+}
 
-  for (int priority = 0; priority < 4; priority++) {
-    const char* ssid = psram_str_get(params.wifi_ssid[priority]);
-    const char* password = psram_str_get(params.wifi_password[priority]);
-    
-    // Ignorer entree vide
-    if (ssid[0] == '\0') continue;
+static int wifi_radio_scan_count(void *user) {
+  int16_t n = WiFi.scanComplete();
+  if (n == WIFI_SCAN_RUNNING) return -1;
+  return n < 0 ? -2 : n;
+}
 
-#ifdef DEBUG_MODE
-    Serial.printf("[WIFI] Try priority %d: %s\n", priority + 1, ssid);
-#endif
+static bool wifi_radio_scan_get(void *user, int i, wifi_mgr_ap_t *ap) {
+  uint8_t *bssid = WiFi.BSSID(i);
+  if (!bssid) return false;
+  strlcpy(ap->ssid, WiFi.SSID(i).c_str(), sizeof(ap->ssid));
+  memcpy(ap->bssid, bssid, 6);
+  ap->channel = WiFi.channel(i);
+  ap->rssi = WiFi.RSSI(i);
+  return true;
+}
 
-    // Deconnexion propre avant nouvel essai
-    WiFi.disconnect(true);
-    WiFi.mode(WIFI_OFF);
-    vTaskDelay(pdMS_TO_TICKS(500));
-    
-    WiFi.mode(WIFI_STA);
-    WiFi.setAutoReconnect(false);
-    vTaskDelay(pdMS_TO_TICKS(100));
-
-    WiFi.begin(ssid, password);
-
-    // Attente connexion (10 secondes max)
-    int retry = 0;
-    while (WiFi.status() != WL_CONNECTED && retry < 20) {
-      vTaskDelay(pdMS_TO_TICKS(500));
-      retry++;
-    }
+static void wifi_radio_scan_free(void *user) {
+  WiFi.scanDelete();
+}
 
-    if (WiFi.status() == WL_CONNECTED) {
-      // Liberer anciennes allocations
-      if (wifi_current_ssid) {
-        heap_caps_free(wifi_current_ssid);
-        wifi_current_ssid = NULL;
-      }
-      if (wifi_current_ip) {
-        heap_caps_free(wifi_current_ip);
-        wifi_current_ip = NULL;
-      }
-      
-      // OPTIMISATION: Allocation directe sans String temporaire
-      wifi_current_ssid = psram_strdup(ssid);
-      
-      IPAddress ip = WiFi.localIP();
-      wifi_current_ip = (char*)heap_caps_malloc(16, MALLOC_CAP_SPIRAM);
-      if (wifi_current_ip) {
-        snprintf(wifi_current_ip, 16, "%d.%d.%d.%d", 
-                 ip[0], ip[1], ip[2], ip[3]);
-      }
-      
-      wifi_is_connected = true;
+static void wifi_radio_connect(void *user, const char *ssid, const char *pass, const uint8_t *bssid, uint8_t channel) {
+  WiFi.begin(ssid, pass, channel, bssid);
+}
+
+static wifi_link_t wifi_radio_link(void *user) {
+  switch (WiFi.status()) {
+    case WL_CONNECTED:
+      return WIFI_LINK_UP;
+    case WL_CONNECT_FAILED:
+      return WIFI_LINK_FAILED;
+    case WL_NO_SSID_AVAIL:
+      return WIFI_LINK_NOT_FOUND;
+    default:
+      return WIFI_LINK_DOWN;
+  }
+}
 
+static void wifi_radio_disconnect(void *user) {
+  WiFi.disconnect(false);
+}
+
+static const wifi_radio_t wifi_radio = {
+  wifi_radio_scan_start, wifi_radio_scan_count, wifi_radio_scan_get, wifi_radio_scan_free,
+  wifi_radio_connect,    wifi_radio_link,       wifi_radio_disconnect, NULL
+};
+
+static wifi_mgr_t wifi_mgr;
+
+// Point d'acces memorise et refus conserves en NVS: reconnexion sans scan des
+// le premier demarrage. Ecriture seulement quand l'etat change.
+static Preferences wifi_prefs;
+static wifi_mgr_saved_t wifi_saved;
+static bool wifi_saved_loaded = false;
+
+static void wifi_saved_load(void) {
+  memset(&wifi_saved, 0, sizeof(wifi_saved));
+  if (wifi_prefs.begin(WIFI_NVS_NAMESPACE, true)) {
+    if (wifi_prefs.getBytes(WIFI_NVS_SAVED_KEY, &wifi_saved, sizeof(wifi_saved)) != sizeof(wifi_saved)) {
+      memset(&wifi_saved, 0, sizeof(wifi_saved));
+    }
+    wifi_prefs.end();
+  }
+  wifi_saved.ssid[WIFI_MGR_SSID_MAX - 1] = '\0';
+  wifi_mgr_restore(&wifi_mgr, &wifi_saved);
+}
+
+static void wifi_saved_update(void) {
+  wifi_mgr_saved_t now;
+  wifi_mgr_get_saved(&wifi_mgr, &now);
+  if (memcmp(&now, &wifi_saved, sizeof(now)) == 0) return;
+  wifi_saved = now;
+  if (wifi_prefs.begin(WIFI_NVS_NAMESPACE, false)) {
+    wifi_prefs.putBytes(WIFI_NVS_SAVED_KEY, &wifi_saved, sizeof(wifi_saved));
+    wifi_prefs.end();
+  }
 #ifdef DEBUG_MODE
-      Serial.printf("[WIFI] Connected to: %s\n", wifi_current_ssid);
-      Serial.printf("[WIFI] IP: %s\n", wifi_current_ip);
+  Serial.printf("[WIFI] Saved AP: %s ch %u, refused 0x%02x\n", wifi_saved.ssid[0] ? wifi_saved.ssid : "-",
+                wifi_saved.channel, wifi_saved.refused);
 #endif
+}
+
+static void wifi_free_current(void) {
+  if (wifi_current_ssid) {
+    heap_caps_free(wifi_current_ssid);
+    wifi_current_ssid = NULL;
+  }
+  if (wifi_current_ip) {
+    heap_caps_free(wifi_current_ip);
+    wifi_current_ip = NULL;
+  }
+}
 
-      xEventGroupSetBits(wifi_event_group, WIFI_CONNECTED_BIT);
-      return true;
+// Evenements du gestionnaire -> bits de wifi_event_group
+static void wifi_mgr_event(wifi_mgr_t *m, wifi_mgr_event_t ev) {
+  if (ev == WIFI_MGR_EV_CONNECTED) {
+    wifi_free_current();
+    wifi_current_ssid = psram_strdup(wifi_mgr_ssid(m));
+
+    IPAddress ip = WiFi.localIP();
+    wifi_current_ip = (char*)heap_caps_malloc(16, MALLOC_CAP_SPIRAM);
+    if (wifi_current_ip) {
+      snprintf(wifi_current_ip, 16, "%d.%d.%d.%d",
+               ip[0], ip[1], ip[2], ip[3]);
     }
 
+    wifi_is_connected = true;
+    xEventGroupClearBits(wifi_event_group, WIFI_DISCONNECTED_BIT);
+    xEventGroupSetBits(wifi_event_group, WIFI_CONNECTED_BIT);
+
 #ifdef DEBUG_MODE
-    Serial.printf("[WIFI] Failed priority %d\n", priority + 1);
+    Serial.printf("[WIFI] Connected to: %s (ch %u, %d dBm) in %lu ms\n", wifi_current_ssid, m->current.channel,
+                  m->current.rssi, (unsigned long)(millis() - wifi_start_ms));
+    Serial.printf("[WIFI] IP: %s\n", wifi_current_ip);
 #endif
-  }
+  } else if (ev == WIFI_MGR_EV_LOST) {
+    wifi_is_connected = false;
+    xEventGroupClearBits(wifi_event_group, WIFI_CONNECTED_BIT);
+    xEventGroupSetBits(wifi_event_group, WIFI_DISCONNECTED_BIT);
+    wifi_start_ms = millis();
 
 #ifdef DEBUG_MODE
-  Serial.println("[WIFI] No network available");
+    Serial.println("[WIFI] Connection lost, reconnecting");
+#endif
+  } else {
+#ifdef DEBUG_MODE
+    Serial.printf("[WIFI] No known network, next scan in %lu s\n", (unsigned long)(m->retry_ms / 1000));
 #endif
-  return false;
+  }
 }
 
 // ============================================================================
@@ -138,70 +199,61 @@ static void wifi_task(void *pvParameters) {
   Serial.println("[WIFI] Task started");
 #endif
 
+  WiFi.persistent(false);     // Pas d'ecriture flash a chaque begin()
   WiFi.mode(WIFI_OFF);
+  wifi_mgr_init(&wifi_mgr, &wifi_radio, wifi_mgr_event, NULL);
 
   while (1) {
+    // Bloque tant que le WiFi est arrete, sinon cadence du gestionnaire
     EventBits_t bits = xEventGroupWaitBits(
       wifi_event_group,
       WIFI_START_BIT | WIFI_STOP_BIT,
       pdTRUE,
       pdFALSE,
-      portMAX_DELAY
+      wifi_mgr.state == WIFI_MGR_OFF ? portMAX_DELAY : pdMS_TO_TICKS(WIFI_POLL_MS)
     );
 
-    if (bits & WIFI_START_BIT) {
-#ifdef DEBUG_MODE
-      Serial.println("[WIFI] Starting connection...");
-#endif
-      
-      if (wifi_connect_with_priority()) {
-        // Connexion reussie - surveiller etat
-        while (WiFi.status() == WL_CONNECTED) {
-          vTaskDelay(pdMS_TO_TICKS(5000));
-        }
-        
-        // Deconnexion detectee
-        wifi_is_connected = false;
-        xEventGroupClearBits(wifi_event_group, WIFI_CONNECTED_BIT);
-        xEventGroupSetBits(wifi_event_group, WIFI_DISCONNECTED_BIT);
-        
-#ifdef DEBUG_MODE
-        Serial.println("[WIFI] Connection lost");
-#endif
-      } else {
-#ifdef DEBUG_MODE
-        Serial.println("[WIFI] Connection failed");
-#endif
-      }
-    }
-
     if (bits & WIFI_STOP_BIT) {
 #ifdef DEBUG_MODE
       Serial.println("[WIFI] Stopping...");
 #endif
-      WiFi.disconnect(true);
+      wifi_mgr_stop(&wifi_mgr);
       WiFi.mode(WIFI_OFF);
       wifi_is_connected = false;
-      
+
       xEventGroupClearBits(wifi_event_group, WIFI_CONNECTED_BIT);
       xEventGroupSetBits(wifi_event_group, WIFI_DISCONNECTED_BIT);
-      
+
       // Liberer memoire
-      if (wifi_current_ssid) {
-        heap_caps_free(wifi_current_ssid);
-        wifi_current_ssid = NULL;
-      }
-      if (wifi_current_ip) {
-        heap_caps_free(wifi_current_ip);
-        wifi_current_ip = NULL;
-      }
-      
+      wifi_free_current();
+
 #ifdef DEBUG_MODE
       Serial.println("[WIFI] Stopped");
 #endif
     }
 
-    vTaskDelay(pdMS_TO_TICKS(1000));
+    if ((bits & WIFI_START_BIT) && wifi_mgr.state == WIFI_MGR_OFF) {
+#ifdef DEBUG_MODE
+      Serial.println("[WIFI] Starting connection...");
+#endif
+      // Reseaux relus a chaque demarrage (modifiables dans les reglages)
+      for (int priority = 0; priority < WIFI_MGR_NETWORKS; priority++) {
+        wifi_mgr_set_network(&wifi_mgr, priority, psram_str_get(params.wifi_ssid[priority]),
+                             psram_str_get(params.wifi_password[priority]));
+      }
+      // Etat NVS repris une fois par demarrage, ensuite la RAM fait foi
+      if (!wifi_saved_loaded) {
+        wifi_saved_load();
+        wifi_saved_loaded = true;
+      }
+      WiFi.mode(WIFI_STA);
+      WiFi.setAutoReconnect(false);   // Reconnexion geree par wifi_mgr
+      wifi_start_ms = millis();
+      wifi_mgr_start(&wifi_mgr, wifi_start_ms);
+    }
+
+    wifi_mgr_step(&wifi_mgr, millis());
+    if (wifi_saved_loaded) wifi_saved_update();
   }
 }
 
@@ -210,8 +262,10 @@ static void wifi_task(void *pvParameters) {
 // ============================================================================
 static void wifi_task_start(void) {
   if (wifi_task_handle != NULL) {
+    // Tache deja creee: relancer la connexion apres un wifi_task_stop()
+    xEventGroupSetBits(wifi_event_group, WIFI_START_BIT);
 #ifdef DEBUG_MODE
-    Serial.println("[WIFI] Task already running");
+    Serial.println("[WIFI] Task already running, start requested");
 #endif
     return;
   }
@@ -237,6 +291,12 @@ static void wifi_task_start(void) {
 #endif
 }
 
+// Reseaux modifies dans les reglages: nouvel essai si aucune connexion en cours
+static void wifi_task_reload_networks(void) {
+  if (!wifi_event_group || wifi_mgr.state == WIFI_MGR_OFF || wifi_is_connected) return;
+  xEventGroupSetBits(wifi_event_group, WIFI_STOP_BIT | WIFI_START_BIT);
+}
+
 static void wifi_task_stop(void) {
   if (wifi_event_group) {
     xEventGroupSetBits(wifi_event_group, WIFI_STOP_BIT);
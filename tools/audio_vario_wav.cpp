@@ -0,0 +1,95 @@
+// Rendu PC du son vario (src/audio_vario.h) dans un fichier WAV
+//
+//   g++ -O2 -I. tools/audio_vario_wav.cpp -o audio_wav
+//   ./audio_wav vario.wav              balayage -4 -> +8 m/s puis retour
+//   ./audio_wav vario.wav 2.5 [5]      vario fixe (m/s), duree (s)
+//
+// Meme chemin que audio_vario_task: une valeur de vario toutes les
+// AUDIO_VARIO_UPDATE_MS (cadence Kalman), rendu par blocs de
+// AUDIO_BLOCK_SAMPLES avec le profil par defaut des parametres. Affiche le
+// nombre de bips, la crete et le plus grand saut entre deux echantillons:
+// un saut au-dela de celui d'un sinus a MAX_FREQ signale un clic (code de
+// sortie non nul).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+
+#include "src/audio_vario.h"
+
+#define AUDIO_VARIO_UPDATE_MS 20
+
+// Copie de default_audio_frequencies (src/params/params.h)
+static const uint16_t profile[AUDIO_PROFILE_POINTS] = {
+  640, 664, 691, 727, 759, 789, 842, 920,
+  998, 1060, 1097, 1121, 1144, 1161, 1170, 1175
+};
+
+// Scenario par defaut: descente, zone morte, montee jusqu'a +8 m/s, retour
+static float sweep_vario(float t, float duration) {
+  float half = duration / 2;
+  float x = t < half ? t / half : (duration - t) / half;
+  return -4.0f + 12.0f * x;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    printf("usage: %s sortie.wav [vario_m_s [duree_s]]\n", argv[0]);
+    return 2;
+  }
+  bool fixed = argc > 2;
+  float fixed_vario = fixed ? strtof(argv[2], NULL) : 0.0f;
+  float duration = argc > 3 ? strtof(argv[3], NULL) : (fixed ? 5.0f : 20.0f);
+
+  uint32_t total = (uint32_t)(duration * AUDIO_SAMPLE_RATE);
+  total -= total % AUDIO_BLOCK_SAMPLES;
+  std::vector<int16_t> pcm(total);
+
+  static audio_vario_state_t s;
+  audio_vario_init(&s, AUDIO_SAMPLE_RATE);
+
+  uint32_t update_samples = AUDIO_VARIO_UPDATE_MS * AUDIO_SAMPLE_RATE / 1000;
+  uint32_t next_update = 0;
+  for (uint32_t pos = 0; pos < total; pos += AUDIO_BLOCK_SAMPLES) {
+    if (pos >= next_update) {
+      float t = (float)pos / AUDIO_SAMPLE_RATE;
+      audio_vario_set_vario(&s, fixed ? fixed_vario : sweep_vario(t, duration), profile);
+      next_update += update_samples;
+    }
+    audio_vario_render(&s, &pcm[pos], AUDIO_BLOCK_SAMPLES);
+  }
+
+  // Bips (sortie du silence), crete, plus grand saut
+  int peak = 0, max_step = 0, beeps = 0;
+  uint32_t quiet = AUDIO_SAMPLE_RATE;   // Le premier son compte
+  for (uint32_t i = 0; i < total; i++) {
+    int v = pcm[i];
+    if (abs(v) > peak) peak = abs(v);
+    if (i > 0 && abs(v - pcm[i - 1]) > max_step) max_step = abs(v - pcm[i - 1]);
+    if (v == 0) {
+      quiet++;
+    } else {
+      if (quiet >= AUDIO_SAMPLE_RATE / 100) beeps++;   // Au moins 10 ms de silence avant
+      quiet = 0;
+    }
+  }
+  int step_limit = (int)(AUDIO_VOLUME_MAX * 2 * M_PI * MAX_FREQ / AUDIO_SAMPLE_RATE * 1.05) + 2;
+
+  FILE *f = fopen(argv[1], "wb");
+  if (!f) {
+    printf("ECHEC: %s non inscriptible\n", argv[1]);
+    return 1;
+  }
+  uint8_t hdr[44];
+  audio_wav_header(hdr, AUDIO_SAMPLE_RATE, total);
+  fwrite(hdr, 1, sizeof(hdr), f);
+  fwrite(pcm.data(), sizeof(int16_t), total, f);
+  fclose(f);
+
+  printf("%s: %.1f s a %d Hz, %d bips, crete %d, saut max %d (limite %d)\n", argv[1],
+         (double)total / AUDIO_SAMPLE_RATE, AUDIO_SAMPLE_RATE, beeps, peak, max_step, step_limit);
+  bool ok = peak <= AUDIO_VOLUME_MAX && max_step <= step_limit;
+  printf("%s\n", ok ? "ok" : "ECHEC");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+// Banc d'essai PC du synthetiseur src/dds_synth.h
+//
+//   g++ -O2 -I. tools/dds_bench.cpp -o dds_bench
+//   ./dds_bench
+//
+// 1. Debit: echantillons/s de dds_render_block par blocs de
+//    AUDIO_BLOCK_SAMPLES (porte ouverte, glissement actif).
+// 2. Purete spectrale: pour plusieurs frequences de MIN_FREQ a MAX_FREQ,
+//    FFT 65536 points (fenetre Blackman-Harris 4 termes) d'un son continu et
+//    SFDR = fondamentale - plus forte raie parasite hors fondamentale.
+//    Code de sortie non nul si un SFDR est sous DDS_BENCH_MIN_SFDR_DB.
+// 3. Clics: plus grand saut entre echantillons a l'ouverture et a la
+//    fermeture de la porte (enveloppe) compare a celui du sinus seul.
+
+#include <stdio.h>
+#include <math.h>
+#include <complex>
+#include <vector>
+#include <chrono>
+
+#include "src/dds_synth.h"
+
+#define DDS_BENCH_FFT_BITS 16
+#define DDS_BENCH_FFT_SIZE (1 << DDS_BENCH_FFT_BITS)
+#define DDS_BENCH_MIN_SFDR_DB 70.0
+#define DDS_BENCH_SAMPLE_RATE AUDIO_SAMPLE_RATE
+#define DDS_BENCH_BLOCK AUDIO_BLOCK_SAMPLES
+#define DDS_BENCH_VOLUME AUDIO_VOLUME_MAX
+
+static int failures = 0;
+
+static void fft(std::vector<std::complex<double>> &a) {
+  size_t n = a.size();
+  for (size_t i = 1, j = 0; i < n; i++) {
+    size_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) std::swap(a[i], a[j]);
+  }
+  for (size_t len = 2; len <= n; len <<= 1) {
+    std::complex<double> w(cos(-2 * M_PI / len), sin(-2 * M_PI / len));
+    for (size_t i = 0; i < n; i += len) {
+      std::complex<double> wn(1);
+      for (size_t k = 0; k < len / 2; k++) {
+        std::complex<double> u = a[i + k], v = a[i + k + len / 2] * wn;
+        a[i + k] = u + v;
+        a[i + k + len / 2] = u - v;
+        wn *= w;
+      }
+    }
+  }
+}
+
+static void bench_throughput(void) {
+  static dds_t d;
+  dds_init(&d, DDS_BENCH_SAMPLE_RATE, AUDIO_RAMP_MS, AUDIO_GLIDE_MS, DDS_BENCH_VOLUME);
+  dds_gate(&d, true);
+  static int16_t block[DDS_BENCH_BLOCK];
+  const uint32_t blocks = 2000000;
+  int64_t sum = 0;
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < blocks; i++) {
+    if ((i & 255) == 0) dds_set_freq(&d, (float)(MIN_FREQ + (i >> 8) % (MAX_FREQ - MIN_FREQ)));
+    dds_render_block(&d, block, DDS_BENCH_BLOCK);
+    sum += block[i % DDS_BENCH_BLOCK];
+  }
+  double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  double rate = blocks * (double)DDS_BENCH_BLOCK / s;
+  printf("debit: %.1f M echantillons/s (%.0f x temps reel a %d Hz)  [%lld]\n", rate / 1e6,
+         rate / DDS_BENCH_SAMPLE_RATE, DDS_BENCH_SAMPLE_RATE, (long long)(sum & 1));
+}
+
+// SFDR en dB d'un son continu a freq
+static double sfdr(float freq, double *fund_hz) {
+  static dds_t d;
+  dds_init(&d, DDS_BENCH_SAMPLE_RATE, AUDIO_RAMP_MS, AUDIO_GLIDE_MS, DDS_BENCH_VOLUME);
+  dds_set_freq(&d, freq);
+  dds_gate(&d, true);
+  // Glissement et attaque termines avant la fenetre d'analyse
+  static int16_t pcm[DDS_BENCH_FFT_SIZE];
+  for (int i = 0; i < 8; i++) dds_render_block(&d, pcm, DDS_BENCH_SAMPLE_RATE / 8);
+  for (int i = 0; i < DDS_BENCH_FFT_SIZE; i += DDS_BENCH_BLOCK) dds_render_block(&d, pcm + i, DDS_BENCH_BLOCK);
+
+  std::vector<std::complex<double>> a(DDS_BENCH_FFT_SIZE);
+  for (int i = 0; i < DDS_BENCH_FFT_SIZE; i++) {
+    double x = 2 * M_PI * i / (DDS_BENCH_FFT_SIZE - 1);
+    double w = 0.35875 - 0.48829 * cos(x) + 0.14128 * cos(2 * x) - 0.01168 * cos(3 * x);
+    a[i] = pcm[i] * w;
+  }
+  fft(a);
+
+  int half = DDS_BENCH_FFT_SIZE / 2;
+  std::vector<double> p(half);
+  int peak = 1;
+  for (int k = 1; k < half; k++) {
+    p[k] = std::norm(a[k]);
+    if (p[k] > p[peak]) peak = k;
+  }
+  // Lobe principal de la fenetre: +-4 raies, avec marge
+  const int guard = 8;
+  double spur = 1e-30;
+  for (int k = 2; k < half; k++) {
+    if (k >= peak - guard && k <= peak + guard) continue;
+    if (p[k] > spur) spur = p[k];
+  }
+  *fund_hz = (double)peak * DDS_BENCH_SAMPLE_RATE / DDS_BENCH_FFT_SIZE;
+  return 10 * log10(p[peak] / spur);
+}
+
+static void bench_purity(void) {
+  const float freqs[] = { (float)MIN_FREQ, 640.0f, 777.7f, 1000.0f, 1175.0f, (float)MAX_FREQ };
+  double worst = 1e9;
+  for (float f : freqs) {
+    double fund;
+    double db = sfdr(f, &fund);
+    printf("sfdr %7.1f Hz: %5.1f dB (fondamentale %.1f Hz)\n", f, db, fund);
+    if (db < worst) worst = db;
+    if (fabs(fund - f) > 1.0) {
+      failures++;
+      printf("ECHEC frequence %.1f Hz au lieu de %.1f Hz\n", fund, f);
+    }
+  }
+  printf("sfdr min: %.1f dB (seuil %.0f dB)\n", worst, DDS_BENCH_MIN_SFDR_DB);
+  if (worst < DDS_BENCH_MIN_SFDR_DB) failures++;
+}
+
+// Saut max entre echantillons: enveloppe contre sinus seul
+static void bench_clicks(void) {
+  static dds_t d;
+  dds_init(&d, DDS_BENCH_SAMPLE_RATE, AUDIO_RAMP_MS, AUDIO_GLIDE_MS, DDS_BENCH_VOLUME);
+  dds_set_freq(&d, MAX_FREQ);
+  static int16_t pcm[DDS_BENCH_SAMPLE_RATE];
+  int prev = 0, step_gate = 0;
+  for (int i = 0; i < DDS_BENCH_SAMPLE_RATE; i += DDS_BENCH_BLOCK) {
+    // Porte basculee a chaque bloc de 4 ms, au milieu de l'attaque/relache
+    dds_gate(&d, (i / DDS_BENCH_BLOCK) % 3 != 0);
+    dds_render_block(&d, pcm + i, DDS_BENCH_BLOCK);
+    for (int k = 0; k < DDS_BENCH_BLOCK; k++) {
+      int v = pcm[i + k];
+      if (abs(v - prev) > step_gate) step_gate = abs(v - prev);
+      prev = v;
+    }
+  }
+  int step_sine = (int)ceil(DDS_BENCH_VOLUME * 2 * sin(M_PI * MAX_FREQ / DDS_BENCH_SAMPLE_RATE));
+  printf("saut max avec porte: %d (sinus seul a %d Hz: %d)\n", step_gate, MAX_FREQ, step_sine);
+  if (step_gate > step_sine + 2) {
+    failures++;
+    printf("ECHEC clic a l'ouverture/fermeture\n");
+  }
+}
+
+int main() {
+  bench_throughput();
+  bench_purity();
+  bench_clicks();
+  printf("%s\n", failures ? "ECHEC" : "ok");
+  return failures ? 1 : 0;
+}
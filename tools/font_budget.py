@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""Budget flash des polices Montserrat compilees (lv_conf.h) et RAM de l'atlas
+de glyphes des ecrans de vol (src/ui/ui_glyph_atlas.h), mesures sur les sources
+de polices d'un arbre LVGL.
+
+Usage (depuis la racine du depot):
+  font_budget.py <lvgl>            <lvgl>/src/font/lv_font_montserrat_NN.c
+
+Flash: octets des tableaux constants de chaque fichier de police (bitmaps,
+descripteurs de glyphes, cmaps, crenage), tailles 32 bits ESP32. Le total est
+donne avec VARIO_FONTS_MINIMAL a 0 et a 1.
+RAM atlas: largeur des caracteres de UI_ATLAS_CHARSET x hauteur de ligne x 2
+octets (RGB565) par couleur, jusqu'a UI_ATLAS_MAX_VARIANTS couleurs en PSRAM.
+"""
+
+import os
+import re
+import sys
+
+# Tailles des elements (ESP32, 32 bits)
+SCALAR_SIZES = {
+    "uint8_t": 1,
+    "int8_t": 1,
+    "uint16_t": 2,
+    "int16_t": 2,
+    "uint32_t": 4,
+    "int32_t": 4,
+}
+GLYPH_DSC_SIZE = 8     # lv_font_fmt_txt_glyph_dsc_t (champs de bits)
+CMAP_SIZE = 20         # lv_font_fmt_txt_cmap_t
+FONT_DSC_SIZE = 40     # lv_font_fmt_txt_dsc_t + lv_font_t, ordre de grandeur
+
+
+def read(path):
+    with open(path, encoding="utf-8", errors="replace") as f:
+        return f.read()
+
+
+def enabled_sizes(lv_conf):
+    """{taille: (active si MINIMAL=0, active si MINIMAL=1)} et la valeur par defaut."""
+    text = read(lv_conf)
+    m = re.search(r"#define\s+VARIO_FONTS_MINIMAL\s+(\d+)", text)
+    default = int(m.group(1)) if m else 0
+    sizes = {}
+    for size, expr in re.findall(r"#define\s+LV_FONT_MONTSERRAT_(\d+)\s+(\S+)", text):
+        expr = expr.strip()
+        if expr in ("0", "1"):
+            sizes[int(size)] = (expr == "1", expr == "1")
+        elif expr == "(!VARIO_FONTS_MINIMAL)":
+            sizes[int(size)] = (True, False)
+    return sizes, default
+
+
+def array_bodies(text):
+    """(type, nom, corps) des tableaux constants d'un fichier de police."""
+    pattern = re.compile(r"(?:static\s+)?(?:LV_ATTRIBUTE_LARGE_CONST\s+)?const\s+(\w+)\s+(\w+)\[\]\s*=\s*\{(.*?)\};",
+                         re.S)
+    for m in pattern.finditer(text):
+        yield m.group(1), m.group(2), m.group(3)
+
+
+def strip_comments(body):
+    body = re.sub(r"/\*.*?\*/", "", body, flags=re.S)
+    return re.sub(r"//[^\n]*", "", body)
+
+
+def font_flash(text):
+    total = FONT_DSC_SIZE
+    for ctype, _name, body in array_bodies(text):
+        body = strip_comments(body)
+        if ctype == "lv_font_fmt_txt_glyph_dsc_t":
+            total += body.count(".bitmap_index") * GLYPH_DSC_SIZE
+        elif ctype == "lv_font_fmt_txt_cmap_t":
+            total += body.count(".range_start") * CMAP_SIZE
+        elif ctype in SCALAR_SIZES:
+            items = [t for t in body.replace("\n", " ").split(",") if t.strip()]
+            total += len(items) * SCALAR_SIZES[ctype]
+    return total
+
+
+def glyph_adv(text):
+    """Avances (1/16 px) par identifiant de glyphe et hauteur de ligne."""
+    adv = []
+    for ctype, _name, body in array_bodies(text):
+        if ctype == "lv_font_fmt_txt_glyph_dsc_t":
+            adv = [int(v) for v in re.findall(r"\.adv_w\s*=\s*(\d+)", strip_comments(body))]
+    m = re.search(r"\.line_height\s*=\s*(\d+)", text)
+    return adv, int(m.group(1)) if m else 0
+
+
+def atlas_ram(font_text, charset, variants):
+    adv, line_height = glyph_adv(font_text)
+    width = 0
+    for c in charset:
+        # Plage ASCII continue a partir de l'espace: glyphe 1 = ' '
+        gid = ord(c) - 32 + 1
+        if gid < 1 or gid >= len(adv):
+            raise ValueError("caractere %r absent de la police" % c)
+        width += (adv[gid] + 8) >> 4
+    per_variant = width * line_height * 2
+    return width, line_height, per_variant, per_variant * variants
+
+
+def main(argv):
+    if len(argv) != 2:
+        print(__doc__)
+        return 2
+    font_dir = os.path.join(argv[1], "src", "font")
+    sizes, default = enabled_sizes("lv_conf.h")
+
+    print("taille  complet  minimal  flash (octets)")
+    totals = [0, 0]
+    missing = False
+    for size in sorted(sizes):
+        full, minimal = sizes[size]
+        if not (full or minimal):
+            continue
+        path = os.path.join(font_dir, "lv_font_montserrat_%d.c" % size)
+        if not os.path.exists(path):
+            print("ECHEC %s introuvable" % path)
+            missing = True
+            continue
+        flash = font_flash(read(path))
+        totals[0] += flash if full else 0
+        totals[1] += flash if minimal else 0
+        print("%6d  %7s  %7s  %d" % (size, "x" if full else "-", "x" if minimal else "-", flash))
+    if missing:
+        return 1
+    print("total: complet %d, minimal %d, gain %d octets (defaut: %s)" %
+          (totals[0], totals[1], totals[0] - totals[1], "minimal" if default else "complet"))
+
+    atlas = read(os.path.join("src", "ui", "ui_glyph_atlas.h"))
+    charset = re.search(r'#define\s+UI_ATLAS_CHARSET\s+"([^"]*)"', atlas).group(1)
+    variants = int(re.search(r"#define\s+UI_ATLAS_MAX_VARIANTS\s+(\d+)", atlas).group(1))
+    graphical = read(os.path.join("src", "ui", "graphical.h"))
+    flight_size = int(re.search(r"#define\s+UI_FONT_FLIGHT_VALUE\s+&lv_font_montserrat_(\d+)", graphical).group(1))
+    font_text = read(os.path.join(font_dir, "lv_font_montserrat_%d.c" % flight_size))
+    width, height, per_variant, worst = atlas_ram(font_text, charset, variants)
+    print("atlas montserrat %d: %dx%d px, %d octets par couleur, %d octets pour %d couleurs (PSRAM)" %
+          (flight_size, width, height, per_variant, worst, variants))
+    print("ok")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,206 @@
+// Rejeu PC d'une trace d'allocations LVGL (src/lvgl_port/lvgl_mem.cpp)
+//
+//   g++ -O2 -I. tools/lvgl_mem_replay.cpp -o lvgl_mem_replay
+//   ./lvgl_mem_replay console.log [n16 n32 n64 n128 n256]
+//
+// Capture: touche LVGL_MEM_TRACE_SERIAL_CMD sur la console serie, scenario
+// (changements d'ecran, pages, zooms), meme touche pour arreter; le journal
+// complet peut etre donne tel quel, seules les lignes "LVMEM" sont lues:
+//   LVMEM a <taille> <ptr>          lv_malloc
+//   LVMEM f <ptr>                   lv_free
+//   LVMEM r <ancien> <taille> <ptr> lv_realloc
+//
+// Les allocations sont rejouees dans les memes pools (src/lvgl_port/
+// lvgl_mem_pool.h, classes LVGL_MEM_POOL_SIZES, nombres de blocs de
+// constants.h ou de la ligne de commande) avec la meme regle de niveaux que
+// lv_malloc_core / lv_realloc_core, le niveau PSRAM etant simule. Affiche par
+// classe pic et replis, le pic PSRAM, les blocs restants en fin de trace et
+// les liberations de pointeurs inconnus (trace tronquee). Code de sortie non
+// nul si une liste libre est incoherente apres le rejeu.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+
+#include "constants.h"
+#include "src/lvgl_port/lvgl_mem.h"
+#include "src/lvgl_port/lvgl_mem_pool.h"
+
+static const uint16_t block_sizes[LVGL_MEM_POOL_CLASSES] = LVGL_MEM_POOL_SIZES;
+static uint16_t block_counts[LVGL_MEM_POOL_CLASSES] = {
+  LVGL_MEM_POOL_16_COUNT, LVGL_MEM_POOL_32_COUNT, LVGL_MEM_POOL_64_COUNT,
+  LVGL_MEM_POOL_128_COUNT, LVGL_MEM_POOL_256_COUNT
+};
+
+static lvgl_mem_pool_t pools[LVGL_MEM_POOL_CLASSES];
+
+// Bloc rejoue: pointeur de la trace -> bloc local
+typedef struct {
+  void *block;  // Bloc de pool, NULL si PSRAM
+  size_t size;  // Taille demandee (PSRAM)
+} replay_block_t;
+
+static std::map<std::string, replay_block_t> live;
+static uint64_t psram_bytes = 0, psram_peak = 0;
+static uint32_t psram_allocs = 0, psram_blocks = 0;
+static uint32_t unknown_frees = 0, lines = 0;
+
+static int pool_class_for(size_t size) {
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    if (size <= pools[i].block_size) return i;
+  }
+  return -1;
+}
+
+static int pool_owner(const void *ptr) {
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    if (lvgl_mem_pool_owns(&pools[i], ptr)) return i;
+  }
+  return -1;
+}
+
+// Pointeur nul tel qu'imprime par printf("%p")
+static bool is_null(const char *p) {
+  return !strcmp(p, "0x0") || !strcmp(p, "(nil)") || !strcmp(p, "0");
+}
+
+static replay_block_t tier_alloc(size_t size) {
+  replay_block_t b = { NULL, size };
+  int cls = pool_class_for(size);
+  if (cls >= 0) b.block = lvgl_mem_pool_alloc(&pools[cls]);
+  if (!b.block) {
+    psram_allocs++;
+    psram_blocks++;
+    psram_bytes += size;
+    if (psram_bytes > psram_peak) psram_peak = psram_bytes;
+  }
+  return b;
+}
+
+static void tier_free(const replay_block_t *b) {
+  if (b->block) {
+    lvgl_mem_pool_free(&pools[pool_owner(b->block)], b->block);
+  } else {
+    psram_blocks--;
+    psram_bytes -= b->size;
+  }
+}
+
+static void replay_alloc(size_t size, const char *ptr) {
+  if (is_null(ptr)) return;  // Echec sur la carte: rien a rejouer
+  live[ptr] = tier_alloc(size);
+}
+
+static void replay_free(const char *ptr) {
+  auto it = live.find(ptr);
+  if (it == live.end()) {
+    unknown_frees++;
+    return;
+  }
+  tier_free(&it->second);
+  live.erase(it);
+}
+
+static void replay_realloc(const char *old_ptr, size_t size, const char *new_ptr) {
+  if (is_null(old_ptr)) {
+    replay_alloc(size, new_ptr);
+    return;
+  }
+  if (is_null(new_ptr)) return;  // Echec: l'ancien bloc reste
+  auto it = live.find(old_ptr);
+  if (it == live.end()) {
+    unknown_frees++;
+    replay_alloc(size, new_ptr);
+    return;
+  }
+
+  // Meme regle que lv_realloc_core
+  replay_block_t b = it->second;
+  live.erase(it);
+  int cls = b.block ? pool_owner(b.block) : -1;
+  if (cls >= 0 && size <= block_sizes[cls] && (cls == 0 || size > block_sizes[cls - 1])) {
+    // Meme classe: bloc garde
+  } else if (cls < 0 && pool_class_for(size) < 0) {
+    psram_bytes = psram_bytes - b.size + size;
+    if (psram_bytes > psram_peak) psram_peak = psram_bytes;
+    b.size = size;
+  } else {
+    replay_block_t nb = tier_alloc(size);
+    tier_free(&b);
+    b = nb;
+  }
+  live[new_ptr] = b;
+}
+
+static bool pools_consistent(void) {
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    uint32_t n = 0;
+    for (void **b = (void **)pools[i].free_list; b; b = (void **)*b) {
+      if (!lvgl_mem_pool_owns(&pools[i], b) || ++n > pools[i].count) return false;
+    }
+    if (n != (uint32_t)(pools[i].count - pools[i].used)) return false;
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2 && argc != 2 + LVGL_MEM_POOL_CLASSES) {
+    printf("usage: %s trace.log [n16 n32 n64 n128 n256]\n", argv[0]);
+    return 2;
+  }
+  for (int i = 0; argc > 2 && i < LVGL_MEM_POOL_CLASSES; i++) block_counts[i] = (uint16_t)atoi(argv[2 + i]);
+
+  FILE *f = fopen(argv[1], "r");
+  if (!f) {
+    printf("ECHEC: %s illisible\n", argv[1]);
+    return 1;
+  }
+
+  size_t total = 0;
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) total += (size_t)block_sizes[i] * block_counts[i];
+  uint8_t *area = (uint8_t *)malloc(total);
+  uint8_t *base = area;
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    lvgl_mem_pool_init(&pools[i], base, block_sizes[i], block_counts[i]);
+    base += (size_t)block_sizes[i] * block_counts[i];
+  }
+
+  char line[256], a[64], b[64];
+  unsigned size;
+  while (fgets(line, sizeof(line), f)) {
+    const char *p = strstr(line, "LVMEM ");
+    if (!p) continue;
+    p += 6;
+    if (sscanf(p, "a %u %63s", &size, a) == 2) {
+      replay_alloc(size, a);
+    } else if (sscanf(p, "f %63s", a) == 1) {
+      replay_free(a);
+    } else if (sscanf(p, "r %63s %u %63s", a, &size, b) == 3) {
+      replay_realloc(a, size, b);
+    } else {
+      continue;
+    }
+    lines++;
+  }
+  fclose(f);
+
+  printf("%u operations rejouees, pools SRAM %u octets\n", lines, (unsigned)total);
+  printf("classe  blocs  pic  allocs  replis\n");
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) {
+    const lvgl_mem_pool_t *pl = &pools[i];
+    printf("%6u  %5u  %3u  %6u  %6u\n", pl->block_size, pl->count, pl->peak, pl->allocs, pl->fallbacks);
+  }
+  uint32_t pool_live = 0;
+  for (int i = 0; i < LVGL_MEM_POOL_CLASSES; i++) pool_live += pools[i].used;
+  printf("psram: %u allocations, pic %llu octets\n", psram_allocs, (unsigned long long)psram_peak);
+  printf("restants en fin de trace: %u blocs (%u pools, %u psram, %llu octets psram)\n",
+         (unsigned)live.size(), pool_live, psram_blocks, (unsigned long long)psram_bytes);
+  if (unknown_frees) printf("liberations de pointeurs inconnus: %u (trace commencee en cours)\n", unknown_frees);
+
+  bool ok = pools_consistent() && pool_live + psram_blocks == live.size();
+  free(area);
+  printf("%s\n", ok ? "ok" : "ECHEC");
+  return ok ? 0 : 1;
+}
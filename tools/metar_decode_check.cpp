@@ -0,0 +1,161 @@
+// Verification PC du decodeur src/metar_decode.h et du choix de station
+// src/metar_stations.h
+//
+//   g++ -O2 -I. tools/metar_decode_check.cpp -o metar_check
+//   ./metar_check [tools/metar_corpus.txt]
+//
+// Decode chaque METAR du corpus et compare aux valeurs attendues, puis lit une
+// reponse aviationweather.gov d'exemple (en morceaux, comme sur le reseau)
+// et verifie la station retenue, l'interpolation et le rejet des
+// observations trop anciennes. Code de sortie non nul en cas d'echec.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "src/metar_stations.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *what, const char *line) {
+  if (ok) return;
+  failures++;
+  printf("ECHEC %s: %s\n", what, line);
+}
+
+// "-" -> absent; "M05" -> -5
+static bool field_float(const char *f, float *v) {
+  if (!strcmp(f, "-")) return false;
+  *v = f[0] == 'M' ? -strtof(f + 1, NULL) : strtof(f, NULL);
+  return true;
+}
+
+static void check_float(const char *f, bool has, float value, const char *what, const char *line) {
+  float expected;
+  if (!field_float(f, &expected)) check(!has, what, line);
+  else check(has && fabsf(value - expected) <= 0.1f, what, line);
+}
+
+static void check_corpus(const char *path) {
+  FILE *f = fopen(path, "r");
+  if (!f) {
+    printf("ECHEC: %s illisible\n", path);
+    failures++;
+    return;
+  }
+  char line[512];
+  int count = 0;
+  while (fgets(line, sizeof(line), f)) {
+    if (line[0] == '#' || line[0] == '\n') continue;
+    line[strcspn(line, "\r\n")] = '\0';
+    char copy[512];
+    strcpy(copy, line);
+    char *fields[11];
+    int n = 0;
+    for (char *p = copy; n < 11; n++) {
+      fields[n] = p;
+      char *bar = n < 10 ? strchr(p, '|') : NULL;
+      if (!bar) {
+        n++;
+        break;
+      }
+      *bar = '\0';
+      p = bar + 1;
+    }
+    if (n != 11) {
+      printf("ECHEC ligne mal formee: %s\n", line);
+      failures++;
+      continue;
+    }
+    count++;
+    metar_report_t r;
+    bool ok = metar_decode(fields[10], &r);
+    if (!strcmp(fields[0], "?")) {
+      check(!ok, "decodage refuse", line);
+      continue;
+    }
+    check(ok && !strcmp(r.station, fields[0]), "station", line);
+    unsigned day, hour, minute;
+    check(sscanf(fields[1], "%u %u %u", &day, &hour, &minute) == 3 && r.day == day && r.hour == hour &&
+              r.minute == minute,
+          "heure", line);
+    check_float(fields[2], r.has_qnh, r.qnh, "qnh", line);
+    check_float(fields[3], r.has_temp, r.temperature, "temperature", line);
+    check_float(fields[4], r.has_temp, r.dewpoint, "point de rosee", line);
+    check_float(fields[5], r.has_wind, (float)r.wind_dir, "direction du vent", line);
+    check_float(fields[6], r.has_wind, r.wind_speed, "vitesse du vent", line);
+    check_float(fields[7], r.wind_gust > 0, r.wind_gust, "rafales", line);
+    check_float(fields[8], r.visibility >= 0, (float)r.visibility, "visibilite", line);
+    check(!strcmp(r.conditions, strcmp(fields[9], "-") ? fields[9] : ""), "conditions", line);
+  }
+  fclose(f);
+  printf("corpus: %d METAR\n", count);
+}
+
+// Extrait de reponse aviationweather.gov (format=json), vario a Chambery
+static const char *const sample =
+  "[{\"icaoId\":\"LFLB\",\"receiptTime\":\"2024-06-01 11:33:12\",\"obsTime\":1717241400,"
+  "\"temp\":21,\"dewp\":12,\"wdir\":340,\"wspd\":6,\"altim\":1016,"
+  "\"rawOb\":\"METAR LFLB 011130Z AUTO 34006KT 9999 FEW040 21/12 Q1016\","
+  "\"lat\":45.6381,\"lon\":5.88013,\"elev\":235,\"name\":\"Chambery/Aix-Les-Bains Arpt, AR, FR\","
+  "\"clouds\":[{\"cover\":\"FEW\",\"base\":4000}]},"
+  "{\"icaoId\":\"LFLP\",\"rawOb\":\"METAR LFLP 011130Z 32008KT CAVOK 23/11 Q1015\","
+  "\"lat\":45.9294,\"lon\":6.09876,\"clouds\":[]},"
+  "{\"icaoId\":\"LFLS\",\"rawOb\":\"METAR LFLS 011130Z 36005KT 9999 SCT045 22/10 Q1017\","
+  "\"lat\":45.3629,\"lon\":5.32937,\"name\":\"Grenoble \\\"Isere\\\"\"},"
+  "{\"icaoId\":\"LSGG\",\"rawOb\":\"METAR LSGG 010850Z 24004KT 9999 FEW050 18/09 Q1014 NOSIG\","
+  "\"lat\":46.2381,\"lon\":6.10895},"
+  "{\"icaoId\":\"LFLY\",\"rawOb\":\"METAR LFLY 011130Z VRB02KT 9999 24/10 Q////\",\"lat\":45.7272,\"lon\":4.9444}]";
+
+static void feed_sample(metar_stations_t *st, float lat, float lon) {
+  metar_stations_init(st, lat, lon);
+  json_stream_t js;
+  json_stream_init(&js, metar_stations_cb, st);
+  size_t len = strlen(sample);
+  for (size_t i = 0; i < len; i += 37) {
+    size_t n = len - i < 37 ? len - i : 37;
+    json_stream_feed(&js, (const uint8_t *)sample + i, n);
+  }
+  check(!js.error && js.depth == 0, "lecture JSON", "exemple");
+}
+
+static void check_stations(void) {
+  static metar_stations_t st;
+  metar_qnh_t q;
+
+  // A 2 km de LFLB: station prise telle quelle
+  feed_sample(&st, 45.62f, 5.88f);
+  check(st.records == 5, "objets lus", "exemple");
+  check(st.count == 4, "stations avec QNH", "exemple");
+  check(metar_stations_qnh(&st, true, 1, 12, 0, &q) && q.used == 1 && !strcmp(q.station, "LFLB") && q.qnh == 1016.0f &&
+            q.age_min == 30,
+        "station proche", "exemple");
+  check(q.nearest && q.nearest->wind_dir == 340, "releve de la station proche", "exemple");
+
+  // Entre Grenoble et Chambery: interpolation des trois plus proches
+  feed_sample(&st, 45.50f, 5.60f);
+  check(metar_stations_qnh(&st, true, 1, 12, 0, &q) && q.used == 3 && q.qnh > 1015.0f && q.qnh < 1017.0f,
+        "interpolation", "exemple");
+  check(!strncmp(q.station, "LF", 2) && !strcmp(q.station + 4, "+2"), "nom interpole", "exemple");
+
+  // A Geneve: LSGG trop ancien (3h10), Annecy puis Chambery
+  feed_sample(&st, 46.20f, 6.10f);
+  check(st.stations[0].distance_km < 5.0f, "LSGG la plus proche", "exemple");
+  check(metar_stations_qnh(&st, true, 1, 12, 0, &q) && q.used == 2 && !strcmp(q.station, "LFLP+1") &&
+            st.stations[0].age_min == 190,
+        "observation ancienne ignoree", "exemple");
+
+  // Le lendemain: tout est trop ancien
+  check(!metar_stations_qnh(&st, true, 2, 12, 0, &q), "observations perimees", "exemple");
+  // Heure inconnue: age non verifie
+  check(metar_stations_qnh(&st, false, 0, 0, 0, &q) && q.age_min == -1, "heure inconnue", "exemple");
+  printf("stations: %u octets d'etat\n", (unsigned)(sizeof(metar_stations_t) + sizeof(json_stream_t)));
+}
+
+int main(int argc, char **argv) {
+  check_corpus(argc > 1 ? argv[1] : "tools/metar_corpus.txt");
+  check_stations();
+  printf("%s\n", failures ? "ECHEC" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,228 @@
+// Verification PC du blob de parametres src/params/params_blob.h
+//
+//   g++ -O2 -I. tools/params_blob_check.cpp -o params_blob_check
+//   ./params_blob_check
+//
+// Schema de test calque sur params.h (tous les types de champs). Verifie
+// l'aller-retour ecriture/lecture, la troncature des chaines, la migration
+// d'un blob v1 vers un schema v2 (champ ajoute par defaut, champ retire lu
+// puis ignore, hook appele avec la version d'origine) et le rejet des blobs
+// abimes: entete, version 0, CRC, longueur, version plus recente, nombre de
+// champs.
+// Code de sortie non nul en cas d'echec.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "src/params/params_blob.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (ok) return;
+  failures++;
+  printf("ECHEC %s\n", what);
+}
+
+typedef struct {
+  char *name;
+  char *ssid[2];
+  int period;
+  uint16_t freq[3];
+  bool colors;
+  uint8_t mode;
+  float scale;
+  int added;      // Apparu en v2
+} test_params_t;
+
+#define FIELD(type, member, since, until) \
+  { PARAMS_FIELD_##type, since, until, offsetof(test_params_t, member) }
+
+// v1: name, ssid, period, freq, colors, mode, scale, (ancien) u16 retire en v2
+// v2: + added
+static const params_field_t fields[] = {
+  FIELD(STR, name, 1, 0),
+  FIELD(STR, ssid[0], 1, 0),
+  FIELD(STR, ssid[1], 1, 0),
+  FIELD(I32, period, 1, 0),
+  FIELD(U16, freq[0], 1, 0),
+  FIELD(U16, freq[1], 1, 0),
+  FIELD(U16, freq[2], 1, 0),
+  FIELD(BOOL, colors, 1, 0),
+  FIELD(U8, mode, 1, 0),
+  FIELD(F32, scale, 1, 0),
+  { PARAMS_FIELD_U16, 1, 2, PARAMS_BLOB_NO_OFFSET },
+  FIELD(I32, added, 2, 0),
+};
+
+static uint16_t migrated_from = 0;
+
+static void migrate(void *obj, uint16_t from_version) {
+  migrated_from = from_version;
+  // Exemple de conversion: periode v1 en secondes, v2 en dixiemes
+  ((test_params_t *)obj)->period *= 10;
+}
+
+static const params_schema_t schema_v1 = { fields, sizeof(fields) / sizeof(fields[0]), 1, NULL };
+static const params_schema_t schema_v2 = { fields, sizeof(fields) / sizeof(fields[0]), 2, migrate };
+
+static void set_defaults(test_params_t *p) {
+  PARAMS_BLOB_STR_SET(&p->name, "");
+  PARAMS_BLOB_STR_SET(&p->ssid[0], "");
+  PARAMS_BLOB_STR_SET(&p->ssid[1], "");
+  p->period = 5;
+  p->freq[0] = 640;
+  p->freq[1] = 700;
+  p->freq[2] = 800;
+  p->colors = true;
+  p->mode = 1;
+  p->scale = 1.0f;
+  p->added = 42;
+}
+
+static void free_strings(test_params_t *p) {
+  free(p->name);
+  free(p->ssid[0]);
+  free(p->ssid[1]);
+  memset(p, 0, sizeof(*p));
+}
+
+static void fill(test_params_t *p) {
+  set_defaults(p);
+  PARAMS_BLOB_STR_SET(&p->name, "Dupont");
+  PARAMS_BLOB_STR_SET(&p->ssid[1], "maison");
+  p->period = 3;
+  p->freq[1] = 1234;
+  p->colors = false;
+  p->mode = 7;
+  p->scale = -0.75f;
+  p->added = -9;
+}
+
+static uint8_t *write_blob(const params_schema_t *s, const test_params_t *p, size_t *size) {
+  *size = params_blob_size(s, p);
+  uint8_t *buf = (uint8_t *)malloc(*size);
+  check(params_blob_write(s, p, buf, *size) == *size, "taille ecrite");
+  check(params_blob_write(s, p, buf, *size - 1) == 0, "tampon trop petit");
+  return buf;
+}
+
+static void check_round_trip(void) {
+  test_params_t src = {}, dst = {};
+  fill(&src);
+  size_t size;
+  uint8_t *buf = write_blob(&schema_v2, &src, &size);
+  check(!memcmp(buf, PARAMS_BLOB_MAGIC, 4), "magique VPRM");
+
+  set_defaults(&dst);
+  check(params_blob_read(&schema_v2, &dst, buf, size) == PARAMS_BLOB_OK, "relecture v2");
+  check(!strcmp(dst.name, "Dupont") && dst.ssid[0] == NULL && !strcmp(dst.ssid[1], "maison"), "chaines");
+  check(dst.period == 3 && dst.freq[0] == 640 && dst.freq[1] == 1234 && dst.freq[2] == 800, "entiers");
+  check(!dst.colors && dst.mode == 7 && dst.scale == -0.75f && dst.added == -9, "bool, u8, f32");
+
+  // Meme contenu, meme blob (params_commit compare les CRC)
+  size_t size2;
+  uint8_t *buf2 = write_blob(&schema_v2, &dst, &size2);
+  check(size2 == size && !memcmp(buf, buf2, size), "blob identique apres relecture");
+  free(buf2);
+  free(buf);
+
+  // Chaine tronquee a PARAMS_BLOB_STR_MAX
+  char longer[PARAMS_BLOB_STR_MAX + 20];
+  memset(longer, 'a', sizeof(longer) - 1);
+  longer[sizeof(longer) - 1] = '\0';
+  PARAMS_BLOB_STR_SET(&src.name, longer);
+  buf = write_blob(&schema_v2, &src, &size);
+  check(params_blob_read(&schema_v2, &dst, buf, size) == PARAMS_BLOB_OK, "relecture chaine longue");
+  check(strlen(dst.name) == PARAMS_BLOB_STR_MAX, "chaine tronquee");
+  free(buf);
+  free_strings(&src);
+  free_strings(&dst);
+}
+
+static void check_migration(void) {
+  test_params_t src = {}, dst = {};
+  fill(&src);
+  size_t size;
+  uint8_t *buf = write_blob(&schema_v1, &src, &size);
+
+  set_defaults(&dst);
+  migrated_from = 0;
+  check(params_blob_read(&schema_v2, &dst, buf, size) == PARAMS_BLOB_MIGRATED, "v1 -> v2 migre");
+  check(migrated_from == 1, "hook appele avec la version 1");
+  check(dst.period == 30, "conversion du hook");
+  check(dst.added == 42, "champ ajoute par defaut");
+  check(!strcmp(dst.name, "Dupont") && dst.freq[1] == 1234 && dst.scale == -0.75f, "champs v1 relus");
+
+  // Blob v2 relu par un firmware v1
+  free(buf);
+  buf = write_blob(&schema_v2, &src, &size);
+  uint16_t version = 0;
+  check(params_blob_check(&schema_v1, buf, size, &version) == PARAMS_BLOB_TOO_NEW && version == 2, "blob plus recent");
+  free(buf);
+  free_strings(&src);
+  free_strings(&dst);
+}
+
+// Recalcule le CRC apres une modification volontaire de l'entete
+static void fix_crc(uint8_t *buf, size_t size) {
+  params_blob_put32(buf + size - 4, params_blob_crc32(0, buf, size - 4));
+}
+
+static void check_corrupt(void) {
+  test_params_t src = {}, dst = {};
+  fill(&src);
+  set_defaults(&dst);
+  size_t size;
+  uint8_t *buf = write_blob(&schema_v2, &src, &size);
+  uint8_t *bad = (uint8_t *)malloc(size);
+
+  memcpy(bad, buf, size);
+  bad[0] = 'X';
+  check(params_blob_read(&schema_v2, &dst, bad, size) == PARAMS_BLOB_BAD_HEADER, "magique");
+  check(params_blob_read(&schema_v2, &dst, buf, 8) == PARAMS_BLOB_BAD_HEADER, "trop court");
+
+  // Un bit change dans chaque octet de donnees ou de CRC
+  bool all = true;
+  for (size_t i = PARAMS_BLOB_HEADER_SIZE; i < size; i++) {
+    memcpy(bad, buf, size);
+    bad[i] ^= 0x10;
+    all = all && params_blob_read(&schema_v2, &dst, bad, size) == PARAMS_BLOB_BAD_CRC;
+  }
+  check(all, "CRC sur chaque octet");
+
+  check(params_blob_read(&schema_v2, &dst, buf, size - 1) == PARAMS_BLOB_TRUNCATED, "blob tronque");
+
+  // Nombre de champs annonce faux, CRC valide
+  memcpy(bad, buf, size);
+  params_blob_put16(bad + 6, params_blob_get16(bad + 6) + 1);
+  fix_crc(bad, size);
+  check(params_blob_read(&schema_v2, &dst, bad, size) == PARAMS_BLOB_TRUNCATED, "nombre de champs");
+
+  // Version 0, CRC valide
+  memcpy(bad, buf, size);
+  params_blob_put16(bad + 4, 0);
+  fix_crc(bad, size);
+  check(params_blob_read(&schema_v2, &dst, bad, size) == PARAMS_BLOB_BAD_HEADER, "version 0 abimee");
+
+  // Longueur de chaine hors blob, CRC valide
+  memcpy(bad, buf, size);
+  params_blob_put16(bad + PARAMS_BLOB_HEADER_SIZE, 0xFFFF);
+  fix_crc(bad, size);
+  check(params_blob_read(&schema_v2, &dst, bad, size) == PARAMS_BLOB_TRUNCATED, "longueur de chaine");
+
+  free(bad);
+  free(buf);
+  free_strings(&src);
+  free_strings(&dst);
+}
+
+int main(void) {
+  check_round_trip();
+  check_migration();
+  check_corrupt();
+  printf("%s\n", failures ? "ECHEC" : "ok");
+  return failures ? 1 : 0;
+}
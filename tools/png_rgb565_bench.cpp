@@ -0,0 +1,108 @@
+// Banc d'essai PC du decodeur src/png_rgb565.h
+//
+//   g++ -O2 -I. tools/png_rgb565_bench.cpp -o png_bench
+//   ./png_bench [-n 50] [-d] tuile.png [...]
+//
+// Decode chaque PNG n fois (source en memoire) puis une fois en flux par petits
+// morceaux de taille variable (comme le corps HTTP), affiche le temps par tuile
+// et verifie que l'etat du decodeur reste sous PNG_RGB565_WORK_MAX. Si un
+// fichier .bin voisin existe (tools/tile_stub_server.py sample), le resultat
+// sans tramage doit lui etre identique. Code de sortie non nul en cas d'echec.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include "src/png_rgb565.h"
+
+static bool read_file(const std::string &path, std::vector<uint8_t> &data) {
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.insert(data.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+// Source en morceaux de 1 a 1460 octets (segments TCP)
+typedef struct {
+  const uint8_t *data;
+  size_t len;
+  uint32_t seed;
+} chunk_src_t;
+
+static size_t chunk_read(void *user, uint8_t *buf, size_t len) {
+  chunk_src_t *s = (chunk_src_t *)user;
+  s->seed = s->seed * 1103515245u + 12345u;
+  size_t n = 1 + (s->seed >> 16) % 1460;
+  if (n > len) n = len;
+  if (n > s->len) n = s->len;
+  memcpy(buf, s->data, n);
+  s->data += n;
+  s->len -= n;
+  return n;
+}
+
+int main(int argc, char **argv) {
+  int iterations = 50;
+  uint8_t flags = 0;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) iterations = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "-d")) flags |= PNG_RGB565_DITHER;
+    else files.push_back(argv[i]);
+  }
+  if (files.empty() || iterations < 1) {
+    fprintf(stderr, "usage: %s [-n iterations] [-d] file.png...\n", argv[0]);
+    return 2;
+  }
+
+  printf("etat decodeur: %u octets (borne %u)\n", (unsigned)sizeof(png_rgb565_t), (unsigned)PNG_RGB565_WORK_MAX);
+  if (sizeof(png_rgb565_t) > PNG_RGB565_WORK_MAX) return 1;
+
+  static png_rgb565_t dec;
+  int failures = 0;
+  double total_ms = 0;
+  int decoded = 0;
+  for (const std::string &path : files) {
+    std::vector<uint8_t> png;
+    if (!read_file(path, png) || png.size() < 24) {
+      printf("%s: illisible\n", path.c_str());
+      failures++;
+      continue;
+    }
+    uint32_t w = png_get32(&png[16]);
+    uint32_t h = png_get32(&png[20]);
+    std::vector<uint16_t> out((size_t)w * h), streamed((size_t)w * h);
+
+    auto t0 = std::chrono::steady_clock::now();
+    bool ok = true;
+    for (int i = 0; i < iterations && ok; i++) ok = png_rgb565_decode(&dec, png.data(), png.size(), out.data(), w, h, flags);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / iterations;
+
+    chunk_src_t src = { png.data(), png.size(), (uint32_t)png.size() };
+    ok = ok && png_rgb565_decode_stream(&dec, chunk_read, &src, streamed.data(), w, h, flags) && streamed == out;
+
+    const char *ref = "";
+    std::vector<uint8_t> expected;
+    std::string bin = path.substr(0, path.rfind('.')) + ".bin";
+    if (ok && !(flags & PNG_RGB565_DITHER) && read_file(bin, expected)) {
+      ok = expected.size() == out.size() * 2 && memcmp(expected.data(), out.data(), expected.size()) == 0;
+      ref = ok ? ", identique au .bin" : ", different du .bin";
+    }
+    printf("%s: %ux%u %u octets, %.3f ms/tuile%s%s\n", path.c_str(), (unsigned)w, (unsigned)h, (unsigned)png.size(), ms,
+           ref, ok ? "" : " ECHEC");
+    if (!ok) {
+      failures++;
+      continue;
+    }
+    total_ms += ms;
+    decoded++;
+  }
+  if (decoded) printf("moyenne: %.3f ms/tuile sur %d fichiers\n", total_ms / decoded, decoded);
+  return failures ? 1 : 0;
+}
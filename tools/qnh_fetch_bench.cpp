@@ -0,0 +1,203 @@
+// Banc d'essai PC de src/qnh_fetch.h contre tools/qnh_stub_server.py
+//
+//   g++ -O2 -I. tools/qnh_fetch_bench.cpp -o qnh_bench
+//   ./qnh_bench [-n 50] 127.0.0.1 8081
+//
+// Envoie n requetes en reutilisant la connexion (keep-alive) puis n requetes
+// avec une connexion neuve par requete, analyse chaque reponse au fil de
+// l'eau et verifie le QNH attendu du serveur. Affiche la latence moyenne et
+// max de chaque mode et les allocations faites pendant l'analyse (attendu: 0).
+// Verifie aussi la reponse METAR (station la plus proche, age) et le cache
+// par maille (age, expiration, remplacement).
+// Code de sortie non nul en cas d'echec.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "src/qnh_fetch.h"
+#include "src/metar_stations.h"
+
+// Allocations comptees pendant l'analyse (glibc)
+extern "C" void *__libc_malloc(size_t size);
+static bool count_allocs = false;
+static size_t alloc_count = 0;
+static size_t alloc_bytes = 0;
+
+extern "C" void *malloc(size_t size) {
+  if (count_allocs) {
+    alloc_count++;
+    alloc_bytes += size;
+  }
+  return __libc_malloc(size);
+}
+
+static int open_connection(const char *host, int port) {
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) return -1;
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static float expected_qnh(float lat, float lon) {
+  double v = fmod(lat * 7.0 + lon * 3.0, 40.0);
+  if (v < 0) v += 40.0;
+  return (float)(round((1000.0 + v) * 10.0) / 10.0);
+}
+
+// Une requete sur fd; fd ferme et remis a -1 si la connexion n'est pas reutilisable
+static bool fetch_one(int *fd, float lat, float lon, float *qnh) {
+  char req[256];
+  int n = snprintf(req, sizeof(req),
+                   "GET /v1/forecast?latitude=%.4f&longitude=%.4f&current=pressure_msl HTTP/1.1\r\n"
+                   "Host: stub\r\nConnection: keep-alive\r\n\r\n",
+                   lat, lon);
+  if (write(*fd, req, n) != n) return false;
+
+  static qnh_http_t http;
+  qnh_openmeteo_t om = { 0, false };
+  qnh_http_init(&http, qnh_openmeteo_cb, &om);
+  uint8_t buf[256];
+  while (http.state != QNH_HTTP_DONE && http.state != QNH_HTTP_ERROR) {
+    ssize_t r = read(*fd, buf, sizeof(buf));
+    if (r <= 0) {
+      qnh_http_eof(&http);
+      break;
+    }
+    count_allocs = true;
+    qnh_http_feed(&http, buf, r);
+    count_allocs = false;
+  }
+  if (http.state != QNH_HTTP_DONE || http.close) {
+    close(*fd);
+    *fd = -1;
+  }
+  *qnh = om.qnh;
+  return qnh_http_ok(&http) && http.has_date && om.found;
+}
+
+static bool run(const char *host, int port, int count, bool reuse, const char *name) {
+  int fd = -1;
+  double total = 0, worst = 0;
+  int failures = 0, connects = 0;
+  for (int i = 0; i < count; i++) {
+    float lat = 45.0f + i * 0.137f;
+    float lon = 5.0f + i * 0.071f;
+    auto t0 = std::chrono::steady_clock::now();
+    if (!reuse && fd >= 0) {
+      close(fd);
+      fd = -1;
+    }
+    if (fd < 0) {
+      fd = open_connection(host, port);
+      connects++;
+    }
+    float qnh = 0;
+    bool ok = fd >= 0 && fetch_one(&fd, lat, lon, &qnh);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    total += ms;
+    if (ms > worst) worst = ms;
+    if (!ok || fabsf(qnh - expected_qnh(lat, lon)) > 0.05f) {
+      failures++;
+      printf("  %s #%d: %s (QNH %.1f, attendu %.1f)\n", name, i, ok ? "valeur" : "echec", qnh, expected_qnh(lat, lon));
+    }
+  }
+  if (fd >= 0) close(fd);
+  printf("%-10s %d requetes, %d connexions, %.3f ms moyenne, %.3f ms max, %d echecs\n", name, count, connects,
+         total / count, worst, failures);
+  return failures == 0;
+}
+
+// Requete METAR a 2 km de LFLB: station prise telle quelle, observation recente
+static bool check_metar(const char *host, int port) {
+  int fd = open_connection(host, port);
+  if (fd < 0) return false;
+  const char req[] =
+    "GET /api/data/metar?bbox=45.0,5.0,46.5,6.5&format=json HTTP/1.1\r\nHost: stub\r\nConnection: keep-alive\r\n\r\n";
+  bool ok = write(fd, req, sizeof(req) - 1) == (ssize_t)(sizeof(req) - 1);
+
+  static qnh_http_t http;
+  static metar_stations_t st;
+  metar_stations_init(&st, 45.62f, 5.88f);
+  qnh_http_init(&http, metar_stations_cb, &st);
+  uint8_t buf[256];
+  while (ok && http.state != QNH_HTTP_DONE && http.state != QNH_HTTP_ERROR) {
+    ssize_t r = read(fd, buf, sizeof(buf));
+    if (r <= 0) {
+      qnh_http_eof(&http);
+      break;
+    }
+    count_allocs = true;
+    qnh_http_feed(&http, buf, r);
+    count_allocs = false;
+  }
+  close(fd);
+  metar_qnh_t q;
+  ok = ok && qnh_http_ok(&http) &&
+       metar_stations_qnh(&st, http.has_date, http.date_day, http.date_hour, http.date_minute, &q) &&
+       !strcmp(q.station, "LFLB") && q.qnh == roundf(expected_qnh(45.6381f, 5.88013f)) && q.age_min >= 0 &&
+       q.age_min < 30;
+  printf("metar: %u objets, %d stations, %s\n", st.records, st.count, ok ? "ok" : "ECHEC");
+  return ok;
+}
+
+static bool check_cache(void) {
+  static qnh_cache_t cache;
+  memset(&cache, 0, sizeof(cache));
+  float qnh = 0;
+  uint32_t age = 0;
+  bool ok = !qnh_cache_get(&cache, 45.1f, 5.1f, 1000, 60000, &qnh, &age);
+  qnh_cache_put(&cache, 45.1f, 5.1f, 1012.5f, 1000);
+  // Meme maille de 0.25 deg, autre point
+  ok = ok && qnh_cache_get(&cache, 45.2f, 5.2f, 31000, 60000, &qnh, &age) && qnh == 1012.5f && age == 30000;
+  ok = ok && !qnh_cache_get(&cache, 45.3f, 5.1f, 31000, 60000, &qnh, &age);  // Maille voisine
+  ok = ok && !qnh_cache_get(&cache, 45.1f, 5.1f, 62000, 60000, &qnh, &age);  // Trop ancien
+  // Remplissage: la plus ancienne est remplacee
+  for (int i = 1; i <= QNH_CACHE_SIZE; i++) qnh_cache_put(&cache, 45.1f + i, 5.1f, 1000.0f + i, 1000 + i * 10);
+  ok = ok && !qnh_cache_get(&cache, 45.1f, 5.1f, 2000, 60000, &qnh, &age);
+  ok = ok && qnh_cache_get(&cache, 45.1f + QNH_CACHE_SIZE, 5.1f, 2000, 60000, &qnh, &age) &&
+       qnh == 1000.0f + QNH_CACHE_SIZE;
+  printf("cache: %s\n", ok ? "ok" : "ECHEC");
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  int count = 50;
+  const char *host = NULL;
+  int port = 0;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) count = atoi(argv[++i]);
+    else if (!host) host = argv[i];
+    else port = atoi(argv[i]);
+  }
+  if (!host || port <= 0 || count < 1) {
+    fprintf(stderr, "usage: %s [-n requetes] ip port\n", argv[0]);
+    return 2;
+  }
+
+  printf("etat analyseur: %u octets, cache: %u octets\n", (unsigned)sizeof(qnh_http_t), (unsigned)sizeof(qnh_cache_t));
+  bool ok = run(host, port, count, true, "keep-alive");
+  ok = run(host, port, count, false, "nouvelle") && ok;
+  ok = check_metar(host, port) && ok;
+  ok = check_cache() && ok;
+  printf("allocations pendant l'analyse: %u (%u octets)\n", (unsigned)alloc_count, (unsigned)alloc_bytes);
+  return ok && alloc_count == 0 ? 0 : 1;
+}
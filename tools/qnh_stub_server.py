@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Serveur HTTP local imitant l'API Open-Meteo (current=pressure_msl) et l'API
+METAR d'aviationweather.gov (format=json) pour tester la recuperation du QNH
+(src/qnh_fetch.h, src/metar_stations.h) sans acces internet.
+
+Les reponses reprennent la forme des API reelles (champs en plus de ceux lus).
+Le QNH depend de la position:
+  pressure_msl = round(1000 + (latitude * 7 + longitude * 3) % 40, 1)
+Les METAR (quelques aeroports des Alpes du nord, filtres par bbox) portent
+l'heure UTC courante arrondie a la demi-heure et ce QNH arrondi a l'hectopascal.
+
+Usage:
+  qnh_stub_server.py [--port 8081] [--chunked] [--close] [--delay-ms 50] [--fail-rate 0.1]
+  puis: g++ -O2 -I. tools/qnh_fetch_bench.cpp -o qnh_bench && ./qnh_bench 127.0.0.1 8081
+"""
+
+import argparse
+import datetime
+import http.server
+import json
+import random
+import socket
+import sys
+import time
+import urllib.parse
+
+
+STATIONS = [
+    ("LFLB", 45.6381, 5.88013),
+    ("LFLP", 45.9294, 6.09876),
+    ("LFLS", 45.3629, 5.32937),
+    ("LSGG", 46.2381, 6.10895),
+    ("LFLY", 45.7272, 4.9444),
+]
+
+
+def pressure(lat, lon):
+    return round(1000 + (lat * 7 + lon * 3) % 40, 1)
+
+
+def metar_records(lat0, lon0, lat1, lon1):
+    now = datetime.datetime.now(datetime.timezone.utc)
+    obs = now.replace(minute=0 if now.minute < 30 else 30, second=0, microsecond=0)
+    records = []
+    for icao, lat, lon in STATIONS:
+        if not (lat0 <= lat <= lat1 and lon0 <= lon <= lon1):
+            continue
+        qnh = int(round(pressure(lat, lon)))
+        raw = f"METAR {icao} {obs:%d%H%M}Z 34006KT 9999 FEW040 21/12 Q{qnh:04d} NOSIG"
+        records.append({"icaoId": icao, "obsTime": int(obs.timestamp()), "temp": 21, "dewp": 12, "altim": qnh,
+                        "rawOb": raw, "lat": lat, "lon": lon, "elev": 300, "name": f"{icao} stub",
+                        "clouds": [{"cover": "FEW", "base": 4000}]})
+    return records
+
+
+class QnhHandler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # keep-alive
+    options = None
+
+    def setup(self):
+        super().setup()
+        # En-tetes et corps sont ecrits separement: sans ceci l'ACK retarde du
+        # client ajoute ~40 ms a chaque requete sur une connexion conservee
+        self.connection.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+
+    def log_message(self, fmt, *args):
+        pass
+
+    def do_GET(self):
+        opts = self.options
+        url = urllib.parse.urlparse(self.path)
+        query = urllib.parse.parse_qs(url.query)
+        if url.path == "/api/data/metar" and "bbox" in query:
+            lat0, lon0, lat1, lon1 = (float(v) for v in query["bbox"][0].split(","))
+            self.reply(200, json.dumps(metar_records(lat0, lon0, lat1, lon1)).encode())
+            return
+        if url.path != "/v1/forecast" or "latitude" not in query or "longitude" not in query:
+            self.reply(400, json.dumps({"error": True, "reason": "bad request"}).encode())
+            return
+        if opts.delay_ms:
+            time.sleep(opts.delay_ms / 1000.0)
+        if random.random() < opts.fail_rate:
+            self.reply(503, b"stub failure", "text/plain")
+            return
+        lat, lon = float(query["latitude"][0]), float(query["longitude"][0])
+        body = {
+            "latitude": lat,
+            "longitude": lon,
+            "generationtime_ms": 0.03,
+            "utc_offset_seconds": 0,
+            "timezone": "GMT",
+            "elevation": 512.0,
+            "current_units": {"time": "iso8601", "interval": "seconds", "pressure_msl": "hPa"},
+            "current": {"time": "2024-06-01T12:00", "interval": 900, "pressure_msl": pressure(lat, lon)},
+            "hourly": {"pressure_msl": [1012.1, 1012.4, -3.5e1]},
+        }
+        self.reply(200, json.dumps(body).encode())
+
+    def reply(self, code, body, ctype="application/json; charset=utf-8"):
+        self.send_response(code)
+        self.send_header("Content-Type", ctype)
+        if self.options.close:
+            self.send_header("Connection", "close")
+            self.close_connection = True
+        if self.options.chunked:
+            self.send_header("Transfer-Encoding", "chunked")
+            self.end_headers()
+            for i in range(0, len(body), 37):
+                part = body[i:i + 37]
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(part), part))
+            self.wfile.write(b"0\r\n\r\n")
+        else:
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=8081)
+    parser.add_argument("--chunked", action="store_true")
+    parser.add_argument("--close", action="store_true", help="Connection: close apres chaque reponse")
+    parser.add_argument("--delay-ms", type=int, default=0)
+    parser.add_argument("--fail-rate", type=float, default=0.0)
+    args = parser.parse_args()
+
+    QnhHandler.options = args
+    server = http.server.ThreadingHTTPServer(("", args.port), QnhHandler)
+    print(f"QNH sur http://0.0.0.0:{args.port}/v1/forecast", file=sys.stderr)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
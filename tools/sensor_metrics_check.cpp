@@ -0,0 +1,118 @@
+// Verification PC des compteurs src/sensor_metrics.h
+//
+//   g++ -O2 -I. tools/sensor_metrics_check.cpp -o metrics_check
+//   ./metrics_check
+//
+// Verifie les bornes des buckets log2, les compteurs de lecture (succes,
+// echec, sans donnee), l'age et le seuil de peremption, les depassements de
+// boucle et le format du dump binaire (bloc sans padding, uptime insere).
+// Code de sortie non nul en cas d'echec.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "src/sensor_metrics.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (ok) return;
+  failures++;
+  printf("ECHEC %s\n", what);
+}
+
+static void check_buckets(void) {
+  // 0 -> [0,1], k -> [2^(k-1)+1, 2^k]
+  check(sensor_metrics_bucket(0) == 0 && sensor_metrics_bucket(1) == 0, "bucket 0");
+  check(sensor_metrics_bucket(2) == 1, "bucket 1");
+  check(sensor_metrics_bucket(3) == 2 && sensor_metrics_bucket(4) == 2, "bucket 2");
+  check(sensor_metrics_bucket(5) == 3 && sensor_metrics_bucket(8) == 3, "bucket 3");
+  check(sensor_metrics_bucket(1024) == 10 && sensor_metrics_bucket(1025) == 11, "bucket 10/11");
+  check(sensor_metrics_bucket(0xFFFFFFFFu) == METRICS_HIST_BUCKETS - 1, "bucket depassement");
+  for (uint32_t v = 1; v < 100000; v++) {
+    uint8_t b = sensor_metrics_bucket(v);
+    if (b < METRICS_HIST_BUCKETS - 1 && (v > (1u << b) || (b > 0 && v <= (1u << (b - 1))))) {
+      check(false, "bucket monotone");
+      break;
+    }
+  }
+}
+
+static void check_counters(void) {
+  static sensor_metrics_t m;
+  sensor_metrics_reset(&m);
+  check(m.magic == METRICS_MAGIC && m.version == METRICS_VERSION, "en-tete apres reset");
+
+  // BMP390: 3 succes, 1 echec
+  sensor_metrics_record_read(&m, METRICS_SENSOR_BMP390, 900, true);
+  sensor_metrics_record_read(&m, METRICS_SENSOR_BMP390, 1100, true);
+  sensor_metrics_record_read(&m, METRICS_SENSOR_BMP390, 3000, true);
+  sensor_metrics_record_read(&m, METRICS_SENSOR_BMP390, 200, false);
+  sensor_metrics_sensor_t *bmp = &m.sensor[METRICS_SENSOR_BMP390];
+  check(bmp->read_ok == 3 && bmp->read_failed == 1 && bmp->read_empty == 0, "compteurs BMP390");
+  check(bmp->read_us_max == 3000, "duree max BMP390");
+  uint32_t total = 0;
+  for (int b = 0; b < METRICS_HIST_BUCKETS; b++) total += bmp->read_us_hist[b];
+  check(total == 4 && bmp->read_us_hist[sensor_metrics_bucket(1100)] == 1, "histogramme BMP390");
+
+  // BNO080: pas d'evenement en attente compte a part, pas en echec
+  for (int i = 0; i < 9; i++) sensor_metrics_record_empty(&m, METRICS_SENSOR_BNO080, 150);
+  sensor_metrics_record_read(&m, METRICS_SENSOR_BNO080, 400, true);
+  sensor_metrics_sensor_t *bno = &m.sensor[METRICS_SENSOR_BNO080];
+  check(bno->read_ok == 1 && bno->read_failed == 0 && bno->read_empty == 9, "BNO080 sans evenement");
+  check(bno->read_us_hist[sensor_metrics_bucket(150)] == 9 && bno->read_us_max == 400, "duree BNO080");
+
+  // Age: seuil strict, age negatif ramene a 0
+  sensor_metrics_record_age(&m, METRICS_SENSOR_GPS, METRICS_STALE_GPS_MS);
+  sensor_metrics_record_age(&m, METRICS_SENSOR_GPS, METRICS_STALE_GPS_MS + 1);
+  sensor_metrics_record_age(&m, METRICS_SENSOR_GPS, (uint32_t)-3);
+  sensor_metrics_sensor_t *gps = &m.sensor[METRICS_SENSOR_GPS];
+  check(gps->consumed == 3 && gps->stale == 1, "peremption GPS");
+  check(gps->age_ms_hist[0] == 1, "age negatif");
+
+  // Boucle: depassement strict de la periode
+  sensor_metrics_record_loop(&m, METRICS_TASK_KALMAN, 20000, 20000);
+  sensor_metrics_record_loop(&m, METRICS_TASK_KALMAN, 20001, 20000);
+  sensor_metrics_record_loop(&m, METRICS_TASK_KALMAN, 5000, 20000);
+  sensor_metrics_task_t *k = &m.task[METRICS_TASK_KALMAN];
+  check(k->loops == 3 && k->overruns == 1 && k->loop_us_max == 20001, "boucle Kalman");
+  check(m.task[METRICS_TASK_SENSORS].loops == 0, "autre tache intacte");
+}
+
+static void check_serialize(void) {
+  static sensor_metrics_t m;
+  sensor_metrics_reset(&m);
+  sensor_metrics_record_read(&m, METRICS_SENSOR_GPS, 77, true);
+
+  // Uniquement des uint32_t: le decodeur PC lit le bloc tel quel
+  check(sizeof(sensor_metrics_t) % sizeof(uint32_t) == 0, "bloc aligne");
+  check(offsetof(sensor_metrics_t, sensor) == 3 * sizeof(uint32_t), "en-tete 12 octets");
+
+  uint8_t small[16];
+  check(sensor_metrics_serialize(&m, 1, small, sizeof(small)) == 0, "tampon trop petit");
+  check(sensor_metrics_serialize(&m, 1, NULL, 4096) == 0, "tampon nul");
+
+  static uint8_t buf[sizeof(sensor_metrics_t)];
+  size_t n = sensor_metrics_serialize(&m, 123456, buf, sizeof(buf));
+  check(n == sizeof(sensor_metrics_t), "taille du dump");
+  uint32_t magic, uptime;
+  memcpy(&magic, buf, 4);
+  memcpy(&uptime, buf + offsetof(sensor_metrics_t, uptime_ms), 4);
+  check(magic == METRICS_MAGIC && !memcmp(buf, "SMET", 4), "magique SMET");
+  check(uptime == 123456 && m.uptime_ms == 0, "uptime insere sans modifier la source");
+  sensor_metrics_t back;
+  memcpy(&back, buf, sizeof(back));
+  check(back.sensor[METRICS_SENSOR_GPS].read_ok == 1, "relecture du dump");
+  printf("bloc: %u octets\n", (unsigned)sizeof(sensor_metrics_t));
+
+  // Bloc global du firmware: en-tete deja en place avant le premier reset
+  check(g_sensor_metrics.magic == METRICS_MAGIC && g_sensor_metrics.version == METRICS_VERSION, "bloc global initialise");
+}
+
+int main() {
+  check_buckets();
+  check_counters();
+  check_serialize();
+  printf("%s\n", failures ? "ECHEC" : "ok");
+  return failures ? 1 : 0;
+}
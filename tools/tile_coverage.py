@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Construit l'index de couverture des tuiles (coverage.bin) depuis une arborescence
+<racine>/<z>/<x>/<y>.bin, au format lu par src/tile_coverage.h.
+
+Usage:
+  tile_coverage.py build /media/sd/osm_tiles/osm    -> ecrit /media/sd/osm_tiles/osm/coverage.bin
+  tile_coverage.py dump  /media/sd/osm_tiles/osm/coverage.bin
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+VERSION = 1
+MAX_ZOOMS = 20
+MAX_BITMAP_BYTES = 256 * 1024
+FLAG_NO_BITMAP = 0x01
+FLAG_OPEN = 0x02
+TILE_EXT = ".bin"
+
+
+def scan(root):
+    tiles = {}
+    for zname in os.listdir(root):
+        zdir = os.path.join(root, zname)
+        if not zname.isdigit() or not os.path.isdir(zdir):
+            continue
+        z = int(zname)
+        if z >= MAX_ZOOMS:
+            continue
+        for xname in os.listdir(zdir):
+            xdir = os.path.join(zdir, xname)
+            if not xname.isdigit() or not os.path.isdir(xdir):
+                continue
+            x = int(xname)
+            for fname in os.listdir(xdir):
+                stem, ext = os.path.splitext(fname)
+                if ext == TILE_EXT and stem.isdigit():
+                    tiles.setdefault(z, set()).add((x, int(stem)))
+    return tiles
+
+
+def build(tiles):
+    body = b""
+    for z in sorted(tiles):
+        coords = tiles[z]
+        min_x = min(x for x, _ in coords)
+        min_y = min(y for _, y in coords)
+        w = max(x for x, _ in coords) - min_x + 1
+        h = max(y for _, y in coords) - min_y + 1
+        nbytes = (w * h + 7) // 8
+        flags = FLAG_NO_BITMAP if nbytes > MAX_BITMAP_BYTES else 0
+        body += struct.pack("<BBxxIIIII", z, flags, min_x, min_y, w, h, len(coords))
+        if not flags & FLAG_NO_BITMAP:
+            bits = bytearray(nbytes)
+            for x, y in coords:
+                i = (y - min_y) * w + (x - min_x)
+                bits[i >> 3] |= 1 << (i & 7)
+            body += bytes(bits)
+    data = b"TCOV" + struct.pack("<HH", VERSION, len(tiles)) + body
+    return data + struct.pack("<I", zlib.crc32(data) & 0xFFFFFFFF)
+
+
+def dump(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"TCOV" or len(data) < 12:
+        sys.exit("fichier invalide")
+    if zlib.crc32(data[:-4]) & 0xFFFFFFFF != struct.unpack("<I", data[-4:])[0]:
+        sys.exit("CRC invalide")
+    version, count = struct.unpack("<HH", data[4:8])
+    print(f"version {version}, {count} zooms")
+    p = 8
+    for _ in range(count):
+        z, flags, min_x, min_y, w, h, n = struct.unpack("<BBxxIIIII", data[p:p + 24])
+        p += 24
+        if not flags & FLAG_NO_BITMAP:
+            p += (w * h + 7) // 8
+        extra = " sans bitmap" if flags & FLAG_NO_BITMAP else ""
+        extra += " ouvert" if flags & FLAG_OPEN else ""
+        print(f"  z{z}: {n} tuiles, x {min_x}-{min_x + w - 1}, y {min_y}-{min_y + h - 1}{extra}")
+
+
+def main():
+    if len(sys.argv) != 3 or sys.argv[1] not in ("build", "dump"):
+        sys.exit(__doc__)
+    if sys.argv[1] == "dump":
+        dump(sys.argv[2])
+        return
+    root = sys.argv[2]
+    tiles = scan(root)
+    out = os.path.join(root, "coverage.bin")
+    with open(out, "wb") as f:
+        f.write(build(tiles))
+    print(f"{out}: {sum(len(c) for c in tiles.values())} tuiles, {len(tiles)} zooms")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,196 @@
+// Verification PC de l'index de couverture src/tile_coverage.h
+//
+//   g++ -O2 -I. tools/tile_coverage_check.cpp -o tile_coverage_check
+//   ./tile_coverage_check            (depuis la racine du depot: lance python3 tools/tile_coverage.py)
+//
+// Aller-retour construction/serialisation/lecture, puis meme arborescence de
+// tuiles passee a tools/tile_coverage.py: son coverage.bin doit etre lu et
+// identique octet pour octet a celui du firmware, et le fichier du firmware
+// doit etre accepte par "tile_coverage.py dump". Verifie aussi les reponses
+// des requetes (zoom inconnu ABSENT, zoom sans bitmap ou hors plage inconnu,
+// boite ouverte apres ajout) et le rejet d'un fichier abime.
+// Code de sortie non nul en cas d'echec.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "src/tile_coverage.h"
+
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (ok) return;
+  failures++;
+  printf("ECHEC %s\n", what);
+}
+
+typedef struct {
+  int z;
+  uint32_t x, y;
+} tile_t;
+
+// z3: bitmap plein, z12: boite clairsemee, z14: trop etendu (pas de bitmap)
+static const tile_t tiles[] = {
+  { 3, 4, 2 }, { 3, 5, 2 }, { 3, 4, 3 },
+  { 12, 2090, 1460 }, { 12, 2100, 1470 }, { 12, 2095, 1461 }, { 12, 2091, 1469 },
+  { 14, 0, 0 }, { 14, 3000, 1000 },
+};
+#define TILE_COUNT (sizeof(tiles) / sizeof(tiles[0]))
+
+static void build_reference(tile_coverage_t *c) {
+  tile_coverage_builder_t b = {};
+  for (size_t i = 0; i < TILE_COUNT; i++) {
+    tile_coverage_builder_push(&b, tiles[i].z, tiles[i].x, tiles[i].y, 1 << 20);
+  }
+  check(tile_coverage_build(c, &b), "construction");
+  tile_coverage_builder_reset(&b);
+}
+
+static uint8_t *serialize(const tile_coverage_t *c, size_t *len) {
+  *len = tile_coverage_serialized_size(c);
+  uint8_t *buf = (uint8_t *)malloc(*len);
+  if (tile_coverage_serialize(c, buf, *len) != *len) *len = 0;
+  return buf;
+}
+
+static uint8_t *read_file(const char *path, size_t *len) {
+  *len = 0;
+  FILE *f = fopen(path, "rb");
+  if (!f) return NULL;
+  fseek(f, 0, SEEK_END);
+  long n = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  uint8_t *buf = (uint8_t *)malloc(n > 0 ? n : 1);
+  *len = fread(buf, 1, n, f);
+  fclose(f);
+  return buf;
+}
+
+static bool touch(const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  fputs("png", f);
+  fclose(f);
+  return true;
+}
+
+static void check_queries(const tile_coverage_t *c) {
+  check(tile_coverage_query(c, 3, 4, 2) == TILE_COVERAGE_PRESENT, "z3 tuile presente");
+  check(tile_coverage_query(c, 3, 5, 3) == TILE_COVERAGE_ABSENT, "z3 trou dans la boite");
+  check(tile_coverage_query(c, 3, 9, 9) == TILE_COVERAGE_ABSENT, "z3 hors boite");
+  check(tile_coverage_query(c, 12, 2095, 1461) == TILE_COVERAGE_PRESENT, "z12 tuile presente");
+  check(tile_coverage_query(c, 12, 2096, 1461) == TILE_COVERAGE_ABSENT, "z12 tuile absente");
+  check(tile_coverage_query(c, 7, 10, 10) == TILE_COVERAGE_ABSENT, "zoom inconnu absent");
+  check(tile_coverage_query(c, 14, 1, 1) == TILE_COVERAGE_UNKNOWN, "z14 sans bitmap inconnu");
+  check(tile_coverage_query(c, TILE_COVERAGE_MAX_ZOOMS, 0, 0) == TILE_COVERAGE_UNKNOWN, "zoom hors plage");
+}
+
+static void check_round_trip(void) {
+  tile_coverage_t c = {}, r = {};
+  build_reference(&c);
+  check(c.zooms[3].bits && c.zooms[3].tiles == 3, "z3 avec bitmap");
+  check(!c.zooms[14].bits && c.zooms[14].tiles == 2, "z14 sans bitmap");
+  check_queries(&c);
+
+  size_t len;
+  uint8_t *buf = serialize(&c, &len);
+  check(len > 0, "serialisation");
+  check(tile_coverage_parse(&r, buf, len), "relecture");
+  check(tile_coverage_same(&c, &r), "aller-retour identique");
+  check_queries(&r);
+
+  buf[len / 2] ^= 0x40;
+  check(!tile_coverage_parse(&r, buf, len), "CRC abime rejete");
+  check(!r.valid, "couverture vide apres rejet");
+  check(tile_coverage_query(&r, 7, 10, 10) == TILE_COVERAGE_UNKNOWN, "invalide: inconnu");
+  free(buf);
+
+  // Ajout hors boite: reste exact dans la boite, inconnu ailleurs, conserve au fichier
+  tile_coverage_add(&c, 3, 9, 9);
+  tile_coverage_add(&c, 3, 5, 3);
+  check(tile_coverage_query(&c, 3, 5, 3) == TILE_COVERAGE_PRESENT, "ajout dans la boite");
+  check(tile_coverage_query(&c, 3, 8, 8) == TILE_COVERAGE_UNKNOWN, "boite ouverte inconnue");
+  tile_coverage_add(&c, 7, 1, 1);
+  check(tile_coverage_query(&c, 7, 1, 1) == TILE_COVERAGE_UNKNOWN, "ajout sur zoom inconnu");
+  buf = serialize(&c, &len);
+  check(tile_coverage_parse(&r, buf, len) && tile_coverage_same(&c, &r), "drapeau ouvert relu");
+  free(buf);
+
+  tile_coverage_free(&c);
+  tile_coverage_free(&r);
+}
+
+// Meme arborescence pour tools/tile_coverage.py, avec des fichiers a ignorer
+static bool make_tree(const char *root) {
+  char path[256];
+  for (size_t i = 0; i < TILE_COUNT; i++) {
+    snprintf(path, sizeof(path), "%s/%d", root, tiles[i].z);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/%d/%u", root, tiles[i].z, (unsigned)tiles[i].x);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/%d/%u/%u.bin", root, tiles[i].z, (unsigned)tiles[i].x, (unsigned)tiles[i].y);
+    if (!touch(path)) return false;
+  }
+  snprintf(path, sizeof(path), "%s/tmp", root);
+  mkdir(path, 0755);
+  snprintf(path, sizeof(path), "%s/tmp/1", root);
+  mkdir(path, 0755);
+  snprintf(path, sizeof(path), "%s/tmp/1/2.bin", root);
+  if (!touch(path)) return false;
+  snprintf(path, sizeof(path), "%s/3/4/download.job", root);
+  return touch(path);
+}
+
+static void check_python(void) {
+  char root[] = "/tmp/tile_coverage_XXXXXX";
+  if (!mkdtemp(root) || !make_tree(root)) {
+    check(false, "arborescence temporaire");
+    return;
+  }
+
+  char cmd[512], path[256];
+  snprintf(cmd, sizeof(cmd), "python3 tools/tile_coverage.py build %s > /dev/null", root);
+  check(system(cmd) == 0, "tile_coverage.py build");
+
+  tile_coverage_t c = {}, p = {};
+  build_reference(&c);
+  size_t ref_len, py_len;
+  uint8_t *ref = serialize(&c, &ref_len);
+  snprintf(path, sizeof(path), "%s/coverage.bin", root);
+  uint8_t *py = read_file(path, &py_len);
+  check(py != NULL, "coverage.bin ecrit par le script");
+  if (py) {
+    check(tile_coverage_parse(&p, py, py_len), "coverage.bin du script relu");
+    check(tile_coverage_same(&c, &p), "script et firmware: meme couverture");
+    check(py_len == ref_len && memcmp(py, ref, ref_len) == 0, "script et firmware: memes octets");
+    check(tile_coverage_query(&p, 7, 10, 10) == TILE_COVERAGE_ABSENT, "script: zoom inconnu absent");
+    check_queries(&p);
+  }
+
+  // Sens inverse: fichier du firmware relu par le script
+  snprintf(path, sizeof(path), "%s/firmware.bin", root);
+  FILE *f = fopen(path, "wb");
+  if (f) {
+    fwrite(ref, 1, ref_len, f);
+    fclose(f);
+  }
+  snprintf(cmd, sizeof(cmd), "python3 tools/tile_coverage.py dump %s > /dev/null", path);
+  check(f && system(cmd) == 0, "tile_coverage.py dump du fichier firmware");
+
+  free(ref);
+  free(py);
+  tile_coverage_free(&c);
+  tile_coverage_free(&p);
+  snprintf(cmd, sizeof(cmd), "rm -rf %s", root);
+  if (system(cmd) != 0) printf("%s non supprime\n", root);
+}
+
+int main() {
+  check_round_trip();
+  check_python();
+  printf("%s\n", failures ? "ECHEC" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,328 @@
+// Client PC du telechargeur de tuiles, a lancer contre tools/tile_stub_server.py
+//
+//   python3 tools/tile_stub_server.py serve --port 8080 --require-agent [--chunked] [--fail-rate 0.1]
+//   g++ -O2 -I. tools/tile_dl_client.cpp -o tile_dl_client
+//   ./tile_dl_client [-a lat lon km] [-z zmin zmax] [-i ms] [-n] http://127.0.0.1:8080/{z}/{x}/{y}.png
+//
+// Reprend le chemin de src/tile_download_task.h avec le meme code pur: plan de
+// la zone (src/tile_download.h, refus au-dela de TILE_DL_MAX_TILES), expansion
+// d'URL, une seule connexion persistante avec TILE_DL_USER_AGENT, corps lu au
+// fil de l'eau (Content-Length ou chunked via src/http_chunked.h) et decode
+// directement par src/png_rgb565.h, essais TILE_DL_RETRIES, au plus une requete
+// toutes les TILE_DL_MIN_INTERVAL_MS (-i pour changer), fichier de reprise
+// reformate et relu tous les TILE_DL_CHECKPOINT_TILES.
+// Sans -n, chaque tuile est comparee pixel a pixel (sans tramage) a
+// /{z}/{x}/{y}.rgb565 du serveur (tuiles generees seulement, pas --dir).
+// Seul le client HTTP differe de la carte (sockets POSIX au lieu de HTTPClient).
+// Code de sortie non nul si une tuile manque, differe ou si la reprise est fausse.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "constants.h"
+#include "src/tile_download.h"
+#include "src/png_rgb565.h"
+
+#define TILE_PX 256
+
+static int sock = -1;
+static char sock_host[64], sock_port[8];
+static uint32_t connects = 0, requests = 0;
+
+static uint32_t now_ms(void) {
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+// "http://hote:port/chemin"
+static bool split_url(const char *url, char *host, char *port, const char **path) {
+  if (strncmp(url, "http://", 7) != 0) return false;
+  const char *h = url + 7;
+  const char *slash = strchr(h, '/');
+  if (!slash) return false;
+  const char *colon = (const char *)memchr(h, ':', slash - h);
+  const char *hend = colon ? colon : slash;
+  snprintf(host, 64, "%.*s", (int)(hend - h), h);
+  if (colon) snprintf(port, 8, "%.*s", (int)(slash - colon - 1), colon + 1);
+  else strcpy(port, "80");
+  *path = slash;
+  return true;
+}
+
+static void sock_close(void) {
+  if (sock >= 0) close(sock);
+  sock = -1;
+}
+
+static bool sock_open(const char *host, const char *port) {
+  if (sock >= 0 && !strcmp(host, sock_host) && !strcmp(port, sock_port)) return true;
+  sock_close();
+  struct addrinfo hints = {}, *res = NULL;
+  hints.ai_socktype = SOCK_STREAM;
+  if (getaddrinfo(host, port, &hints, &res) != 0) return false;
+  sock = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+  struct timeval tv = { TILE_DL_HTTP_TIMEOUT_MS / 1000, 0 };
+  bool ok = sock >= 0 && setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0 &&
+            connect(sock, res->ai_addr, res->ai_addrlen) == 0;
+  freeaddrinfo(res);
+  if (!ok) {
+    sock_close();
+    return false;
+  }
+  strcpy(sock_host, host);
+  strcpy(sock_port, port);
+  connects++;
+  return true;
+}
+
+// Lecture tamponnee de la connexion
+static uint8_t rx_buf[4096];
+static size_t rx_pos = 0, rx_len = 0;
+
+static int rx_read(uint8_t *buf, size_t len) {
+  if (rx_pos == rx_len) {
+    ssize_t n = recv(sock, rx_buf, sizeof(rx_buf), 0);
+    if (n <= 0) return -1;
+    rx_pos = 0;
+    rx_len = (size_t)n;
+  }
+  size_t n = rx_len - rx_pos < len ? rx_len - rx_pos : len;
+  memcpy(buf, rx_buf + rx_pos, n);
+  rx_pos += n;
+  return (int)n;
+}
+
+static bool rx_line(char *line, size_t size) {
+  size_t o = 0;
+  uint8_t c;
+  while (rx_read(&c, 1) == 1) {
+    if (c == '\n') {
+      if (o && line[o - 1] == '\r') o--;
+      line[o] = '\0';
+      return true;
+    }
+    if (o + 1 < size) line[o++] = (char)c;
+  }
+  return false;
+}
+
+// Corps de la reponse, meme logique que tile_dl_body_t
+typedef struct {
+  long expected;      // -1: inconnu (jusqu'a la fermeture)
+  bool chunked;
+  http_chunked_t dechunk;
+  size_t got;
+  bool closed;
+} body_t;
+
+static bool body_done(const body_t *b) {
+  if (b->chunked) return http_chunked_done(&b->dechunk);
+  return b->expected >= 0 ? b->got == (size_t)b->expected : b->closed;
+}
+
+static size_t body_read(void *user, uint8_t *buf, size_t len) {
+  body_t *b = (body_t *)user;
+  while (!body_done(b) && !b->dechunk.error) {
+    size_t want = len;
+    if (!b->chunked && b->expected >= 0 && want > (size_t)b->expected - b->got) want = b->expected - b->got;
+    int n = rx_read(buf, want);
+    if (n <= 0) {
+      b->closed = true;
+      break;
+    }
+    size_t m = b->chunked ? http_chunked_decode(&b->dechunk, buf, n) : (size_t)n;
+    b->got += m;
+    if (m) return m;
+  }
+  return 0;
+}
+
+// GET sur la connexion persistante; le corps est lu par consume (peut etre NULL)
+static int http_get(const char *url, bool (*consume)(body_t *b, void *user), void *user, bool *consumed) {
+  char host[64], port[8];
+  const char *path;
+  *consumed = false;
+  if (!split_url(url, host, port, &path)) return -1;
+
+  for (int attempt = 0; attempt < 2; attempt++) {  // Connexion fermee par le serveur: une reconnexion
+    if (!sock_open(host, port)) return -1;
+    char req[512];
+    int n = snprintf(req, sizeof(req),
+                     "GET %s HTTP/1.1\r\n"
+                     "Host: %s\r\n"
+                     "User-Agent: " TILE_DL_USER_AGENT "\r\n"
+                     "Connection: keep-alive\r\n\r\n",
+                     path, host);
+    requests++;
+    char line[512];
+    if (send(sock, req, n, MSG_NOSIGNAL) != n || !rx_line(line, sizeof(line))) {
+      sock_close();
+      rx_pos = rx_len = 0;
+      continue;
+    }
+    int code = 0;
+    sscanf(line, "HTTP/%*s %d", &code);
+    body_t b = {};
+    b.expected = -1;
+    bool keep = true;
+    while (rx_line(line, sizeof(line)) && line[0]) {
+      if (!strncasecmp(line, "Content-Length:", 15)) b.expected = atol(line + 15);
+      else if (!strncasecmp(line, "Transfer-Encoding:", 18) && strcasestr(line, "chunked")) b.chunked = true;
+      else if (!strncasecmp(line, "Connection:", 11) && strcasestr(line, "close")) keep = false;
+    }
+    if (code == 200 && consume) *consumed = consume(&b, user);
+    // Reste du corps vide pour garder la connexion (comme tile_dl_fetch)
+    uint8_t tail[256];
+    while (!body_done(&b) && !b.closed && !b.dechunk.error && body_read(&b, tail, sizeof(tail)) > 0) {}
+    if (!body_done(&b) || !keep) {
+      sock_close();
+      rx_pos = rx_len = 0;
+    }
+    return code;
+  }
+  return -1;
+}
+
+typedef struct {
+  png_rgb565_t *dec;
+  uint16_t *tile;
+  std::vector<uint8_t> raw;
+} tile_ctx_t;
+
+static bool consume_png(body_t *b, void *user) {
+  tile_ctx_t *c = (tile_ctx_t *)user;
+  return png_rgb565_decode_stream(c->dec, body_read, b, c->tile, TILE_PX, TILE_PX, 0);
+}
+
+static bool consume_raw(body_t *b, void *user) {
+  tile_ctx_t *c = (tile_ctx_t *)user;
+  uint8_t buf[1024];
+  size_t n;
+  c->raw.clear();
+  while ((n = body_read(b, buf, sizeof(buf))) > 0) c->raw.insert(c->raw.end(), buf, buf + n);
+  return body_done(b);
+}
+
+int main(int argc, char **argv) {
+  double lat = TEST_LAT, lon = TEST_LON, km = 2.0;
+  int z_min = 10, z_max = 13;
+  uint32_t interval = TILE_DL_MIN_INTERVAL_MS;
+  bool verify = true;
+  const char *url = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-a") && i + 3 < argc) {
+      lat = atof(argv[++i]);
+      lon = atof(argv[++i]);
+      km = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "-z") && i + 2 < argc) {
+      z_min = atoi(argv[++i]);
+      z_max = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-i") && i + 1 < argc) {
+      interval = (uint32_t)atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "-n")) {
+      verify = false;
+    } else {
+      url = argv[i];
+    }
+  }
+  if (!url || strlen(url) >= TILE_DL_URL_MAX) {
+    printf("usage: %s [-a lat lon km] [-z zmin zmax] [-i ms] [-n] http://hote:port/{z}/{x}/{y}.png\n", argv[0]);
+    return 2;
+  }
+
+  // Zone comme btn_download_map_cb
+  tile_dl_job_t job = {};
+  double dlat = km / 111.32, dlon = dlat / cos(lat * M_PI / 180.0);
+  job.lat_min = lat - dlat;
+  job.lat_max = lat + dlat;
+  job.lon_min = lon - dlon;
+  job.lon_max = lon + dlon;
+  job.z_min = z_min;
+  job.z_max = z_max;
+  strcpy(job.url, url);
+  tile_dl_plan_t plan;
+  if (!tile_dl_plan(&plan, &job, TILE_DL_MAX_TILES)) {
+    printf("ECHEC zone vide ou plus de %u tuiles\n", (unsigned)TILE_DL_MAX_TILES);
+    return 1;
+  }
+
+  tile_ctx_t ctx;
+  ctx.dec = (png_rgb565_t *)malloc(sizeof(png_rgb565_t));
+  ctx.tile = (uint16_t *)malloc(TILE_PX * TILE_PX * sizeof(uint16_t));
+  uint32_t done = 0, failed = 0, retries = 0, mismatches = 0, resume_errors = 0;
+  uint32_t t_start = now_ms(), t_last = 0;
+
+  for (uint32_t index = 0; index < plan.total; index++) {
+    int z;
+    uint32_t x, y;
+    char tile_url[TILE_DL_URL_MAX + 32];
+    tile_dl_plan_at(&plan, index, &z, &x, &y);
+    tile_dl_expand_url(job.url, z, x, y, 0, tile_url, sizeof(tile_url));
+
+    bool ok = false;
+    int code = 0;
+    for (int attempt = 0; attempt <= TILE_DL_RETRIES && !ok; attempt++) {
+      if (attempt) {
+        retries++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(TILE_DL_RETRY_DELAY_MS));
+      }
+      // Debit limite comme la tache
+      uint32_t since = now_ms() - t_last;
+      if (t_last && since < interval) std::this_thread::sleep_for(std::chrono::milliseconds(interval - since));
+      t_last = now_ms();
+      code = http_get(tile_url, consume_png, &ctx, &ok);
+    }
+    if (!ok) {
+      failed++;
+      printf("ECHEC %s: HTTP %d\n", tile_url, code);
+      continue;
+    }
+    done++;
+
+    if (verify) {
+      char ref_url[TILE_DL_URL_MAX + 48];
+      char *ext = strstr(tile_url, ".png");
+      snprintf(ref_url, sizeof(ref_url), "%.*s.rgb565", (int)(ext ? ext - tile_url : strlen(tile_url)), tile_url);
+      bool got = false;
+      http_get(ref_url, consume_raw, &ctx, &got);
+      if (!got || ctx.raw.size() != TILE_PX * TILE_PX * 2 || memcmp(ctx.raw.data(), ctx.tile, ctx.raw.size()) != 0) {
+        mismatches++;
+        printf("ECHEC pixels differents: %s\n", tile_url);
+      }
+    }
+
+    // Fichier de reprise
+    if ((index + 1) % TILE_DL_CHECKPOINT_TILES == 0) {
+      job.next = index + 1;
+      char text[TILE_DL_URL_MAX + 96];
+      tile_dl_job_t back;
+      tile_dl_job_format(&job, text, sizeof(text));
+      if (!tile_dl_job_parse(&back, text) || back.next != job.next || strcmp(back.url, job.url) != 0 ||
+          back.z_min != job.z_min || back.z_max != job.z_max) {
+        resume_errors++;
+      }
+    }
+  }
+  sock_close();
+
+  uint32_t elapsed = now_ms() - t_start;
+  printf("%u tuiles z%d-%d: %u ok, %u echecs, %u nouveaux essais, %u differentes\n", (unsigned)plan.total, z_min,
+         z_max, done, failed, retries, mismatches);
+  printf("%u requetes sur %u connexion(s), %u ms, %.2f tuiles/s (limite %.2f)\n", requests, connects, elapsed,
+         elapsed ? done * 1000.0 / elapsed : 0.0, interval ? 1000.0 / interval : 0.0);
+  if (resume_errors) printf("ECHEC fichier de reprise: %u relectures fausses\n", resume_errors);
+  free(ctx.dec);
+  free(ctx.tile);
+
+  bool all_ok = !failed && !mismatches && !resume_errors;
+  printf("%s\n", all_ok ? "ok" : "ECHEC");
+  return all_ok ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""Serveur HTTP local de tuiles PNG pour tester le telechargeur (src/tile_download_task.h)
+sans acces internet, et generateur de tuiles de reference pour src/png_rgb565.h.
+
+Les tuiles sont lues dans --dir (<z>/<x>/<y>.png) si elles existent, sinon generees:
+motif dependant de z/x/y, type de couleur et filtres PNG varies selon la tuile.
+
+Usage:
+  tile_stub_server.py serve  [--port 8080] [--dir DIR] [--fail-rate 0.1] [--delay-ms 50] [--chunked]
+                             [--require-agent]
+      URL a configurer: http://<ip du PC>:8080/{z}/{x}/{y}.png
+      /{z}/{x}/{y}.rgb565: pixels RGB565 attendus (tuile generee), pour tools/tile_dl_client.cpp
+      --require-agent: 403 sans User-Agent, comme les serveurs OSM
+  tile_stub_server.py sample z x y out.png
+      ecrit out.png et out.bin (RGB565 petit-boutiste attendu, format des tuiles de la carte)
+      a verifier avec tools/png_rgb565_bench.cpp (decodage et temps par tuile)
+"""
+
+import argparse
+import http.server
+import os
+import random
+import re
+import struct
+import sys
+import time
+import zlib
+
+TILE = 256
+COLOR_GRAY, COLOR_RGB, COLOR_PALETTE, COLOR_RGBA = 0, 2, 3, 6
+
+
+def chunk(kind, data):
+    body = kind + data
+    return struct.pack(">I", len(data)) + body + struct.pack(">I", zlib.crc32(body) & 0xFFFFFFFF)
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def filter_row(kind, row, prev, bpp):
+    out = bytearray(len(row))
+    for i, v in enumerate(row):
+        a = row[i - bpp] if i >= bpp else 0
+        b = prev[i]
+        c = prev[i - bpp] if i >= bpp else 0
+        pred = (0, a, b, (a + b) >> 1, paeth(a, b, c))[kind]
+        out[i] = (v - pred) & 0xFF
+    return bytes([kind]) + bytes(out)
+
+
+def encode_png(width, height, color, rows, palette=None, level=6, idat_split=0):
+    channels = {COLOR_GRAY: 1, COLOR_RGB: 3, COLOR_PALETTE: 1, COLOR_RGBA: 4}[color]
+    prev = bytes(width * channels)
+    raw = b""
+    for y, row in enumerate(rows):
+        raw += filter_row(y % 5, row, prev, channels)
+        prev = row
+    data = zlib.compress(raw, level)
+    out = b"\x89PNG\r\n\x1a\n" + chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, color, 0, 0, 0))
+    if palette is not None:
+        out += chunk(b"PLTE", b"".join(bytes(c) for c in palette))
+    step = idat_split or len(data)
+    for i in range(0, len(data), step):
+        out += chunk(b"IDAT", data[i:i + step])
+    return out + chunk(b"IEND", b"")
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def over_white(c, a):
+    return (c * a + 255 * (255 - a) + 127) // 255
+
+
+def make_tile(z, x, y):
+    """Retourne (png, pixels RGB565 attendus)."""
+    def pixel(px, py):
+        r = (px * 3 + x * 37) & 0xFF
+        g = (py * 5 + y * 53) & 0xFF
+        b = ((px ^ py) + z * 29) & 0xFF
+        return r, g, b
+
+    kind = (x + y) % 4
+    rows, expected = [], []
+    palette = None
+    if kind == 0:
+        color = COLOR_RGB
+        for py in range(TILE):
+            row = bytearray()
+            for px in range(TILE):
+                r, g, b = pixel(px, py)
+                row += bytes((r, g, b))
+                expected.append(rgb565(r, g, b))
+            rows.append(bytes(row))
+    elif kind == 1:
+        color = COLOR_PALETTE
+        palette = [((i * 7) & 0xFF, (i * 13) & 0xFF, (255 - i) & 0xFF) for i in range(256)]
+        for py in range(TILE):
+            row = bytes(((px >> 2) + (py >> 2) + z) & 0xFF for px in range(TILE))
+            expected.extend(rgb565(*palette[i]) for i in row)
+            rows.append(row)
+    elif kind == 2:
+        color = COLOR_RGBA
+        for py in range(TILE):
+            row = bytearray()
+            for px in range(TILE):
+                r, g, b = pixel(px, py)
+                a = 255 if (px // 32 + py // 32) % 2 else (px + py) & 0xFF
+                row += bytes((r, g, b, a))
+                expected.append(rgb565(over_white(r, a), over_white(g, a), over_white(b, a)))
+            rows.append(bytes(row))
+    else:
+        color = COLOR_GRAY
+        for py in range(TILE):
+            row = bytes(pixel(px, py)[0] for px in range(TILE))
+            expected.extend(rgb565(v, v, v) for v in row)
+            rows.append(row)
+
+    png = encode_png(TILE, TILE, color, rows, palette, level=(x + y + z) % 10, idat_split=8192 if kind == 2 else 0)
+    return png, expected
+
+
+class TileHandler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # keep-alive
+    options = None
+
+    def do_GET(self):
+        opts = self.options
+        m = re.match(r"^/(\d+)/(\d+)/(\d+)(\.png|\.rgb565)?$", self.path.split("?")[0])
+        if not m:
+            self.reply(404, b"not found")
+            return
+        if opts.require_agent and not self.headers.get("User-Agent"):
+            self.reply(403, b"user agent required")
+            return
+        z, x, y = (int(v) for v in m.groups()[:3])
+        if m.group(4) == ".rgb565":
+            expected = make_tile(z, x, y)[1]
+            self.reply(200, struct.pack(f"<{len(expected)}H", *expected), "application/octet-stream")
+            return
+        if opts.delay_ms:
+            time.sleep(opts.delay_ms / 1000.0)
+        if random.random() < opts.fail_rate:
+            self.reply(503, b"stub failure")
+            return
+        path = os.path.join(opts.dir, str(z), str(x), f"{y}.png") if opts.dir else ""
+        if path and os.path.exists(path):
+            with open(path, "rb") as f:
+                body = f.read()
+        else:
+            body = make_tile(z, x, y)[0]
+        self.reply(200, body, "image/png")
+
+    def reply(self, code, body, ctype="text/plain"):
+        self.send_response(code)
+        self.send_header("Content-Type", ctype)
+        if self.options.chunked:
+            self.send_header("Transfer-Encoding", "chunked")
+            self.end_headers()
+            for i in range(0, len(body), 4000):
+                part = body[i:i + 4000]
+                self.wfile.write(b"%x\r\n%s\r\n" % (len(part), part))
+            self.wfile.write(b"0\r\n\r\n")
+        else:
+            self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            self.wfile.write(body)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+    serve = sub.add_parser("serve")
+    serve.add_argument("--port", type=int, default=8080)
+    serve.add_argument("--dir", default="")
+    serve.add_argument("--fail-rate", type=float, default=0.0)
+    serve.add_argument("--delay-ms", type=int, default=0)
+    serve.add_argument("--chunked", action="store_true")
+    serve.add_argument("--require-agent", action="store_true")
+    sample = sub.add_parser("sample")
+    sample.add_argument("z", type=int)
+    sample.add_argument("x", type=int)
+    sample.add_argument("y", type=int)
+    sample.add_argument("out")
+    args = parser.parse_args()
+
+    if args.cmd == "sample":
+        png, expected = make_tile(args.z, args.x, args.y)
+        with open(args.out, "wb") as f:
+            f.write(png)
+        with open(os.path.splitext(args.out)[0] + ".bin", "wb") as f:
+            f.write(struct.pack(f"<{len(expected)}H", *expected))
+        return
+
+    TileHandler.options = args
+    server = http.server.ThreadingHTTPServer(("", args.port), TileHandler)
+    print(f"tuiles sur http://0.0.0.0:{args.port}/{{z}}/{{x}}/{{y}}.png", file=sys.stderr)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
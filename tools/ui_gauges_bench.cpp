@@ -0,0 +1,358 @@
+// Banc PC des instruments dessines (src/ui/ui_gauges.h)
+//
+//   g++ -O2 -I. tools/ui_gauges_bench.cpp -o gauges_bench
+//   ./gauges_bench
+//
+// Rejoue 10 minutes de vol simule (cycles thermique / transition, perte de
+// donnees de 2 s) a la cadence UI_FLIGHT_UPDATE_PERIOD_MS sur la barre vario,
+// l'aiguille et la bande altitude. Pour chaque mise a jour, les zones
+// invalidees sont calculees avec les fonctions de src/ui/ui_gauge_geom.h
+// utilisees par les setters, puis redessinees seules dans un framebuffer
+// RGB565 logiciel (memes primitives que les callbacks DRAW_MAIN: rectangles
+// arrondis, lignes epaisses, bouts ronds de l'aiguille; les chiffres de la
+// bande sont remplaces par un bloc de meme emprise).
+//
+// Affiche pixels et temps par mise a jour, incremental contre objet entier,
+// et compare a chaque mise a jour le rendu incremental a un rendu complet:
+// un pixel different signale une zone d'invalidation trop petite (code de
+// sortie non nul). Le rendu LVGL lui-meme (anti-crenelage, polices, cache
+// de couches) n'est pas mesure ici.
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <chrono>
+
+#include "constants.h"
+#include "src/ui/ui_gauge_geom.h"
+
+// Constantes des callbacks de src/ui/ui_gauges.h
+#define GAUGE_COLOR_BG 0x222222
+#define GAUGE_COLOR_BORDER 0x555555
+#define GAUGE_COLOR_SCALE 0xAAAAAA
+#define GAUGE_BAR_PAD 3
+#define GAUGE_NEEDLE_WIDTH 6
+#define GAUGE_TAPE_TICK_M 10
+#define GAUGE_TAPE_LABEL_M 50
+
+#define BENCH_COLOR_PARENT 0x1A1A1A
+#define BENCH_COLOR_TAPE_REF 0x00D4FF
+#define BENCH_BAR_W 480
+#define BENCH_BAR_H 40
+#define BENCH_FLIGHT_S 600
+
+static int failures = 0;
+
+// --- Framebuffer et primitives ----------------------------------------------
+
+typedef struct {
+  int32_t w, h;
+  std::vector<uint16_t> px;
+} canvas_t;
+
+static uint16_t rgb565(uint32_t c) {
+  return (uint16_t)(((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F));
+}
+
+static void canvas_init(canvas_t *c, int32_t w, int32_t h) {
+  c->w = w;
+  c->h = h;
+  c->px.assign((size_t)w * h, 0);
+}
+
+// Zone dessinable = clip borne a l'objet
+static bool clip_to(const canvas_t *c, const gauge_rect_t *clip, gauge_rect_t *out) {
+  out->x1 = clip->x1 < 0 ? 0 : clip->x1;
+  out->y1 = clip->y1 < 0 ? 0 : clip->y1;
+  out->x2 = clip->x2 >= c->w ? c->w - 1 : clip->x2;
+  out->y2 = clip->y2 >= c->h ? c->h - 1 : clip->y2;
+  return !gauge_rect_empty(out);
+}
+
+static int64_t rect_area(const canvas_t *c, const gauge_rect_t *r) {
+  gauge_rect_t a;
+  if (!clip_to(c, r, &a)) return 0;
+  return (int64_t)(a.x2 - a.x1 + 1) * (a.y2 - a.y1 + 1);
+}
+
+// Pixel dans un rectangle arrondi (rayon borne a la demi-largeur, comme LVGL)
+static bool in_round_rect(int32_t x, int32_t y, const gauge_rect_t *r, int32_t radius) {
+  if (x < r->x1 || x > r->x2 || y < r->y1 || y > r->y2) return false;
+  int32_t w = r->x2 - r->x1 + 1, h = r->y2 - r->y1 + 1;
+  int32_t m = (w < h ? w : h) / 2;
+  if (radius > m) radius = m;
+  if (radius <= 0) return true;
+  int32_t cx = x < r->x1 + radius ? r->x1 + radius : (x > r->x2 - radius ? r->x2 - radius : x);
+  int32_t cy = y < r->y1 + radius ? r->y1 + radius : (y > r->y2 - radius ? r->y2 - radius : y);
+  int32_t dx = x - cx, dy = y - cy;
+  return dx * dx + dy * dy <= radius * radius;
+}
+
+static void fill_round_rect(canvas_t *c, const gauge_rect_t *clip, const gauge_rect_t *r, int32_t radius,
+                            uint32_t color) {
+  gauge_rect_t a;
+  if (!clip_to(c, clip, &a)) return;
+  uint16_t v = rgb565(color);
+  for (int32_t y = a.y1 > r->y1 ? a.y1 : r->y1; y <= a.y2 && y <= r->y2; y++) {
+    for (int32_t x = a.x1 > r->x1 ? a.x1 : r->x1; x <= a.x2 && x <= r->x2; x++) {
+      if (in_round_rect(x, y, r, radius)) c->px[(size_t)y * c->w + x] = v;
+    }
+  }
+}
+
+// Fond + cadre 1 px d'un objet (lv_draw_rect avec bordure)
+static void draw_frame(canvas_t *c, const gauge_rect_t *clip, uint32_t bg, uint32_t border, int32_t radius) {
+  gauge_rect_t all = { 0, 0, c->w - 1, c->h - 1 };
+  gauge_rect_t in = { 1, 1, c->w - 2, c->h - 2 };
+  fill_round_rect(c, clip, &all, radius, border);
+  fill_round_rect(c, clip, &in, radius - 1, bg);
+}
+
+// Ligne epaisse: bouts carres (rond = false) ou ronds
+static void draw_line(canvas_t *c, const gauge_rect_t *clip, int32_t x1, int32_t y1, int32_t x2, int32_t y2,
+                      int32_t width, bool round, uint32_t color) {
+  float hw = width / 2.0f + 0.5f;  // Frange d'anti-crenelage comprise
+  int32_t m = (int32_t)ceilf(hw);
+  gauge_rect_t box = { (x1 < x2 ? x1 : x2) - m, (y1 < y2 ? y1 : y2) - m, (x1 > x2 ? x1 : x2) + m,
+                       (y1 > y2 ? y1 : y2) + m };
+  gauge_rect_t a;
+  if (!clip_to(c, clip, &a)) return;
+  if (box.x1 > a.x1) a.x1 = box.x1;
+  if (box.y1 > a.y1) a.y1 = box.y1;
+  if (box.x2 < a.x2) a.x2 = box.x2;
+  if (box.y2 < a.y2) a.y2 = box.y2;
+
+  float dx = (float)(x2 - x1), dy = (float)(y2 - y1);
+  float len2 = dx * dx + dy * dy;
+  uint16_t v = rgb565(color);
+  for (int32_t y = a.y1; y <= a.y2; y++) {
+    for (int32_t x = a.x1; x <= a.x2; x++) {
+      float t = len2 > 0 ? ((x - x1) * dx + (y - y1) * dy) / len2 : 0.0f;
+      if (!round && (t < 0.0f || t > 1.0f)) continue;
+      if (t < 0.0f) t = 0.0f;
+      if (t > 1.0f) t = 1.0f;
+      float ex = x1 + t * dx - x, ey = y1 + t * dy - y;
+      if (ex * ex + ey * ey <= hw * hw) c->px[(size_t)y * c->w + x] = v;
+    }
+  }
+}
+
+static void clear(canvas_t *c, const gauge_rect_t *clip) {
+  gauge_rect_t all = { 0, 0, c->w - 1, c->h - 1 };
+  fill_round_rect(c, clip, &all, 0, BENCH_COLOR_PARENT);
+}
+
+// --- Instruments (etat + rendu, comme ui_gauge_t et les callbacks) ----------
+
+typedef struct {
+  float range;
+  uint32_t color;
+  bool valid;
+  int32_t lo, hi;
+  int32_t step;
+  int32_t offset;
+  gauge_needle_geom_t *needle;
+} gauge_state_t;
+
+static void bar_draw(canvas_t *c, const gauge_state_t *g, const gauge_rect_t *clip) {
+  clear(c, clip);
+  draw_frame(c, clip, GAUGE_COLOR_BG, GAUGE_COLOR_BORDER, 5);
+  if (g->valid && g->hi > g->lo) {
+    gauge_rect_t a = { GAUGE_BAR_PAD + g->lo, GAUGE_BAR_PAD, GAUGE_BAR_PAD + g->hi - 1, c->h - 1 - GAUGE_BAR_PAD };
+    fill_round_rect(c, clip, &a, 3, g->color);
+  }
+  int32_t center = GAUGE_BAR_PAD + (c->w - 2 * GAUGE_BAR_PAD) / 2;
+  gauge_rect_t m = { center, 1, center, c->h - 2 };
+  fill_round_rect(c, clip, &m, 0, GAUGE_COLOR_SCALE);
+}
+
+// Copie de ui_vario_bar_set: zones a redessiner
+static int bar_set(gauge_state_t *g, int32_t w, int32_t h, bool valid, float value, uint32_t color,
+                   gauge_rect_t *dirty) {
+  int32_t inner_w = w - 2 * GAUGE_BAR_PAD;
+  int32_t lo = inner_w / 2, hi = inner_w / 2;
+  if (valid) gauge_bar_span(value, g->range, inner_w, &lo, &hi);
+  int n = gauge_bar_dirty(g->lo, g->hi, lo, hi, color != g->color, GAUGE_BAR_PAD, h, &dirty[0]) ? 1 : 0;
+  g->lo = lo;
+  g->hi = hi;
+  g->color = color;
+  g->valid = valid;
+  return n;
+}
+
+static void needle_draw(canvas_t *c, const gauge_state_t *g, const gauge_rect_t *clip) {
+  clear(c, clip);
+  int32_t cx = c->w / 2, cy = c->h / 2;
+  const gauge_needle_geom_t *n = g->needle;
+  for (int v = -(int)n->range; v <= (int)n->range; v++) {
+    int32_t s = gauge_needle_step(n, (float)v);
+    bool major = (v % 5) == 0;
+    draw_line(c, clip, cx + n->x_out[s] * (major ? 6 : 7) / 8, cy + n->y_out[s] * (major ? 6 : 7) / 8,
+              cx + n->x_out[s], cy + n->y_out[s], major ? 3 : 1, false, GAUGE_COLOR_SCALE);
+  }
+  if (g->valid) {
+    draw_line(c, clip, cx + n->x_in[g->step], cy + n->y_in[g->step], cx + n->x_out[g->step] * 7 / 8,
+              cy + n->y_out[g->step] * 7 / 8, GAUGE_NEEDLE_WIDTH, true, g->color);
+  }
+}
+
+// Copie de ui_vario_needle_set
+static int needle_set(gauge_state_t *g, int32_t w, int32_t h, bool valid, float value, uint32_t color,
+                      gauge_rect_t *dirty) {
+  int32_t step = gauge_needle_step(g->needle, value);
+  if (step == g->step && valid == g->valid && color == g->color) return 0;
+  int n = 0;
+  if (g->valid) dirty[n++] = gauge_needle_bbox(g->needle, g->step, w / 2, h / 2, GAUGE_NEEDLE_WIDTH);
+  if (valid) dirty[n++] = gauge_needle_bbox(g->needle, step, w / 2, h / 2, GAUGE_NEEDLE_WIDTH);
+  g->step = step;
+  g->valid = valid;
+  g->color = color;
+  return n;
+}
+
+static void tape_draw(canvas_t *c, const gauge_state_t *g, const gauge_rect_t *clip) {
+  clear(c, clip);
+  int32_t w = c->w, h = c->h;
+  draw_frame(c, clip, GAUGE_COLOR_BG, GAUGE_COLOR_BORDER, 5);
+  if (!g->valid) return;
+
+  float px_per_m = g->range;
+  int32_t mark = gauge_tape_first_mark(g->offset, px_per_m, h, GAUGE_TAPE_TICK_M);
+  for (;; mark += GAUGE_TAPE_TICK_M) {
+    int32_t y = gauge_tape_y(mark, px_per_m, g->offset, h);
+    if (y < 0) break;
+    if (y >= h) continue;
+    bool major = (mark % GAUGE_TAPE_LABEL_M) == 0;
+    draw_line(c, clip, 1, y, major ? w / 3 : w / 6, y, major ? 2 : 1, false, GAUGE_COLOR_SCALE);
+    if (major) {
+      // Emprise d'un libelle 4 chiffres en police petite
+      gauge_rect_t a = { w / 3 + 6, y - 7, w / 3 + 6 + 40, y + 7 };
+      fill_round_rect(c, clip, &a, 0, 0xFFFFFF);
+    }
+  }
+  draw_line(c, clip, 1, h / 2, w - 2, h / 2, 3, false, g->color);
+}
+
+// Copie de ui_altitude_tape_set: l'objet entier si le decalage change
+static int tape_set(gauge_state_t *g, int32_t w, int32_t h, bool valid, float altitude, uint32_t color,
+                    gauge_rect_t *dirty) {
+  (void)color;
+  int32_t offset = valid ? gauge_tape_offset(altitude, g->range) : g->offset;
+  if (offset == g->offset && valid == g->valid) return 0;
+  g->offset = offset;
+  g->valid = valid;
+  dirty[0] = { 0, 0, w - 1, h - 1 };
+  return 1;
+}
+
+// --- Vol simule ---------------------------------------------------------------
+
+typedef struct {
+  float t, altitude, vario_int;
+  uint32_t seed;
+} flight_t;
+
+static float noise(uint32_t *seed) {
+  *seed = *seed * 1664525u + 1013904223u;
+  return ((*seed >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+}
+
+// Thermique oscillant 60 s puis transition 60 s, vario integre sur ~10 s
+static void flight_step(flight_t *f, float dt) {
+  float phase = fmodf(f->t, 120.0f);
+  float vario = (phase < 60.0f) ? 2.5f + 1.5f * sinf(phase * 2.0f * (float)M_PI / 8.0f) : -1.2f;
+  vario += 0.3f * noise(&f->seed);
+  f->t += dt;
+  f->altitude += vario * dt;
+  f->vario_int += (vario - f->vario_int) * dt / 10.0f;
+}
+
+static uint32_t vario_color(float vario) {
+  if (vario <= -10.0f) return 0x00004D;
+  if (vario <= -5.0f) return 0x0000AA;
+  if (vario <= 0.0f) return 0x0055FF;
+  if (vario <= 2.0f) return 0x00DD00;
+  if (vario <= 5.0f) return 0xFF8800;
+  return 0xDD0000;
+}
+
+// --- Banc -----------------------------------------------------------------------
+
+typedef void (*draw_fn_t)(canvas_t *, const gauge_state_t *, const gauge_rect_t *);
+typedef int (*set_fn_t)(gauge_state_t *, int32_t, int32_t, bool, float, uint32_t, gauge_rect_t *);
+
+static void bench_gauge(const char *name, int32_t w, int32_t h, gauge_state_t g, draw_fn_t draw, set_fn_t set,
+                        bool altitude) {
+  canvas_t inc, full;
+  canvas_init(&inc, w, h);
+  canvas_init(&full, w, h);
+  gauge_rect_t all = { 0, 0, w - 1, h - 1 };
+  draw(&inc, &g, &all);
+
+  flight_t f = { 0.0f, 1200.0f, 0.0f, 12345 };
+  const float dt = UI_FLIGHT_UPDATE_PERIOD_MS / 1000.0f;
+  const uint32_t updates = BENCH_FLIGHT_S * 1000 / UI_FLIGHT_UPDATE_PERIOD_MS;
+  uint32_t redraws = 0, mismatches = 0;
+  int64_t px_sum = 0, px_max = 0;
+  double inc_s = 0, full_s = 0;
+
+  for (uint32_t i = 0; i < updates; i++) {
+    flight_step(&f, dt);
+    // Perte des donnees pendant 2 s a mi-vol
+    bool valid = !(f.t >= 300.0f && f.t < 302.0f);
+    float value = altitude ? f.altitude : f.vario_int;
+
+    gauge_rect_t dirty[2];
+    int n = set(&g, w, h, valid, value, vario_color(f.vario_int), dirty);
+    if (n) redraws++;
+
+    int64_t px = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < n; k++) draw(&inc, &g, &dirty[k]);
+    auto t1 = std::chrono::steady_clock::now();
+    draw(&full, &g, &all);
+    auto t2 = std::chrono::steady_clock::now();
+    inc_s += std::chrono::duration<double>(t1 - t0).count();
+    full_s += std::chrono::duration<double>(t2 - t1).count();
+
+    for (int k = 0; k < n; k++) px += rect_area(&inc, &dirty[k]);
+    px_sum += px;
+    if (px > px_max) px_max = px;
+    if (inc.px != full.px) {
+      if (!mismatches) printf("%s: ecart au rendu complet a t=%.1f s\n", name, f.t);
+      mismatches++;
+      inc.px = full.px;
+    }
+  }
+
+  int64_t px_full = (int64_t)w * h;
+  printf("%s %dx%d: %u maj, %u redessins, %.0f px/maj (max %lld, objet %lld, %.1f%%), %.1f us/maj (objet entier "
+         "%.1f us), %u ecarts\n",
+         name, w, h, updates, redraws, (double)px_sum / updates, (long long)px_max, (long long)px_full,
+         100.0 * px_sum / ((double)px_full * updates), inc_s * 1e6 / updates, full_s * 1e6 / updates, mismatches);
+  if (mismatches) failures++;
+}
+
+int main() {
+  gauge_state_t bar = {};
+  bar.range = UI_GAUGE_VARIO_RANGE;
+  bench_gauge("barre", BENCH_BAR_W, BENCH_BAR_H, bar, bar_draw, bar_set, false);
+
+  static gauge_needle_geom_t geom;
+  gauge_needle_init(&geom, UI_GAUGE_NEEDLE_SIZE / 10, UI_GAUGE_NEEDLE_SIZE / 2 - 4, UI_GAUGE_VARIO_RANGE);
+  gauge_state_t needle = {};
+  needle.range = UI_GAUGE_VARIO_RANGE;
+  needle.needle = &geom;
+  needle.step = gauge_needle_step(&geom, 0.0f);
+  bench_gauge("aiguille", UI_GAUGE_NEEDLE_SIZE, UI_GAUGE_NEEDLE_SIZE, needle, needle_draw, needle_set, false);
+
+  gauge_state_t tape = {};
+  tape.range = UI_GAUGE_TAPE_PX_PER_M;
+  tape.color = BENCH_COLOR_TAPE_REF;
+  tape.offset = INT32_MIN;
+  bench_gauge("bande", UI_GAUGE_TAPE_W, UI_GAUGE_TAPE_H, tape, tape_draw, tape_set, true);
+
+  printf("%s\n", failures ? "ECHEC" : "ok");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,407 @@
+// Verification PC de la machine a etats src/wifi_manager.h avec une radio
+// simulee
+//
+//   g++ -O2 -I. tools/wifi_manager_check.cpp -o wifi_check
+//   ./wifi_check
+//
+// La radio simulee est jouee avec deux jeux de durees: celles mesurees sur
+// l'ESP32-S3 (scan actif ~1.3 s, association + DHCP ~1.2 s, 0.6 s avec
+// BSSID/canal connus, refus du mot de passe ~1.5 s, point d'acces absent
+// ~2 s) et un jeu pessimiste (+50 %, point d'acces lent). Le temps avance par
+// pas de 20 ms (periode de wifi_task). Verifie le choix du reseau, le repli
+// sur le candidat suivant, la reconnexion rapide, l'attente entre deux scans,
+// la distinction refus / point d'acces absent et l'etat conserve en NVS.
+// Code de sortie non nul en cas d'echec.
+//
+// Les temps sont verifies pour chaque jeu par rapport a la somme des phases
+// radio (scan, essais) plus deux pas de scrutation: le gestionnaire n'ajoute
+// pas d'attente. L'objectif absolu (moins de 3 s) n'est asserte qu'avec les
+// durees mesurees; sur le vario, wifi_task affiche le temps reel de chaque
+// connexion en DEBUG_MODE. Exception: le premier essai apres un mot de passe
+// refuse (scan + refus + association, ~3.4 s), le refus ne se voit qu'apres la
+// poignee de main. Le refus est conserve en NVS: le reseau passe en dernier
+// et les demarrages suivants, meme apres redemarrage, repassent sous 3 s.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "src/wifi_manager.h"
+
+#define SIM_STEP_MS 20
+#define SIM_SLACK_MS (2 * SIM_STEP_MS)
+#define SIM_APS_MAX 8
+
+typedef struct {
+  const char *name;
+  uint32_t scan, assoc, assoc_fast, auth_fail, no_ap;
+  bool measured;                      // Durees relevees sur la carte: objectif 3 s asserte
+} sim_profile_t;
+
+static const sim_profile_t profiles[] = {
+  { "mesure", 1300, 1200, 600, 1500, 2000, true },
+  { "pessimiste", 1950, 1800, 900, 2250, 3000, false },
+};
+static const sim_profile_t *prof = &profiles[0];
+
+typedef struct {
+  const char *ssid;
+  const char *pass;
+  uint8_t bssid_last;
+  uint8_t channel;
+  int8_t rssi;
+  bool present;
+} sim_ap_t;
+
+typedef struct {
+  uint32_t now;
+  sim_ap_t aps[SIM_APS_MAX];
+  int ap_count;
+  // Scan
+  bool scanning;
+  uint32_t scan_end;
+  bool scan_ready;
+  int scans;
+  // Connexion
+  int target;                         // Point d'acces vise, -1: aucun
+  bool target_ok;
+  uint32_t link_at;
+  wifi_link_t link;
+  int connects;
+  bool last_fast;
+  // Evenements recus
+  int ev_connected, ev_lost, ev_failed;
+  uint32_t ev_time;
+} sim_radio_t;
+
+static sim_radio_t sim;
+static wifi_mgr_t mgr;
+static int failures = 0;
+
+static void check(bool ok, const char *what) {
+  if (ok) return;
+  failures++;
+  printf("ECHEC %s [%s] (t=%u ms, etat %d)\n", what, prof->name, (unsigned)sim.now, (int)mgr.state);
+}
+
+static bool sim_scan_start(void *user) {
+  sim_radio_t *r = (sim_radio_t *)user;
+  r->scanning = true;
+  r->scan_ready = false;
+  r->scan_end = r->now + prof->scan;
+  r->scans++;
+  return true;
+}
+
+static int sim_scan_count(void *user) {
+  sim_radio_t *r = (sim_radio_t *)user;
+  if (!r->scan_ready) return r->scanning ? -1 : -2;
+  int n = 0;
+  for (int i = 0; i < r->ap_count; i++) n += r->aps[i].present;
+  return n;
+}
+
+static bool sim_scan_get(void *user, int i, wifi_mgr_ap_t *ap) {
+  sim_radio_t *r = (sim_radio_t *)user;
+  for (int k = 0; k < r->ap_count; k++) {
+    if (!r->aps[k].present || i--) continue;
+    memset(ap, 0, sizeof(*ap));
+    strncpy(ap->ssid, r->aps[k].ssid, sizeof(ap->ssid) - 1);
+    ap->bssid[5] = r->aps[k].bssid_last;
+    ap->channel = r->aps[k].channel;
+    ap->rssi = r->aps[k].rssi;
+    return true;
+  }
+  return false;
+}
+
+static void sim_scan_free(void *user) {
+  sim_radio_t *r = (sim_radio_t *)user;
+  r->scanning = r->scan_ready = false;
+}
+
+static void sim_connect(void *user, const char *ssid, const char *pass, const uint8_t *bssid, uint8_t channel) {
+  sim_radio_t *r = (sim_radio_t *)user;
+  r->connects++;
+  r->target = -1;
+  for (int k = 0; k < r->ap_count && r->target < 0; k++) {
+    if (r->aps[k].present && !strcmp(r->aps[k].ssid, ssid) && (!bssid || bssid[5] == r->aps[k].bssid_last))
+      r->target = k;
+  }
+  r->last_fast = bssid != NULL && channel != 0;
+  r->link = WIFI_LINK_DOWN;
+  if (r->target < 0) {
+    r->target_ok = false;
+    r->link_at = r->now + prof->no_ap;
+  } else {
+    r->target_ok = !strcmp(r->aps[r->target].pass, pass);
+    r->link_at = r->now + (r->target_ok ? (channel ? prof->assoc_fast : prof->assoc) : prof->auth_fail);
+  }
+}
+
+static wifi_link_t sim_link(void *user) {
+  return ((sim_radio_t *)user)->link;
+}
+
+static void sim_disconnect(void *user) {
+  sim_radio_t *r = (sim_radio_t *)user;
+  r->target = -1;
+  r->link_at = 0;
+  r->link = WIFI_LINK_DOWN;
+}
+
+static void sim_event(wifi_mgr_t *m, wifi_mgr_event_t ev) {
+  (void)m;
+  if (ev == WIFI_MGR_EV_CONNECTED) sim.ev_connected++;
+  else if (ev == WIFI_MGR_EV_LOST) sim.ev_lost++;
+  else sim.ev_failed++;
+  sim.ev_time = sim.now;
+}
+
+// Avance le temps simule; s'arrete a la premiere connexion si until_up
+static void run(uint32_t duration_ms, bool until_up) {
+  uint32_t end = sim.now + duration_ms;
+  while (sim.now < end) {
+    sim.now += SIM_STEP_MS;
+    if (sim.scanning && !sim.scan_ready && sim.now >= sim.scan_end) sim.scan_ready = true;
+    if (sim.link_at && sim.now >= sim.link_at) {
+      sim.link_at = 0;
+      bool found = sim.target >= 0 && sim.aps[sim.target].present;
+      sim.link = !found ? WIFI_LINK_NOT_FOUND : sim.target_ok ? WIFI_LINK_UP : WIFI_LINK_FAILED;
+    }
+    if (sim.link == WIFI_LINK_UP && (sim.target < 0 || !sim.aps[sim.target].present)) sim.link = WIFI_LINK_DOWN;
+    wifi_mgr_step(&mgr, sim.now);
+    if (until_up && wifi_mgr_connected(&mgr)) return;
+  }
+}
+
+static int add_ap(const char *ssid, const char *pass, uint8_t bssid_last, uint8_t channel, int8_t rssi) {
+  sim_ap_t *ap = &sim.aps[sim.ap_count];
+  ap->ssid = ssid;
+  ap->pass = pass;
+  ap->bssid_last = bssid_last;
+  ap->channel = channel;
+  ap->rssi = rssi;
+  ap->present = true;
+  return sim.ap_count++;
+}
+
+static void reset(void) {
+  memset(&sim, 0, sizeof(sim));
+  sim.target = -1;
+  sim.now = 1000;
+  wifi_radio_t radio = { sim_scan_start, sim_scan_count, sim_scan_get, sim_scan_free,
+                         sim_connect,    sim_link,       sim_disconnect, &sim };
+  wifi_mgr_init(&mgr, &radio, sim_event, NULL);
+  wifi_mgr_set_network(&mgr, 0, "Maison", "pass-maison");
+  wifi_mgr_set_network(&mgr, 1, "Club", "pass-club");
+  wifi_mgr_set_network(&mgr, 2, "", "");
+  wifi_mgr_set_network(&mgr, 3, "Telephone", "pass-tel");
+}
+
+// Redemarrage du vario: gestionnaire neuf, meme radio, etat RAM perdu
+static void restart_mgr(void) {
+  wifi_radio_t radio = mgr.radio;
+  wifi_mgr_init(&mgr, &radio, sim_event, NULL);
+}
+
+// Temps de connexion depuis start()
+static uint32_t connect_time(void) {
+  uint32_t t0 = sim.now;
+  wifi_mgr_start(&mgr, sim.now);
+  run(60000, true);
+  return sim.now - t0;
+}
+
+static void check_selection(void) {
+  // Seul le 4e reseau est la: un scan puis une connexion (au lieu de 3 essais)
+  reset();
+  add_ap("Voisin", "x", 1, 6, -40);
+  add_ap("Telephone", "pass-tel", 2, 11, -60);
+  uint32_t t = connect_time();
+  printf("4e reseau: %u ms\n", (unsigned)t);
+  check(wifi_mgr_connected(&mgr) && !strcmp(wifi_mgr_ssid(&mgr), "Telephone"), "4e reseau choisi");
+  check(t <= prof->scan + prof->assoc_fast + SIM_SLACK_MS, "4e reseau: scan + association");
+  check(!prof->measured || t < 3000, "4e reseau en moins de 3 s");
+  check(sim.scans == 1 && sim.connects == 1, "un scan, un essai");
+  check(sim.ev_connected == 1, "evenement connecte");
+
+  // Priorite: Maison faible mais au-dessus du seuil vs Club fort
+  reset();
+  add_ap("Club", "pass-club", 3, 1, -50);
+  add_ap("Maison", "pass-maison", 4, 6, -55);
+  connect_time();
+  check(!strcmp(wifi_mgr_ssid(&mgr), "Maison"), "priorite a RSSI proche");
+  reset();
+  add_ap("Club", "pass-club", 3, 1, -45);
+  add_ap("Maison", "pass-maison", 4, 6, -80);
+  connect_time();
+  check(!strcmp(wifi_mgr_ssid(&mgr), "Club"), "RSSI nettement meilleur");
+
+  // Deux points d'acces du meme reseau: le plus fort
+  reset();
+  add_ap("Maison", "pass-maison", 5, 1, -75);
+  add_ap("Maison", "pass-maison", 6, 11, -48);
+  connect_time();
+  check(mgr.current.bssid[5] == 6 && mgr.current.channel == 11, "point d'acces le plus fort");
+
+  // Trop faible: ignore
+  reset();
+  add_ap("Maison", "pass-maison", 7, 1, -92);
+  add_ap("Club", "pass-club", 8, 6, -70);
+  connect_time();
+  check(!strcmp(wifi_mgr_ssid(&mgr), "Club"), "point d'acces trop faible ignore");
+}
+
+static void check_fallback(void) {
+  // Mot de passe refuse: candidat suivant du meme scan
+  reset();
+  add_ap("Maison", "autre-pass", 1, 1, -50);
+  add_ap("Club", "pass-club", 2, 6, -60);
+  uint32_t t = connect_time();
+  printf("repli apres refus: %u ms\n", (unsigned)t);
+  check(!strcmp(wifi_mgr_ssid(&mgr), "Club") && sim.scans == 1 && sim.connects == 2, "repli sans rescan");
+  check(t <= prof->scan + prof->auth_fail + prof->assoc_fast + SIM_SLACK_MS, "repli apres refus: scan + refus + association");
+
+  // Demarrage suivant (sans point d'acces memorise): le reseau refuse passe en dernier
+  wifi_mgr_stop(&mgr);
+  mgr.cached = false;
+  int connects = sim.connects;
+  t = connect_time();
+  printf("apres refus, demarrage suivant: %u ms\n", (unsigned)t);
+  check(!strcmp(wifi_mgr_ssid(&mgr), "Club") && sim.connects == connects + 1, "reseau refuse essaye en dernier");
+  check(t <= prof->scan + prof->assoc_fast + SIM_SLACK_MS, "demarrage suivant: scan + association");
+  check(!prof->measured || t < 3000, "demarrage suivant en moins de 3 s");
+
+  // Redemarrage du vario: refus relu depuis l'etat conserve (NVS)
+  wifi_mgr_saved_t saved;
+  wifi_mgr_get_saved(&mgr, &saved);
+  wifi_mgr_stop(&mgr);
+  restart_mgr();
+  wifi_mgr_set_network(&mgr, 0, "Maison", "pass-maison");
+  wifi_mgr_set_network(&mgr, 1, "Club", "pass-club");
+  saved.ssid[0] = '\0';  // Sans point d'acces memorise: scan
+  wifi_mgr_restore(&mgr, &saved);
+  connects = sim.connects;
+  t = connect_time();
+  check(!strcmp(wifi_mgr_ssid(&mgr), "Club") && sim.connects == connects + 1, "refus conserve au redemarrage");
+  check(!prof->measured || t < 3000, "apres redemarrage en moins de 3 s");
+
+  // Mot de passe corrige dans les reglages: priorite normale
+  wifi_mgr_stop(&mgr);
+  mgr.cached = false;
+  sim.aps[0].pass = "pass-maison2";
+  wifi_mgr_set_network(&mgr, 0, "Maison", "pass-maison2");
+  connect_time();
+  check(!strcmp(wifi_mgr_ssid(&mgr), "Maison"), "refus oublie apres modification");
+
+  // Aucun reseau connu: echec signale puis rescans espaces
+  reset();
+  add_ap("Voisin", "x", 1, 6, -40);
+  wifi_mgr_start(&mgr, sim.now);
+  run(2000, false);
+  check(sim.ev_failed == 1 && mgr.state == WIFI_MGR_WAIT, "echec signale");
+  run(WIFI_MGR_RETRY_MIN_MS + 3 * WIFI_MGR_RETRY_MIN_MS, false);
+  check(sim.scans == 3, "attente doublee entre scans");
+  add_ap("Club", "pass-club", 2, 6, -60);
+  run(WIFI_MGR_RETRY_MAX_MS + 5000, true);
+  check(wifi_mgr_connected(&mgr), "reseau apparu trouve");
+  check(mgr.retry_ms == WIFI_MGR_RETRY_MIN_MS, "attente remise a zero");
+}
+
+static void check_reconnect(void) {
+  reset();
+  int home = add_ap("Maison", "pass-maison", 1, 6, -50);
+  connect_time();
+
+  // Arret puis redemarrage: BSSID/canal memorises, pas de scan
+  wifi_mgr_stop(&mgr);
+  check(sim.target < 0 && mgr.state == WIFI_MGR_OFF, "arret");
+  run(5000, false);
+  int scans = sim.scans;
+  uint32_t t = connect_time();
+  printf("reconnexion rapide: %u ms\n", (unsigned)t);
+  check(sim.scans == scans && sim.last_fast && t <= prof->assoc_fast + SIM_SLACK_MS, "reconnexion sans scan");
+
+  // Perte du lien puis retour du point d'acces
+  sim.aps[home].present = false;
+  run(100, false);
+  check(sim.ev_lost == 1 && !wifi_mgr_connected(&mgr), "perte signalee");
+  run(1000, false);
+  sim.aps[home].present = true;
+  run(30000, true);
+  check(wifi_mgr_connected(&mgr) && sim.ev_connected == 3, "reconnecte apres perte");
+
+  // Point d'acces memorise remplace (autre BSSID): echec rapide puis scan
+  wifi_mgr_stop(&mgr);
+  sim.aps[home].present = false;
+  add_ap("Maison", "pass-maison", 9, 1, -55);
+  t = connect_time();
+  printf("point d'acces memorise absent: %u ms\n", (unsigned)t);
+  check(wifi_mgr_connected(&mgr) && mgr.current.bssid[5] == 9, "nouveau point d'acces");
+  check(t <= WIFI_MGR_FAST_TIMEOUT_MS + prof->scan + prof->assoc_fast + SIM_SLACK_MS, "repli sur scan");
+  check(!prof->measured || t < 3000, "point d'acces memorise absent en moins de 3 s");
+
+  // Reseau modifie dans les reglages: point d'acces memorise oublie
+  wifi_mgr_stop(&mgr);
+  wifi_mgr_set_network(&mgr, 0, "Maison", "nouveau-pass");
+  check(!mgr.cached, "cache oublie apres modification");
+  wifi_mgr_set_network(&mgr, 1, "Club", "pass-club");
+
+  // Arret pendant le scan: aucun evenement ensuite
+  reset();
+  add_ap("Club", "pass-club", 2, 6, -60);
+  wifi_mgr_start(&mgr, sim.now);
+  run(500, false);
+  wifi_mgr_stop(&mgr);
+  run(10000, false);
+  check(!sim.scanning && sim.connects == 0 && sim.ev_connected + sim.ev_failed == 0, "arret pendant le scan");
+}
+
+static void check_not_found_and_saved(void) {
+  // Point d'acces vu au scan puis disparu: candidat suivant, pas compte comme refus
+  reset();
+  int home = add_ap("Maison", "pass-maison", 1, 1, -50);
+  add_ap("Club", "pass-club", 2, 6, -60);
+  wifi_mgr_start(&mgr, sim.now);
+  run(prof->scan + SIM_STEP_MS, false);
+  sim.aps[home].present = false;
+  run(30000, true);
+  check(wifi_mgr_connected(&mgr) && !strcmp(wifi_mgr_ssid(&mgr), "Club"), "absent: candidat suivant");
+  check(mgr.refused == 0, "absent: pas de refus");
+
+  // Etat conserve puis relu au demarrage suivant: reconnexion sans scan
+  wifi_mgr_saved_t saved;
+  wifi_mgr_get_saved(&mgr, &saved);
+  check(!strcmp(saved.ssid, "Club") && saved.channel == 6 && saved.bssid[5] == 2, "etat conserve");
+  wifi_mgr_stop(&mgr);
+  restart_mgr();
+  wifi_mgr_set_network(&mgr, 0, "Maison", "pass-maison");
+  wifi_mgr_set_network(&mgr, 1, "Club", "pass-club");
+  wifi_mgr_restore(&mgr, &saved);
+  int scans = sim.scans;
+  uint32_t t = connect_time();
+  printf("apres redemarrage, point d'acces conserve: %u ms\n", (unsigned)t);
+  check(wifi_mgr_connected(&mgr) && sim.scans == scans && sim.last_fast, "reconnexion sans scan apres redemarrage");
+  check(!prof->measured || t < 1000, "point d'acces conserve en moins de 1 s");
+
+  // Reseau retire des reglages: point d'acces conserve ignore
+  wifi_mgr_stop(&mgr);
+  restart_mgr();
+  wifi_mgr_set_network(&mgr, 0, "Maison", "pass-maison");
+  wifi_mgr_restore(&mgr, &saved);
+  check(!mgr.cached, "point d'acces d'un reseau retire ignore");
+}
+
+int main() {
+  for (size_t i = 0; i < sizeof(profiles) / sizeof(profiles[0]); i++) {
+    prof = &profiles[i];
+    printf("-- durees %s\n", prof->name);
+    check_selection();
+    check_fallback();
+    check_reconnect();
+    check_not_found_and_saved();
+  }
+  printf("etat: %u octets\n", (unsigned)sizeof(wifi_mgr_t));
+  printf("%s\n", failures ? "ECHEC" : "ok");
+  return failures ? 1 : 0;
+}